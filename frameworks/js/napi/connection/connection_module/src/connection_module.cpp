@@ -21,6 +21,7 @@
 #include "getaddressbyname_context.h"
 #include "getdefaultnet_context.h"
 #include "net_all_capabilities.h"
+#include "net_conn_client.h"
 #include "netconnection.h"
 #include "netmanager_base_log.h"
 #include "netmanager_base_module_template.h"
@@ -145,6 +146,10 @@ napi_value ConnectionModule::InitConnectionModule(napi_env env, napi_value expor
     ModuleTemplate::DefineClass(env, exports, netConnectionFunctions, INTERFACE_NET_CONNECTION);
 
     InitProperties(env, exports);
+
+    // Apps poll the default network and its properties, answer them from the shared page and the cache
+    DelayedSingleton<NetConnClient>::GetInstance()->SetStatePageEnabled(true);
+    DelayedSingleton<NetConnClient>::GetInstance()->SetStateCacheEnabled(true);
     return exports;
 }
 
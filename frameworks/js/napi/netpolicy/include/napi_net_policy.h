@@ -90,6 +90,11 @@ struct GetBackgroundPolicyContext : BaseContext {
     NetBackgroundPolicy backgroundPolicy;
 };
 
+struct UidPoliciesContext : BaseContext {
+    std::vector<uint32_t> uids;
+    std::vector<NetUidPolicy> policies;
+};
+
 struct CellularPolicysContext : BaseContext {
     std::vector<NetPolicyCellularPolicy> input;
 };
@@ -109,6 +114,8 @@ public:
     static void ExecRestoreAllPolicies(napi_env env, void *data);
     static void ExecSetBackgroundPolicy(napi_env env, void *data);
     static void ExecGetBackgroundPolicy(napi_env env, void *data);
+    static void ExecSetPoliciesByUids(napi_env env, void *data);
+    static void ExecGetPoliciesByUids(napi_env env, void *data);
     static void ExecOn(napi_env env, void *data);
     static void ExecOff(napi_env env, void *data);
     static void CompleteSetPolicyByUid(napi_env env, napi_status status, void *data);
@@ -120,6 +127,8 @@ public:
     static void CompleteRestoreAllPolicies(napi_env env, napi_status status, void *data);
     static void CompleteSetBackgroundPolicy(napi_env env, napi_status status, void *data);
     static void CompleteGetBackgroundPolicy(napi_env env, napi_status status, void *data);
+    static void CompleteSetPoliciesByUids(napi_env env, napi_status status, void *data);
+    static void CompleteGetPoliciesByUids(napi_env env, napi_status status, void *data);
     static void CompleteOn(napi_env env, napi_status status, void *data);
     static void CompleteOff(napi_env env, napi_status status, void *data);
 
@@ -128,6 +137,8 @@ public:
     static napi_value SetPolicyByUid(napi_env env, napi_callback_info info);
     static napi_value GetPolicyByUid(napi_env env, napi_callback_info info);
     static napi_value GetUidsByPolicy(napi_env env, napi_callback_info info);
+    static napi_value SetPoliciesByUids(napi_env env, napi_callback_info info);
+    static napi_value GetPoliciesByUids(napi_env env, napi_callback_info info);
     static napi_value SetNetQuotaPolicies(napi_env env, napi_callback_info info);
     static napi_value GetNetQuotaPolicies(napi_env env, napi_callback_info info);
     static napi_value SetSnoozePolicy(napi_env env, napi_callback_info info);
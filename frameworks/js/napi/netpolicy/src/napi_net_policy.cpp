@@ -620,12 +620,171 @@ napi_value NapiNetPolicy::GetBackgroundPolicy(napi_env env, napi_callback_info i
     return result;
 }
 
+bool MatchPoliciesByUidsParameters(napi_env env, napi_value argv[], size_t argc)
+{
+    switch (argc) {
+        case ARGV_INDEX_1: {
+            return NapiCommon::MatchParameters(env, argv, {napi_object});
+        }
+        case ARGV_INDEX_2: {
+            return NapiCommon::MatchParameters(env, argv, {napi_object, napi_function});
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+bool ReadUidPolicies(napi_env env, napi_value array, UidPoliciesContext *context)
+{
+    bool isArray = false;
+    uint32_t length = 0;
+    if (napi_is_array(env, array, &isArray) != napi_ok || !isArray ||
+        napi_get_array_length(env, array, &length) != napi_ok || length > MAX_UID_POLICY_BATCH_SIZE) {
+        return false;
+    }
+    context->uids.reserve(length);
+    context->policies.reserve(length);
+    for (uint32_t i = 0; i < length; ++i) {
+        napi_value element = nullptr;
+        napi_get_element(env, array, i, &element);
+        if (!NapiCommon::MatchValueType(env, element, napi_object) ||
+            !NapiCommon::MatchObjectProperty(env, element, {{"uid", napi_number}, {"policy", napi_number}})) {
+            return false;
+        }
+        uint32_t uid = 0;
+        uint32_t policy = 0;
+        napi_get_value_uint32(env, NapiCommon::GetNamedProperty(env, element, "uid"), &uid);
+        napi_get_value_uint32(env, NapiCommon::GetNamedProperty(env, element, "policy"), &policy);
+        context->uids.push_back(uid);
+        context->policies.push_back(static_cast<NetUidPolicy>(policy));
+    }
+    return true;
+}
+
+bool ReadUids(napi_env env, napi_value array, UidPoliciesContext *context)
+{
+    bool isArray = false;
+    uint32_t length = 0;
+    if (napi_is_array(env, array, &isArray) != napi_ok || !isArray ||
+        napi_get_array_length(env, array, &length) != napi_ok || length > MAX_UID_POLICY_BATCH_SIZE) {
+        return false;
+    }
+    context->uids.reserve(length);
+    for (uint32_t i = 0; i < length; ++i) {
+        napi_value element = nullptr;
+        napi_get_element(env, array, i, &element);
+        uint32_t uid = 0;
+        if (!NapiCommon::MatchValueType(env, element, napi_number) ||
+            napi_get_value_uint32(env, element, &uid) != napi_ok) {
+            return false;
+        }
+        context->uids.push_back(uid);
+    }
+    return true;
+}
+
+void NapiNetPolicy::ExecSetPoliciesByUids(napi_env env, void *data)
+{
+    auto context = static_cast<UidPoliciesContext *>(data);
+    NetPolicyResultCode result =
+        DelayedSingleton<NetPolicyClient>::GetInstance()->SetPoliciesByUids(context->uids, context->policies);
+    context->errorCode = static_cast<int32_t>(result);
+    context->resolved = (result == NetPolicyResultCode::ERR_NONE);
+}
+
+void NapiNetPolicy::ExecGetPoliciesByUids(napi_env env, void *data)
+{
+    auto context = static_cast<UidPoliciesContext *>(data);
+    NetPolicyResultCode result =
+        DelayedSingleton<NetPolicyClient>::GetInstance()->GetPoliciesByUids(context->uids, context->policies);
+    context->errorCode = static_cast<int32_t>(result);
+    context->resolved = (result == NetPolicyResultCode::ERR_NONE);
+}
+
+void NapiNetPolicy::CompleteSetPoliciesByUids(napi_env env, napi_status status, void *data)
+{
+    auto context = static_cast<UidPoliciesContext *>(data);
+    napi_value callbackValue = nullptr;
+    if (status == napi_ok) {
+        if (context->resolved) {
+            napi_get_undefined(env, &callbackValue);
+        } else {
+            callbackValue = NapiCommon::CreateCodeMessage(env, "Failed to SetPoliciesByUids", context->errorCode);
+        }
+    } else {
+        callbackValue = NapiCommon::CreateErrorMessage(
+            env, "SetPoliciesByUids error,napi_status = " + std::to_string(status));
+    }
+    NapiCommon::Handle1ValueCallback(env, context, callbackValue);
+}
+
+void NapiNetPolicy::CompleteGetPoliciesByUids(napi_env env, napi_status status, void *data)
+{
+    auto context = static_cast<UidPoliciesContext *>(data);
+    napi_value callbackValue = nullptr;
+    if (status == napi_ok) {
+        if (context->resolved) {
+            napi_create_array_with_length(env, context->policies.size(), &callbackValue);
+            for (size_t i = 0; i < context->policies.size(); ++i) {
+                napi_value policy = nullptr;
+                napi_create_uint32(env, static_cast<uint32_t>(context->policies[i]), &policy);
+                napi_set_element(env, callbackValue, static_cast<uint32_t>(i), policy);
+            }
+        } else {
+            callbackValue = NapiCommon::CreateCodeMessage(env, "Failed to GetPoliciesByUids", context->errorCode);
+        }
+    } else {
+        callbackValue = NapiCommon::CreateErrorMessage(
+            env, "GetPoliciesByUids error,napi_status = " + std::to_string(status));
+    }
+    NapiCommon::Handle2ValueCallback(env, context, callbackValue);
+}
+
+napi_value NapiNetPolicy::SetPoliciesByUids(napi_env env, napi_callback_info info)
+{
+    size_t argc = ARGV_NUM_2;
+    napi_value argv[] = {nullptr, nullptr};
+    napi_value thisVar = nullptr;
+    void *data = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, &thisVar, &data));
+    NAPI_ASSERT(env, MatchPoliciesByUidsParameters(env, argv, argc), "type mismatch");
+    auto context = std::make_unique<UidPoliciesContext>();
+    NAPI_ASSERT(env, ReadUidPolicies(env, argv[ARGV_INDEX_0], context.get()), "invalid uid policies");
+    if (argc == ARGV_NUM_2) {
+        napi_create_reference(env, argv[ARGV_INDEX_1], CALLBACK_REF_CNT, &context->callbackRef);
+    }
+    napi_value result = NapiCommon::HandleAsyncWork(
+        env, context.release(), "SetPoliciesByUids", ExecSetPoliciesByUids, CompleteSetPoliciesByUids);
+    return result;
+}
+
+napi_value NapiNetPolicy::GetPoliciesByUids(napi_env env, napi_callback_info info)
+{
+    size_t argc = ARGV_NUM_2;
+    napi_value argv[] = {nullptr, nullptr};
+    napi_value thisVar = nullptr;
+    void *data = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, &thisVar, &data));
+    NAPI_ASSERT(env, MatchPoliciesByUidsParameters(env, argv, argc), "type mismatch");
+    auto context = std::make_unique<UidPoliciesContext>();
+    NAPI_ASSERT(env, ReadUids(env, argv[ARGV_INDEX_0], context.get()), "invalid uids");
+    if (argc == ARGV_NUM_2) {
+        napi_create_reference(env, argv[ARGV_INDEX_1], CALLBACK_REF_CNT, &context->callbackRef);
+    }
+    napi_value result = NapiCommon::HandleAsyncWork(
+        env, context.release(), "GetPoliciesByUids", ExecGetPoliciesByUids, CompleteGetPoliciesByUids);
+    return result;
+}
+
 napi_value NapiNetPolicy::DeclareNapiNetPolicyInterface(napi_env env, napi_value exports)
 {
     napi_property_descriptor desc[] = {
         DECLARE_NAPI_FUNCTION("setPolicyByUid", SetPolicyByUid),
         DECLARE_NAPI_FUNCTION("getPolicyByUid", GetPolicyByUid),
         DECLARE_NAPI_FUNCTION("getUidsByPolicy", GetUidsByPolicy),
+        DECLARE_NAPI_FUNCTION("setPoliciesByUids", SetPoliciesByUids),
+        DECLARE_NAPI_FUNCTION("getPoliciesByUids", GetPoliciesByUids),
         DECLARE_NAPI_FUNCTION("setNetQuotaPolicies", SetNetQuotaPolicies),
         DECLARE_NAPI_FUNCTION("getNetQuotaPolicies", GetNetQuotaPolicies),
         DECLARE_NAPI_FUNCTION("restoreAllPolicies", RestoreAllPolicies),
@@ -15,10 +15,26 @@
 
 #include "net_all_capabilities.h"
 
+#include "net_flat_buffer.h"
 #include "net_mgr_log_wrapper.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
+namespace {
+// Takes the place of the capability count, which the legacy format keeps far below it
+constexpr uint32_t CAPS_MASK_MARKER = 0x80000000u | NET_FLAT_VERSION;
+} // namespace
+
+bool NetAllCapabilities::operator==(const NetAllCapabilities &obj) const
+{
+    bool out = true;
+    out = out && (linkUpBandwidthKbps_ == obj.linkUpBandwidthKbps_);
+    out = out && (linkDownBandwidthKbps_ == obj.linkDownBandwidthKbps_);
+    out = out && (netCaps_ == obj.netCaps_);
+    out = out && (bearerTypes_ == obj.bearerTypes_);
+    return out;
+}
+
 bool NetAllCapabilities::CapsIsValid() const
 {
     for (auto it = netCaps_.begin(); it != netCaps_.end(); it++) {
@@ -48,6 +64,11 @@ bool NetAllCapabilities::Marshalling(Parcel &parcel) const
     if (!parcel.WriteUint32(linkUpBandwidthKbps_) || !parcel.WriteUint32(linkDownBandwidthKbps_)) {
         return false;
     }
+    // The masks drop out of range values, those go as a list so the receiver can still reject them
+    if (!IsNetLegacyWireFormat() && CapsIsValid()) {
+        return parcel.WriteUint32(CAPS_MASK_MARKER) && parcel.WriteUint32(ToCapsMask(netCaps_)) &&
+            parcel.WriteUint32(ToBearerTypesMask(bearerTypes_));
+    }
     if (!parcel.WriteUint32(netCaps_.size())) {
         return false;
     }
@@ -79,14 +100,21 @@ bool NetAllCapabilities::Unmarshalling(Parcel &parcel)
     if (!parcel.ReadUint32(size)) {
         return false;
     }
+    if (size == CAPS_MASK_MARKER) {
+        uint32_t capsMask = 0;
+        uint32_t bearerTypesMask = 0;
+        if (!parcel.ReadUint32(capsMask) || !parcel.ReadUint32(bearerTypesMask)) {
+            return false;
+        }
+        FromMasks(capsMask, bearerTypesMask);
+        return true;
+    }
     uint32_t cap = 0;
     for (uint32_t i = 0; i < size; i++) {
         if (!parcel.ReadUint32(cap)) {
             return false;
         }
-        if (cap >= NET_CAPABILITY_INTERNAL_DEFAULT) {
-            continue;
-        }
+        // Out of range values are kept, dropping them would widen the request, CapsIsValid rejects them
         netCaps_.insert(static_cast<NetCap>(cap));
     }
     if (!parcel.ReadUint32(size)) {
@@ -97,14 +125,25 @@ bool NetAllCapabilities::Unmarshalling(Parcel &parcel)
         if (!parcel.ReadUint32(type)) {
             return false;
         }
-        if (type >= BEARER_DEFAULT) {
-            continue;
-        }
         bearerTypes_.insert(static_cast<NetBearType>(type));
     }
     return true;
 }
 
+void NetAllCapabilities::FromMasks(uint32_t capsMask, uint32_t bearerTypesMask)
+{
+    for (uint32_t cap = NET_CAPABILITY_MMS; cap < NET_CAPABILITY_INTERNAL_DEFAULT; cap++) {
+        if (capsMask & (1u << cap)) {
+            netCaps_.insert(netCaps_.end(), static_cast<NetCap>(cap));
+        }
+    }
+    for (uint32_t type = BEARER_CELLULAR; type < BEARER_DEFAULT; type++) {
+        if (bearerTypesMask & (1u << type)) {
+            bearerTypes_.insert(bearerTypes_.end(), static_cast<NetBearType>(type));
+        }
+    }
+}
+
 std::string NetAllCapabilities::ToString(const std::string &tab) const
 {
     std::string str;
@@ -191,5 +230,27 @@ void NetAllCapabilities::ToStrNetBearTypes(const std::set<NetBearType> &bearerTy
         }
     }
 }
+
+uint32_t NetAllCapabilities::ToCapsMask(const std::set<NetCap> &netCaps)
+{
+    uint32_t mask = 0;
+    for (auto cap : netCaps) {
+        if ((cap >= NET_CAPABILITY_MMS) && (cap < NET_CAPABILITY_INTERNAL_DEFAULT)) {
+            mask |= (1u << static_cast<uint32_t>(cap));
+        }
+    }
+    return mask;
+}
+
+uint32_t NetAllCapabilities::ToBearerTypesMask(const std::set<NetBearType> &bearerTypes)
+{
+    uint32_t mask = 0;
+    for (auto type : bearerTypes) {
+        if ((type >= BEARER_CELLULAR) && (type < BEARER_DEFAULT)) {
+            mask |= (1u << static_cast<uint32_t>(type));
+        }
+    }
+    return mask;
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "net_conn_callback_batch.h"
+
+#include "net_mgr_log_wrapper.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint32_t MAX_BATCH_EVENT_NUM = 1024;
+constexpr uint32_t ALL_FACETS = FACET_AVAILABLE | FACET_CAPABILITIES | FACET_CONNECTION_PROPERTIES |
+    FACET_BLOCK_STATUS | FACET_LOST | FACET_UNAVAILABLE;
+
+bool CanMerge(const NetConnCallbackEvent &pending, const NetConnCallbackEvent &event)
+{
+    if (pending.netId != event.netId || (pending.facets & (FACET_LOST | FACET_UNAVAILABLE))) {
+        return false;
+    }
+    // Facets already pending only get a newer value, new ones must come after all of them in enum order.
+    uint32_t added = event.facets & ~pending.facets;
+    uint32_t lowestAdded = added & (~added + 1);
+    return added == 0 || lowestAdded > pending.facets;
+}
+} // namespace
+
+void NetConnCallbackBatch::Add(const NetConnCallbackEvent &event)
+{
+    if (events_.empty() || !CanMerge(events_.back(), event)) {
+        events_.push_back(event);
+        return;
+    }
+    NetConnCallbackEvent &pending = events_.back();
+    pending.facets |= event.facets;
+    if (event.facets & FACET_CAPABILITIES) {
+        pending.netAllCap = event.netAllCap;
+    }
+    if (event.facets & FACET_CONNECTION_PROPERTIES) {
+        pending.linkInfo = event.linkInfo;
+    }
+    if (event.facets & FACET_BLOCK_STATUS) {
+        pending.blocked = event.blocked;
+    }
+}
+
+bool NetConnCallbackBatch::IsEmpty() const
+{
+    return events_.empty();
+}
+
+bool NetConnCallbackBatch::Marshalling(Parcel &parcel) const
+{
+    if (!parcel.WriteUint32(static_cast<uint32_t>(events_.size()))) {
+        return false;
+    }
+    for (const auto &event : events_) {
+        if (!parcel.WriteInt32(event.netId) || !parcel.WriteUint32(event.facets)) {
+            return false;
+        }
+        if ((event.facets & FACET_CAPABILITIES) &&
+            (event.netAllCap == nullptr || !event.netAllCap->Marshalling(parcel))) {
+            return false;
+        }
+        if ((event.facets & FACET_CONNECTION_PROPERTIES) &&
+            (event.linkInfo == nullptr || !event.linkInfo->Marshalling(parcel))) {
+            return false;
+        }
+        if ((event.facets & FACET_BLOCK_STATUS) && !parcel.WriteBool(event.blocked)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+sptr<NetConnCallbackBatch> NetConnCallbackBatch::Unmarshalling(Parcel &parcel)
+{
+    sptr<NetConnCallbackBatch> ptr = (std::make_unique<NetConnCallbackBatch>()).release();
+    if (ptr == nullptr) {
+        NETMGR_LOG_E("make_unique<NetConnCallbackBatch>() failed");
+        return nullptr;
+    }
+    uint32_t size = 0;
+    if (!parcel.ReadUint32(size)) {
+        return nullptr;
+    }
+    if (size > MAX_BATCH_EVENT_NUM) {
+        NETMGR_LOG_E("batch event num [%{public}u] out of range", size);
+        return nullptr;
+    }
+    ptr->events_.resize(size);
+    for (auto &event : ptr->events_) {
+        if (!parcel.ReadInt32(event.netId) || !parcel.ReadUint32(event.facets)) {
+            return nullptr;
+        }
+        if ((event.facets & ~ALL_FACETS) != 0) {
+            return nullptr;
+        }
+        if (event.facets & FACET_CAPABILITIES) {
+            event.netAllCap = (std::make_unique<NetAllCapabilities>()).release();
+            if (event.netAllCap == nullptr || !event.netAllCap->Unmarshalling(parcel)) {
+                return nullptr;
+            }
+        }
+        if (event.facets & FACET_CONNECTION_PROPERTIES) {
+            event.linkInfo = NetLinkInfo::Unmarshalling(parcel);
+            if (event.linkInfo == nullptr) {
+                return nullptr;
+            }
+        }
+        if ((event.facets & FACET_BLOCK_STATUS) && !parcel.ReadBool(event.blocked)) {
+            return nullptr;
+        }
+    }
+    return ptr;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -151,8 +151,31 @@ int32_t NetConnClient::GetDefaultNet(NetHandle &netHandle)
         return IPC_PROXY_ERR;
     }
 
+    NetStateSummary state;
+    if (ReadDefaultNetFromPage(state)) {
+        netHandle.SetNetId(state.defaultNetId);
+        return ERR_NONE;
+    }
+
     int32_t netId = 0;
-    int32_t result = proxy->GetDefaultNet(netId);
+    int32_t result = ERR_NONE;
+    uint64_t version = 0;
+    bool cached = PrepareStateCache(proxy, version);
+    std::unique_lock<std::mutex> lock(cacheMutex_);
+    if (cached && cache_.hasDefaultNetId) {
+        result = cache_.defaultNetRet;
+        netId = cache_.defaultNetId;
+    } else {
+        lock.unlock();
+        result = proxy->GetDefaultNet(netId);
+        lock.lock();
+        if (cached && cache_.subscribed && cache_.version == version) {
+            cache_.hasDefaultNetId = true;
+            cache_.defaultNetRet = result;
+            cache_.defaultNetId = netId;
+        }
+    }
+    lock.unlock();
     if (result != ERR_NONE) {
         NETMGR_LOG_D("fail to get default net.");
         return result;
@@ -170,7 +193,30 @@ int32_t NetConnClient::HasDefaultNet(bool& flag)
         NETMGR_LOG_E("proxy is nullptr");
         return IPC_PROXY_ERR;
     }
-    return proxy->HasDefaultNet(flag);
+
+    NetStateSummary state;
+    if (ReadDefaultNetFromPage(state)) {
+        flag = true;
+        return ERR_NONE;
+    }
+
+    uint64_t version = 0;
+    bool cached = PrepareStateCache(proxy, version);
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        if (cached && cache_.hasDefaultFlag) {
+            flag = cache_.defaultFlag;
+            return cache_.defaultFlagRet;
+        }
+    }
+    int32_t result = proxy->HasDefaultNet(flag);
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (cached && cache_.subscribed && cache_.version == version) {
+        cache_.hasDefaultFlag = true;
+        cache_.defaultFlagRet = result;
+        cache_.defaultFlag = flag;
+    }
+    return result;
 }
 
 int32_t NetConnClient::GetAllNets(std::list<sptr<NetHandle>> &netList)
@@ -204,7 +250,23 @@ int32_t NetConnClient::GetConnectionProperties(const NetHandle &netHandle, NetLi
         return IPC_PROXY_ERR;
     }
 
-    return proxy->GetConnectionProperties(netHandle.GetNetId(), info);
+    int32_t netId = netHandle.GetNetId();
+    uint64_t version = 0;
+    bool cached = PrepareStateCache(proxy, version);
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto iter = cache_.linkInfos.find(netId);
+        if (cached && iter != cache_.linkInfos.end()) {
+            info = iter->second;
+            return ERR_NONE;
+        }
+    }
+    int32_t result = proxy->GetConnectionProperties(netId, info);
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (result == ERR_NONE && cached && cache_.subscribed && cache_.version == version) {
+        cache_.linkInfos[netId] = info;
+    }
+    return result;
 }
 
 int32_t NetConnClient::GetNetCapabilities(const NetHandle &netHandle, NetAllCapabilities &netAllCap)
@@ -215,7 +277,23 @@ int32_t NetConnClient::GetNetCapabilities(const NetHandle &netHandle, NetAllCapa
         return IPC_PROXY_ERR;
     }
 
-    return proxy->GetNetCapabilities(netHandle.GetNetId(), netAllCap);
+    int32_t netId = netHandle.GetNetId();
+    uint64_t version = 0;
+    bool cached = PrepareStateCache(proxy, version);
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto iter = cache_.netCaps.find(netId);
+        if (cached && iter != cache_.netCaps.end()) {
+            netAllCap = iter->second;
+            return ERR_NONE;
+        }
+    }
+    int32_t result = proxy->GetNetCapabilities(netId, netAllCap);
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (result == ERR_NONE && cached && cache_.subscribed && cache_.version == version) {
+        cache_.netCaps[netId] = netAllCap;
+    }
+    return result;
 }
 
 int32_t NetConnClient::GetAddressesByName(const std::string &host, int32_t netId, std::vector<INetAddr> &addrList)
@@ -343,6 +421,172 @@ void NetConnClient::OnRemoteDied(const wptr<IRemoteObject> &remote)
 
     local->RemoveDeathRecipient(deathRecipient_);
     NetConnService_ = nullptr;
+
+    // The restarted service starts a new version sequence and knows nothing of our subscription
+    {
+        std::lock_guard<std::mutex> cacheLock(cacheMutex_);
+        ResetStateCacheLocked(0);
+        cache_.subscribed = false;
+    }
+    std::lock_guard<std::mutex> pageLock(pageMutex_);
+    statePage_.store(nullptr, std::memory_order_release);
+    if (statePageMem_ != nullptr) {
+        retiredPages_.push_back(statePageMem_);
+        statePageMem_ = nullptr;
+    }
+    statePageRefused_ = false;
+}
+
+int32_t NetConnClient::GetNetStateSummary(NetStateSummary &state)
+{
+    const NetConnStatePage *page = statePage_.load(std::memory_order_acquire);
+    if (page == nullptr) {
+        page = MapStatePage();
+    }
+    if (page == nullptr) {
+        return NET_CONN_ERR_INTERNAL_ERROR;
+    }
+    if (!page->Read(state)) {
+        return NET_CONN_ERR_INTERNAL_ERROR;
+    }
+    return ERR_NONE;
+}
+
+void NetConnClient::SetStatePageEnabled(bool enable)
+{
+    statePageEnabled_.store(enable, std::memory_order_relaxed);
+}
+
+bool NetConnClient::ReadDefaultNetFromPage(NetStateSummary &state)
+{
+    // The service maps the page only for holders of GET_NETWORK_INFO, everyone else falls back to the IPC
+    // and gets the permission error from there
+    if (!statePageEnabled_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    return GetNetStateSummary(state) == ERR_NONE && (state.flags & STATE_FLAG_DEFAULT_NET) != 0;
+}
+
+const NetConnStatePage *NetConnClient::MapStatePage()
+{
+    // Taken before pageMutex_, OnRemoteDied locks mutex_ first as well
+    sptr<INetConnService> proxy = GetProxy();
+    if (proxy == nullptr) {
+        NETMGR_LOG_E("proxy is nullptr");
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(pageMutex_);
+    const NetConnStatePage *page = statePage_.load(std::memory_order_acquire);
+    if (page != nullptr || statePageRefused_) {
+        return page;
+    }
+    sptr<Ashmem> mem = nullptr;
+    int32_t ret = proxy->GetNetStatePage(mem);
+    if (ret != ERR_NONE || mem == nullptr) {
+        NETMGR_LOG_E("get state page failed, ret [%{public}d]", ret);
+        statePageRefused_ = true;
+        return nullptr;
+    }
+    if (!mem->MapReadOnlyAshmem()) {
+        NETMGR_LOG_E("map state page failed");
+        statePageRefused_ = true;
+        return nullptr;
+    }
+    page = NetConnStatePage::Attach(mem->ReadFromAshmem(sizeof(NetConnStatePage), 0), mem->GetAshmemSize());
+    if (page == nullptr) {
+        NETMGR_LOG_E("unknown state page layout");
+        statePageRefused_ = true;
+        return nullptr;
+    }
+    statePageMem_ = mem;
+    statePage_.store(page, std::memory_order_release);
+    return page;
+}
+
+void NetConnClient::SetStateCacheEnabled(bool enable)
+{
+    sptr<NetStateCallback> callback;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        cacheEnabled_ = enable;
+        ResetStateCacheLocked(cache_.version);
+        if (enable || !cache_.subscribed) {
+            return;
+        }
+        cache_.subscribed = false;
+        callback = stateCallback_;
+    }
+    UnsubscribeStateVersion(callback);
+}
+
+void NetConnClient::UnsubscribeStateVersion(const sptr<NetStateCallback> &callback)
+{
+    sptr<INetConnService> proxy = GetProxy();
+    if (proxy == nullptr) {
+        NETMGR_LOG_E("proxy is nullptr");
+        return;
+    }
+    int32_t ret = proxy->UnregisterNetStateCallback(callback);
+    if (ret != ERR_NONE) {
+        NETMGR_LOG_E("unregister net state callback failed, ret [%{public}d]", ret);
+    }
+}
+
+bool NetConnClient::PrepareStateCache(const sptr<INetConnService> &proxy, uint64_t &version)
+{
+    sptr<NetStateCallback> callback;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        if (!cacheEnabled_) {
+            return false;
+        }
+        if (cache_.subscribed) {
+            version = cache_.version;
+            return true;
+        }
+        if (stateCallback_ == nullptr) {
+            stateCallback_ = (std::make_unique<NetStateCallback>(*this)).release();
+        }
+        callback = stateCallback_;
+    }
+
+    int32_t ret = proxy->RegisterNetStateCallback(callback, version);
+    if (ret != ERR_NONE) {
+        NETMGR_LOG_E("register net state callback failed, ret [%{public}d]", ret);
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        if (cacheEnabled_) {
+            if (!cache_.subscribed) {
+                ResetStateCacheLocked(version);
+                cache_.subscribed = true;
+            }
+            version = cache_.version;
+            return true;
+        }
+    }
+    // Turned off while subscribing
+    UnsubscribeStateVersion(callback);
+    return false;
+}
+
+void NetConnClient::OnStateVersionChange(uint64_t version)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (cache_.subscribed && cache_.version != version) {
+        NETMGR_LOG_D("net state version [%{public}s]", std::to_string(version).c_str());
+        ResetStateCacheLocked(version);
+    }
+}
+
+void NetConnClient::ResetStateCacheLocked(uint64_t version)
+{
+    bool subscribed = cache_.subscribed;
+    cache_ = StateCache();
+    cache_.subscribed = subscribed;
+    cache_.version = version;
 }
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "net_conn_state_page.h"
+
+#include <new>
+#include <thread>
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint32_t MAX_READ_RETRY = 64;
+} // namespace
+
+NetConnStatePage::NetConnStatePage()
+    : magic_(MAGIC), layoutVersion_(LAYOUT_VERSION), sequence_(0), defaultNetId_(0), flags_(0), bearerTypes_(0),
+      linkUpBandwidthKbps_(0), linkDownBandwidthKbps_(0), version_(0)
+{
+}
+
+NetConnStatePage *NetConnStatePage::Create(void *addr)
+{
+    if (addr == nullptr) {
+        return nullptr;
+    }
+    return new (addr) NetConnStatePage();
+}
+
+const NetConnStatePage *NetConnStatePage::Attach(const void *addr, size_t size)
+{
+    if (addr == nullptr || size < sizeof(NetConnStatePage)) {
+        return nullptr;
+    }
+    auto page = static_cast<const NetConnStatePage *>(addr);
+    if (page->magic_.load(std::memory_order_relaxed) != MAGIC ||
+        page->layoutVersion_.load(std::memory_order_relaxed) != LAYOUT_VERSION) {
+        return nullptr;
+    }
+    return page;
+}
+
+void NetConnStatePage::Write(const NetStateSummary &state)
+{
+    uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    defaultNetId_.store(state.defaultNetId, std::memory_order_relaxed);
+    flags_.store(state.flags, std::memory_order_relaxed);
+    bearerTypes_.store(state.bearerTypes, std::memory_order_relaxed);
+    linkUpBandwidthKbps_.store(state.linkUpBandwidthKbps, std::memory_order_relaxed);
+    linkDownBandwidthKbps_.store(state.linkDownBandwidthKbps, std::memory_order_relaxed);
+    version_.store(state.version, std::memory_order_relaxed);
+    sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+bool NetConnStatePage::Read(NetStateSummary &state) const
+{
+    for (uint32_t i = 0; i < MAX_READ_RETRY; ++i) {
+        uint32_t begin = sequence_.load(std::memory_order_acquire);
+        if (begin & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        state.defaultNetId = defaultNetId_.load(std::memory_order_relaxed);
+        state.flags = flags_.load(std::memory_order_relaxed);
+        state.bearerTypes = bearerTypes_.load(std::memory_order_relaxed);
+        state.linkUpBandwidthKbps = linkUpBandwidthKbps_.load(std::memory_order_relaxed);
+        state.linkDownBandwidthKbps = linkDownBandwidthKbps_.load(std::memory_order_relaxed);
+        state.version = version_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) == begin) {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "net_flat_buffer.h"
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <cstring>
+#include <limits>
+
+#include "net_mgr_log_wrapper.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint8_t ADDRESS_EMPTY = 0;
+constexpr uint8_t ADDRESS_IPV4 = 4;
+constexpr uint8_t ADDRESS_IPV6 = 16;
+constexpr uint8_t ADDRESS_TEXT = 0xFF;
+constexpr uint32_t BITS_PER_BYTE = 8;
+constexpr uint32_t MAX_FLAT_BUFFER_SIZE = 64 * 1024;
+
+std::atomic<bool> g_legacyWireFormat(false);
+
+// The raw form is only used when it converts back to the very same text, so the round trip is lossless
+bool ToRawAddress(const std::string &address, int32_t family, uint8_t *raw)
+{
+    char text[INET6_ADDRSTRLEN] = {0};
+    return inet_pton(family, address.c_str(), raw) == 1 &&
+        inet_ntop(family, raw, text, sizeof(text)) != nullptr && address == text;
+}
+} // namespace
+
+void SetNetLegacyWireFormat(bool legacy)
+{
+    g_legacyWireFormat.store(legacy, std::memory_order_relaxed);
+}
+
+bool IsNetLegacyWireFormat()
+{
+    return g_legacyWireFormat.load(std::memory_order_relaxed);
+}
+
+void NetFlatWriter::PutUint8(uint8_t value)
+{
+    buffer_.push_back(value);
+}
+
+void NetFlatWriter::PutUint16(uint16_t value)
+{
+    PutUint8(static_cast<uint8_t>(value));
+    PutUint8(static_cast<uint8_t>(value >> BITS_PER_BYTE));
+}
+
+void NetFlatWriter::PutUint32(uint32_t value)
+{
+    PutUint16(static_cast<uint16_t>(value));
+    PutUint16(static_cast<uint16_t>(value >> (2 * BITS_PER_BYTE)));
+}
+
+void NetFlatWriter::PutBytes(const void *data, size_t size)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    buffer_.insert(buffer_.end(), bytes, bytes + size);
+}
+
+bool NetFlatWriter::PutString(const std::string &value)
+{
+    if (value.size() > std::numeric_limits<uint16_t>::max()) {
+        NETMGR_LOG_E("string of [%{public}zu] bytes is too long", value.size());
+        return false;
+    }
+    PutUint16(static_cast<uint16_t>(value.size()));
+    PutBytes(value.data(), value.size());
+    return true;
+}
+
+bool NetFlatWriter::PutAddress(const std::string &address)
+{
+    uint8_t raw[ADDRESS_IPV6] = {0};
+    if (address.empty()) {
+        PutUint8(ADDRESS_EMPTY);
+    } else if (ToRawAddress(address, AF_INET, raw)) {
+        PutUint8(ADDRESS_IPV4);
+        PutBytes(raw, ADDRESS_IPV4);
+    } else if (ToRawAddress(address, AF_INET6, raw)) {
+        PutUint8(ADDRESS_IPV6);
+        PutBytes(raw, ADDRESS_IPV6);
+    } else {
+        PutUint8(ADDRESS_TEXT);
+        return PutString(address);
+    }
+    return true;
+}
+
+bool NetFlatWriter::Fits() const
+{
+    return buffer_.size() <= MAX_FLAT_BUFFER_SIZE;
+}
+
+bool NetFlatWriter::WriteTo(Parcel &parcel) const
+{
+    if (!Fits()) {
+        NETMGR_LOG_E("flat buffer of [%{public}zu] bytes is too large", buffer_.size());
+        return false;
+    }
+    return parcel.WriteInt32(NET_FLAT_MAGIC) && parcel.WriteUint32(static_cast<uint32_t>(buffer_.size())) &&
+        parcel.WriteBuffer(buffer_.data(), buffer_.size());
+}
+
+bool NetFlatReader::ReadFrom(Parcel &parcel)
+{
+    size_t position = parcel.GetReadPosition();
+    int32_t magic = 0;
+    if (!parcel.ReadInt32(magic) || magic != NET_FLAT_MAGIC) {
+        parcel.RewindRead(position);
+        return false;
+    }
+    uint32_t size = 0;
+    if (!parcel.ReadUint32(size) || size == 0 || size > MAX_FLAT_BUFFER_SIZE) {
+        parcel.RewindRead(position);
+        return false;
+    }
+    data_ = parcel.ReadBuffer(size);
+    if (data_ == nullptr) {
+        parcel.RewindRead(position);
+        return false;
+    }
+    size_ = size;
+    pos_ = 0;
+    return true;
+}
+
+const uint8_t *NetFlatReader::Take(size_t size)
+{
+    if (data_ == nullptr || size > size_ - pos_) {
+        return nullptr;
+    }
+    const uint8_t *bytes = data_ + pos_;
+    pos_ += size;
+    return bytes;
+}
+
+bool NetFlatReader::GetUint8(uint8_t &value)
+{
+    const uint8_t *bytes = Take(sizeof(value));
+    if (bytes == nullptr) {
+        return false;
+    }
+    value = bytes[0];
+    return true;
+}
+
+bool NetFlatReader::GetUint16(uint16_t &value)
+{
+    const uint8_t *bytes = Take(sizeof(value));
+    if (bytes == nullptr) {
+        return false;
+    }
+    value = static_cast<uint16_t>(bytes[0] | (bytes[1] << BITS_PER_BYTE));
+    return true;
+}
+
+bool NetFlatReader::GetUint32(uint32_t &value)
+{
+    uint16_t low = 0;
+    uint16_t high = 0;
+    if (!GetUint16(low) || !GetUint16(high)) {
+        return false;
+    }
+    value = static_cast<uint32_t>(low) | (static_cast<uint32_t>(high) << (2 * BITS_PER_BYTE));
+    return true;
+}
+
+bool NetFlatReader::GetString(std::string &value)
+{
+    uint16_t size = 0;
+    if (!GetUint16(size)) {
+        return false;
+    }
+    const uint8_t *bytes = Take(size);
+    if (bytes == nullptr) {
+        return false;
+    }
+    value.assign(reinterpret_cast<const char *>(bytes), size);
+    return true;
+}
+
+bool NetFlatReader::GetAddress(std::string &address)
+{
+    uint8_t kind = 0;
+    if (!GetUint8(kind)) {
+        return false;
+    }
+    int32_t family = AF_INET;
+    switch (kind) {
+        case ADDRESS_EMPTY:
+            address.clear();
+            return true;
+        case ADDRESS_TEXT:
+            return GetString(address);
+        case ADDRESS_IPV4:
+            break;
+        case ADDRESS_IPV6:
+            family = AF_INET6;
+            break;
+        default:
+            return false;
+    }
+    const uint8_t *raw = Take(kind);
+    char text[INET6_ADDRSTRLEN] = {0};
+    if (raw == nullptr || inet_ntop(family, raw, text, sizeof(text)) == nullptr) {
+        return false;
+    }
+    address = text;
+    return true;
+}
+
+bool NetFlatReader::AtEnd() const
+{
+    return pos_ == size_;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
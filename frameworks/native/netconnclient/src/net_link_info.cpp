@@ -14,11 +14,166 @@
  */
 
 #include "net_link_info.h"
+
+#include <limits>
+
+#include "net_flat_buffer.h"
 #include "net_mgr_log_wrapper.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
+namespace {
+constexpr uint8_t ROUTE_IS_HOST = 0x01;
+constexpr uint8_t ROUTE_HAS_GATEWAY = 0x02;
+constexpr uint8_t ROUTE_IS_DEFAULT = 0x04;
+
+bool PutCount(NetFlatWriter &writer, size_t count)
+{
+    if (count > std::numeric_limits<uint16_t>::max()) {
+        NETMGR_LOG_E("list of [%{public}zu] entries is too long", count);
+        return false;
+    }
+    writer.PutUint16(static_cast<uint16_t>(count));
+    return true;
+}
+
+bool PutNetAddr(NetFlatWriter &writer, const INetAddr &netAddr)
+{
+    writer.PutUint8(netAddr.type_);
+    writer.PutUint8(netAddr.family_);
+    writer.PutUint8(netAddr.prefixlen_);
+    writer.PutUint8(netAddr.port_);
+    return writer.PutAddress(netAddr.address_) && writer.PutAddress(netAddr.netMask_) &&
+        writer.PutString(netAddr.hostName_);
+}
+
+bool GetNetAddr(NetFlatReader &reader, INetAddr &netAddr)
+{
+    return reader.GetUint8(netAddr.type_) && reader.GetUint8(netAddr.family_) &&
+        reader.GetUint8(netAddr.prefixlen_) && reader.GetUint8(netAddr.port_) &&
+        reader.GetAddress(netAddr.address_) && reader.GetAddress(netAddr.netMask_) &&
+        reader.GetString(netAddr.hostName_);
+}
+
+bool PutNetAddrList(NetFlatWriter &writer, const std::list<INetAddr> &netAddrList)
+{
+    if (!PutCount(writer, netAddrList.size())) {
+        return false;
+    }
+    for (const auto &netAddr : netAddrList) {
+        if (!PutNetAddr(writer, netAddr)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GetNetAddrList(NetFlatReader &reader, std::list<INetAddr> &netAddrList)
+{
+    uint16_t size = 0;
+    if (!reader.GetUint16(size)) {
+        return false;
+    }
+    for (uint16_t i = 0; i < size; i++) {
+        netAddrList.emplace_back();
+        if (!GetNetAddr(reader, netAddrList.back())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PutRoute(NetFlatWriter &writer, const Route &route)
+{
+    if (!writer.PutString(route.iface_) || !PutNetAddr(writer, route.destination_) ||
+        !PutNetAddr(writer, route.gateway_)) {
+        return false;
+    }
+    writer.PutUint32(static_cast<uint32_t>(route.rtnType_));
+    writer.PutUint32(static_cast<uint32_t>(route.mtu_));
+    uint8_t flags = (route.isHost_ ? ROUTE_IS_HOST : 0) | (route.hasGateway_ ? ROUTE_HAS_GATEWAY : 0) |
+        (route.isDefaultRoute_ ? ROUTE_IS_DEFAULT : 0);
+    writer.PutUint8(flags);
+    return true;
+}
+
+bool GetRoute(NetFlatReader &reader, Route &route)
+{
+    uint32_t rtnType = 0;
+    uint32_t mtu = 0;
+    uint8_t flags = 0;
+    if (!reader.GetString(route.iface_) || !GetNetAddr(reader, route.destination_) ||
+        !GetNetAddr(reader, route.gateway_) || !reader.GetUint32(rtnType) || !reader.GetUint32(mtu) ||
+        !reader.GetUint8(flags)) {
+        return false;
+    }
+    route.rtnType_ = static_cast<int32_t>(rtnType);
+    route.mtu_ = static_cast<int32_t>(mtu);
+    route.isHost_ = (flags & ROUTE_IS_HOST) != 0;
+    route.hasGateway_ = (flags & ROUTE_HAS_GATEWAY) != 0;
+    route.isDefaultRoute_ = (flags & ROUTE_IS_DEFAULT) != 0;
+    return true;
+}
+
+bool PutLinkInfo(NetFlatWriter &writer, const NetLinkInfo &linkInfo)
+{
+    writer.PutUint8(NET_FLAT_VERSION);
+    if (!writer.PutString(linkInfo.ifaceName_) || !writer.PutString(linkInfo.domain_)) {
+        return false;
+    }
+    writer.PutUint16(linkInfo.mtu_);
+    if (!writer.PutString(linkInfo.tcpBufferSizes_)) {
+        return false;
+    }
+    if (!PutNetAddrList(writer, linkInfo.netAddrList_) || !PutNetAddrList(writer, linkInfo.dnsList_)) {
+        return false;
+    }
+    if (!PutCount(writer, linkInfo.routeList_.size())) {
+        return false;
+    }
+    for (const auto &route : linkInfo.routeList_) {
+        if (!PutRoute(writer, route)) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+bool NetLinkInfo::operator==(const NetLinkInfo &obj) const
+{
+    bool out = true;
+    out = out && (ifaceName_ == obj.ifaceName_);
+    out = out && (domain_ == obj.domain_);
+    out = out && (netAddrList_ == obj.netAddrList_);
+    out = out && (dnsList_ == obj.dnsList_);
+    out = out && (routeList_ == obj.routeList_);
+    out = out && (mtu_ == obj.mtu_);
+    out = out && (tcpBufferSizes_ == obj.tcpBufferSizes_);
+    return out;
+}
+
 bool NetLinkInfo::Marshalling(Parcel &parcel) const
+{
+    if (IsNetLegacyWireFormat()) {
+        return MarshallingLegacy(parcel);
+    }
+    return MarshallingFlat(parcel);
+}
+
+bool NetLinkInfo::MarshallingFlat(Parcel &parcel) const
+{
+    NetFlatWriter writer;
+    if (!PutLinkInfo(writer, *this) || !writer.Fits()) {
+        // The legacy format has no size limits, readers accept it whatever the flag is
+        NETMGR_LOG_I("link info of [%{public}s] does not fit the flat format, write it field by field",
+            ifaceName_.c_str());
+        return MarshallingLegacy(parcel);
+    }
+    return writer.WriteTo(parcel);
+}
+
+bool NetLinkInfo::MarshallingLegacy(Parcel &parcel) const
 {
     if (!parcel.WriteString(ifaceName_)) {
         return false;
@@ -63,6 +218,52 @@ bool NetLinkInfo::Marshalling(Parcel &parcel) const
 }
 
 sptr<NetLinkInfo> NetLinkInfo::Unmarshalling(Parcel &parcel)
+{
+    NetFlatReader reader;
+    if (reader.ReadFrom(parcel)) {
+        return UnmarshallingFlat(reader);
+    }
+    return UnmarshallingLegacy(parcel);
+}
+
+sptr<NetLinkInfo> NetLinkInfo::UnmarshallingFlat(NetFlatReader &reader)
+{
+    uint8_t version = 0;
+    if (!reader.GetUint8(version) || version != NET_FLAT_VERSION) {
+        NETMGR_LOG_E("flat NetLinkInfo version [%{public}u] not supported", version);
+        return nullptr;
+    }
+    sptr<NetLinkInfo> ptr = (std::make_unique<NetLinkInfo>()).release();
+    if (ptr == nullptr) {
+        return nullptr;
+    }
+    if (!reader.GetString(ptr->ifaceName_) || !reader.GetString(ptr->domain_) || !reader.GetUint16(ptr->mtu_) ||
+        !reader.GetString(ptr->tcpBufferSizes_)) {
+        return nullptr;
+    }
+    if (!GetNetAddrList(reader, ptr->netAddrList_) || !GetNetAddrList(reader, ptr->dnsList_)) {
+        NETMGR_LOG_E("read flat address list failed");
+        return nullptr;
+    }
+    uint16_t size = 0;
+    if (!reader.GetUint16(size)) {
+        return nullptr;
+    }
+    for (uint16_t i = 0; i < size; i++) {
+        ptr->routeList_.emplace_back();
+        if (!GetRoute(reader, ptr->routeList_.back())) {
+            NETMGR_LOG_E("read flat route failed");
+            return nullptr;
+        }
+    }
+    if (!reader.AtEnd()) {
+        NETMGR_LOG_E("flat NetLinkInfo has trailing bytes");
+        return nullptr;
+    }
+    return ptr;
+}
+
+sptr<NetLinkInfo> NetLinkInfo::UnmarshallingLegacy(Parcel &parcel)
 {
     sptr<NetLinkInfo> ptr = (std::make_unique<NetLinkInfo>()).release();
     if (ptr == nullptr) {
@@ -116,46 +317,7 @@ bool NetLinkInfo::Marshalling(Parcel &parcel, const sptr<NetLinkInfo> &object)
         NETMGR_LOG_E("NetLinkInfo object ptr is nullptr");
         return false;
     }
-    if (!parcel.WriteString(object->ifaceName_)) {
-        return false;
-    }
-    if (!parcel.WriteString(object->domain_)) {
-        return false;
-    }
-    if (!parcel.WriteUint32(object->netAddrList_.size())) {
-        return false;
-    }
-    for (auto it = object->netAddrList_.begin(); it != object->netAddrList_.end(); it++) {
-        if (!it->Marshalling(parcel)) {
-            NETMGR_LOG_E("write objects net address to parcel failed");
-            return false;
-        }
-    }
-    if (!parcel.WriteUint32(object->dnsList_.size())) {
-        return false;
-    }
-    for (auto it = object->dnsList_.begin(); it != object->dnsList_.end(); it++) {
-        if (!it->Marshalling(parcel)) {
-            NETMGR_LOG_E("write objects dns to parcel failed");
-            return false;
-        }
-    }
-    if (!parcel.WriteUint32(object->routeList_.size())) {
-        return false;
-    }
-    for (auto it = object->routeList_.begin(); it != object->routeList_.end(); it++) {
-        if (!it->Marshalling(parcel)) {
-            NETMGR_LOG_E("write objects route to parcel failed");
-            return false;
-        }
-    }
-    if (!parcel.WriteUint16(object->mtu_)) {
-        return false;
-    }
-    if (!parcel.WriteString(object->tcpBufferSizes_)) {
-        return false;
-    }
-    return true;
+    return object->Marshalling(parcel);
 }
 
 void NetLinkInfo::Initialize()
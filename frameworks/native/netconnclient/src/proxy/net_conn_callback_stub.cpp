@@ -26,6 +26,8 @@ NetConnCallbackStub::NetConnCallbackStub()
     memberFuncMap_[NET_LOST] = &NetConnCallbackStub::OnNetLost;
     memberFuncMap_[NET_UNAVAILABLE] = &NetConnCallbackStub::OnNetUnavailable;
     memberFuncMap_[NET_BLOCK_STATUS_CHANGE] = &NetConnCallbackStub::OnNetBlockStatusChange;
+    memberFuncMap_[NET_CALLBACK_BATCH] = &NetConnCallbackStub::OnNetCallbackBatch;
+    memberFuncMap_[NET_STATE_VERSION_CHANGE] = &NetConnCallbackStub::OnNetStateVersionChange;
 }
 
 NetConnCallbackStub::~NetConnCallbackStub() {}
@@ -194,6 +196,37 @@ int32_t NetConnCallbackStub::OnNetBlockStatusChange(MessageParcel& data, Message
     return ERR_NONE;
 }
 
+int32_t NetConnCallbackStub::OnNetCallbackBatch(MessageParcel &data, MessageParcel &reply)
+{
+    sptr<NetConnCallbackBatch> batch = NetConnCallbackBatch::Unmarshalling(data);
+    if (batch == nullptr) {
+        NETMGR_LOG_E("Unmarshalling batch failed");
+        return IPC_PROXY_ERR;
+    }
+
+    int32_t result = NetCallbackBatch(batch);
+    if (!reply.WriteInt32(result)) {
+        NETMGR_LOG_E("Write parcel failed");
+        return result;
+    }
+    return ERR_NONE;
+}
+
+int32_t NetConnCallbackStub::OnNetStateVersionChange(MessageParcel &data, MessageParcel &reply)
+{
+    uint64_t version = 0;
+    if (!data.ReadUint64(version)) {
+        return IPC_PROXY_ERR;
+    }
+
+    int32_t result = NetStateVersionChange(version);
+    if (!reply.WriteInt32(result)) {
+        NETMGR_LOG_E("Write parcel failed");
+        return result;
+    }
+    return ERR_NONE;
+}
+
 int32_t NetConnCallbackStub::NetAvailable(sptr<NetHandle> &netHandle)
 {
     return ERR_NONE;
@@ -224,5 +257,45 @@ int32_t NetConnCallbackStub::NetBlockStatusChange(sptr<NetHandle> &netHandle, bo
 {
     return ERR_NONE;
 }
+
+int32_t NetConnCallbackStub::NetCallbackBatch(const sptr<NetConnCallbackBatch> &batch)
+{
+    if (batch == nullptr) {
+        return ERR_NULL_OBJECT;
+    }
+    int32_t result = ERR_NONE;
+    auto keepFirstError = [&result](int32_t ret) {
+        if (result == ERR_NONE) {
+            result = ret;
+        }
+    };
+    for (const auto &event : batch->events_) {
+        sptr<NetHandle> netHandle = std::make_unique<NetHandle>(event.netId).release();
+        if (event.facets & FACET_AVAILABLE) {
+            keepFirstError(NetAvailable(netHandle));
+        }
+        if (event.facets & FACET_CAPABILITIES) {
+            keepFirstError(NetCapabilitiesChange(netHandle, event.netAllCap));
+        }
+        if (event.facets & FACET_CONNECTION_PROPERTIES) {
+            keepFirstError(NetConnectionPropertiesChange(netHandle, event.linkInfo));
+        }
+        if (event.facets & FACET_BLOCK_STATUS) {
+            keepFirstError(NetBlockStatusChange(netHandle, event.blocked));
+        }
+        if (event.facets & FACET_LOST) {
+            keepFirstError(NetLost(netHandle));
+        }
+        if (event.facets & FACET_UNAVAILABLE) {
+            keepFirstError(NetUnavailable());
+        }
+    }
+    return result;
+}
+
+int32_t NetConnCallbackStub::NetStateVersionChange(uint64_t version)
+{
+    return ERR_NONE;
+}
 }  // namespace NetManagerStandard
 }  // namespace OHOS
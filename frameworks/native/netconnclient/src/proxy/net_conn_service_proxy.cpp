@@ -984,5 +984,115 @@ int32_t NetConnServiceProxy::RestoreFactoryData()
     }
     return ret;
 }
+
+int32_t NetConnServiceProxy::RegisterNetStateCallback(const sptr<INetConnCallback> &callback, uint64_t &version)
+{
+    if (callback == nullptr) {
+        NETMGR_LOG_E("The parameter of callback is nullptr");
+        return NET_CONN_ERR_INPUT_NULL_PTR;
+    }
+
+    MessageParcel data;
+    if (!WriteInterfaceToken(data)) {
+        NETMGR_LOG_E("WriteInterfaceToken failed");
+        return IPC_PROXY_ERR;
+    }
+    if (!data.WriteRemoteObject(callback->AsObject().GetRefPtr())) {
+        return IPC_PROXY_ERR;
+    }
+
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        NETMGR_LOG_E("Remote is null");
+        return ERR_NULL_OBJECT;
+    }
+
+    MessageParcel reply;
+    MessageOption option;
+    int32_t error = remote->SendRequest(CMD_NM_REGISTER_NET_STATE_CALLBACK, data, reply, option);
+    if (error != ERR_NONE) {
+        NETMGR_LOG_E("proxy SendRequest failed, error code: [%{public}d]", error);
+        return error;
+    }
+
+    int32_t ret = 0;
+    if (!reply.ReadInt32(ret)) {
+        return IPC_PROXY_ERR;
+    }
+    if (ret == ERR_NONE && !reply.ReadUint64(version)) {
+        return IPC_PROXY_ERR;
+    }
+    return ret;
+}
+
+int32_t NetConnServiceProxy::GetNetStatePage(sptr<Ashmem> &page)
+{
+    MessageParcel data;
+    if (!WriteInterfaceToken(data)) {
+        NETMGR_LOG_E("WriteInterfaceToken failed");
+        return IPC_PROXY_ERR;
+    }
+
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        NETMGR_LOG_E("Remote is null");
+        return ERR_NULL_OBJECT;
+    }
+
+    MessageParcel reply;
+    MessageOption option;
+    int32_t error = remote->SendRequest(CMD_NM_GET_NET_STATE_PAGE, data, reply, option);
+    if (error != ERR_NONE) {
+        NETMGR_LOG_E("proxy SendRequest failed, error code: [%{public}d]", error);
+        return error;
+    }
+
+    int32_t ret = 0;
+    if (!reply.ReadInt32(ret)) {
+        return IPC_PROXY_ERR;
+    }
+    if (ret != ERR_NONE) {
+        return ret;
+    }
+    page = reply.ReadAshmem();
+    return (page == nullptr) ? IPC_PROXY_ERR : ERR_NONE;
+}
+
+int32_t NetConnServiceProxy::UnregisterNetStateCallback(const sptr<INetConnCallback> &callback)
+{
+    if (callback == nullptr) {
+        NETMGR_LOG_E("The parameter of callback is nullptr");
+        return NET_CONN_ERR_INPUT_NULL_PTR;
+    }
+
+    MessageParcel data;
+    if (!WriteInterfaceToken(data)) {
+        NETMGR_LOG_E("WriteInterfaceToken failed");
+        return IPC_PROXY_ERR;
+    }
+    if (!data.WriteRemoteObject(callback->AsObject().GetRefPtr())) {
+        return IPC_PROXY_ERR;
+    }
+
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        NETMGR_LOG_E("Remote is null");
+        return ERR_NULL_OBJECT;
+    }
+
+    MessageParcel reply;
+    MessageOption option;
+    int32_t error = remote->SendRequest(CMD_NM_UNREGISTER_NET_STATE_CALLBACK, data, reply, option);
+    if (error != ERR_NONE) {
+        NETMGR_LOG_E("proxy SendRequest failed, error code: [%{public}d]", error);
+        return error;
+    }
+
+    int32_t ret = 0;
+    if (!reply.ReadInt32(ret)) {
+        return IPC_PROXY_ERR;
+    }
+    return ret;
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -814,5 +814,72 @@ int32_t NetsysNativeServiceProxy::StopDhcpService(const std::string &iface)
     NETNATIVE_LOGI("End to StopDhcpService, ret =%{public}d", ret);
     return ret;
 }
+int32_t NetsysNativeServiceProxy::FirewallSetUidRule(uint32_t chain, uint32_t uid, bool member)
+{
+    NETNATIVE_LOGI("Begin to FirewallSetUidRule");
+    MessageParcel data;
+    if (!WriteInterfaceToken(data)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+    if (!data.WriteUint32(chain) || !data.WriteUint32(uid) || !data.WriteBool(member)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    MessageParcel reply;
+    MessageOption option;
+    Remote()->SendRequest(INetsysService::NETSYS_FIREWALL_SET_UID_RULE, data, reply, option);
+    return reply.ReadInt32();
+}
+
+int32_t NetsysNativeServiceProxy::FirewallSetUids(uint32_t chain, const std::vector<uint32_t> &uids)
+{
+    NETNATIVE_LOGI("Begin to FirewallSetUids, size %{public}zu", uids.size());
+    MessageParcel data;
+    if (!WriteInterfaceToken(data)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+    if (!data.WriteUint32(chain) || !data.WriteUInt32Vector(uids)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    MessageParcel reply;
+    MessageOption option;
+    Remote()->SendRequest(INetsysService::NETSYS_FIREWALL_SET_UIDS, data, reply, option);
+    return reply.ReadInt32();
+}
+
+int32_t NetsysNativeServiceProxy::FirewallEnableChain(uint32_t chain, bool enable)
+{
+    NETNATIVE_LOGI("Begin to FirewallEnableChain");
+    MessageParcel data;
+    if (!WriteInterfaceToken(data)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+    if (!data.WriteUint32(chain) || !data.WriteBool(enable)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    MessageParcel reply;
+    MessageOption option;
+    Remote()->SendRequest(INetsysService::NETSYS_FIREWALL_ENABLE_CHAIN, data, reply, option);
+    return reply.ReadInt32();
+}
+
+int32_t NetsysNativeServiceProxy::FirewallSetChainInterface(uint32_t chain, const std::string &iface, bool attach)
+{
+    NETNATIVE_LOGI("Begin to FirewallSetChainInterface");
+    MessageParcel data;
+    if (!WriteInterfaceToken(data)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+    if (!data.WriteUint32(chain) || !data.WriteString(iface) || !data.WriteBool(attach)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    MessageParcel reply;
+    MessageOption option;
+    Remote()->SendRequest(INetsysService::NETSYS_FIREWALL_SET_CHAIN_INTERFACE, data, reply, option);
+    return reply.ReadInt32();
+}
 } // namespace NetsysNative
 } // namespace OHOS
\ No newline at end of file
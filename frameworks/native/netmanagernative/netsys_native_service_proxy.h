@@ -67,6 +67,10 @@ public:
     int32_t StopDhcpClient(const std::string &iface, bool bIpv6) override;
     int32_t StartDhcpService(const std::string &iface, const std::string &ipv4addr) override;
     int32_t StopDhcpService(const std::string &iface) override;
+    int32_t FirewallSetUidRule(uint32_t chain, uint32_t uid, bool member) override;
+    int32_t FirewallSetUids(uint32_t chain, const std::vector<uint32_t> &uids) override;
+    int32_t FirewallEnableChain(uint32_t chain, bool enable) override;
+    int32_t FirewallSetChainInterface(uint32_t chain, const std::string &iface, bool attach) override;
 private:
     static inline BrokerDelegator<NetsysNativeServiceProxy> delegator_;
 };
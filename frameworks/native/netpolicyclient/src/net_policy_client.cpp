@@ -47,6 +47,30 @@ NetUidPolicy NetPolicyClient::GetPolicyByUid(uint32_t uid)
     return proxy->GetPolicyByUid(uid);
 }
 
+NetPolicyResultCode NetPolicyClient::SetPoliciesByUids(const std::vector<uint32_t> &uids,
+    const std::vector<NetUidPolicy> &policies)
+{
+    sptr<INetPolicyService> proxy = GetProxy();
+    if (proxy == nullptr) {
+        NETMGR_LOG_E("proxy is nullptr");
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    return proxy->SetPoliciesByUids(uids, policies);
+}
+
+NetPolicyResultCode NetPolicyClient::GetPoliciesByUids(const std::vector<uint32_t> &uids,
+    std::vector<NetUidPolicy> &policies)
+{
+    sptr<INetPolicyService> proxy = GetProxy();
+    if (proxy == nullptr) {
+        NETMGR_LOG_E("proxy is nullptr");
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    return proxy->GetPoliciesByUids(uids, policies);
+}
+
 std::vector<uint32_t> NetPolicyClient::GetUidsByPolicy(NetUidPolicy policy)
 {
     std::vector<uint32_t> uids;
@@ -296,6 +320,17 @@ NetPolicyResultCode NetPolicyClient::SetIdleTrustlist(uint32_t uid, bool isTrust
     return proxy->SetIdleTrustlist(uid, isTrustlist);
 }
 
+NetPolicyResultCode NetPolicyClient::ReplaceIdleTrustlist(const std::vector<uint32_t> &uids)
+{
+    sptr<INetPolicyService> proxy = GetProxy();
+    if (proxy == nullptr) {
+        NETMGR_LOG_E("proxy is nullptr");
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    return proxy->ReplaceIdleTrustlist(uids);
+}
+
 NetPolicyResultCode NetPolicyClient::GetIdleTrustlist(std::vector<uint32_t> &uids)
 {
     sptr<INetPolicyService> proxy = GetProxy();
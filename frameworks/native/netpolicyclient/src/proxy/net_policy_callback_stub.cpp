@@ -22,6 +22,7 @@ namespace NetManagerStandard {
 NetPolicyCallbackStub::NetPolicyCallbackStub()
 {
     memberFuncMap_[NET_POLICY_UIDPOLICY_CHANGED] = &NetPolicyCallbackStub::OnNetUidPolicyChanged;
+    memberFuncMap_[NET_POLICY_UIDPOLICIES_CHANGED] = &NetPolicyCallbackStub::OnNetUidPoliciesChanged;
     memberFuncMap_[NET_POLICY_CELLULARPOLICY_CHANGED] = &NetPolicyCallbackStub::OnNetCellularPolicyChanged;
     memberFuncMap_[NET_POLICY_STRATEGYSWITCH_CHANGED] = &NetPolicyCallbackStub::OnNetStrategySwitch;
     memberFuncMap_[NET_POLICY_BACKGROUNDPOLICY_CHANGED] = &NetPolicyCallbackStub::OnNetBackgroundPolicyChanged;
@@ -79,6 +80,34 @@ int32_t NetPolicyCallbackStub::NetUidPolicyChanged(uint32_t uid, NetUidPolicy po
     return ERR_NONE;
 }
 
+int32_t NetPolicyCallbackStub::OnNetUidPoliciesChanged(MessageParcel &data, MessageParcel &reply)
+{
+    std::vector<uint32_t> uids;
+    if (!data.ReadUInt32Vector(&uids)) {
+        NETMGR_LOG_E("ReadUInt32Vector uids failed");
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    std::vector<uint32_t> rawPolicies;
+    if (!data.ReadUInt32Vector(&rawPolicies) || rawPolicies.size() != uids.size()) {
+        NETMGR_LOG_E("ReadUInt32Vector policies failed");
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    std::vector<NetUidPolicy> policies;
+    policies.reserve(rawPolicies.size());
+    for (uint32_t policy : rawPolicies) {
+        policies.push_back(static_cast<NetUidPolicy>(policy));
+    }
+    int32_t result = NetUidPoliciesChanged(uids, policies);
+    if (!reply.WriteInt32(result)) {
+        NETMGR_LOG_E("Write parcel failed");
+        return result;
+    }
+
+    return ERR_NONE;
+}
+
 int32_t NetPolicyCallbackStub::OnNetBackgroundPolicyChanged(MessageParcel &data, MessageParcel &reply)
 {
     bool isBackgroundPolicyAllow = false;
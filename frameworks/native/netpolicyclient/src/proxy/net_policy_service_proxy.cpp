@@ -86,6 +86,98 @@ NetUidPolicy NetPolicyServiceProxy::GetPolicyByUid(uint32_t uid)
     return static_cast<NetUidPolicy>(reply.ReadInt32());
 }
 
+NetPolicyResultCode NetPolicyServiceProxy::SetPoliciesByUids(const std::vector<uint32_t> &uids,
+    const std::vector<NetUidPolicy> &policies)
+{
+    if (uids.size() != policies.size() || uids.size() > MAX_UID_POLICY_BATCH_SIZE) {
+        NETMGR_LOG_E("invalid batch, uids size[%{public}zu] policies size[%{public}zu]", uids.size(),
+            policies.size());
+        return NetPolicyResultCode::ERR_INVALID_POLICY;
+    }
+
+    MessageParcel data;
+    if (!WriteInterfaceToken(data)) {
+        NETMGR_LOG_E("WriteInterfaceToken failed");
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    std::vector<uint32_t> rawPolicies;
+    rawPolicies.reserve(policies.size());
+    for (NetUidPolicy policy : policies) {
+        rawPolicies.push_back(static_cast<uint32_t>(policy));
+    }
+    if (!data.WriteUInt32Vector(uids) || !data.WriteUInt32Vector(rawPolicies)) {
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        NETMGR_LOG_E("Remote is null");
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    MessageParcel reply;
+    MessageOption option;
+    int32_t retCode = remote->SendRequest(CMD_NSM_SET_UID_POLICIES, data, reply, option);
+    if (retCode != ERR_NONE) {
+        NETMGR_LOG_E("proxy SendRequest failed, error code: [%{public}d]", retCode);
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    return static_cast<NetPolicyResultCode>(reply.ReadInt32());
+}
+
+NetPolicyResultCode NetPolicyServiceProxy::GetPoliciesByUids(const std::vector<uint32_t> &uids,
+    std::vector<NetUidPolicy> &policies)
+{
+    if (uids.size() > MAX_UID_POLICY_BATCH_SIZE) {
+        NETMGR_LOG_E("invalid batch, uids size[%{public}zu]", uids.size());
+        return NetPolicyResultCode::ERR_INVALID_UID;
+    }
+
+    MessageParcel data;
+    if (!WriteInterfaceToken(data)) {
+        NETMGR_LOG_E("WriteInterfaceToken failed");
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    if (!data.WriteUInt32Vector(uids)) {
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        NETMGR_LOG_E("Remote is null");
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    MessageParcel reply;
+    MessageOption option;
+    int32_t retCode = remote->SendRequest(CMD_NSM_GET_UID_POLICIES, data, reply, option);
+    if (retCode != ERR_NONE) {
+        NETMGR_LOG_E("proxy SendRequest failed, error code: [%{public}d]", retCode);
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    NetPolicyResultCode result = static_cast<NetPolicyResultCode>(reply.ReadInt32());
+    if (result != NetPolicyResultCode::ERR_NONE) {
+        return result;
+    }
+
+    std::vector<uint32_t> rawPolicies;
+    if (!reply.ReadUInt32Vector(&rawPolicies) || rawPolicies.size() != uids.size()) {
+        NETMGR_LOG_E("proxy SendRequest Readuint32Vector failed");
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+    policies.clear();
+    policies.reserve(rawPolicies.size());
+    for (uint32_t policy : rawPolicies) {
+        policies.push_back(static_cast<NetUidPolicy>(policy));
+    }
+
+    return NetPolicyResultCode::ERR_NONE;
+}
+
 std::vector<uint32_t> NetPolicyServiceProxy::GetUidsByPolicy(NetUidPolicy policy)
 {
     MessageParcel data;
@@ -578,6 +670,40 @@ NetPolicyResultCode NetPolicyServiceProxy::SetIdleTrustlist(uint32_t uid, bool i
     return static_cast<NetPolicyResultCode>(reply.ReadInt32());
 }
 
+NetPolicyResultCode NetPolicyServiceProxy::ReplaceIdleTrustlist(const std::vector<uint32_t> &uids)
+{
+    if (uids.size() > MAX_UID_POLICY_BATCH_SIZE) {
+        NETMGR_LOG_E("invalid batch, uids size[%{public}zu]", uids.size());
+        return NetPolicyResultCode::ERR_INVALID_UID;
+    }
+
+    MessageParcel data;
+    if (!WriteInterfaceToken(data)) {
+        NETMGR_LOG_E("WriteInterfaceToken failed");
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    if (!data.WriteUInt32Vector(uids)) {
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        NETMGR_LOG_E("Remote is null");
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    MessageParcel reply;
+    MessageOption option;
+    int32_t retCode = remote->SendRequest(CMD_NSM_REPLACE_IDLE_TRUSTLIST, data, reply, option);
+    if (retCode != ERR_NONE) {
+        NETMGR_LOG_E("proxy SendRequest failed, error code: [%{public}d]", retCode);
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    return static_cast<NetPolicyResultCode>(reply.ReadInt32());
+}
+
 NetPolicyResultCode NetPolicyServiceProxy::GetIdleTrustlist(std::vector<uint32_t> &uids)
 {
     MessageParcel data;
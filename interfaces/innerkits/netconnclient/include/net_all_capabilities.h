@@ -42,19 +42,33 @@ enum NetBearType {
     BEARER_DEFAULT
 };
 
+static_assert(NET_CAPABILITY_INTERNAL_DEFAULT <= 32 && BEARER_DEFAULT <= 32, "masks are 32 bits wide");
+
 struct NetAllCapabilities : public Parcelable {
     uint32_t linkUpBandwidthKbps_ = 0;
     uint32_t linkDownBandwidthKbps_ = 0;
     std::set<NetCap> netCaps_;
     std::set<NetBearType> bearerTypes_;
 
+    bool operator==(const NetAllCapabilities &obj) const;
     bool CapsIsValid() const;
     bool CapsIsNull() const;
     virtual bool Marshalling(Parcel &parcel) const override;
     bool Unmarshalling(Parcel &parcel);
     std::string ToString(const std::string &tab) const;
 
+    /**
+     * @brief Bit n is set if capability n is present, out of range values are ignored, see CapsIsValid
+     */
+    static uint32_t ToCapsMask(const std::set<NetCap> &netCaps);
+
+    /**
+     * @brief Bit n is set if bearer type n is present, out of range values are ignored, see CapsIsValid
+     */
+    static uint32_t ToBearerTypesMask(const std::set<NetBearType> &bearerTypes);
+
 private:
+    void FromMasks(uint32_t capsMask, uint32_t bearerTypesMask);
     void ToStrNetCaps(const std::set<NetCap> &netCaps, std::string &str) const;
     void ToStrNetBearTypes(const std::set<NetBearType> &bearerTypes, std::string &str) const;
 };
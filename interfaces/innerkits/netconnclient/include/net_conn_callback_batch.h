@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NET_CONN_CALLBACK_BATCH_H
+#define NET_CONN_CALLBACK_BATCH_H
+
+#include <vector>
+
+#include "parcel.h"
+
+#include "net_all_capabilities.h"
+#include "net_link_info.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+enum NetConnCallbackFacet : uint32_t {
+    FACET_AVAILABLE = 1 << 0,
+    FACET_CAPABILITIES = 1 << 1,
+    FACET_CONNECTION_PROPERTIES = 1 << 2,
+    FACET_BLOCK_STATUS = 1 << 3,
+    FACET_LOST = 1 << 4,
+    FACET_UNAVAILABLE = 1 << 5,
+};
+
+struct NetConnCallbackEvent {
+    int32_t netId = 0;
+    uint32_t facets = 0;
+    sptr<NetAllCapabilities> netAllCap = nullptr;
+    sptr<NetLinkInfo> linkInfo = nullptr;
+    bool blocked = false;
+};
+
+/**
+ * Changed facets of one or more networks, delivered to a NetConnCallback in a single parcel.
+ * Within an event the facets are applied in enum order: available, capabilities, properties, block, lost,
+ * unavailable. Unavailable is not tied to a network and goes with net id 0.
+ */
+struct NetConnCallbackBatch : public Parcelable {
+    std::vector<NetConnCallbackEvent> events_;
+
+    /**
+     * @brief Add an event, merging it into the last event when that one is for the same network
+     *
+     * A merge never changes the order facets are delivered in, so it does not happen after a lost or an
+     * unavailable, nor when a new facet would be applied before one already pending.
+     *
+     * @param event The event, payloads of the facets it carries must not be null
+     */
+    void Add(const NetConnCallbackEvent &event);
+    bool IsEmpty() const;
+    virtual bool Marshalling(Parcel &parcel) const override;
+    static sptr<NetConnCallbackBatch> Unmarshalling(Parcel &parcel);
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_CONN_CALLBACK_BATCH_H
@@ -16,13 +16,18 @@
 #ifndef NET_CONN_MANAGER_H
 #define NET_CONN_MANAGER_H
 
+#include <atomic>
 #include <string>
 #include <map>
+#include <mutex>
+#include <vector>
 
 #include "parcel.h"
 #include "singleton.h"
 
 #include "i_net_conn_service.h"
+#include "net_conn_callback_stub.h"
+#include "net_conn_state_page.h"
 #include "i_net_supplier_callback.h"
 #include "net_supplier_callback_base.h"
 #include "net_link_info.h"
@@ -57,6 +62,33 @@ public:
     int32_t NetDetection(const NetHandle &netHandle);
     int32_t SetAirplaneMode(bool state);
     int32_t RestoreFactoryData();
+    /**
+     * @brief Serve GetDefaultNet, HasDefaultNet, GetConnectionProperties and GetNetCapabilities from a local cache
+     *
+     * The cache is dropped whenever the service reports a new state version, so reads return the same data
+     * as the service, one IPC per change instead of one per call. Turning the cache off also ends the
+     * subscription to the state versions.
+     *
+     * @param enable Whether to cache, off by default, the JS connection module turns it on
+     */
+    void SetStateCacheEnabled(bool enable);
+    /**
+     * @brief Read the connectivity summary of the default network from the shared state page
+     *
+     * Only the first call makes an IPC, to map the page.
+     *
+     * @param state out param
+     * @return Returns 0 on success, otherwise it will fail
+     */
+    int32_t GetNetStateSummary(NetStateSummary &state);
+    /**
+     * @brief Let GetDefaultNet and HasDefaultNet answer from the shared state page while a default network exists
+     *
+     * The page is only handed to processes that hold GET_NETWORK_INFO, others keep going through the service.
+     *
+     * @param enable Whether to read the page, off by default, the JS connection module turns it on
+     */
+    void SetStatePageEnabled(bool enable);
 
 private:
     class NetConnDeathRecipient : public IRemoteObject::DeathRecipient {
@@ -72,15 +104,61 @@ private:
         NetConnClient &client_;
     };
 
+    class NetStateCallback : public NetConnCallbackStub {
+    public:
+        explicit NetStateCallback(NetConnClient &client) : client_(client) {}
+        ~NetStateCallback() override = default;
+        int32_t NetStateVersionChange(uint64_t version) override
+        {
+            client_.OnStateVersionChange(version);
+            return ERR_NONE;
+        }
+
+    private:
+        NetConnClient &client_;
+    };
+
+    struct StateCache {
+        bool subscribed = false;
+        uint64_t version = 0;
+        bool hasDefaultNetId = false;
+        int32_t defaultNetRet = 0;
+        int32_t defaultNetId = 0;
+        bool hasDefaultFlag = false;
+        int32_t defaultFlagRet = 0;
+        bool defaultFlag = false;
+        std::map<int32_t, NetLinkInfo> linkInfos;
+        std::map<int32_t, NetAllCapabilities> netCaps;
+    };
+
 private:
     sptr<INetConnService> GetProxy();
     void OnRemoteDied(const wptr<IRemoteObject> &remote);
+    bool PrepareStateCache(const sptr<INetConnService> &proxy, uint64_t &version);
+    void OnStateVersionChange(uint64_t version);
+    void UnsubscribeStateVersion(const sptr<NetStateCallback> &callback);
+    void ResetStateCacheLocked(uint64_t version);
+    const NetConnStatePage *MapStatePage();
+    bool ReadDefaultNetFromPage(NetStateSummary &state);
 
 private:
     std::mutex mutex_;
     sptr<INetConnService> NetConnService_;
     sptr<IRemoteObject::DeathRecipient> deathRecipient_;
     std::map<uint32_t, sptr<INetSupplierCallback>> netSupplierCallback_;
+    // Guards everything below, never held across an IPC
+    std::mutex cacheMutex_;
+    bool cacheEnabled_ = false;
+    StateCache cache_;
+    sptr<NetStateCallback> stateCallback_;
+    // Guards the page mapping, readers only load statePage_
+    std::mutex pageMutex_;
+    std::atomic<const NetConnStatePage *> statePage_ {nullptr};
+    std::atomic<bool> statePageEnabled_ {false};
+    sptr<Ashmem> statePageMem_;
+    // Pages of a dead service stay mapped, a reader may still be looking at one
+    std::vector<sptr<Ashmem>> retiredPages_;
+    bool statePageRefused_ = false;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
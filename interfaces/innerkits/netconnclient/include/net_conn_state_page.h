@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_CONN_STATE_PAGE_H
+#define NET_CONN_STATE_PAGE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace OHOS {
+namespace NetManagerStandard {
+enum NetConnStateFlag : uint32_t {
+    STATE_FLAG_DEFAULT_NET = 1 << 0,
+    STATE_FLAG_VALIDATED = 1 << 1,
+    STATE_FLAG_METERED = 1 << 2,
+};
+
+/**
+ * Connectivity summary of the default network
+ */
+struct NetStateSummary {
+    // Same version as NetStateVersionChange reports
+    uint64_t version = 0;
+    int32_t defaultNetId = 0;
+    uint32_t flags = 0;
+    // NetAllCapabilities::ToBearerTypesMask of the default network
+    uint32_t bearerTypes = 0;
+    uint32_t linkUpBandwidthKbps = 0;
+    uint32_t linkDownBandwidthKbps = 0;
+};
+
+/**
+ * Layout of the shared memory page NetConnService publishes its connectivity summary in.
+ *
+ * Only the service writes, clients map the page read only and never need an IPC to read it.
+ * Writes are guarded by a sequence lock: the sequence is odd while a write is in progress and a reader
+ * retries until it sees the same even sequence before and after copying the fields.
+ */
+class NetConnStatePage {
+public:
+    static constexpr uint32_t MAGIC = 0x4E435350;
+    static constexpr uint32_t LAYOUT_VERSION = 1;
+
+    /**
+     * @brief Construct an empty page in place, service side
+     *
+     * @param addr Start of a writable mapping of at least sizeof(NetConnStatePage) bytes
+     * @return The page
+     */
+    static NetConnStatePage *Create(void *addr);
+
+    /**
+     * @brief View a mapped page, client side
+     *
+     * @param addr Start of the mapping
+     * @param size Size of the mapping
+     * @return The page, nullptr if the mapping is too small or written with an unknown layout
+     */
+    static const NetConnStatePage *Attach(const void *addr, size_t size);
+
+    void Write(const NetStateSummary &state);
+
+    /**
+     * @brief Copy a consistent summary out of the page
+     *
+     * @param state out param
+     * @return Returns false if the writer kept the page busy for every retry
+     */
+    bool Read(NetStateSummary &state) const;
+
+private:
+    NetConnStatePage();
+
+private:
+    std::atomic<uint32_t> magic_;
+    std::atomic<uint32_t> layoutVersion_;
+    std::atomic<uint32_t> sequence_;
+    std::atomic<int32_t> defaultNetId_;
+    std::atomic<uint32_t> flags_;
+    std::atomic<uint32_t> bearerTypes_;
+    std::atomic<uint32_t> linkUpBandwidthKbps_;
+    std::atomic<uint32_t> linkDownBandwidthKbps_;
+    std::atomic<uint64_t> version_;
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+    "the page is shared between processes");
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_CONN_STATE_PAGE_H
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_FLAT_BUFFER_H
+#define NET_FLAT_BUFFER_H
+
+#include <string>
+#include <vector>
+
+#include "parcel.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * Leads a flat encoded object in the parcel, in place of the int32 length the legacy format starts with. It is
+ * negative, so a reader of the legacy format fails on it instead of misreading the buffer.
+ */
+constexpr int32_t NET_FLAT_MAGIC = -0x4E464C54;
+constexpr uint8_t NET_FLAT_VERSION = 1;
+
+/**
+ * @brief Keep writing NetLinkInfo and NetAllCapabilities field by field, for peers built before the flat format
+ *
+ * Readers accept both formats whatever the flag is. Nothing in the services sets it, it is there for tests and
+ * for a compat build to call at startup when it has to talk to such peers.
+ */
+void SetNetLegacyWireFormat(bool legacy);
+bool IsNetLegacyWireFormat();
+
+/**
+ * Appends little endian values to one contiguous buffer, which goes into the parcel as a single blob.
+ */
+class NetFlatWriter {
+public:
+    void PutUint8(uint8_t value);
+    void PutUint16(uint16_t value);
+    void PutUint32(uint32_t value);
+    void PutBytes(const void *data, size_t size);
+
+    /**
+     * @brief Length prefixed string
+     *
+     * @return Returns false if the string does not fit a 16 bit length
+     */
+    bool PutString(const std::string &value);
+
+    /**
+     * @brief Address in text form, sent as the raw 4 or 16 bytes when it converts back to the same text
+     */
+    bool PutAddress(const std::string &address);
+
+    /**
+     * @brief Whether the buffer is within the size a reader accepts
+     */
+    bool Fits() const;
+
+    /**
+     * @brief Write NET_FLAT_MAGIC, the size and the buffer
+     *
+     * @return Returns false if the buffer does not fit, callers then fall back to the legacy format
+     */
+    bool WriteTo(Parcel &parcel) const;
+
+private:
+    std::vector<uint8_t> buffer_;
+};
+
+/**
+ * Reads what NetFlatWriter wrote, in place in the parcel. Every getter fails once the buffer runs out.
+ */
+class NetFlatReader {
+public:
+    /**
+     * @brief Take the buffer out of the parcel
+     *
+     * @return Returns false if the parcel does not hold a flat buffer here, the read position is then unchanged
+     */
+    bool ReadFrom(Parcel &parcel);
+
+    bool GetUint8(uint8_t &value);
+    bool GetUint16(uint16_t &value);
+    bool GetUint32(uint32_t &value);
+    bool GetString(std::string &value);
+    bool GetAddress(std::string &address);
+    bool AtEnd() const;
+
+private:
+    const uint8_t *Take(size_t size);
+
+private:
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+    size_t pos_ = 0;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_FLAT_BUFFER_H
@@ -24,6 +24,8 @@
 
 namespace OHOS {
 namespace NetManagerStandard {
+class NetFlatReader;
+
 struct NetLinkInfo : public Parcelable {
     std::string ifaceName_;
     std::string domain_;
@@ -33,6 +35,8 @@ struct NetLinkInfo : public Parcelable {
     uint16_t mtu_ = 0;
     std::string tcpBufferSizes_;
 
+    bool operator==(const NetLinkInfo &obj) const;
+
     virtual bool Marshalling(Parcel &parcel) const override;
     static sptr<NetLinkInfo> Unmarshalling(Parcel &parcel);
     static bool Marshalling(Parcel &parcel, const sptr<NetLinkInfo> &object);
@@ -42,6 +46,12 @@ struct NetLinkInfo : public Parcelable {
     std::string ToStringAddr(const std::string &tab) const;
     std::string ToStringDns(const std::string &tab) const;
     std::string ToStringRoute(const std::string &tab) const;
+
+private:
+    bool MarshallingLegacy(Parcel &parcel) const;
+    bool MarshallingFlat(Parcel &parcel) const;
+    static sptr<NetLinkInfo> UnmarshallingLegacy(Parcel &parcel);
+    static sptr<NetLinkInfo> UnmarshallingFlat(NetFlatReader &reader);
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
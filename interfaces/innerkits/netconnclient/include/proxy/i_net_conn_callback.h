@@ -18,6 +18,7 @@
 
 #include "iremote_broker.h"
 
+#include "net_conn_callback_batch.h"
 #include "net_specifier.h"
 #include "net_link_info.h"
 #include "net_handle.h"
@@ -36,6 +37,8 @@ public:
         NET_LOST,
         NET_UNAVAILABLE,
         NET_BLOCK_STATUS_CHANGE,
+        NET_CALLBACK_BATCH,
+        NET_STATE_VERSION_CHANGE,
     };
 
 public:
@@ -45,6 +48,8 @@ public:
     virtual int32_t NetLost(sptr<NetHandle> &netHandle) = 0;
     virtual int32_t NetUnavailable() = 0;
     virtual int32_t NetBlockStatusChange(sptr<NetHandle> &netHandle, bool blocked) = 0;
+    virtual int32_t NetCallbackBatch(const sptr<NetConnCallbackBatch> &batch) = 0;
+    virtual int32_t NetStateVersionChange(uint64_t version) = 0;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
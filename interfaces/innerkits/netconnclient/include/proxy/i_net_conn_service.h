@@ -18,6 +18,7 @@
 
 #include <string>
 
+#include "ashmem.h"
 #include "iremote_broker.h"
 
 #include "i_net_conn_callback.h"
@@ -62,6 +63,9 @@ public:
         CMD_NM_REGISTER_NET_SUPPLIER_CALLBACK,
         CMD_NM_SET_AIRPLANE_MODE,
         CMD_NM_RESTORE_FACTORY_DATA,
+        CMD_NM_REGISTER_NET_STATE_CALLBACK,
+        CMD_NM_GET_NET_STATE_PAGE,
+        CMD_NM_UNREGISTER_NET_STATE_CALLBACK,
         CMD_NM_END,
     };
 
@@ -95,6 +99,9 @@ public:
     virtual int32_t BindSocket(int32_t socket_fd, int32_t netId) =0;
     virtual int32_t SetAirplaneMode(bool state) = 0;
     virtual int32_t RestoreFactoryData() = 0;
+    virtual int32_t RegisterNetStateCallback(const sptr<INetConnCallback> &callback, uint64_t &version) = 0;
+    virtual int32_t GetNetStatePage(sptr<Ashmem> &page) = 0;
+    virtual int32_t UnregisterNetStateCallback(const sptr<INetConnCallback> &callback) = 0;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
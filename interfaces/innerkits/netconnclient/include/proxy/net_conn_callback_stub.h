@@ -39,6 +39,23 @@ public:
     int32_t NetLost(sptr<NetHandle> &netHandle) override;
     int32_t NetUnavailable() override;
     int32_t NetBlockStatusChange(sptr<NetHandle> &netHandle, bool blocked) override;
+    /**
+     * @brief Deliver a batch of network changes
+     *
+     * The default implementation replays every event through the single-change callbacks above.
+     *
+     * @param batch The batch
+     * @return Returns 0 on success, otherwise the first failing callback result
+     */
+    int32_t NetCallbackBatch(const sptr<NetConnCallbackBatch> &batch) override;
+    /**
+     * @brief The connectivity state of the service changed, only sent to callbacks registered with
+     * RegisterNetStateCallback
+     *
+     * @param version The version of the new state
+     * @return Returns 0, the default implementation ignores it
+     */
+    int32_t NetStateVersionChange(uint64_t version) override;
 
 private:
     using NetConnCallbackFunc = int32_t (NetConnCallbackStub::*)(MessageParcel &, MessageParcel &);
@@ -50,6 +67,8 @@ private:
     int32_t OnNetLost(MessageParcel &data, MessageParcel &reply);
     int32_t OnNetUnavailable(MessageParcel &data, MessageParcel &reply);
     int32_t OnNetBlockStatusChange(MessageParcel &data, MessageParcel &reply);
+    int32_t OnNetCallbackBatch(MessageParcel &data, MessageParcel &reply);
+    int32_t OnNetStateVersionChange(MessageParcel &data, MessageParcel &reply);
 
 private:
     std::map<uint32_t, NetConnCallbackFunc> memberFuncMap_;
@@ -54,6 +54,9 @@ public:
     int32_t BindSocket(int32_t socket_fd, int32_t netId) override;
     int32_t SetAirplaneMode(bool state) override;
     int32_t RestoreFactoryData() override;
+    int32_t RegisterNetStateCallback(const sptr<INetConnCallback> &callback, uint64_t &version) override;
+    int32_t GetNetStatePage(sptr<Ashmem> &page) override;
+    int32_t UnregisterNetStateCallback(const sptr<INetConnCallback> &callback) override;
 
 private:
     bool WriteInterfaceToken(MessageParcel &data);
@@ -60,6 +60,10 @@ public:
         NETSYS_STOP_DHCP_CLIENT,
         NETSYS_START_DHCP_SERVICE,
         NETSYS_STOP_DHCP_SERVICE,
+        NETSYS_FIREWALL_SET_UID_RULE,
+        NETSYS_FIREWALL_SET_UIDS,
+        NETSYS_FIREWALL_ENABLE_CHAIN,
+        NETSYS_FIREWALL_SET_CHAIN_INTERFACE,
     };
 
     virtual int32_t SetResolverConfigParcel(const DnsresolverParamsParcel& resolvParams) = 0;
@@ -104,6 +108,10 @@ public:
     virtual int32_t StopDhcpClient(const std::string &iface, bool bIpv6) = 0;
     virtual int32_t StartDhcpService(const std::string &iface, const std::string &ipv4addr) = 0;
     virtual int32_t StopDhcpService(const std::string &iface) = 0;
+    virtual int32_t FirewallSetUidRule(uint32_t chain, uint32_t uid, bool member) = 0;
+    virtual int32_t FirewallSetUids(uint32_t chain, const std::vector<uint32_t> &uids) = 0;
+    virtual int32_t FirewallEnableChain(uint32_t chain, bool enable) = 0;
+    virtual int32_t FirewallSetChainInterface(uint32_t chain, const std::string &iface, bool attach) = 0;
 
     DECLARE_INTERFACE_DESCRIPTOR(u"OHOS.NetsysNative.INetsysService")
 };
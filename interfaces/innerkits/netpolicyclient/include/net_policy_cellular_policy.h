@@ -27,7 +27,7 @@ struct NetPolicyCellularPolicy : public Parcelable {
     std::string simId_;
     /*  Time rubbing, for example:1636598990 */
     int64_t periodStartTime_ = -1;
-    /* Unit: Month for example:M1 (The 1st of each month) */
+    /* Dx, Wx, Mx or Yx, for example:M1 (The 1st of each month), see NetBillingCycle */
     std::string periodDuration_ = "M1";
     std::string title_;
     std::string summary_;
@@ -45,6 +45,25 @@ public:
      * @return Returns NetUidPolicy, otherwise fail
      */
     NetUidPolicy GetPolicyByUid(uint32_t uid);
+    /**
+     * @brief The interface is set the policies of several uids at once, applied atomically
+     *
+     * @param uids uids, at most MAX_UID_POLICY_BATCH_SIZE
+     * @param policies policies, same size as uids
+     *
+     * @return Returns 0 success, otherwise fail
+     */
+    NetPolicyResultCode SetPoliciesByUids(const std::vector<uint32_t> &uids,
+        const std::vector<NetUidPolicy> &policies);
+    /**
+     * @brief The interface is get the policies of several uids at once
+     *
+     * @param uids uids, at most MAX_UID_POLICY_BATCH_SIZE
+     * @param policies out param, policies in the order of uids
+     *
+     * @return Returns 0 success, otherwise fail
+     */
+    NetPolicyResultCode GetPoliciesByUids(const std::vector<uint32_t> &uids, std::vector<NetUidPolicy> &policies);
     /**
      * @brief The interface is get uids by policy
      *
@@ -154,6 +173,14 @@ public:
      * @return Returns 0, successfully
      */
     NetPolicyResultCode SetIdleTrustlist(uint32_t uid, bool isTrustlist);
+    /**
+     * @brief ReplaceIdleTrustlist for replace the whole trust list for Idle status
+     *
+     * @param uids the new trust list, at most MAX_UID_POLICY_BATCH_SIZE uids
+     *
+     * @return Returns 0, successfully
+     */
+    NetPolicyResultCode ReplaceIdleTrustlist(const std::vector<uint32_t> &uids);
     /**
      * @brief GetIdleTrustlist for get trust list for Idle status
      *
@@ -16,8 +16,13 @@
 #ifndef NET_POLICY_CONSTANTS_H
 #define NET_POLICY_CONSTANTS_H
 
+#include <cstdint>
+
 namespace OHOS {
 namespace NetManagerStandard {
+// Upper bound on the number of uids carried by one SetPoliciesByUids, GetPoliciesByUids or ReplaceIdleTrustlist call.
+constexpr uint32_t MAX_UID_POLICY_BATCH_SIZE = 4096;
+
 enum class NetPolicyResultCode {
     ERR_NONE = 0,
     ERR_INTERNAL_ERROR = (-1),
@@ -17,6 +17,7 @@
 #define I_NET_POLICY_CALLBACK_H
 
 #include <string>
+#include <vector>
 
 #include "iremote_broker.h"
 #include "net_policy_cellular_policy.h"
@@ -34,10 +35,26 @@ public:
         NET_POLICY_CELLULARPOLICY_CHANGED = 1,
         NET_POLICY_STRATEGYSWITCH_CHANGED = 2,
         NET_POLICY_BACKGROUNDPOLICY_CHANGED = 3,
+        NET_POLICY_UIDPOLICIES_CHANGED = 4,
     };
 
 public:
     virtual int32_t NetUidPolicyChanged(uint32_t uid, NetUidPolicy policy) = 0;
+
+    /**
+     * @brief Batched uid policy change, by default delivered as one NetUidPolicyChanged per entry
+     *
+     * Implementations that predate the batch keep receiving every change without overriding it.
+     */
+    virtual int32_t NetUidPoliciesChanged(const std::vector<uint32_t> &uids,
+        const std::vector<NetUidPolicy> &policies)
+    {
+        for (size_t i = 0; i < uids.size() && i < policies.size(); ++i) {
+            NetUidPolicyChanged(uids[i], policies[i]);
+        }
+        return static_cast<int32_t>(NetPolicyResultCode::ERR_NONE);
+    }
+
     virtual int32_t NetCellularPolicyChanged(const std::vector<NetPolicyCellularPolicy> &cellularPolicies) = 0;
     virtual int32_t NetStrategySwitch(const std::string &simId, bool enable) = 0;
     virtual int32_t NetBackgroundPolicyChanged(bool isBackgroundPolicyAllow) = 0;
@@ -49,12 +49,19 @@ public:
         CMD_NSM_GET_BACKGROUND_POLICY = 17,
         CMD_NSM_GET_BACKGROUND_POLICY_BY_UID = 18,
         CMD_NSM_GET_BACKGROUND_POLICY_BY_CURRENT = 19,
+        CMD_NSM_SET_UID_POLICIES = 20,
+        CMD_NSM_GET_UID_POLICIES = 21,
+        CMD_NSM_REPLACE_IDLE_TRUSTLIST = 22,
         CMD_NSM_END = 100,
     };
 
 public:
     virtual NetPolicyResultCode SetPolicyByUid(uint32_t uid, NetUidPolicy policy) = 0;
     virtual NetUidPolicy GetPolicyByUid(uint32_t uid) = 0;
+    virtual NetPolicyResultCode SetPoliciesByUids(const std::vector<uint32_t> &uids,
+        const std::vector<NetUidPolicy> &policies) = 0;
+    virtual NetPolicyResultCode GetPoliciesByUids(const std::vector<uint32_t> &uids,
+        std::vector<NetUidPolicy> &policies) = 0;
     virtual std::vector<uint32_t> GetUidsByPolicy(NetUidPolicy policy) = 0;
     virtual bool IsUidNetAccess(uint32_t uid, bool metered) = 0;
     virtual bool IsUidNetAccess(uint32_t uid, const std::string &ifaceName) = 0;
@@ -71,6 +78,7 @@ public:
     virtual NetBackgroundPolicy GetCurrentBackgroundPolicy() = 0;
     virtual NetPolicyResultCode SetSnoozePolicy(int8_t netType, const std::string &simId) = 0;
     virtual NetPolicyResultCode SetIdleTrustlist(uint32_t uid, bool isTrustlist) = 0;
+    virtual NetPolicyResultCode ReplaceIdleTrustlist(const std::vector<uint32_t> &uids) = 0;
     virtual NetPolicyResultCode GetIdleTrustlist(std::vector<uint32_t> &uids) = 0;
 };
 } // namespace NetManagerStandard
@@ -42,6 +42,7 @@ private:
 
 private:
     int32_t OnNetUidPolicyChanged(MessageParcel &data, MessageParcel &reply);
+    int32_t OnNetUidPoliciesChanged(MessageParcel &data, MessageParcel &reply);
     int32_t OnNetCellularPolicyChanged(MessageParcel &data, MessageParcel &reply);
     int32_t OnNetStrategySwitch(MessageParcel &data, MessageParcel &reply);
     int32_t OnNetBackgroundPolicyChanged(MessageParcel &data, MessageParcel &reply);
@@ -31,6 +31,10 @@ public:
     virtual ~NetPolicyServiceProxy();
     NetPolicyResultCode SetPolicyByUid(uint32_t uid, NetUidPolicy policy) override;
     NetUidPolicy GetPolicyByUid(uint32_t uid) override;
+    NetPolicyResultCode SetPoliciesByUids(const std::vector<uint32_t> &uids,
+        const std::vector<NetUidPolicy> &policies) override;
+    NetPolicyResultCode GetPoliciesByUids(const std::vector<uint32_t> &uids,
+        std::vector<NetUidPolicy> &policies) override;
     std::vector<uint32_t> GetUidsByPolicy(NetUidPolicy policy) override;
     bool IsUidNetAccess(uint32_t uid, bool metered) override;
     bool IsUidNetAccess(uint32_t uid, const std::string &ifaceName) override;
@@ -47,6 +51,7 @@ public:
     NetBackgroundPolicy GetCurrentBackgroundPolicy() override;
     NetPolicyResultCode SetSnoozePolicy(int8_t netType, const std::string &simId) override;
     NetPolicyResultCode SetIdleTrustlist(uint32_t uid, bool isTrustlist) override;
+    NetPolicyResultCode ReplaceIdleTrustlist(const std::vector<uint32_t> &uids) override;
     NetPolicyResultCode GetIdleTrustlist(std::vector<uint32_t> &uids) override;
 
 private:
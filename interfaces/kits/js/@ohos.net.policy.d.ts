@@ -70,6 +70,28 @@ declare namespace policy {
   function getPolicyByUid(uid: number, callback: AsyncCallback<NetUidPolicy>): void;
   function getPolicyByUid(uid: number): Promise<NetUidPolicy>;
 
+  /**
+   * Set policies for several UIDs at once. The batch is applied entirely or not at all.
+   *
+   * @param uidPolicies the UIDs of applications and their policies, at most 4096 entries.
+   * @permission ohos.permission.SET_NETWORK_POLICY
+   * @systemapi Hide this for inner system use.
+   */
+  function setPoliciesByUids(uidPolicies: Array<UidPolicy>, callback: AsyncCallback<void>): void;
+  function setPoliciesByUids(uidPolicies: Array<UidPolicy>): Promise<void>;
+
+  /**
+   * Query the policies of several UIDs at once.
+   *
+   * @param uids the UIDs of applications, at most 4096 entries.
+   * @param callback Returns the policies in the order of uids.
+   *      For details, see {@link NetUidPolicy}.
+   * @permission ohos.permission.GET_NETWORK_POLICY
+   * @systemapi Hide this for inner system use.
+   */
+  function getPoliciesByUids(uids: Array<number>, callback: AsyncCallback<Array<NetUidPolicy>>): void;
+  function getPoliciesByUids(uids: Array<number>): Promise<Array<NetUidPolicy>>;
+
   /**
    * Query the application UIDs of the specified policy.
    *
@@ -175,6 +197,18 @@ declare namespace policy {
     metered?: MeteringMode;
   }
 
+  /**
+   * The policy of one application, an entry of {@link setPoliciesByUids}.
+   *
+   * @systemapi Hide this for inner system use.
+   */
+  export interface UidPolicy {
+    /* The UID of the application */
+    uid: number;
+    /* @see{NetUidPolicy} */
+    policy: NetUidPolicy;
+  }
+
   /**
    * @systemapi Hide this for inner system use.
    */
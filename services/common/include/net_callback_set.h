@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_CALLBACK_SET_H
+#define NET_CALLBACK_SET_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "iremote_object.h"
+#include "refbase.h"
+
+#include "net_mgr_log_wrapper.h"
+#include "net_worker_pool.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * Registered client callbacks of one kind, keyed by their remote object.
+ *
+ * Add, Remove and Find are O(1). A death recipient is attached to every remote client, so a client that dies
+ * without unregistering is dropped from the set as soon as the binder driver reports it. Notify fans the
+ * notification out on the shared NetWorkerPool, one task per client: clients are served in parallel and each
+ * client still sees its notifications in order. Thread safe.
+ */
+template <typename Callback>
+class NetCallbackSet {
+public:
+    using DiedHandler = std::function<void(const sptr<Callback> &callback, uint32_t cookie)>;
+    using NotifyFunc = std::function<void(const sptr<Callback> &callback)>;
+
+    /**
+     * @param limit Maximum number of callbacks, 0 for no limit
+     * @param workers Pool that runs Notify
+     */
+    explicit NetCallbackSet(uint32_t limit, NetWorkerPool &workers = NetWorkerPool::GetInstance())
+        : state_(std::make_shared<State>()), workers_(workers), limit_(limit)
+    {
+    }
+
+    ~NetCallbackSet()
+    {
+        Clear();
+    }
+
+    NetCallbackSet(const NetCallbackSet &) = delete;
+    NetCallbackSet &operator=(const NetCallbackSet &) = delete;
+
+    /**
+     * @brief Set the handler run on the binder thread after a dead client has been removed
+     *
+     * @param handler The handler, receives the callback and the cookie it was added with
+     */
+    void SetDiedHandler(const DiedHandler &handler)
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->diedHandler = handler;
+    }
+
+    /**
+     * @brief Add a callback
+     *
+     * @param callback The callback
+     * @param cookie Caller data handed back by Find and the died handler
+     * @return Returns false if the callback is null, already added or the set is full
+     */
+    bool Add(const sptr<Callback> &callback, uint32_t cookie = 0)
+    {
+        IRemoteObject *key = GetKey(callback);
+        if (key == nullptr) {
+            NETMGR_LOG_E("The parameter callback is null");
+            return false;
+        }
+        sptr<IRemoteObject::DeathRecipient> recipient = (std::make_unique<Recipient>(state_, key)).release();
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            if (state_->entries.find(key) != state_->entries.end()) {
+                NETMGR_LOG_I("callback already registered");
+                return false;
+            }
+            if (limit_ != 0 && state_->entries.size() >= limit_) {
+                NETMGR_LOG_E("callback num cannot more than [%{public}u]", limit_);
+                return false;
+            }
+            state_->entries.emplace(key, Entry {callback, recipient, cookie});
+        }
+        // Attaching calls into the binder driver, so it runs unlocked. The entry is in place before, a death
+        // reported right away already finds it.
+        bool watched = callback->AsObject()->AddDeathRecipient(recipient);
+        bool stale = false;
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            auto iter = state_->entries.find(key);
+            bool current = iter != state_->entries.end() && iter->second.recipient.GetRefPtr() == recipient.GetRefPtr();
+            // Local objects do not support death notification, they live as long as the service.
+            if (current && !watched) {
+                iter->second.recipient = nullptr;
+            }
+            stale = watched && !current;
+        }
+        // Removed again while the recipient was being attached
+        if (stale) {
+            callback->AsObject()->RemoveDeathRecipient(recipient);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Remove a callback
+     *
+     * @param callback The callback
+     * @return Returns false if the callback was not added
+     */
+    bool Remove(const sptr<Callback> &callback)
+    {
+        IRemoteObject *key = GetKey(callback);
+        if (key == nullptr) {
+            return false;
+        }
+        Entry entry;
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            auto iter = state_->entries.find(key);
+            if (iter == state_->entries.end()) {
+                return false;
+            }
+            entry = iter->second;
+            state_->entries.erase(iter);
+        }
+        if (entry.recipient != nullptr) {
+            entry.callback->AsObject()->RemoveDeathRecipient(entry.recipient);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Look a callback up
+     *
+     * @param callback The callback
+     * @param cookie out param, the cookie it was added with
+     * @return Returns false if the callback was not added
+     */
+    bool Find(const sptr<Callback> &callback, uint32_t &cookie) const
+    {
+        IRemoteObject *key = GetKey(callback);
+        if (key == nullptr) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        auto iter = state_->entries.find(key);
+        if (iter == state_->entries.end()) {
+            return false;
+        }
+        cookie = iter->second.cookie;
+        return true;
+    }
+
+    size_t Size() const
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->entries.size();
+    }
+
+    void Clear()
+    {
+        std::unordered_map<IRemoteObject *, Entry> entries;
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            entries.swap(state_->entries);
+        }
+        for (auto &item : entries) {
+            if (item.second.recipient != nullptr) {
+                item.second.callback->AsObject()->RemoveDeathRecipient(item.second.recipient);
+            }
+        }
+    }
+
+    /**
+     * @brief Call every registered callback on the worker pool without waiting
+     *
+     * @param notify Called once per callback
+     */
+    void Notify(const NotifyFunc &notify)
+    {
+        std::vector<std::pair<IRemoteObject *, sptr<Callback>>> targets;
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            targets.reserve(state_->entries.size());
+            for (auto &item : state_->entries) {
+                targets.emplace_back(item.first, item.second.callback);
+            }
+        }
+        if (targets.empty()) {
+            return;
+        }
+        // One copy of the payload for all clients.
+        auto sharedNotify = std::make_shared<NotifyFunc>(notify);
+        for (auto &target : targets) {
+            sptr<Callback> callback = target.second;
+            if (!workers_.Post(target.first, [sharedNotify, callback]() { (*sharedNotify)(callback); })) {
+                (*sharedNotify)(callback);
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        sptr<Callback> callback;
+        sptr<IRemoteObject::DeathRecipient> recipient;
+        uint32_t cookie = 0;
+    };
+
+    struct State {
+        mutable std::mutex mutex;
+        std::unordered_map<IRemoteObject *, Entry> entries;
+        DiedHandler diedHandler;
+    };
+
+    class Recipient : public IRemoteObject::DeathRecipient {
+    public:
+        Recipient(const std::weak_ptr<State> &state, IRemoteObject *key) : state_(state), key_(key) {}
+        ~Recipient() override = default;
+
+        void OnRemoteDied(const wptr<IRemoteObject> &remote) override
+        {
+            std::shared_ptr<State> state = state_.lock();
+            if (state == nullptr) {
+                return;
+            }
+            Entry entry;
+            DiedHandler handler;
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                auto iter = state->entries.find(key_);
+                // The client may have been removed and a new one registered at the same address.
+                if (iter == state->entries.end() || iter->second.recipient.GetRefPtr() != this) {
+                    return;
+                }
+                entry = iter->second;
+                state->entries.erase(iter);
+                handler = state->diedHandler;
+            }
+            NETMGR_LOG_I("client died, callback removed");
+            if (handler) {
+                handler(entry.callback, entry.cookie);
+            }
+        }
+
+    private:
+        std::weak_ptr<State> state_;
+        IRemoteObject *key_;
+    };
+
+    static IRemoteObject *GetKey(const sptr<Callback> &callback)
+    {
+        if (callback == nullptr) {
+            return nullptr;
+        }
+        sptr<IRemoteObject> remote = callback->AsObject();
+        return (remote == nullptr) ? nullptr : remote.GetRefPtr();
+    }
+
+private:
+    std::shared_ptr<State> state_;
+    NetWorkerPool &workers_;
+    uint32_t limit_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_CALLBACK_SET_H
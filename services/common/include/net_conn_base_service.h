@@ -34,6 +34,8 @@ public:
     virtual int32_t UpdateNetLinkInfo(uint32_t supplierId, const sptr<NetLinkInfo> &netLinkInfo) = 0;
     virtual int32_t UpdateNetSupplierInfo(uint32_t supplierId, const sptr<NetSupplierInfo> &netSupplierInfo) = 0;
     virtual int32_t RestrictBackgroundChanged(bool isRestrictBackground) = 0;
+    /* Report every link that is up to the policy service again, asynchronously */
+    virtual int32_t ReplayIfaceLinks() = 0;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
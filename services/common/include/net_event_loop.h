@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_EVENT_LOOP_H
+#define NET_EVENT_LOOP_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "net_mpsc_queue.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * Serial executor: tasks posted from any thread run one at a time, in post order, on one worker thread.
+ */
+class NetEventLoop {
+public:
+    using Task = std::function<void()>;
+
+    explicit NetEventLoop(const std::string &name);
+    ~NetEventLoop();
+
+    /**
+     * @brief Start the worker thread
+     *
+     * @return Returns true if the loop is running after the call
+     */
+    bool Start();
+
+    /**
+     * @brief Run all tasks already posted, then stop the worker thread
+     *
+     * From a task of the loop itself this only asks the thread to exit once the task returns. The thread is then
+     * joined by the next Start or Stop from another thread, or by the destructor.
+     */
+    void Stop();
+
+    /**
+     * @brief Queue a task without waiting for it
+     *
+     * A task that is accepted always runs, at the latest when the loop stops.
+     *
+     * @param task The task to run on the loop thread
+     * @return Returns false if the loop is not running, the task is dropped
+     */
+    bool Post(Task task);
+
+    /**
+     * @brief Queue a task to run once the delay has elapsed
+     *
+     * Delayed tasks still pending when the loop stops are run at stop time.
+     *
+     * @param task The task to run on the loop thread
+     * @param delayMs Delay in milliseconds
+     * @return Returns false if the loop is not running, the task is dropped
+     */
+    bool PostDelayed(Task task, uint32_t delayMs);
+
+    /**
+     * @brief Run a task on the loop thread and wait for its result
+     *
+     * Runs inline when called from the loop thread itself. The task is not run once the loop is stopped.
+     *
+     * @param func The task to run
+     * @param failure Returned instead of running func when the loop is stopped
+     * @return The value returned by func
+     */
+    template <typename Func>
+    auto Invoke(Func &&func, decltype(std::declval<Func &>()()) failure) -> decltype(func())
+    {
+        using Result = decltype(func());
+        if (IsInLoopThread()) {
+            return func();
+        }
+        std::future<Result> result;
+        if (!PostTask(std::forward<Func>(func), result)) {
+            return failure;
+        }
+        return result.get();
+    }
+
+    /**
+     * @brief Invoke that returns a value initialized result once the loop is stopped
+     */
+    template <typename Func>
+    auto Invoke(Func &&func) -> decltype(func())
+    {
+        using Result = decltype(func());
+        if constexpr (std::is_void<Result>::value) {
+            if (IsInLoopThread()) {
+                func();
+                return;
+            }
+            std::future<void> done;
+            if (PostTask(std::forward<Func>(func), done)) {
+                done.get();
+            }
+        } else {
+            return Invoke(std::forward<Func>(func), Result());
+        }
+    }
+
+    bool IsInLoopThread() const;
+    bool IsRunning() const
+    {
+        return running_;
+    }
+
+private:
+    template <typename Func, typename Result>
+    bool PostTask(Func &&func, std::future<Result> &result)
+    {
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+        result = task->get_future();
+        return Post([task]() { (*task)(); });
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct DelayedTask {
+        Clock::time_point deadline;
+        uint64_t seq;
+        Task task;
+        bool operator>(const DelayedTask &other) const
+        {
+            return (deadline != other.deadline) ? (deadline > other.deadline) : (seq > other.seq);
+        }
+    };
+
+    void Run();
+    void JoinStopped();
+    void RunPendingTasks();
+    void RunDueTasks(bool runAll);
+    void Wakeup();
+
+private:
+    std::string name_;
+    NetMpscQueue<Task> tasks_;
+    std::atomic<bool> running_;
+    std::atomic<bool> stopRequested_;
+    std::atomic<bool> sleeping_;
+    // Serializes Start and Stop from threads other than the loop thread
+    std::mutex lifecycleMutex_;
+    // Held shared while a task is pushed and exclusively to stop accepting tasks, so none is pushed after the
+    // final drain in Stop
+    std::shared_mutex postMutex_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::thread thread_;
+    std::atomic<std::thread::id> threadId_;
+    // Only touched by the loop thread, delayed tasks reach it through tasks_.
+    std::priority_queue<DelayedTask, std::vector<DelayedTask>, std::greater<DelayedTask>> delayedTasks_;
+    uint64_t delayedSeq_ = 0;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_EVENT_LOOP_H
@@ -36,9 +36,13 @@ public:
     int32_t UpdateNetLinkInfo(uint32_t supplierId, const sptr<NetLinkInfo> &netLinkInfo);
     int32_t UpdateNetSupplierInfo(uint32_t supplierId, const sptr<NetSupplierInfo> &netSupplierInfo);
     void RegisterConnService(const sptr<NetConnBaseService> &service);
+    void IfaceLinkChanged(NetBearType bearerType, const std::string &ident, const std::string &ifaceName, bool up);
 
     int32_t GetIfaceStatsDetail(const std::string &iface, uint32_t start, uint32_t end, NetStatsInfo &info);
     int32_t ResetStatsFactory();
+    int32_t SetIfaceQuota(const NetStatsQuota &quota, const sptr<NetStatsQuotaCallback> &callback,
+        int64_t &usedBytes);
+    int32_t RemoveIfaceQuota(const std::string &ident);
     void RegisterStatsService(const sptr<NetStatsBaseService> &service);
 
     int32_t ResetPolicyFactory();
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_MPSC_QUEUE_H
+#define NET_MPSC_QUEUE_H
+
+#include <atomic>
+#include <utility>
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * Unbounded lock-free multi-producer single-consumer queue.
+ *
+ * Push may be called from any thread, Pop and Empty only from the single consumer thread.
+ * A Push that is still in flight may be invisible to the consumer for a moment; consumers
+ * must re-check after being woken up rather than rely on a single Pop.
+ */
+template <typename T>
+class NetMpscQueue {
+public:
+    NetMpscQueue()
+    {
+        Node *stub = new Node();
+        head_.store(stub, std::memory_order_relaxed);
+        tail_ = stub;
+    }
+
+    ~NetMpscQueue()
+    {
+        T value;
+        while (Pop(value)) {
+        }
+        delete tail_;
+    }
+
+    NetMpscQueue(const NetMpscQueue &) = delete;
+    NetMpscQueue &operator=(const NetMpscQueue &) = delete;
+
+    void Push(T value)
+    {
+        Node *node = new Node(std::move(value));
+        Node *prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    bool Pop(T &value)
+    {
+        Node *tail = tail_;
+        Node *next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            return false;
+        }
+        value = std::move(next->value);
+        tail_ = next;
+        delete tail;
+        return true;
+    }
+
+    bool Empty() const
+    {
+        return tail_->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    struct Node {
+        Node() : next(nullptr) {}
+        explicit Node(T &&v) : next(nullptr), value(std::move(v)) {}
+        std::atomic<Node *> next;
+        T value;
+    };
+
+    std::atomic<Node *> head_;
+    Node *tail_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_MPSC_QUEUE_H
@@ -15,14 +15,21 @@
 #ifndef NET_POLICY_BASE_SERVICE_H
 #define NET_POLICY_BASE_SERVICE_H
 
+#include <string>
+
 #include "refbase.h"
 
+#include "net_all_capabilities.h"
+
 namespace OHOS {
 namespace NetManagerStandard {
 class NetPolicyBaseService : public virtual RefBase {
 public:
     virtual int32_t ResetPolicyFactory() = 0;
     virtual bool IsUidNetAccess(uint32_t uid, bool metered) = 0;
+    /* Called on the connection service's state loop, must not call back into the connection service */
+    virtual void OnIfaceLinkChanged(NetBearType bearerType, const std::string &ident, const std::string &ifaceName,
+        bool up) = 0;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
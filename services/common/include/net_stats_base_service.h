@@ -15,16 +15,44 @@
 #ifndef NET_STATS_BASE_SERVICE_H
 #define NET_STATS_BASE_SERVICE_H
 
+#include <string>
+
 #include "refbase.h"
 
 #include "net_stats_info.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
+/**
+ * Traffic thresholds of one interface over one accounting period.
+ */
+struct NetStatsQuota {
+    /* Owner chosen key, unique among all quotas */
+    std::string ident;
+    std::string iface;
+    /* Period bounds in seconds since the epoch, the end is exclusive */
+    int64_t periodStart = 0;
+    int64_t periodEnd = 0;
+    /* rx + tx bytes, -1 for no threshold */
+    int64_t warningBytes = -1;
+    int64_t limitBytes = -1;
+};
+
+class NetStatsQuotaCallback : public virtual RefBase {
+public:
+    virtual void OnQuotaWarningReached(const NetStatsQuota &quota) = 0;
+    virtual void OnQuotaLimitReached(const NetStatsQuota &quota) = 0;
+    /* The quota is disarmed, the owner sets it again with the next period */
+    virtual void OnQuotaPeriodEnded(const NetStatsQuota &quota) = 0;
+};
+
 class NetStatsBaseService : public virtual RefBase {
 public:
     virtual int32_t GetIfaceStatsDetail(const std::string &iface, uint32_t start, uint32_t end, NetStatsInfo &info) = 0;
     virtual int32_t ResetStatsFactory() = 0;
+    virtual int32_t SetIfaceQuota(const NetStatsQuota &quota, const sptr<NetStatsQuotaCallback> &callback,
+        int64_t &usedBytes) = 0;
+    virtual int32_t RemoveIfaceQuota(const std::string &ident) = 0;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_WORKER_POOL_H
+#define NET_WORKER_POOL_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "net_event_loop.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * Fixed set of serial workers shared by the callback fan-out of every service.
+ *
+ * Tasks are routed by key, so tasks posted with the same key keep their order while different keys run in parallel.
+ */
+class NetWorkerPool {
+public:
+    static constexpr uint32_t DEFAULT_WORKER_NUM = 4;
+
+    static NetWorkerPool &GetInstance();
+
+    NetWorkerPool(const std::string &name, uint32_t workerNum);
+    ~NetWorkerPool();
+    NetWorkerPool(const NetWorkerPool &) = delete;
+    NetWorkerPool &operator=(const NetWorkerPool &) = delete;
+
+    /**
+     * @brief Queue a task on the worker owning the key
+     *
+     * @param key Routing key, usually the remote object of a client
+     * @param task The task
+     * @return Returns false if the pool is stopped, the task is dropped
+     */
+    bool Post(const void *key, NetEventLoop::Task task);
+
+    /**
+     * @brief Run every queued task, then stop the workers
+     */
+    void Stop();
+
+private:
+    std::vector<std::unique_ptr<NetEventLoop>> workers_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_WORKER_POOL_H
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "net_event_loop.h"
+
+#include <pthread.h>
+
+#include "net_mgr_log_wrapper.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr size_t MAX_THREAD_NAME_LEN = 15;
+} // namespace
+
+NetEventLoop::NetEventLoop(const std::string &name)
+    : name_(name), running_(false), stopRequested_(false), sleeping_(false), threadId_(std::thread::id())
+{
+}
+
+NetEventLoop::~NetEventLoop()
+{
+    Stop();
+}
+
+bool NetEventLoop::Start()
+{
+    std::lock_guard<std::mutex> lifecycleLock(lifecycleMutex_);
+    if (running_) {
+        return true;
+    }
+    // A Stop from a task of the loop left the thread for us to join
+    JoinStopped();
+    stopRequested_ = false;
+    {
+        std::unique_lock<std::shared_mutex> postLock(postMutex_);
+        running_ = true;
+    }
+    thread_ = std::thread([this]() { Run(); });
+    std::string threadName = name_.substr(0, MAX_THREAD_NAME_LEN);
+    pthread_setname_np(thread_.native_handle(), threadName.c_str());
+    NETMGR_LOG_D("event loop [%{public}s] started", name_.c_str());
+    return true;
+}
+
+void NetEventLoop::Stop()
+{
+    if (IsInLoopThread()) {
+        // Called from one of our own tasks, the thread exits once the current task returns.
+        {
+            std::unique_lock<std::shared_mutex> postLock(postMutex_);
+            running_ = false;
+        }
+        stopRequested_ = true;
+        return;
+    }
+    std::lock_guard<std::mutex> lifecycleLock(lifecycleMutex_);
+    {
+        std::unique_lock<std::shared_mutex> postLock(postMutex_);
+        running_ = false;
+    }
+    JoinStopped();
+    NETMGR_LOG_D("event loop [%{public}s] stopped", name_.c_str());
+}
+
+void NetEventLoop::JoinStopped()
+{
+    if (!thread_.joinable()) {
+        return;
+    }
+    stopRequested_ = true;
+    Wakeup();
+    thread_.join();
+    // No task can be pushed any more, run those that raced with Stop so that Invoke callers never wait forever.
+    RunPendingTasks();
+    RunDueTasks(true);
+}
+
+bool NetEventLoop::Post(Task task)
+{
+    if (!task) {
+        return false;
+    }
+    std::shared_lock<std::shared_mutex> postLock(postMutex_);
+    if (!running_) {
+        return false;
+    }
+    tasks_.Push(std::move(task));
+    Wakeup();
+    return true;
+}
+
+bool NetEventLoop::PostDelayed(Task task, uint32_t delayMs)
+{
+    if (!task) {
+        return false;
+    }
+    Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(delayMs);
+    return Post([this, deadline, task]() { delayedTasks_.push(DelayedTask {deadline, delayedSeq_++, task}); });
+}
+
+bool NetEventLoop::IsInLoopThread() const
+{
+    return threadId_.load() == std::this_thread::get_id();
+}
+
+void NetEventLoop::Wakeup()
+{
+    // Pairs with the fence in Run: either we see the sleeping flag or the loop sees our task.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!sleeping_.load()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    condition_.notify_one();
+}
+
+void NetEventLoop::RunPendingTasks()
+{
+    Task task;
+    while (tasks_.Pop(task)) {
+        task();
+        task = nullptr;
+    }
+}
+
+void NetEventLoop::RunDueTasks(bool runAll)
+{
+    Clock::time_point now = Clock::now();
+    while (!delayedTasks_.empty() && (runAll || delayedTasks_.top().deadline <= now)) {
+        Task task = delayedTasks_.top().task;
+        delayedTasks_.pop();
+        task();
+    }
+}
+
+void NetEventLoop::Run()
+{
+    threadId_ = std::this_thread::get_id();
+    while (true) {
+        RunPendingTasks();
+        RunDueTasks(false);
+        std::unique_lock<std::mutex> lock(mutex_);
+        sleeping_ = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        // Re-check after publishing the sleeping flag, a producer that missed it has already pushed.
+        if (!tasks_.Empty()) {
+            sleeping_ = false;
+            continue;
+        }
+        if (stopRequested_) {
+            sleeping_ = false;
+            break;
+        }
+        if (delayedTasks_.empty()) {
+            condition_.wait(lock);
+        } else {
+            condition_.wait_until(lock, delayedTasks_.top().deadline);
+        }
+        sleeping_ = false;
+    }
+    threadId_ = std::thread::id();
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
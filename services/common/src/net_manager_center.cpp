@@ -86,6 +86,23 @@ int32_t NetManagerCenter::ResetStatsFactory()
     return statsService_->ResetStatsFactory();
 }
 
+int32_t NetManagerCenter::SetIfaceQuota(const NetStatsQuota &quota, const sptr<NetStatsQuotaCallback> &callback,
+    int64_t &usedBytes)
+{
+    if (statsService_ == nullptr) {
+        return NETMANAGER_ERROR;
+    }
+    return statsService_->SetIfaceQuota(quota, callback, usedBytes);
+}
+
+int32_t NetManagerCenter::RemoveIfaceQuota(const std::string &ident)
+{
+    if (statsService_ == nullptr) {
+        return NETMANAGER_ERROR;
+    }
+    return statsService_->RemoveIfaceQuota(ident);
+}
+
 void NetManagerCenter::RegisterStatsService(const sptr<NetStatsBaseService> &service)
 {
     statsService_ = service;
@@ -103,6 +120,19 @@ int32_t NetManagerCenter::ResetPolicyFactory()
 void NetManagerCenter::RegisterPolicyService(const sptr<NetPolicyBaseService> &service)
 {
     policyService_ = service;
+    // Links that came up before the policy service registered
+    if (policyService_ != nullptr && connService_ != nullptr) {
+        connService_->ReplayIfaceLinks();
+    }
+}
+
+void NetManagerCenter::IfaceLinkChanged(NetBearType bearerType, const std::string &ident,
+    const std::string &ifaceName, bool up)
+{
+    if (policyService_ == nullptr) {
+        return;
+    }
+    policyService_->OnIfaceLinkChanged(bearerType, ident, ifaceName, up);
 }
 
 int32_t NetManagerCenter::ResetEthernetFactory()
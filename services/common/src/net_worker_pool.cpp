@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "net_worker_pool.h"
+
+#include <cstdint>
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+// Remote objects are heap allocated, the low bits carry no entropy.
+constexpr uint32_t KEY_ALIGN_SHIFT = 4;
+} // namespace
+
+NetWorkerPool &NetWorkerPool::GetInstance()
+{
+    static NetWorkerPool instance("NetCbWorker", DEFAULT_WORKER_NUM);
+    return instance;
+}
+
+NetWorkerPool::NetWorkerPool(const std::string &name, uint32_t workerNum)
+{
+    if (workerNum == 0) {
+        workerNum = 1;
+    }
+    for (uint32_t i = 0; i < workerNum; i++) {
+        auto worker = std::make_unique<NetEventLoop>(name + std::to_string(i));
+        worker->Start();
+        workers_.push_back(std::move(worker));
+    }
+}
+
+NetWorkerPool::~NetWorkerPool()
+{
+    Stop();
+}
+
+bool NetWorkerPool::Post(const void *key, NetEventLoop::Task task)
+{
+    size_t index = (reinterpret_cast<uintptr_t>(key) >> KEY_ALIGN_SHIFT) % workers_.size();
+    return workers_[index]->Post(std::move(task));
+}
+
+void NetWorkerPool::Stop()
+{
+    for (auto &worker : workers_) {
+        worker->Stop();
+    }
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -16,6 +16,7 @@
 #ifndef HTTP_REQUEST_H
 #define HTTP_REQUEST_H
 
+#include <memory>
 #include <string>
 #include <stdint.h>
 
@@ -20,9 +20,10 @@
 #include <vector>
 #include <functional>
 #include "i_net_conn_callback.h"
+#include "net_conn_callback_batcher.h"
 #include "net_specifier.h"
 #include "net_supplier.h"
-#include "timer.h"
+#include "net_timer_wheel.h"
 
 class NetSupplier;
 
@@ -45,16 +46,24 @@ public:
     void SetServiceSupply(sptr<NetSupplier> netServiceSupplied);
     sptr<INetConnCallback> GetNetCallback();
     sptr<NetSpecifier> GetNetSpecifier();
-    std::unique_ptr<Timer>&  GetTimer();
+
+    /**
+     * @brief Handle an expired request timeout, called from the NetConnService state loop
+     *
+     * NetUnavailable is queued on the batcher, behind the callbacks already queued for the client.
+     *
+     * @param batcher The batcher of the client callbacks
+     * @return Returns true if no network was supplied in time and the request should be removed
+     */
+    bool TimeOutNetAvailable(NetConnCallbackBatcher &batcher);
 
 private:
     bool CompareByNetworkIdent(const std::string &ident);
-    bool CompareByNetworkCapabilities(const std::set<NetCap> &netCaps);
-    bool CompareByNetworkNetType(NetBearType bearerType);
+    bool CompareByNetworkCapabilities(uint32_t netCapsMask) const;
+    bool CompareByNetworkNetType(uint32_t bearerTypesMask) const;
     bool CompareByNetworkBand(uint32_t netLinkUpBand, uint32_t netLinkDownBand);
     bool HaveCapability(NetCap netCap) const;
     bool HaveTypes(const std::set<NetBearType> &bearerTypes) const;
-    void TimeOutNetAvailable();
 
 private:
     uint32_t requestId_ = 1;
@@ -63,7 +72,10 @@ private:
     sptr<NetSupplier> netServiceSupplied_ = nullptr;
     uint32_t timeoutMS_ = 0;
     TimeOutHandler timeOutHandler_ = nullptr;
-    std::unique_ptr<Timer> lpTimer_ = nullptr;
+    uint64_t timerId_ = 0;
+    // Masks of the specifier, which does not change once the request is made
+    uint32_t reqCapsMask_ = 0;
+    uint32_t reqBearerTypesMask_ = 0;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
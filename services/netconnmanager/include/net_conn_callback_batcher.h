@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NET_CONN_CALLBACK_BATCHER_H
+#define NET_CONN_CALLBACK_BATCHER_H
+
+#include <map>
+
+#include "i_net_conn_callback.h"
+#include "net_event_loop.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * Coalesces NetConnCallback events per client, and sends them as one batch per client.
+ * An event arriving while nothing was sent lately goes out at once and opens a short window, events of the
+ * window are delivered together when it closes. A client gets its events in the order they were queued in,
+ * only back to back events of the same network are merged.
+ */
+class NetConnCallbackBatcher {
+public:
+    NetConnCallbackBatcher(NetEventLoop &loop, uint32_t windowMs);
+    ~NetConnCallbackBatcher() = default;
+
+    /**
+     * @brief Queue an event for a client, may be called from any thread
+     *
+     * @param callback The client callback
+     * @param event The event, see NetConnCallbackBatch::Add
+     */
+    void Enqueue(const sptr<INetConnCallback> &callback, const NetConnCallbackEvent &event);
+
+    /**
+     * @brief Hand every pending batch to the shared NetWorkerPool and open a new window, must be called on the
+     * loop thread
+     */
+    void Flush();
+
+private:
+    struct PendingEvents {
+        sptr<INetConnCallback> callback;
+        sptr<NetConnCallbackBatch> batch;
+    };
+
+    void Add(const sptr<INetConnCallback> &callback, const NetConnCallbackEvent &event);
+    static void Send(IRemoteObject *key, const sptr<INetConnCallback> &callback,
+        const sptr<NetConnCallbackBatch> &batch);
+
+private:
+    NetEventLoop &loop_;
+    uint32_t windowMs_;
+    // Owned by loop_, keyed by the remote object of the client so every proxy of one client shares a batch
+    std::map<IRemoteObject *, PendingEvents> pending_;
+    bool windowOpen_ = false;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_CONN_CALLBACK_BATCHER_H
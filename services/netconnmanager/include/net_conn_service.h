@@ -17,8 +17,12 @@
 #define NET_CONN_SERVICE_H
 
 #include <list>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <set>
 #include <string>
+#include <unordered_set>
 #include <vector>
 #include <functional>
 #include "singleton.h"
@@ -30,11 +34,16 @@
 #include "net_activate.h"
 #include "network.h"
 #include "net_score.h"
-#include "timer.h"
+#include "net_callback_set.h"
+#include "net_conn_callback_batcher.h"
+#include "net_conn_state_page.h"
+#include "net_event_loop.h"
+#include "net_request_matcher.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
 constexpr uint32_t MAX_REQUEST_NUM = 200;
+constexpr uint32_t CALLBACK_BATCH_WINDOW_MS = 10;
 class NetConnService : public SystemAbility,
     public NetConnServiceStub,
     public std::enable_shared_from_this<NetConnService> {
@@ -182,8 +191,16 @@ public:
     int32_t GetConnectionProperties(int32_t netId, NetLinkInfo &info) override;
     int32_t GetNetCapabilities(int32_t netId, NetAllCapabilities &netAllCap) override;
     int32_t BindSocket(int32_t socket_fd, int32_t netId) override;
-    void HandleDetectionResult(uint32_t supplierId, bool ifValid);
+    void HandleDetectionResult(uint32_t supplierId, NetDetectionStatus netDetectionState,
+        const std::string &urlRedirect);
+    void HandleDetectionQuality(uint32_t supplierId, bool reachable, int64_t latencyMs);
     int32_t RestrictBackgroundChanged(bool isRestrictBackground);
+    /**
+     * @brief Report every link that is up to the policy service, used when it registers after the links came up
+     *
+     * @return int32_t result
+     */
+    int32_t ReplayIfaceLinks();
     /**
      * @brief Set airplane mode
      *
@@ -197,9 +214,43 @@ public:
      * @return int32_t result
      */
     int32_t RestoreFactoryData() override;
+    /**
+     * @brief Subscribe to connectivity state versions, the callback gets NetStateVersionChange after every change
+     *
+     * @param callback The callback, dropped when its process dies
+     * @param version out param, the current state version
+     * @return Returns 0 on success, otherwise it will fail
+     */
+    int32_t RegisterNetStateCallback(const sptr<INetConnCallback> &callback, uint64_t &version) override;
+    /**
+     * @brief Get the shared memory page the connectivity summary is published in, see NetConnStatePage
+     *
+     * @param page out param, read only for the caller
+     * @return Returns 0 on success, otherwise it will fail
+     */
+    int32_t GetNetStatePage(sptr<Ashmem> &page) override;
+    /**
+     * @brief Stop the NetStateVersionChange notifications of RegisterNetStateCallback
+     *
+     * @param callback The callback
+     * @return Returns 0 on success, otherwise it will fail
+     */
+    int32_t UnregisterNetStateCallback(const sptr<INetConnCallback> &callback) override;
 
 private:
     bool Init();
+    int32_t RegisterNetSupplierInner(NetBearType bearerType, const std::string &ident,
+        const std::set<NetCap> &netCaps, uint32_t &supplierId);
+    int32_t UnregisterNetSupplierInner(uint32_t supplierId);
+    int32_t RegisterNetConnCallbackInner(const sptr<NetSpecifier> &netSpecifier,
+        const sptr<INetConnCallback> &callback, const uint32_t &timeoutMS);
+    int32_t UnregisterNetConnCallbackInner(const sptr<INetConnCallback> &callback);
+    int32_t UpdateNetSupplierInfoInner(uint32_t supplierId, const sptr<NetSupplierInfo> &netSupplierInfo);
+    int32_t UpdateNetLinkInfoInner(uint32_t supplierId, const sptr<NetLinkInfo> &netLinkInfo);
+    void HandleDetectionResultInner(uint32_t supplierId, NetDetectionStatus netDetectionState,
+        const std::string &urlRedirect);
+    void RestrictBackgroundChangedInner(bool restrictBackground);
+    int32_t OnRequestTimeout(uint32_t &reqId);
     sptr<NetSupplier> GetNetSupplierFromList(NetBearType bearerType, const std::string &ident);
     sptr<NetSupplier> GetNetSupplierFromList(
         NetBearType bearerType, const std::string &ident, const std::set<NetCap> &netCaps);
@@ -208,11 +259,13 @@ private:
     int32_t DeactivateNetwork(uint32_t reqId);
     void CallbackForSupplier(sptr<NetSupplier>& supplier, CallbackType type);
     void CallbackForAvailable(sptr<NetSupplier> &supplier, const sptr<INetConnCallback> &callback);
-    uint32_t FindBestNetworkForRequest(sptr<NetSupplier>& supplier, sptr<NetActivate>& netActivateNetwork);
+    NetConnCallbackEvent MakeCallbackEvent(sptr<NetSupplier> &supplier, uint32_t facets);
     void SendRequestToAllNetwork(sptr<NetActivate> request);
-    void SendBestScoreAllNetwork(uint32_t reqId, int32_t bestScore, uint32_t supplierId);
+    void SendBestScoreToHolders(uint32_t reqId, int32_t bestScore, uint32_t supplierId);
     void SendAllRequestToNetwork(sptr<NetSupplier> supplier);
-    void FindBestNetworkForAllRequest();
+    void ReevaluateSupplier(const sptr<NetSupplier> &supplier);
+    void EvaluateRequests(const std::vector<uint32_t> &reqIds);
+    void EvaluateRequest(const sptr<NetActivate> &request);
     void MakeDefaultNetWork(sptr<NetSupplier>& oldService, sptr<NetSupplier>& newService);
     void NotFindBestSupplier(uint32_t reqId, const sptr<NetActivate> &active,
         const sptr<NetSupplier> &supplier, const sptr<INetConnCallback> &callback);
@@ -220,6 +273,8 @@ private:
     int32_t RegUnRegNetDetectionCallback(int32_t netId, const sptr<INetDetectionCallback> &callback, bool isReg);
     int32_t GenerateNetId();
     bool FindSameCallback(const sptr<INetConnCallback> &callback, uint32_t &reqId);
+    void TrackRequestHolder(const sptr<NetSupplier> &supplier, uint32_t reqId);
+    void CancelRequestOnHolders(uint32_t reqId);
 
 private:
     enum ServiceRunningState {
@@ -227,8 +282,41 @@ private:
         STATE_RUNNING,
     };
 
+    /**
+     * Immutable view of the connectivity state for the read-only getters, rebuilt by the state loop after every
+     * change and swapped in atomically, so readers never wait for the state loop. The version only moves when the
+     * rebuilt view differs from the published one.
+     */
+    struct NetConnSnapshot {
+        struct Entry {
+            NetBearType bearerType = BEARER_DEFAULT;
+            std::string ident;
+            int32_t uid = 0;
+            NetLinkInfo linkInfo;
+            NetAllCapabilities netAllCap;
+        };
+        uint64_t version = 0;
+        int32_t defaultNetId = INVALID_NET_ID;
+        std::map<int32_t, Entry> networks;
+        std::set<uint32_t> supplierIds;
+        // As the first supplier has it, RestrictBackgroundChanged compares against this
+        bool restrictBackground = false;
+    };
+
+    std::shared_ptr<const NetConnSnapshot> LoadSnapshot() const;
+    bool HasSupplier(uint32_t supplierId) const;
+    static bool SameState(const NetConnSnapshot &lhs, const NetConnSnapshot &rhs);
+    void PublishSnapshot();
+    void ReportIfaceLinks(const NetConnSnapshot &last, const NetConnSnapshot &current);
+    void CreateStatePage();
+    void WriteStatePage(const NetConnSnapshot &snapshot);
+
     bool registerToService_;
     ServiceRunningState state_;
+    // Every member below is owned by stateLoop_, INetConnCallback deliveries go through callbackLoop_.
+    std::unique_ptr<NetEventLoop> stateLoop_ = nullptr;
+    std::unique_ptr<NetEventLoop> callbackLoop_ = nullptr;
+    std::unique_ptr<NetConnCallbackBatcher> callbackBatcher_ = nullptr;
     sptr<NetSpecifier> defaultNetSpecifier_ = nullptr;
     sptr<NetActivate> defaultNetActivate_ = nullptr;
     sptr<NetSupplier> defaultNetSupplier_ = nullptr;
@@ -236,9 +324,18 @@ private:
     NET_ACTIVATE_MAP netActivates_;
     NET_ACTIVATE_MAP deleteNetActivates_;
     NET_NETWORK_MAP networks_;
+    // Callback to its request id, a callback can only be registered once. Dead clients are deactivated.
+    NetCallbackSet<INetConnCallback> netConnCallbacks_ {0};
+    NetCallbackSet<INetConnCallback> netStateCallbacks_ {0};
+    // Request to the ids of the suppliers it was sent to, so a cancel does not walk every supplier.
+    NetRequestMatcher netRequestMatcher_;
     std::unique_ptr<NetScore> netScore_ = nullptr;
     sptr<NetConnServiceIface> serviceIface_ = nullptr;
     std::atomic<int32_t> netIdLastValue_ = MIN_NET_ID - 1;
+    // Only ever accessed through std::atomic_load/atomic_store, published by the state loop
+    std::shared_ptr<const NetConnSnapshot> snapshot_ = std::make_shared<const NetConnSnapshot>();
+    sptr<Ashmem> statePageMem_ = nullptr;
+    NetConnStatePage *statePage_ = nullptr;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
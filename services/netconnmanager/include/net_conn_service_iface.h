@@ -31,6 +31,7 @@ public:
     int32_t UpdateNetLinkInfo(uint32_t supplierId, const sptr<NetLinkInfo> &netLinkInfo) override;
     int32_t UpdateNetSupplierInfo(uint32_t supplierId, const sptr<NetSupplierInfo> &netSupplierInfo) override;
     int32_t RestrictBackgroundChanged(bool isRestrictBackground) override;
+    int32_t ReplayIfaceLinks() override;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
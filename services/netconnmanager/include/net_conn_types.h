@@ -55,7 +55,8 @@ enum ResultCode {
     ERR_NET_OVER_MAX_REQUEST_NUM                                    = (-31),
     ERR_REGISTER_THE_SAME_CALLBACK                                  = (-32),
     ERR_UNREGISTER_CALLBACK_NOT_FOUND                               = (-33),
-    ERR_PERMISSION_CHECK_FAIL                                       = (-34)
+    ERR_PERMISSION_CHECK_FAIL                                       = (-34),
+    ERR_SERVICE_STOPPED                                             = (-35)
 };
 
 enum NetMonitorResponseCode {
@@ -74,6 +75,7 @@ enum NetDetectionStatus {
 };
 using NetDetectionStateHandler = std::function<void(NetDetectionStatus netDetectionState,
     const std::string &urlRedirect)>;
+using NetDetectionQualityHandler = std::function<void(bool reachable, int64_t latencyMs)>;
 } // namespace NetManagerStandard
 } // namespace OHOS
 #endif // NET_CONN_TYPES_H
@@ -16,16 +16,20 @@
 #ifndef NET_MONITOR_H
 #define NET_MONITOR_H
 
+#include <memory>
 #include <mutex>
-#include <thread>
+#include <vector>
 
-#include "http_request.h"
 #include "net_conn_types.h"
+#include "net_probe_engine.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
-const std::string DEFAULT_PORTAL_HTTPS_URL = "http://connectivitycheck.platform.hicloud.com/generate_204";
-constexpr int32_t HTTP_DETECTION_WAIT_TIME_MS = 10000;
+const std::string DEFAULT_PORTAL_HTTP_URL = "http://connectivitycheck.platform.hicloud.com/generate_204";
+const std::string DEFAULT_PORTAL_HTTPS_URL = "https://connectivitycheck.platform.hicloud.com/generate_204";
+constexpr uint32_t HTTP_DETECTION_WAIT_TIME_MS = 10000;
+constexpr uint32_t HTTP_DETECTION_MAX_WAIT_TIME_MS = 160000;
+constexpr uint32_t HTTP_DETECTION_JITTER_PERCENT = 10;
 const std::string PORTAL_URL_REDIRECT_FIRST_CASE = "Location: ";
 const std::string PORTAL_URL_REDIRECT_SECOND_CASE = "http";
 const std::string CONTENT_STR = "Content-Length:";
@@ -33,45 +37,117 @@ const std::string PORTAL_END_STR = "?";
 constexpr int32_t PORTAL_CONTENT_LENGTH_MIN = 4;
 constexpr int32_t NET_CONTENT_LENGTH = 6;
 
-class NetMonitor {
+/**
+ * Runs detection rounds for one network. Rounds are started by the shared NetTimerWheel and the probes run
+ * on the shared NetProbeEngine, so an idle monitor costs no thread. Handlers are called on those threads without
+ * the monitor lock held, they should hand the result over to their own thread.
+ */
+class NetMonitor : public std::enable_shared_from_this<NetMonitor> {
 public:
-    NetMonitor(NetDetectionStateHandler handle);
-    virtual ~NetMonitor();
     /**
-     * @brief : Start NetMonitor thread
-     * @Return success : NET_OPT_SUCCESS  failed : NET_OPT_FAILED
+     * @brief Construct a NetMonitor
+     *
+     * @param handle Receives the result of every detection round
+     * @param probeUrls Probed in parallel each round, the first conclusive answer wins
      */
-    ResultCode InitNetMonitorThread();
+    NetMonitor(NetDetectionStateHandler handle,
+        const std::vector<std::string> &probeUrls = {DEFAULT_PORTAL_HTTP_URL, DEFAULT_PORTAL_HTTPS_URL});
+    virtual ~NetMonitor();
 
     /**
-     * @brief : Trigger thread to perform network detection
+     * @brief : Start a detection round now and keep detecting periodically, restarts a running detection
      * @param ifaceName
      */
-    void SignalNetMonitorThread(const std::string &ifaceName);
+    void Start(const std::string &ifaceName);
+
+    /**
+     * @brief : Stop detecting, the handler is not called once this returns, must not be called from a handler
+     *
+     */
+    void Stop();
 
     /**
-     * @brief : stop the NetMonitor processing thread.
+     * @brief Receive the latency of every detection round, for network scoring
      *
+     * @param handle Called after the state handler, reachable is false if no probe validated the network
      */
-    void StopNetMonitorThread();
+    void SetQualityHandler(NetDetectionQualityHandler handle);
 
 private:
+    struct ProbeRound {
+        size_t pending = 0;
+        std::vector<uint64_t> probeIds;
+    };
+
+    // A finished round, taken under mutex_ and reported after releasing it
+    struct RoundReport {
+        bool due = false;
+        uint64_t generation = 0;
+        NetDetectionStatus status = INVALID_DETECTION_STATE;
+        std::string urlRedirect;
+        int64_t latencyMs = -1;
+        NetDetectionStateHandler stateHandler;
+        NetDetectionQualityHandler qualityHandler;
+    };
+
     /**
-     * @brief : Detect Internet ability
-     * @return true http detection success, false http detection failed
+     * @brief Start the probes of a round, must hold mutex_
+     *
+     * @param generation Detection generation the round belongs to
+     * @param report out param, filled if the round finished at once
      */
-    bool HttpDetection();
+    void StartRoundLocked(uint64_t generation, RoundReport &report);
 
     /**
-     * @brief : NetMonitor thread function
+     * @brief Publish the result of one probe, runs on the probe engine thread
+     *
+     * @param generation Detection generation the probe belongs to
+     * @param round The detection round the probe belongs to
+     * @param url Probe url
+     * @param result Probe result
+     */
+    void OnProbeResult(uint64_t generation, const std::shared_ptr<ProbeRound> &round, const std::string &url,
+        const NetProbeResult &result);
+
+    /**
+     * @brief Conclude a round, drop its remaining probes and schedule the next one, must hold mutex_
+     *
+     * @param status Result of the round
+     * @param urlRedirect Portal url if any
+     * @param latencyMs Time taken by the deciding probe, -1 if none
+     * @param report out param, to be passed to Report once mutex_ is released
+     */
+    void FinishRoundLocked(NetDetectionStatus status, const std::string &urlRedirect, int64_t latencyMs,
+        RoundReport &report);
+
+    /**
+     * @brief Call the handlers for a finished round, must not hold mutex_
+     *
+     * @param report The round, dropped if the detection was stopped or restarted meanwhile
+     */
+    void Report(const RoundReport &report);
+
+    /**
+     * @brief Cancel the scheduled round and the probes in flight, must hold mutex_
+     */
+    void CancelLocked();
+
+    /**
+     * @brief Classify a probe response header
+     *
+     * @param strResponse Response header of the probe
+     * @param urlRedirect out param, the portal url if any
+     * @return NetDetectionStatus INVALID_DETECTION_STATE if the response is not conclusive
      */
-    void RunNetMonitorThreadFunc();
+    static NetDetectionStatus ParseProbeResponse(const std::string &strResponse, std::string &urlRedirect);
 
     /**
-     * @brief : Exit the NetMonitor thread.
+     * @brief Wait time before the next round, backed off after every validated round
      *
+     * @param status Result of the last round
+     * @return uint32_t Wait time in milliseconds, jittered
      */
-    void ExitNetMonitorThread();
+    uint32_t NextDetectionWaitTime(NetDetectionStatus status);
 
     /**
      * @brief Get the Status Code From Response object
@@ -79,7 +155,7 @@ private:
      * @param strResponse
      * @return int32_t Returns -1, strResponse is invalid; otherwise returns statusCode
      */
-    int32_t GetStatusCodeFromResponse(const std::string &strResponse);
+    static int32_t GetStatusCodeFromResponse(const std::string &strResponse);
 
     /**
      * @brief Get the Url Redirect From Response object
@@ -88,18 +164,22 @@ private:
      * @param urlRedirect    The redirected url obtained from the response data
      * @return int32_t Returns 0, get urlRedirect; returns -1, urlRedirect is empty
      */
-    int32_t GetUrlRedirectFromResponse(const std::string &strResponse, std::string &urlRedirect);
+    static int32_t GetUrlRedirectFromResponse(const std::string &strResponse, std::string &urlRedirect);
 
 private:
     std::mutex mutex_;
-    std::condition_variable condition_;
-    std::condition_variable conditionTimeout_;
-    bool isStopNetMonitor_;
-    bool isExitNetMonitorThread_;
-    std::unique_ptr<std::thread> netMonitorThread_;
+    // Held while the handlers run, so that Stop can wait for a report in progress
+    std::mutex reportMutex_;
     NetDetectionStateHandler netDetectionStatus_;
+    NetDetectionQualityHandler netDetectionQuality_;
     NetDetectionStatus lastDetectionState_;
     std::string ifaceName_;
+    std::vector<std::string> probeUrls_;
+    // Bumped by Start and Stop, results of an older generation are dropped
+    uint64_t generation_ = 0;
+    uint64_t timerId_ = 0;
+    std::shared_ptr<ProbeRound> currentRound_;
+    uint32_t validatedRounds_ = 0;
 };
 }  // namespace NetManagerStandard
 }  // namespace OHOS
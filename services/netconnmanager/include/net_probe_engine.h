@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NET_PROBE_ENGINE_H
+#define NET_PROBE_ENGINE_H
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace OHOS {
+namespace NetManagerStandard {
+struct NetProbeRequest {
+    std::string url;
+    // Interface the probe is bound to, empty for the default route
+    std::string ifaceName;
+    int64_t connectTimeoutMs = 1500;
+    int64_t timeoutMs = 2000;
+};
+
+struct NetProbeResult {
+    // CURLcode of the transfer, 0 on success
+    int32_t errCode = 0;
+    // Raw response headers, every hop when a redirect was followed
+    std::string header;
+    int64_t totalTimeMs = 0;
+};
+
+using NetProbeCallback = std::function<void(const NetProbeResult &result)>;
+
+/**
+ * Process-wide HTTP probe engine built on one curl multi handle and one thread.
+ *
+ * Every probe opens a fresh connection and stops at the first body byte, a portal check must see what the
+ * network answers now. Probes on the same interface share a DNS and TLS session cache across rounds, so an
+ * HTTPS probe resumes the session of the previous one. The cache lives until ReleaseInterface. Completion
+ * callbacks run on the engine thread and must not block.
+ */
+class NetProbeEngine {
+public:
+    static NetProbeEngine &GetInstance();
+
+    /**
+     * @brief Initialize libcurl once per process, safe to call from any thread
+     */
+    static void GlobalInit();
+
+    /**
+     * @brief Start a probe
+     *
+     * @param request The probe request
+     * @param callback Called once on the engine thread with the result, unless the probe is cancelled
+     * @return Probe id for CancelProbe, 0 if the probe could not be started
+     */
+    uint64_t StartProbe(const NetProbeRequest &request, const NetProbeCallback &callback);
+
+    /**
+     * @brief Cancel a running probe and release its transfer
+     *
+     * Best effort: a probe that completed before the engine thread sees the cancel still reports,
+     * callers must tolerate a late callback.
+     *
+     * @param probeId Id returned by StartProbe
+     */
+    void CancelProbe(uint64_t probeId);
+
+    /**
+     * @brief Drop the caches of an interface that went away, probes still running on it keep them until they end
+     *
+     * @param ifaceName Interface name as given in NetProbeRequest
+     */
+    void ReleaseInterface(const std::string &ifaceName);
+
+private:
+    NetProbeEngine();
+    ~NetProbeEngine();
+    NetProbeEngine(const NetProbeEngine &) = delete;
+    NetProbeEngine &operator=(const NetProbeEngine &) = delete;
+
+    struct Probe;
+    struct Share;
+    struct Command {
+        bool cancel = false;
+        bool releaseIface = false;
+        uint64_t probeId = 0;
+        NetProbeRequest request;
+        NetProbeCallback callback;
+    };
+
+    void Run();
+    void RunCommands();
+    void AddProbe(const Command &command);
+    void RemoveProbe(uint64_t probeId);
+    void ReadDoneProbes();
+    std::shared_ptr<Share> AcquireShare(const std::string &ifaceName);
+    static size_t HeaderCallback(char *data, size_t size, size_t nmemb, void *userp);
+    static size_t DiscardCallback(char *data, size_t size, size_t nmemb, void *userp);
+
+private:
+    void *multi_ = nullptr;
+    std::thread thread_;
+    std::atomic<bool> exit_;
+    std::atomic<uint64_t> nextProbeId_;
+    std::mutex mutex_;
+    std::vector<Command> commands_;
+    // Owned by the engine thread
+    std::map<uint64_t, std::unique_ptr<Probe>> probes_;
+    std::map<std::string, std::shared_ptr<Share>> shares_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_PROBE_ENGINE_H
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_REQUEST_MATCHER_H
+#define NET_REQUEST_MATCHER_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "net_activate.h"
+#include "net_supplier.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * Incremental request to supplier matching.
+ *
+ * Requests asking for the same ident, capabilities, bearer types and bandwidth share one match class.
+ * Every class keeps the suppliers that satisfy it, and the connected ones ordered by score, so a supplier
+ * change only touches the classes whose best supplier actually moved.
+ * Not thread safe, owned by the NetConnService state loop.
+ */
+class NetRequestMatcher {
+public:
+    NetRequestMatcher() = default;
+    ~NetRequestMatcher() = default;
+
+    /**
+     * @brief Index a new request and match it against the known suppliers
+     *
+     * @param request The request
+     */
+    void AddRequest(const sptr<NetActivate> &request);
+
+    /**
+     * @brief Drop a request from the index
+     *
+     * @param reqId The request id
+     */
+    void RemoveRequest(uint32_t reqId);
+
+    /**
+     * @brief Re-match a supplier whose state, capabilities or score changed
+     *
+     * @param supplier The changed supplier, added to the index if unknown
+     * @param affectedReqIds out param, requests whose best supplier or best score changed, or that the
+     *        supplier stopped matching
+     */
+    void UpdateSupplier(const sptr<NetSupplier> &supplier, std::vector<uint32_t> &affectedReqIds);
+
+    /**
+     * @brief Drop a supplier from the index
+     *
+     * @param supplierId The supplier id
+     * @param affectedReqIds out param, requests whose best supplier or best score changed
+     */
+    void RemoveSupplier(uint32_t supplierId, std::vector<uint32_t> &affectedReqIds);
+
+    /**
+     * @brief Get the connected, best scored supplier for a request
+     *
+     * @param reqId The request id
+     * @param bestScore out param, real score of the returned supplier, 0 if none
+     * @return The best supplier, nullptr if no connected supplier matches
+     */
+    sptr<NetSupplier> GetBestSupplier(uint32_t reqId, int32_t &bestScore) const;
+
+    /**
+     * @brief Get every supplier satisfying a request, connected or not
+     *
+     * @param reqId The request id
+     * @param suppliers out param
+     */
+    void GetMatchedSuppliers(uint32_t reqId, std::vector<sptr<NetSupplier>> &suppliers) const;
+
+    /**
+     * @brief Get every request a supplier satisfies
+     *
+     * @param supplierId The supplier id
+     * @param reqIds out param
+     */
+    void GetMatchedRequests(uint32_t supplierId, std::vector<uint32_t> &reqIds) const;
+
+    /**
+     * @brief Remember that a supplier was handed a request, until the request or the supplier goes away
+     *
+     * @param reqId The request id
+     * @param supplierId The supplier id
+     */
+    void AddHolder(uint32_t reqId, uint32_t supplierId);
+
+    /**
+     * @brief Forget a holder that let go of the request
+     *
+     * @param reqId The request id
+     * @param supplierId The supplier id
+     */
+    void RemoveHolder(uint32_t reqId, uint32_t supplierId);
+
+    /**
+     * @brief Get the suppliers holding a request, split by whether they still satisfy it
+     *
+     * @param reqId The request id
+     * @param matched out param, holders that still match the request
+     * @param unmatched out param, holders that stopped matching and have to release the request
+     */
+    void GetHolders(uint32_t reqId, std::vector<sptr<NetSupplier>> &matched,
+        std::vector<sptr<NetSupplier>> &unmatched) const;
+
+    void Clear();
+
+private:
+    // ident, capabilities, bearer types, up and down bandwidth of the specifier
+    using MatchKey = std::tuple<std::string, std::set<NetCap>, std::set<NetBearType>, uint32_t, uint32_t>;
+    // -score first so that begin() is the highest score, ties go to the lowest supplier id
+    using RankEntry = std::pair<int32_t, uint32_t>;
+
+    struct MatchClass {
+        std::set<uint32_t> requests;
+        std::set<uint32_t> members;
+        std::set<RankEntry> ranking;
+        std::map<uint32_t, int32_t> rankedScores;
+    };
+
+    static MatchKey MakeKey(const sptr<NetActivate> &request);
+    sptr<NetActivate> GetSampleRequest(const MatchClass &matchClass) const;
+    bool UpdateMembership(MatchClass &matchClass, const sptr<NetSupplier> &supplier);
+    static RankEntry GetTop(const MatchClass &matchClass);
+    void CollectRequests(const MatchClass &matchClass, std::vector<uint32_t> &reqIds) const;
+
+private:
+    std::map<MatchKey, MatchClass> classes_;
+    std::map<uint32_t, MatchKey> requestKeys_;
+    std::map<uint32_t, sptr<NetActivate>> requests_;
+    std::map<uint32_t, sptr<NetSupplier>> suppliers_;
+    std::map<uint32_t, std::set<uint32_t>> holders_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_REQUEST_MATCHER_H
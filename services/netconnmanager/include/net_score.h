@@ -16,6 +16,7 @@
 #ifndef NET_SCORE_H
 #define NET_SCORE_H
 
+#include <string>
 #include <vector>
 #include <unordered_map>
 #include <singleton.h>
@@ -26,6 +27,10 @@ namespace NetManagerStandard {
 using NetTypeScore = std::unordered_map<NetBearType, int32_t>;
 constexpr int32_t NET_TYPE_SCORE_INTERVAL = 10;
 constexpr int32_t NET_VALID_SCORE = 4 * NET_TYPE_SCORE_INTERVAL;
+// Under half the gap between bearer types, so quality reorders networks of one type but never crosses types
+constexpr int32_t MAX_QUALITY_BONUS = (NET_TYPE_SCORE_INTERVAL - 1) / 2;
+// GetTop only selects a score above 0
+constexpr int32_t MIN_NET_SCORE = 1;
 enum class NetTypeScoreValue : int32_t {
     USB_VALUE               = 4 * NET_TYPE_SCORE_INTERVAL,
     BLUETOOTH_VALUE         = 5 * NET_TYPE_SCORE_INTERVAL,
@@ -36,16 +41,86 @@ enum class NetTypeScoreValue : int32_t {
     WIFI_AWARE_VALUE        = 10 * NET_TYPE_SCORE_INTERVAL
 };
 
+/**
+ * Score points of each quality term at its best, the terms are normalized to [-1, 1] before weighting.
+ * A term without data contributes nothing, so a fresh network scores as its bearer type. The weighted sum is
+ * clamped to MAX_QUALITY_BONUS either way.
+ */
+struct NetScoreWeights {
+    // log scale around 10 Mbps of the advertised down link bandwidth
+    int32_t bandwidth = 10;
+    // smoothed latency of the detection probes
+    int32_t latency = 10;
+    // smoothed share of failed detection rounds, only ever lowers the score
+    int32_t stability = 10;
+    // bonus of a network with NET_CAPABILITY_NOT_METERED
+    int32_t unmetered = 5;
+    // the quality bonus only moves once the new value differs by at least this much
+    int32_t hysteresis = 3;
+};
+
+/**
+ * Scores suppliers from their bearer type plus a quality bonus built from link bandwidth, detection latency,
+ * detection stability and metered state. The bonus only ranks networks of one bearer type, a VPN gets none.
+ * Measurements are smoothed with an EWMA and the bonus has a dead band, so noise in the samples does not flip the
+ * default network.
+ * Not thread safe, owned by the NetConnService state loop.
+ */
 class NetScore {
 public:
     NetScore();
     ~NetScore();
     bool GetServiceScore(sptr<NetSupplier> &supplier);
 
+    /**
+     * @brief Feed the result of a detection round into the quality history of a supplier
+     *
+     * @param supplierId The supplier id
+     * @param reachable Whether the round validated the network
+     * @param latencyMs Time of the deciding probe, ignored if not reachable
+     */
+    void UpdateProbeResult(uint32_t supplierId, bool reachable, int64_t latencyMs);
+
+    /**
+     * @brief Forget the quality history of a supplier
+     *
+     * @param supplierId The supplier id
+     */
+    void RemoveSupplier(uint32_t supplierId);
+
+    /**
+     * @brief Replace the weights, takes effect on the next GetServiceScore
+     *
+     * @param weights The new weights
+     */
+    void SetWeights(const NetScoreWeights &weights);
+    NetScoreWeights GetWeights() const;
+
+    /**
+     * @brief Override the weights from a file of "name=value" lines, '#' starts a comment
+     *
+     * @param fileName The weights file, names are the NetScoreWeights fields
+     * @return Whether the file was read, a missing file keeps the current weights
+     */
+    bool LoadWeights(const std::string &fileName);
+
 private:
+    struct NetQuality {
+        double latencyMs = 0;
+        double lossRate = 0;
+        uint32_t samples = 0;
+        uint32_t latencySamples = 0;
+        int32_t bonus = 0;
+        bool hasBonus = false;
+    };
+
     int32_t CalculateScoreForWifi(sptr<NetSupplier> &supplier);
     int32_t GetWifiSignalBar(int32_t rssi, int32_t signalBars);
+    int32_t CalculateQualityBonus(sptr<NetSupplier> &supplier);
+
 private:
+    NetScoreWeights weights_;
+    std::unordered_map<uint32_t, NetQuality> qualities_;
     NetTypeScore netTypeScore_ = {
         {BEARER_CELLULAR, static_cast<int32_t>(NetTypeScoreValue::CELLULAR_VALUE)},
         {BEARER_WIFI, static_cast<int32_t>(NetTypeScoreValue::WIFI_VALUE)},
@@ -18,6 +18,7 @@
 
 #include <string>
 #include <set>
+#include <unordered_set>
 #include <vector>
 #include <map>
 #include "network.h"
@@ -53,7 +54,10 @@ public:
     std::string GetNetSupplierIdent() const;
     const std::set<NetCap> &GetNetCaps() const;
     std::set<NetCap> GetNetCaps();
-    NetAllCapabilities GetNetCapabilities() const;
+    const NetAllCapabilities &GetNetCapabilities() const;
+    // Masks of GetNetCapabilities, see NetAllCapabilities::ToCapsMask
+    uint32_t GetNetCapsMask() const;
+    uint32_t GetBearerTypesMask() const;
     NetLinkInfo GetNetLinkInfo() const;
     bool GetRoaming() const;
     int8_t GetStrength() const;
@@ -81,8 +85,9 @@ public:
     int32_t SelectAsBestNetwork(uint32_t reqId);
     void ReceiveBestScore(uint32_t reqId, int32_t bestScore, uint32_t supplierId);
     int32_t CancelRequest(uint32_t reqId);
+    bool HasRequest(uint32_t reqId) const;
     void RemoveBestRequest(uint32_t reqId);
-    std::set<uint32_t>& GetBestRequestList();
+    std::unordered_set<uint32_t>& GetBestRequestList();
     void SetDefault();
     void ClearDefault();
     void UpdateNetStateForTest(int32_t netState);
@@ -97,13 +102,15 @@ private:
     NetLinkInfo netLinkInfo_;
     NetSupplierInfo netSupplierInfo_;
     NetAllCapabilities netAllCapabilities_;
+    uint32_t netCapsMask_ = 0;
+    uint32_t bearerTypesMask_ = 0;
     uint32_t supplierId_ = 0;
     NetConnState state_ = NET_CONN_STATE_IDLE;
     int32_t netScore_ = 0;
     int32_t netRealScore_ = 0;
     bool ifNetValid_ = false;
-    std::set<uint32_t> requestList_;
-    std::set<uint32_t> bestReqList_;
+    std::unordered_set<uint32_t> requestList_;
+    std::unordered_set<uint32_t> bestReqList_;
     sptr<INetSupplierCallback> netController_ = nullptr;
     sptr<Network> network_ = nullptr;
     sptr<NetHandle> netHandle_ = nullptr;
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef NET_TIMER_WHEEL_H
+#define NET_TIMER_WHEEL_H
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * Hierarchical timer wheel driven by a single thread.
+ *
+ * Schedule and Cancel are O(1). Callbacks run on the wheel thread, outside the wheel lock, and must not block.
+ * A callback may schedule or cancel timers. A delay beyond the reach of the top level is parked there and
+ * placed again each time its slot cascades, until it is in reach.
+ */
+class NetTimerWheel {
+public:
+    using Callback = std::function<void()>;
+    using Clock = std::function<std::chrono::steady_clock::time_point()>;
+    static constexpr uint32_t DEFAULT_TICK_MS = 10;
+
+    static NetTimerWheel &GetInstance();
+
+    /**
+     * @param tickMs Resolution of the wheel
+     * @param clock Time source, std::chrono::steady_clock::now when null
+     */
+    explicit NetTimerWheel(uint32_t tickMs = DEFAULT_TICK_MS, const Clock &clock = nullptr);
+    ~NetTimerWheel();
+    NetTimerWheel(const NetTimerWheel &) = delete;
+    NetTimerWheel &operator=(const NetTimerWheel &) = delete;
+
+    /**
+     * @brief Run a callback once after a delay
+     *
+     * @param delayMs Delay in milliseconds, rounded up to the tick
+     * @param callback The callback
+     * @return Timer id for Cancel, never 0
+     */
+    uint64_t Schedule(uint32_t delayMs, const Callback &callback);
+
+    /**
+     * @brief Cancel a pending timer
+     *
+     * @param timerId Id returned by Schedule
+     * @return Returns false if the timer already fired or is unknown
+     */
+    bool Cancel(uint64_t timerId);
+
+    /**
+     * @brief Spread an interval by up to jitterPercent in both directions
+     *
+     * @param intervalMs The interval
+     * @param jitterPercent Maximum deviation in percent of the interval
+     * @return The jittered interval
+     */
+    static uint32_t Jitter(uint32_t intervalMs, uint32_t jitterPercent);
+
+    /**
+     * @brief Exponential backoff, baseMs doubled per attempt and capped
+     *
+     * @param baseMs Interval of the first attempt
+     * @param attempt Zero based attempt count
+     * @param maxMs Upper bound
+     * @return The backoff interval
+     */
+    static uint32_t Backoff(uint32_t baseMs, uint32_t attempt, uint32_t maxMs);
+
+private:
+    static constexpr uint32_t LEVEL_NUM = 4;
+    static constexpr uint32_t SLOT_BITS = 6;
+    static constexpr uint32_t SLOT_NUM = 1 << SLOT_BITS;
+    static constexpr uint64_t SLOT_MASK = SLOT_NUM - 1;
+    static constexpr uint64_t MAX_DELTA_TICKS = (1ULL << (SLOT_BITS * LEVEL_NUM)) - 1;
+
+    struct TimerNode {
+        uint64_t id;
+        uint64_t expireTick;
+        Callback callback;
+    };
+    using Slot = std::list<TimerNode>;
+    struct Location {
+        Slot *slot;
+        Slot::iterator node;
+    };
+
+    void Run();
+    uint64_t NowTick() const;
+    Slot &SlotFor(uint64_t expireTick);
+    void Place(Slot &from, Slot::iterator node);
+    void Cascade(uint32_t level);
+    void ProcessTick(std::vector<Callback> &expired);
+    uint64_t NextWakeTick() const;
+
+private:
+    std::chrono::milliseconds tick_;
+    Clock clock_;
+    std::chrono::steady_clock::time_point start_;
+    std::array<std::array<Slot, SLOT_NUM>, LEVEL_NUM> wheels_;
+    std::unordered_map<uint64_t, Location> timers_;
+    // Next tick to process
+    uint64_t currentTick_ = 0;
+    uint64_t nextTimerId_ = 1;
+    bool exit_ = false;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::thread thread_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_TIMER_WHEEL_H
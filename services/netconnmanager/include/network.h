@@ -28,10 +28,14 @@ namespace NetManagerStandard {
 constexpr uint32_t INVALID_NET_ID = 0;
 constexpr int32_t MIN_NET_ID = 100;
 constexpr int32_t MAX_NET_ID = 0xFFFF - 0x400;
-using NetDetectionHandler = std::function<void(uint32_t supplierId, bool ifValid)>;
+// Called on the monitor's thread, see NetMonitor
+using NetDetectionHandler = std::function<void(uint32_t supplierId, NetDetectionStatus netDetectionState,
+    const std::string &urlRedirect)>;
+using NetQualityHandler = std::function<void(uint32_t supplierId, bool reachable, int64_t latencyMs)>;
 class Network : public virtual RefBase {
 public:
-    Network(int32_t netId, uint32_t supplierId, NetDetectionHandler handler);
+    Network(int32_t netId, uint32_t supplierId, NetDetectionHandler handler,
+        NetQualityHandler qualityHandler = nullptr);
     ~Network();
     bool operator==(const Network &network) const;
     int32_t GetNetId() const;
@@ -51,23 +55,33 @@ public:
     void ClearDefaultNetWorkNetId();
     void SetExternDetection();
 
+    /**
+     * @brief Take a detection result handed over by the NetDetectionHandler, on the owner's thread
+     *
+     * @param netDetectionState The new state
+     * @param urlRedirect Portal url if any
+     * @param callbacks out param, the detection callbacks to notify, empty if nothing has to be reported
+     * @return Returns true if the result has to be reported
+     */
+    bool HandleNetMonitorResult(NetDetectionStatus netDetectionState, const std::string &urlRedirect,
+        std::vector<sptr<INetDetectionCallback>> &callbacks);
+    static NetDetectionResultCode NetDetectionResultConvert(int32_t internalRet);
+
 private:
     void StopNetDetection();
     bool CreateBasicNetwork();
     bool ReleaseBasicNetwork();
-    void StartDetectionThread();
-    void HandleNetMonitorResult(NetDetectionStatus netDetectionState, const std::string &urlRedirect);
-    void NotifyNetDetectionResult(NetDetectionResultCode detectionResult, const std::string &urlRedirect);
+    void InitNetMonitor();
     int32_t Ipv4PrefixLen(const std::string &ip);
-    NetDetectionResultCode NetDetectionResultConvert(int32_t internalRet);
 
 private:
     int32_t netId_ = 0;
     uint32_t supplierId_ = 0;
     NetLinkInfo netLinkInfo_;
     bool isPhyNetCreated_ = false;
-    std::unique_ptr<NetMonitor> netMonitor_ = nullptr;
+    std::shared_ptr<NetMonitor> netMonitor_ = nullptr;
     NetDetectionHandler  netCallback_;
+    NetQualityHandler netQualityCallback_;
     NetDetectionStatus netDetectionState_;
     std::string urlRedirect_;
     std::vector<sptr<INetDetectionCallback>> netDetectionRetCallback_;
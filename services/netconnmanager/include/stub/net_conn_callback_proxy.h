@@ -34,6 +34,8 @@ public:
     int32_t NetLost(sptr<NetHandle> &netHandle) override;
     int32_t NetUnavailable() override;
     int32_t NetBlockStatusChange(sptr<NetHandle> &netHandle, bool blocked) override;
+    int32_t NetCallbackBatch(const sptr<NetConnCallbackBatch> &batch) override;
+    int32_t NetStateVersionChange(uint64_t version) override;
 private:
     bool WriteInterfaceToken(MessageParcel &data);
 
@@ -62,6 +62,9 @@ private:
     int32_t OnBindSocket(MessageParcel &data, MessageParcel &reply);
     int32_t OnSetAirplaneMode(MessageParcel &data, MessageParcel &reply);
     int32_t OnRestoreFactoryData(MessageParcel &data, MessageParcel &reply);
+    int32_t OnRegisterNetStateCallback(MessageParcel &data, MessageParcel &reply);
+    int32_t OnGetNetStatePage(MessageParcel &data, MessageParcel &reply);
+    int32_t OnUnregisterNetStateCallback(MessageParcel &data, MessageParcel &reply);
 private:
     int32_t ConvertCode(int32_t internalCode);
 
@@ -20,21 +20,17 @@
 #include <cinttypes>
 
 #include "net_mgr_log_wrapper.h"
+#include "net_probe_engine.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
 HttpRequest::HttpRequest()
 {
-    CURLcode errCode = curl_global_init(CURL_GLOBAL_ALL);
-    if (errCode != CURLE_OK) {
-        NETMGR_LOG_E("curl_global_init failed, errCode:[%{public}x]!", errCode);
-    }
+    // libcurl stays initialized for the life of the process, shared with the probe engine.
+    NetProbeEngine::GlobalInit();
 }
 
-HttpRequest::~HttpRequest()
-{
-    curl_global_cleanup();
-}
+HttpRequest::~HttpRequest() {}
 
 void HttpRequest::SetIfaceName(const std::string &ifaceName)
 {
@@ -252,4 +248,4 @@ int32_t HttpRequest::DataCallback(char *data, size_t size, size_t nmemb, std::st
     return writtenLen;
 }
 }  // namespace NetManagerStandard
-}  // namespace OHOS
\ No newline at end of file
+}  // namespace OHOS
@@ -21,7 +21,6 @@
 namespace OHOS {
 namespace NetManagerStandard {
 static std::atomic<uint32_t> g_nextRequestId = MIN_REQUEST_ID;
-using TimeOutCallback = std::function<void()>;
 
 NetActivate::NetActivate(const sptr<NetSpecifier> &specifier, const sptr<INetConnCallback> &callback,
     TimeOutHandler timeOutHandler, const uint32_t &timeoutMS)
@@ -31,53 +30,65 @@ NetActivate::NetActivate(const sptr<NetSpecifier> &specifier, const sptr<INetCon
     if (g_nextRequestId > MAX_REQUEST_ID) {
         g_nextRequestId = MIN_REQUEST_ID;
     }
-    if (timeoutMS > 0) {
-        lpTimer_ = std::make_unique<Timer>();
-        TimeOutCallback timeOutcallback = std::bind(&NetActivate::TimeOutNetAvailable, this);
-        lpTimer_->StartOnce(timeoutMS, timeOutcallback);
+    if (netSpecifier_ != nullptr) {
+        reqCapsMask_ = NetAllCapabilities::ToCapsMask(netSpecifier_->netCapabilities_.netCaps_);
+        reqBearerTypesMask_ = NetAllCapabilities::ToBearerTypesMask(netSpecifier_->netCapabilities_.bearerTypes_);
+    }
+    if (timeoutMS > 0 && timeOutHandler_) {
+        // All request timeouts share the wheel thread. The callback only carries the id, so a request
+        // released before its timeout fires is never touched from the wheel thread.
+        TimeOutHandler handler = timeOutHandler_;
+        uint32_t reqId = requestId_;
+        timerId_ = NetTimerWheel::GetInstance().Schedule(timeoutMS, [handler, reqId]() {
+            uint32_t timeoutReqId = reqId;
+            handler(timeoutReqId);
+        });
     }
 }
 
 NetActivate::~NetActivate()
 {
-    if (lpTimer_) {
-        lpTimer_->Stop();
+    if (timerId_ != 0) {
+        NetTimerWheel::GetInstance().Cancel(timerId_);
     }
 }
 
-void NetActivate::TimeOutNetAvailable()
+bool NetActivate::TimeOutNetAvailable(NetConnCallbackBatcher &batcher)
 {
     if (netServiceSupplied_) {
-        return;
+        return false;
     }
     if (netConnCallback_) {
-        netConnCallback_->NetUnavailable();
-    }
-    if (timeOutHandler_) {
-        timeOutHandler_(requestId_);
+        NetConnCallbackEvent event;
+        event.facets = FACET_UNAVAILABLE;
+        batcher.Enqueue(netConnCallback_, event);
     }
+    return true;
 }
 
 bool NetActivate::MatchRequestAndNetwork(sptr<NetSupplier> supplier)
 {
-    NETMGR_LOG_E("MatchRequestAndNetwork Enter");
     if (supplier == nullptr) {
         NETMGR_LOG_E("supplier is null");
         return false;
     }
+    if (netSpecifier_ == nullptr) {
+        NETMGR_LOG_E("netSpecifier is null");
+        return false;
+    }
     if (!CompareByNetworkIdent(supplier->GetNetSupplierIdent())) {
         NETMGR_LOG_D("supplier ident is not satisfy");
         return false;
     }
-    NetAllCapabilities netAllCaps = supplier->GetNetCapabilities();
-    if (!CompareByNetworkCapabilities(netAllCaps.netCaps_)) {
+    if (!CompareByNetworkCapabilities(supplier->GetNetCapsMask())) {
         NETMGR_LOG_D("supplier capa is not satisfy");
         return false;
     }
-    if (!CompareByNetworkNetType((supplier->GetNetSupplierType()))) {
+    if (!CompareByNetworkNetType(supplier->GetBearerTypesMask())) {
         NETMGR_LOG_D("supplier net type not satisfy");
         return false;
     }
+    const NetAllCapabilities &netAllCaps = supplier->GetNetCapabilities();
     if (!CompareByNetworkBand(netAllCaps.linkUpBandwidthKbps_, netAllCaps.linkDownBandwidthKbps_)) {
         NETMGR_LOG_D("supplier net band not satisfy");
         return false;
@@ -97,36 +108,21 @@ bool NetActivate::CompareByNetworkIdent(const std::string &ident)
     return false;
 }
 
-bool NetActivate::CompareByNetworkCapabilities(const std::set<NetCap> &netCaps)
+bool NetActivate::CompareByNetworkCapabilities(uint32_t netCapsMask) const
 {
     if (netSpecifier_ == nullptr) {
         return false;
     }
-    std::set<NetCap> &reqCaps = netSpecifier_->netCapabilities_.netCaps_;
-    if (reqCaps.empty()) {
-        return true;
-    }
-    for (auto cap : reqCaps) {
-        if (netCaps.find(cap) == netCaps.end()) {
-            return false;
-        }
-    }
-    return true;
+    return (reqCapsMask_ & netCapsMask) == reqCapsMask_;
 }
 
-bool NetActivate::CompareByNetworkNetType(NetBearType bearerType)
+bool NetActivate::CompareByNetworkNetType(uint32_t bearerTypesMask) const
 {
     if (netSpecifier_ == nullptr) {
         return false;
     }
-    std::set<NetBearType> &reqTypes = netSpecifier_->netCapabilities_.bearerTypes_;
-    if (reqTypes.empty()) {
-        return true;
-    }
-    if (reqTypes.find(bearerType) == reqTypes.end()) {
-        return false;
-    }
-    return true;
+    // An empty request set accepts any bearer, otherwise the supplier's bearer must be one of them.
+    return (reqBearerTypesMask_ == 0) || ((reqBearerTypesMask_ & bearerTypesMask) != 0);
 }
 
 bool NetActivate::CompareByNetworkBand(uint32_t netLinkUpBand, uint32_t netLinkDownBand)
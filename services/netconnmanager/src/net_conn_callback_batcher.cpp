@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "net_conn_callback_batcher.h"
+
+#include "net_mgr_log_wrapper.h"
+#include "net_worker_pool.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+NetConnCallbackBatcher::NetConnCallbackBatcher(NetEventLoop &loop, uint32_t windowMs)
+    : loop_(loop), windowMs_(windowMs)
+{
+}
+
+void NetConnCallbackBatcher::Enqueue(const sptr<INetConnCallback> &callback, const NetConnCallbackEvent &event)
+{
+    if (callback == nullptr || event.facets == 0) {
+        return;
+    }
+    if (loop_.IsInLoopThread()) {
+        Add(callback, event);
+        return;
+    }
+    loop_.Post([this, callback, event]() { Add(callback, event); });
+}
+
+void NetConnCallbackBatcher::Add(const sptr<INetConnCallback> &callback, const NetConnCallbackEvent &event)
+{
+    sptr<IRemoteObject> remote = callback->AsObject();
+    IRemoteObject *key = (remote == nullptr) ? nullptr : remote.GetRefPtr();
+    if (key == nullptr) {
+        return;
+    }
+    PendingEvents &pending = pending_[key];
+    if (pending.batch == nullptr) {
+        pending.callback = callback;
+        pending.batch = (std::make_unique<NetConnCallbackBatch>()).release();
+    }
+    pending.batch->Add(event);
+    if (!windowOpen_) {
+        Flush();
+    }
+}
+
+void NetConnCallbackBatcher::Flush()
+{
+    if (pending_.empty()) {
+        windowOpen_ = false;
+        return;
+    }
+    std::map<IRemoteObject *, PendingEvents> pending;
+    pending.swap(pending_);
+    for (auto &client : pending) {
+        Send(client.first, client.second.callback, client.second.batch);
+    }
+    // Events arriving from now on wait for the window, unless the loop is stopping and would not close it.
+    windowOpen_ = loop_.PostDelayed([this]() { Flush(); }, windowMs_);
+}
+
+void NetConnCallbackBatcher::Send(IRemoteObject *key, const sptr<INetConnCallback> &callback,
+    const sptr<NetConnCallbackBatch> &batch)
+{
+    auto send = [callback, batch]() {
+        int32_t ret = callback->NetCallbackBatch(batch);
+        if (ret != ERR_NONE) {
+            NETMGR_LOG_E("NetCallbackBatch failed, event num[%{public}zu] ret[%{public}d]", batch->events_.size(),
+                ret);
+        }
+    };
+    // Clients are served in parallel, batches of one client stay on one worker and keep their order.
+    if (!NetWorkerPool::GetInstance().Post(key, send)) {
+        send();
+    }
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -14,6 +14,8 @@
  */
 #include "net_conn_service.h"
 
+#include <algorithm>
+#include <sys/mman.h>
 #include <sys/time.h>
 
 #include "system_ability_definition.h"
@@ -28,10 +30,10 @@
 #include "net_mgr_log_wrapper.h"
 #include "netmanager_base_permission.h"
 
-static std::mutex NET_CONN_CALLBACK_MUTEX;
-
 namespace OHOS {
 namespace NetManagerStandard {
+// Optional product tuning of the quality weights, see NetScore::LoadWeights
+constexpr const char *SCORE_WEIGHTS_FILE = "/system/etc/net_score_weights.conf";
 const bool REGISTER_LOCAL_RESULT =
     SystemAbility::MakeAndRegisterAbility(DelayedSingleton<NetConnService>::GetInstance().get());
 
@@ -39,9 +41,88 @@ NetConnService::NetConnService()
     : SystemAbility(COMM_NET_CONN_MANAGER_SYS_ABILITY_ID, true), registerToService_(false), state_(STATE_STOPPED)
 {
     CreateDefaultRequest();
+    stateLoop_ = std::make_unique<NetEventLoop>("NetConnState");
+    callbackLoop_ = std::make_unique<NetEventLoop>("NetConnCallback");
+    callbackBatcher_ = std::make_unique<NetConnCallbackBatcher>(*callbackLoop_, CALLBACK_BATCH_WINDOW_MS);
+    netConnCallbacks_.SetDiedHandler([this](const sptr<INetConnCallback> &, uint32_t reqId) {
+        NETMGR_LOG_I("client of request[%{public}u] died", reqId);
+        stateLoop_->Post([this, reqId]() { DeactivateNetwork(reqId); });
+    });
+    CreateStatePage();
+    stateLoop_->Start();
+    callbackLoop_->Start();
+}
+
+NetConnService::~NetConnService()
+{
+    stateLoop_->Stop();
+    callbackLoop_->Stop();
+    if (statePage_ != nullptr) {
+        munmap(statePage_, sizeof(NetConnStatePage));
+        statePage_ = nullptr;
+    }
 }
 
-NetConnService::~NetConnService() {}
+void NetConnService::CreateStatePage()
+{
+    statePageMem_ = Ashmem::CreateAshmem("NetConnStatePage", sizeof(NetConnStatePage));
+    if (statePageMem_ == nullptr) {
+        NETMGR_LOG_E("create state page failed");
+        return;
+    }
+    void *addr = mmap(nullptr, sizeof(NetConnStatePage), PROT_READ | PROT_WRITE, MAP_SHARED,
+        statePageMem_->GetAshmemFd(), 0);
+    if (addr == MAP_FAILED) {
+        NETMGR_LOG_E("map state page failed, errno[%{public}d]", errno);
+        statePageMem_ = nullptr;
+        return;
+    }
+    statePage_ = NetConnStatePage::Create(addr);
+    // Our mapping stays writable, every mapping made by a client from now on is read only
+    if (!statePageMem_->SetProtection(PROT_READ)) {
+        NETMGR_LOG_E("protect state page failed");
+        munmap(addr, sizeof(NetConnStatePage));
+        statePage_ = nullptr;
+        statePageMem_ = nullptr;
+    }
+}
+
+void NetConnService::WriteStatePage(const NetConnSnapshot &snapshot)
+{
+    if (statePage_ == nullptr) {
+        return;
+    }
+    NetStateSummary state;
+    state.version = snapshot.version;
+    state.defaultNetId = snapshot.defaultNetId;
+    auto iter = snapshot.networks.find(snapshot.defaultNetId);
+    if (iter != snapshot.networks.end()) {
+        const NetAllCapabilities &netAllCap = iter->second.netAllCap;
+        state.flags |= STATE_FLAG_DEFAULT_NET;
+        if (netAllCap.netCaps_.count(NET_CAPABILITY_VALIDATED) != 0) {
+            state.flags |= STATE_FLAG_VALIDATED;
+        }
+        if (netAllCap.netCaps_.count(NET_CAPABILITY_NOT_METERED) == 0) {
+            state.flags |= STATE_FLAG_METERED;
+        }
+        state.bearerTypes = NetAllCapabilities::ToBearerTypesMask(netAllCap.bearerTypes_);
+        state.linkUpBandwidthKbps = netAllCap.linkUpBandwidthKbps_;
+        state.linkDownBandwidthKbps = netAllCap.linkDownBandwidthKbps_;
+    }
+    statePage_->Write(state);
+}
+
+int32_t NetConnService::GetNetStatePage(sptr<Ashmem> &page)
+{
+    if (!NetManagerPermission::CheckPermission(Permission::GET_NETWORK_INFO)) {
+        return ERR_PERMISSION_CHECK_FAIL;
+    }
+    if (statePageMem_ == nullptr) {
+        return ERR_SERVICE_NULL_PTR;
+    }
+    page = statePageMem_;
+    return ERR_NONE;
+}
 
 void NetConnService::OnStart()
 {
@@ -67,9 +148,10 @@ void NetConnService::CreateDefaultRequest()
         defaultNetSpecifier_ = (std::make_unique<NetSpecifier>()).release();
         defaultNetSpecifier_->SetCapability(NET_CAPABILITY_INTERNET);
         defaultNetActivate_ = std::make_unique<NetActivate>(defaultNetSpecifier_, nullptr,
-            std::bind(&NetConnService::DeactivateNetwork, this, std::placeholders::_1), 0).release();
+            std::bind(&NetConnService::OnRequestTimeout, this, std::placeholders::_1), 0).release();
         defaultNetActivate_->SetRequestId(DEFAULT_REQUEST_ID);
         netActivates_[DEFAULT_REQUEST_ID] = defaultNetActivate_;
+        netRequestMatcher_.AddRequest(defaultNetActivate_);
     }
     return;
 }
@@ -101,6 +183,7 @@ bool NetConnService::Init()
         NETMGR_LOG_E("Make NetScore failed");
         return false;
     }
+    netScore_->LoadWeights(SCORE_WEIGHTS_FILE);
     return true;
 }
 
@@ -121,7 +204,18 @@ int32_t NetConnService::RegisterNetSupplier(
         NETMGR_LOG_E("netType parameter invalid");
         return ERR_INVALID_NETORK_TYPE;
     }
+    // The caller needs the supplier id back, so this one waits for the state loop.
+    return stateLoop_->Invoke(
+        [this, bearerType, &ident, &netCaps, &supplierId]() {
+            int32_t ret = RegisterNetSupplierInner(bearerType, ident, netCaps, supplierId);
+            PublishSnapshot();
+            return ret;
+        }, static_cast<int32_t>(ERR_SERVICE_STOPPED));
+}
 
+int32_t NetConnService::RegisterNetSupplierInner(
+    NetBearType bearerType, const std::string &ident, const std::set<NetCap> &netCaps, uint32_t &supplierId)
+{
     sptr<NetSupplier> supplier = GetNetSupplierFromList(bearerType, ident, netCaps);
     if (supplier != nullptr) {
         NETMGR_LOG_D("supplier already exists.");
@@ -149,7 +243,8 @@ int32_t NetConnService::RegisterNetSupplier(
     }
     using namespace std::placeholders;
     sptr<Network> network = (std::make_unique<Network>(netId, supplierId,
-        std::bind(&NetConnService::HandleDetectionResult, this, _1, _2))).release();
+        std::bind(&NetConnService::HandleDetectionResult, this, _1, _2, _3),
+        std::bind(&NetConnService::HandleDetectionQuality, this, _1, _2, _3))).release();
     if (network == nullptr) {
         NETMGR_LOG_E("network is nullptr");
         return ERR_NO_NETWORK;
@@ -161,6 +256,7 @@ int32_t NetConnService::RegisterNetSupplier(
     // save supplier
     netSuppliers_[supplierId] = supplier;
     networks_[netId] = network;
+    ReevaluateSupplier(supplier);
 
     NETMGR_LOG_D("RegisterNetSupplier service out. netSuppliers_ size[%{public}zd]", netSuppliers_.size());
     return ERR_NONE;
@@ -183,10 +279,30 @@ int32_t NetConnService::GenerateNetId()
 int32_t NetConnService::UnregisterNetSupplier(uint32_t supplierId)
 {
     NETMGR_LOG_D("UnregisterNetSupplier supplierId[%{public}d]", supplierId);
+    if (!HasSupplier(supplierId)) {
+        NETMGR_LOG_E("supplier[%{public}d] doesn't exist.", supplierId);
+        return ERR_NO_SUPPLIER;
+    }
+    bool posted = stateLoop_->Post([this, supplierId]() {
+        UnregisterNetSupplierInner(supplierId);
+        PublishSnapshot();
+    });
+    return posted ? ERR_NONE : ERR_SERVICE_STOPPED;
+}
+
+bool NetConnService::HasSupplier(uint32_t supplierId) const
+{
+    // Registration publishes before it returns, so a supplier id handed out is always in the snapshot
+    std::shared_ptr<const NetConnSnapshot> snapshot = LoadSnapshot();
+    return snapshot->supplierIds.find(supplierId) != snapshot->supplierIds.end();
+}
+
+int32_t NetConnService::UnregisterNetSupplierInner(uint32_t supplierId)
+{
     // Remove supplier from the list based on supplierId
     NET_SUPPLIER_MAP::iterator iterSupplier = netSuppliers_.find(supplierId);
     if (iterSupplier == netSuppliers_.end()) {
-        NETMGR_LOG_E("supplier doesn't exist.");
+        NETMGR_LOG_E("supplier[%{public}d] doesn't exist.", supplierId);
         return ERR_NO_SUPPLIER;
     }
     NETMGR_LOG_D("unregister supplier[%{public}d, %{public}s], defaultNetSupplier[%{public}d], %{public}s",
@@ -205,7 +321,10 @@ int32_t NetConnService::UnregisterNetSupplier(uint32_t supplierId)
         MakeDefaultNetWork(defaultNetSupplier_, newSupplier);
     }
     netSuppliers_.erase(iterSupplier);
-    FindBestNetworkForAllRequest();
+    netScore_->RemoveSupplier(supplierId);
+    std::vector<uint32_t> affectedReqIds;
+    netRequestMatcher_.RemoveSupplier(supplierId, affectedReqIds);
+    EvaluateRequests(affectedReqIds);
     NETMGR_LOG_D("Destroy supplier network.");
     return ERR_NONE;
 }
@@ -217,15 +336,17 @@ int32_t NetConnService::RegisterNetSupplierCallback(uint32_t supplierId, const s
         NETMGR_LOG_E("The parameter callback is null");
         return ERR_SERVICE_NULL_PTR;
     }
-    std::map<uint32_t, sptr<NetSupplier>>::iterator iterSupplier = netSuppliers_.find(supplierId);
-    if (iterSupplier == netSuppliers_.end()) {
-        NETMGR_LOG_E("supplier doesn't exist.");
-        return ERR_NO_SUPPLIER;
-    }
-    iterSupplier->second->RegisterSupplierCallback(callback);
-    SendAllRequestToNetwork(iterSupplier->second);
-    NETMGR_LOG_D("RegisterNetSupplierCallback service out.");
-    return ERR_NONE;
+    return stateLoop_->Invoke([this, supplierId, &callback]() {
+        NET_SUPPLIER_MAP::iterator iterSupplier = netSuppliers_.find(supplierId);
+        if (iterSupplier == netSuppliers_.end()) {
+            NETMGR_LOG_E("supplier doesn't exist.");
+            return static_cast<int32_t>(ERR_NO_SUPPLIER);
+        }
+        iterSupplier->second->RegisterSupplierCallback(callback);
+        SendAllRequestToNetwork(iterSupplier->second);
+        NETMGR_LOG_D("RegisterNetSupplierCallback service out.");
+        return static_cast<int32_t>(ERR_NONE);
+    }, static_cast<int32_t>(ERR_SERVICE_STOPPED));
 }
 
 int32_t NetConnService::RegisterNetConnCallback(const sptr<INetConnCallback> &callback)
@@ -238,7 +359,9 @@ int32_t NetConnService::RegisterNetConnCallback(const sptr<INetConnCallback> &ca
         NETMGR_LOG_E("The parameter callback is null");
         return ERR_SERVICE_NULL_PTR;
     }
-    return RegisterNetConnCallback(defaultNetSpecifier_, callback, 0);
+    return stateLoop_->Invoke(
+        [this, &callback]() { return RegisterNetConnCallbackInner(defaultNetSpecifier_, callback, 0); },
+        static_cast<int32_t>(ERR_SERVICE_STOPPED));
 }
 
 int32_t NetConnService::RegisterNetConnCallback(
@@ -248,15 +371,23 @@ int32_t NetConnService::RegisterNetConnCallback(
     if (!NetManagerPermission::CheckPermission(Permission::GET_NETWORK_INFO)) {
         return ERR_PERMISSION_CHECK_FAIL;
     }
-    if (netActivates_.size() >= MAX_REQUEST_NUM) {
-        NETMGR_LOG_E("Over the max request number");
-        return ERR_NET_OVER_MAX_REQUEST_NUM;
-    }
     if (netSpecifier == nullptr || callback == nullptr) {
         NETMGR_LOG_E("The parameter of netSpecifier or callback is null");
         return ERR_SERVICE_NULL_PTR;
     }
-    std::lock_guard<std::mutex> lock(NET_CONN_CALLBACK_MUTEX);
+    return stateLoop_->Invoke(
+        [this, &netSpecifier, &callback, &timeoutMS]() {
+            return RegisterNetConnCallbackInner(netSpecifier, callback, timeoutMS);
+        }, static_cast<int32_t>(ERR_SERVICE_STOPPED));
+}
+
+int32_t NetConnService::RegisterNetConnCallbackInner(
+    const sptr<NetSpecifier> &netSpecifier, const sptr<INetConnCallback> &callback, const uint32_t &timeoutMS)
+{
+    if (netActivates_.size() >= MAX_REQUEST_NUM) {
+        NETMGR_LOG_E("Over the max request number");
+        return ERR_NET_OVER_MAX_REQUEST_NUM;
+    }
     uint32_t reqId = 0;
     if (FindSameCallback(callback, reqId)) {
         NETMGR_LOG_D("RegisterNetConnCallback FindSameCallback(callback, reqId)");
@@ -275,65 +406,38 @@ int32_t NetConnService::UnregisterNetConnCallback(const sptr<INetConnCallback> &
         NETMGR_LOG_E("callback is null");
         return ERR_SERVICE_NULL_PTR;
     }
+    return stateLoop_->Invoke([this, &callback]() { return UnregisterNetConnCallbackInner(callback); },
+        static_cast<int32_t>(ERR_SERVICE_STOPPED));
+}
+
+int32_t NetConnService::UnregisterNetConnCallbackInner(const sptr<INetConnCallback> &callback)
+{
     uint32_t reqId = 0;
-    std::lock_guard<std::mutex> lock(NET_CONN_CALLBACK_MUTEX);
     if (!FindSameCallback(callback, reqId)) {
         NETMGR_LOG_D("UnregisterNetConnCallback FindSameCallback(callback, reqId)");
         return ERR_UNREGISTER_CALLBACK_NOT_FOUND;
     }
     deleteNetActivates_.clear();
+    return DeactivateNetwork(reqId);
+}
 
-    NET_ACTIVATE_MAP::iterator iterActive;
-    for (iterActive = netActivates_.begin(); iterActive != netActivates_.end();) {
-        if (!iterActive->second) {
-            ++iterActive;
-            continue;
-        }
-        sptr<INetConnCallback> saveCallback = iterActive->second->GetNetCallback();
-        if (saveCallback == nullptr) {
-            ++iterActive;
-            continue;
-        }
-        if (callback->AsObject().GetRefPtr() != saveCallback->AsObject().GetRefPtr()) {
-            ++iterActive;
-            continue;
-        }
-        reqId = iterActive->first;
-        sptr<NetActivate> netActivate = iterActive->second;
-        if (netActivate) {
-            sptr<NetSupplier> supplier = netActivate->GetServiceSupply();
-            if (supplier) {
-                supplier->CancelRequest(reqId);
-            }
-        }
+bool NetConnService::FindSameCallback(const sptr<INetConnCallback> &callback, uint32_t &reqId)
+{
+    return netConnCallbacks_.Find(callback, reqId);
+}
 
-        NET_SUPPLIER_MAP::iterator iterSupplier;
-        for (iterSupplier = netSuppliers_.begin(); iterSupplier != netSuppliers_.end(); ++iterSupplier) {
-            iterSupplier->second->CancelRequest(reqId);
-        }
-        deleteNetActivates_[reqId] = netActivate;
-        iterActive = netActivates_.erase(iterActive);
-    }
-    return ERR_NONE;
+void NetConnService::TrackRequestHolder(const sptr<NetSupplier> &supplier, uint32_t reqId)
+{
+    netRequestMatcher_.AddHolder(reqId, supplier->GetSupplierId());
 }
 
-bool NetConnService::FindSameCallback(const sptr<INetConnCallback> &callback, uint32_t &reqId)
+void NetConnService::CancelRequestOnHolders(uint32_t reqId)
 {
-    NET_ACTIVATE_MAP::iterator iterActive;
-    for (iterActive = netActivates_.begin(); iterActive != netActivates_.end(); ++iterActive) {
-        if (!iterActive->second) {
-            continue;
-        }
-        sptr<INetConnCallback> saveCallback = iterActive->second->GetNetCallback();
-        if (saveCallback == nullptr) {
-            continue;
-        }
-        if (callback->AsObject().GetRefPtr() == saveCallback->AsObject().GetRefPtr()) {
-            reqId = iterActive->first;
-            return true;
-        }
+    std::vector<sptr<NetSupplier>> holders;
+    netRequestMatcher_.GetHolders(reqId, holders, holders);
+    for (auto &supplier : holders) {
+        supplier->CancelRequest(reqId);
     }
-    return false;
 }
 
 int32_t NetConnService::UpdateNetStateForTest(const sptr<NetSpecifier> &netSpecifier, int32_t netState)
@@ -348,13 +452,24 @@ int32_t NetConnService::UpdateNetStateForTest(const sptr<NetSpecifier> &netSpeci
 
 int32_t NetConnService::UpdateNetSupplierInfo(uint32_t supplierId, const sptr<NetSupplierInfo> &netSupplierInfo)
 {
-    NETMGR_LOG_D("Update supplier info: supplierId[%{public}d], netSuppliers_ size[%{public}zd]", supplierId,
-        netSuppliers_.size());
+    NETMGR_LOG_D("Update supplier info: supplierId[%{public}d]", supplierId);
     if (netSupplierInfo == nullptr) {
         NETMGR_LOG_E("netSupplierInfo is nullptr");
         return ERR_INVALID_PARAMS;
     }
+    if (!HasSupplier(supplierId)) {
+        NETMGR_LOG_E("supplier[%{public}d] doesn't exist.", supplierId);
+        return ERR_NO_SUPPLIER;
+    }
+    bool posted = stateLoop_->Post([this, supplierId, netSupplierInfo]() {
+        UpdateNetSupplierInfoInner(supplierId, netSupplierInfo);
+        PublishSnapshot();
+    });
+    return posted ? ERR_NONE : ERR_SERVICE_STOPPED;
+}
 
+int32_t NetConnService::UpdateNetSupplierInfoInner(uint32_t supplierId, const sptr<NetSupplierInfo> &netSupplierInfo)
+{
     NETMGR_LOG_D("Update supplier info: netSupplierInfo[%{public}s]", netSupplierInfo->ToString("").c_str());
 
     // According to supplierId, get the supplier from the list
@@ -374,7 +489,7 @@ int32_t NetConnService::UpdateNetSupplierInfo(uint32_t supplierId, const sptr<Ne
     if (!netScore_->GetServiceScore(iterSupplier->second)) {
         NETMGR_LOG_E("GetServiceScore fail.");
     }
-    FindBestNetworkForAllRequest();
+    ReevaluateSupplier(iterSupplier->second);
     NETMGR_LOG_D("UpdateNetSupplierInfo service out.");
     return ERR_NONE;
 }
@@ -382,10 +497,25 @@ int32_t NetConnService::UpdateNetSupplierInfo(uint32_t supplierId, const sptr<Ne
 int32_t NetConnService::RestrictBackgroundChanged(bool restrictBackground)
 {
     NETMGR_LOG_D("NetConnService::RestrictBackgroundChanged restrictBackground = %{public}d", restrictBackground);
+    // Called by the policy service, possibly while it holds its own lock; never wait for the state loop here.
+    std::shared_ptr<const NetConnSnapshot> snapshot = LoadSnapshot();
+    if (!snapshot->supplierIds.empty() && snapshot->restrictBackground == restrictBackground) {
+        NETMGR_LOG_D("restrict background is already %{public}d", restrictBackground);
+        return ERR_NET_NO_RESTRICT_BACKGROUND;
+    }
+    stateLoop_->Post([this, restrictBackground]() {
+        RestrictBackgroundChangedInner(restrictBackground);
+        PublishSnapshot();
+    });
+    return ERR_NONE;
+}
+
+void NetConnService::RestrictBackgroundChangedInner(bool restrictBackground)
+{
     for (auto it = netSuppliers_.begin(); it != netSuppliers_.end(); ++it) {
         if (it->second->GetRestrictBackground() == restrictBackground) {
             NETMGR_LOG_D("it->second->GetRestrictBackground() == restrictBackground");
-            return ERR_NET_NO_RESTRICT_BACKGROUND;
+            return;
         }
 
         if (it->second->GetNetSupplierType() == BEARER_VPN) {
@@ -394,7 +524,6 @@ int32_t NetConnService::RestrictBackgroundChanged(bool restrictBackground)
         it->second->SetRestrictBackground(restrictBackground);
     }
     NETMGR_LOG_D("RestrictBackgroundChanged service out.");
-    return ERR_NONE;
 }
 
 int32_t NetConnService::UpdateNetLinkInfo(uint32_t supplierId, const sptr<NetLinkInfo> &netLinkInfo)
@@ -404,7 +533,20 @@ int32_t NetConnService::UpdateNetLinkInfo(uint32_t supplierId, const sptr<NetLin
         NETMGR_LOG_E("netLinkInfo is nullptr");
         return ERR_INVALID_PARAMS;
     }
+    if (!HasSupplier(supplierId)) {
+        NETMGR_LOG_E("supplier[%{public}d] doesn't exist.", supplierId);
+        return ERR_NO_SUPPLIER;
+    }
+    // A netsys failure while applying the link is only logged, the caller does not wait for it
+    bool posted = stateLoop_->Post([this, supplierId, netLinkInfo]() {
+        UpdateNetLinkInfoInner(supplierId, netLinkInfo);
+        PublishSnapshot();
+    });
+    return posted ? ERR_NONE : ERR_SERVICE_STOPPED;
+}
 
+int32_t NetConnService::UpdateNetLinkInfoInner(uint32_t supplierId, const sptr<NetLinkInfo> &netLinkInfo)
+{
     NET_SUPPLIER_MAP::iterator iterSupplier = netSuppliers_.find(supplierId);
     if ((iterSupplier == netSuppliers_.end()) || (iterSupplier->second == nullptr)) {
         NETMGR_LOG_E("supplier is nullptr");
@@ -419,7 +561,7 @@ int32_t NetConnService::UpdateNetLinkInfo(uint32_t supplierId, const sptr<NetLin
     if (!netScore_->GetServiceScore(iterSupplier->second)) {
         NETMGR_LOG_E("GetServiceScore fail.");
     }
-    FindBestNetworkForAllRequest();
+    ReevaluateSupplier(iterSupplier->second);
     NETMGR_LOG_D("UpdateNetLinkInfo service out.");
     return ERR_NONE;
 }
@@ -443,21 +585,16 @@ int32_t NetConnService::NetDetection(int32_t netId)
         !NetManagerPermission::CheckPermission(Permission::INTERNET)) {
         return ERR_PERMISSION_CHECK_FAIL;
     }
-    sptr<Network> dectionNetwork = nullptr;
-    NET_NETWORK_MAP::iterator iterNetwork = networks_.find(netId);
-    if ((iterNetwork == networks_.end()) || (iterNetwork->second == nullptr)) {
-        NETMGR_LOG_E("Could not find the corresponding network.");
-    } else {
-        dectionNetwork = iterNetwork->second;
-    }
-
-    if (dectionNetwork == nullptr) {
-        NETMGR_LOG_E("Network is not find, need register!");
-        return ERR_NET_NOT_FIND_NETID;
-    }
-    dectionNetwork->SetExternDetection();
-    dectionNetwork->StartNetDetection();
-    return ERR_NONE;
+    return stateLoop_->Invoke([this, netId]() {
+        NET_NETWORK_MAP::iterator iterNetwork = networks_.find(netId);
+        if ((iterNetwork == networks_.end()) || (iterNetwork->second == nullptr)) {
+            NETMGR_LOG_E("Network is not find, need register!");
+            return static_cast<int32_t>(ERR_NET_NOT_FIND_NETID);
+        }
+        iterNetwork->second->SetExternDetection();
+        iterNetwork->second->StartNetDetection();
+        return static_cast<int32_t>(ERR_NONE);
+    }, static_cast<int32_t>(ERR_SERVICE_STOPPED));
 }
 
 int32_t NetConnService::RegUnRegNetDetectionCallback(
@@ -468,24 +605,19 @@ int32_t NetConnService::RegUnRegNetDetectionCallback(
         return ERR_SERVICE_NULL_PTR;
     }
 
-    sptr<Network> dectionNetwork = nullptr;
-    NET_NETWORK_MAP::iterator iterNetwork = networks_.find(netId);
-    if ((iterNetwork == networks_.end()) || (iterNetwork->second == nullptr)) {
-        NETMGR_LOG_E("Could not find the corresponding network.");
-    } else {
-        dectionNetwork = iterNetwork->second;
-    }
-
-    if (dectionNetwork == nullptr) {
-        NETMGR_LOG_E("Network is not find, need register!");
-        return ERR_NET_NOT_FIND_NETID;
-    }
-    if (isReg) {
-        dectionNetwork->RegisterNetDetectionCallback(callback);
-        return ERR_NONE;
-    } else {
-        return dectionNetwork->UnRegisterNetDetectionCallback(callback);
-    }
+    // The callback list is read on the state loop when a result comes in, so it is only changed there as well.
+    return stateLoop_->Invoke([this, netId, callback, isReg]() {
+        NET_NETWORK_MAP::iterator iterNetwork = networks_.find(netId);
+        if ((iterNetwork == networks_.end()) || (iterNetwork->second == nullptr)) {
+            NETMGR_LOG_E("Network is not find, need register!");
+            return static_cast<int32_t>(ERR_NET_NOT_FIND_NETID);
+        }
+        if (isReg) {
+            iterNetwork->second->RegisterNetDetectionCallback(callback);
+            return static_cast<int32_t>(ERR_NONE);
+        }
+        return iterNetwork->second->UnRegisterNetDetectionCallback(callback);
+    }, static_cast<int32_t>(ERR_SERVICE_STOPPED));
 }
 
 sptr<NetSupplier> NetConnService::GetNetSupplierFromList(NetBearType bearerType, const std::string &ident)
@@ -521,16 +653,24 @@ int32_t NetConnService::ActivateNetwork(const sptr<NetSpecifier> &netSpecifier,
         NETMGR_LOG_E("The parameter of netSpecifier or callback is null");
         return ERR_INVALID_PARAMS;
     }
+    // The request is matched by masks, an unknown capability or bearer type would silently drop out of them
+    if (!netSpecifier->netCapabilities_.CapsIsValid()) {
+        NETMGR_LOG_E("Unknown capability or bearer type in the request");
+        return ERR_INVALID_PARAMS;
+    }
     sptr<NetActivate> request = (std::make_unique<NetActivate>(netSpecifier, callback,
-        std::bind(&NetConnService::DeactivateNetwork, this, std::placeholders::_1), timeoutMS)).release();
+        std::bind(&NetConnService::OnRequestTimeout, this, std::placeholders::_1), timeoutMS)).release();
     uint32_t reqId = request->GetRequestId();
     NETMGR_LOG_D("ActivateNetwork  reqId is [%{public}d]", reqId);
     netActivates_[reqId] = request;
-    sptr<NetSupplier> bestNet = nullptr;
-    int bestscore = static_cast<int>(FindBestNetworkForRequest(bestNet, request));
+    netConnCallbacks_.Add(callback, reqId);
+    netRequestMatcher_.AddRequest(request);
+    int32_t bestscore = 0;
+    sptr<NetSupplier> bestNet = netRequestMatcher_.GetBestSupplier(reqId, bestscore);
     if (bestscore != 0 && bestNet != nullptr) {
         NETMGR_LOG_D("The bestscore is: [%{public}d]", bestscore);
         bestNet->SelectAsBestNetwork(reqId);
+        TrackRequestHolder(bestNet, reqId);
         request->SetServiceSupply(bestNet);
         CallbackForAvailable(bestNet, callback);
         return ERR_NONE;
@@ -542,6 +682,22 @@ int32_t NetConnService::ActivateNetwork(const sptr<NetSpecifier> &netSpecifier,
     return ERR_NONE;
 }
 
+int32_t NetConnService::OnRequestTimeout(uint32_t &reqId)
+{
+    // Runs on the shared timer wheel thread, hand the request over to the state loop.
+    uint32_t timeoutReqId = reqId;
+    stateLoop_->Post([this, timeoutReqId]() {
+        NET_ACTIVATE_MAP::iterator iter = netActivates_.find(timeoutReqId);
+        if (iter == netActivates_.end() || iter->second == nullptr) {
+            return;
+        }
+        if (iter->second->TimeOutNetAvailable(*callbackBatcher_)) {
+            DeactivateNetwork(timeoutReqId);
+        }
+    });
+    return ERR_NONE;
+}
+
 int32_t NetConnService::DeactivateNetwork(uint32_t reqId)
 {
     NETMGR_LOG_D("DeactivateNetwork Enter, reqId is [%{public}d]", reqId);
@@ -556,12 +712,13 @@ int32_t NetConnService::DeactivateNetwork(uint32_t reqId)
         if (pNetService) {
             pNetService->CancelRequest(reqId);
         }
+        sptr<INetConnCallback> callback = pNetActivate->GetNetCallback();
+        if (callback != nullptr) {
+            netConnCallbacks_.Remove(callback);
+        }
     }
-
-    NET_SUPPLIER_MAP::iterator iterSupplier;
-    for (iterSupplier = netSuppliers_.begin(); iterSupplier != netSuppliers_.end(); ++iterSupplier) {
-        iterSupplier->second->CancelRequest(reqId);
-    }
+    CancelRequestOnHolders(reqId);
+    netRequestMatcher_.RemoveRequest(reqId);
     deleteNetActivates_[reqId] = pNetActivate;
     netActivates_.erase(iterActivate);
     return ERR_NONE;
@@ -573,12 +730,12 @@ int32_t NetConnService::GetDefaultNet(int32_t &netId)
     if (!NetManagerPermission::CheckPermission(Permission::GET_NETWORK_INFO)) {
         return ERR_PERMISSION_CHECK_FAIL;
     }
-    if (!defaultNetSupplier_) {
+    std::shared_ptr<const NetConnSnapshot> snapshot = LoadSnapshot();
+    if (snapshot->defaultNetId == INVALID_NET_ID) {
         NETMGR_LOG_E("not found the netId");
         return ERR_NET_DEFAULTNET_NOT_EXIST;
     }
-
-    netId = defaultNetSupplier_->GetNetId();
+    netId = snapshot->defaultNetId;
     NETMGR_LOG_D("found the netId: [%{public}d]", netId);
     return ERR_NONE;
 }
@@ -589,11 +746,127 @@ int32_t NetConnService::HasDefaultNet(bool &flag)
     if (!NetManagerPermission::CheckPermission(Permission::GET_NETWORK_INFO)) {
         return ERR_PERMISSION_CHECK_FAIL;
     }
-    if (!defaultNetSupplier_) {
-        flag = false;
-        return ERR_NET_DEFAULTNET_NOT_EXIST;
+    flag = LoadSnapshot()->defaultNetId != INVALID_NET_ID;
+    return flag ? ERR_NONE : ERR_NET_DEFAULTNET_NOT_EXIST;
+}
+
+std::shared_ptr<const NetConnService::NetConnSnapshot> NetConnService::LoadSnapshot() const
+{
+    return std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+}
+
+bool NetConnService::SameState(const NetConnSnapshot &lhs, const NetConnSnapshot &rhs)
+{
+    auto sameEntry = [](const std::pair<const int32_t, NetConnSnapshot::Entry> &left,
+        const std::pair<const int32_t, NetConnSnapshot::Entry> &right) {
+        return left.first == right.first && left.second.bearerType == right.second.bearerType &&
+            left.second.ident == right.second.ident && left.second.uid == right.second.uid &&
+            left.second.linkInfo == right.second.linkInfo && left.second.netAllCap == right.second.netAllCap;
+    };
+    return lhs.defaultNetId == rhs.defaultNetId && lhs.restrictBackground == rhs.restrictBackground &&
+        lhs.supplierIds == rhs.supplierIds && lhs.networks.size() == rhs.networks.size() &&
+        std::equal(lhs.networks.begin(), lhs.networks.end(), rhs.networks.begin(), sameEntry);
+}
+
+void NetConnService::PublishSnapshot()
+{
+    auto snapshot = std::make_shared<NetConnSnapshot>();
+    std::shared_ptr<const NetConnSnapshot> last = LoadSnapshot();
+    if (defaultNetSupplier_ != nullptr) {
+        snapshot->defaultNetId = defaultNetSupplier_->GetNetId();
+    }
+    if (!netSuppliers_.empty() && netSuppliers_.begin()->second != nullptr) {
+        snapshot->restrictBackground = netSuppliers_.begin()->second->GetRestrictBackground();
+    }
+    for (auto &item : netSuppliers_) {
+        const sptr<NetSupplier> &supplier = item.second;
+        snapshot->supplierIds.insert(item.first);
+        sptr<Network> network = (supplier == nullptr) ? nullptr : supplier->GetNetwork();
+        if (network == nullptr) {
+            continue;
+        }
+        NetConnSnapshot::Entry &entry = snapshot->networks[network->GetNetId()];
+        entry.bearerType = supplier->GetNetSupplierType();
+        entry.ident = supplier->GetNetSupplierIdent();
+        entry.uid = supplier->GetSupplierUid();
+        entry.linkInfo = network->GetNetLinkInfo();
+        entry.netAllCap = supplier->GetNetCapabilities();
+    }
+    // Rebuilt after every state loop task, only a real change moves the version and notifies the clients
+    if (SameState(*last, *snapshot)) {
+        return;
+    }
+    snapshot->version = last->version + 1;
+    uint64_t version = snapshot->version;
+    WriteStatePage(*snapshot);
+    std::shared_ptr<const NetConnSnapshot> current(std::move(snapshot));
+    std::atomic_store_explicit(&snapshot_, current, std::memory_order_release);
+    ReportIfaceLinks(*last, *current);
+    netStateCallbacks_.Notify(
+        [version](const sptr<INetConnCallback> &callback) { callback->NetStateVersionChange(version); });
+}
+
+void NetConnService::ReportIfaceLinks(const NetConnSnapshot &last, const NetConnSnapshot &current)
+{
+    // Only the difference, the policy service keeps its own interface table
+    auto sameLink = [](const NetConnSnapshot::Entry &lhs, const NetConnSnapshot::Entry &rhs) {
+        return lhs.bearerType == rhs.bearerType && lhs.ident == rhs.ident &&
+            lhs.linkInfo.ifaceName_ == rhs.linkInfo.ifaceName_;
+    };
+    for (const auto &item : last.networks) {
+        const NetConnSnapshot::Entry &entry = item.second;
+        auto it = current.networks.find(item.first);
+        if (!entry.linkInfo.ifaceName_.empty() && (it == current.networks.end() || !sameLink(entry, it->second))) {
+            NetManagerCenter::GetInstance().IfaceLinkChanged(entry.bearerType, entry.ident,
+                entry.linkInfo.ifaceName_, false);
+        }
+    }
+    for (const auto &item : current.networks) {
+        const NetConnSnapshot::Entry &entry = item.second;
+        auto it = last.networks.find(item.first);
+        if (!entry.linkInfo.ifaceName_.empty() && (it == last.networks.end() || !sameLink(entry, it->second))) {
+            NetManagerCenter::GetInstance().IfaceLinkChanged(entry.bearerType, entry.ident,
+                entry.linkInfo.ifaceName_, true);
+        }
+    }
+}
+
+int32_t NetConnService::ReplayIfaceLinks()
+{
+    // Called by the policy service while it registers; never wait for the state loop here.
+    stateLoop_->Post([this]() { ReportIfaceLinks(NetConnSnapshot(), *LoadSnapshot()); });
+    return ERR_NONE;
+}
+
+int32_t NetConnService::RegisterNetStateCallback(const sptr<INetConnCallback> &callback, uint64_t &version)
+{
+    if (!NetManagerPermission::CheckPermission(Permission::GET_NETWORK_INFO)) {
+        return ERR_PERMISSION_CHECK_FAIL;
+    }
+    if (callback == nullptr) {
+        NETMGR_LOG_E("callback is nullptr");
+        return ERR_INVALID_PARAMS;
+    }
+    // Added before the version is read, so a change racing with the registration is reported rather than lost.
+    // Registering the same callback again is not an error, the client re-subscribes after a service restart.
+    netStateCallbacks_.Add(callback);
+    version = LoadSnapshot()->version;
+    return ERR_NONE;
+}
+
+int32_t NetConnService::UnregisterNetStateCallback(const sptr<INetConnCallback> &callback)
+{
+    if (!NetManagerPermission::CheckPermission(Permission::GET_NETWORK_INFO)) {
+        return ERR_PERMISSION_CHECK_FAIL;
+    }
+    if (callback == nullptr) {
+        NETMGR_LOG_E("callback is nullptr");
+        return ERR_INVALID_PARAMS;
+    }
+    // A client that dies without unregistering is dropped by netStateCallbacks_ itself
+    if (!netStateCallbacks_.Remove(callback)) {
+        return ERR_UNREGISTER_CALLBACK_NOT_FOUND;
     }
-    flag = true;
     return ERR_NONE;
 }
 
@@ -656,14 +929,13 @@ int32_t NetConnService::GetSpecificNet(NetBearType bearerType, std::list<int32_t
         return ERR_INVALID_NETORK_TYPE;
     }
 
-    NET_SUPPLIER_MAP::iterator iterSupplier;
-    for (iterSupplier = netSuppliers_.begin(); iterSupplier != netSuppliers_.end(); ++iterSupplier) {
-        auto supplierType = iterSupplier->second->GetNetSupplierType();
-        if (bearerType == supplierType) {
-            netIdList.push_back(iterSupplier->second->GetNetId());
+    std::shared_ptr<const NetConnSnapshot> snapshot = LoadSnapshot();
+    for (auto &item : snapshot->networks) {
+        if (item.second.bearerType == bearerType) {
+            netIdList.push_back(item.first);
         }
     }
-    NETMGR_LOG_D("netSuppliers_ size[%{public}zd] networks_ size[%{public}zd]", netSuppliers_.size(), networks_.size());
+    NETMGR_LOG_D("networks size[%{public}zd]", snapshot->networks.size());
     return ERR_NONE;
 }
 
@@ -672,10 +944,11 @@ int32_t NetConnService::GetAllNets(std::list<int32_t> &netIdList)
     if (!NetManagerPermission::CheckPermission(Permission::GET_NETWORK_INFO)) {
         return ERR_PERMISSION_CHECK_FAIL;
     }
-    for (auto p = networks_.begin(); p != networks_.end(); ++p) {
-        netIdList.push_back(p->second->GetNetId());
+    std::shared_ptr<const NetConnSnapshot> snapshot = LoadSnapshot();
+    for (auto &item : snapshot->networks) {
+        netIdList.push_back(item.first);
     }
-    NETMGR_LOG_D("netSuppliers_ size[%{public}zd] networks_ size[%{public}zd]", netSuppliers_.size(), networks_.size());
+    NETMGR_LOG_D("networks size[%{public}zd]", snapshot->networks.size());
     return ERR_NONE;
 }
 
@@ -684,13 +957,10 @@ int32_t NetConnService::GetSpecificUidNet(int32_t uid, int32_t &netId)
     NETMGR_LOG_D("Enter GetSpecificUidNet.");
     NETMGR_LOG_D("uid is [%{public}d].", uid);
     netId = INVALID_NET_ID;
-    NET_SUPPLIER_MAP::iterator iterSupplier;
-    for (iterSupplier = netSuppliers_.begin(); iterSupplier != netSuppliers_.end(); ++iterSupplier) {
-        NETMGR_LOG_D("uid is [%{public}d].", iterSupplier->second->GetSupplierUid());
-        NETMGR_LOG_D("type is [%{public}d].", static_cast<int32_t>(iterSupplier->second->GetNetSupplierType()));
-        if ((uid == iterSupplier->second->GetSupplierUid()) &&
-            (iterSupplier->second->GetNetSupplierType() == BEARER_VPN)) {
-            netId = iterSupplier->second->GetNetId();
+    std::shared_ptr<const NetConnSnapshot> snapshot = LoadSnapshot();
+    for (auto &item : snapshot->networks) {
+        if ((uid == item.second.uid) && (item.second.bearerType == BEARER_VPN)) {
+            netId = item.first;
             return ERR_NONE;
         }
     }
@@ -703,12 +973,12 @@ int32_t NetConnService::GetConnectionProperties(int32_t netId, NetLinkInfo &info
     if (!NetManagerPermission::CheckPermission(Permission::GET_NETWORK_INFO)) {
         return ERR_PERMISSION_CHECK_FAIL;
     }
-    NET_NETWORK_MAP::iterator iterNetwork = networks_.find(netId);
-    if ((iterNetwork == networks_.end()) || (iterNetwork->second == nullptr)) {
+    std::shared_ptr<const NetConnSnapshot> snapshot = LoadSnapshot();
+    auto iter = snapshot->networks.find(netId);
+    if (iter == snapshot->networks.end()) {
         return ERR_NO_NETWORK;
     }
-
-    info = iterNetwork->second->GetNetLinkInfo();
+    info = iter->second.linkInfo;
     return ERR_NONE;
 }
 
@@ -718,15 +988,14 @@ int32_t NetConnService::GetNetCapabilities(int32_t netId, NetAllCapabilities &ne
     if (!NetManagerPermission::CheckPermission(Permission::GET_NETWORK_INFO)) {
         return ERR_PERMISSION_CHECK_FAIL;
     }
-    NET_SUPPLIER_MAP::iterator iterSupplier;
-    for (iterSupplier = netSuppliers_.begin(); iterSupplier != netSuppliers_.end(); ++iterSupplier) {
-        if (netId == iterSupplier->second->GetNetId()) {
-            netAllCap = iterSupplier->second->GetNetCapabilities();
-            return ERR_NONE;
-        }
+    std::shared_ptr<const NetConnSnapshot> snapshot = LoadSnapshot();
+    auto iter = snapshot->networks.find(netId);
+    if (iter == snapshot->networks.end()) {
+        NETMGR_LOG_E("no network.");
+        return ERR_NO_NETWORK;
     }
-    NETMGR_LOG_E("no network.");
-    return ERR_NO_NETWORK;
+    netAllCap = iter->second.netAllCap;
+    return ERR_NONE;
 }
 
 int32_t NetConnService::BindSocket(int32_t socket_fd, int32_t netId)
@@ -741,89 +1010,80 @@ void NetConnService::NotFindBestSupplier(uint32_t reqId, const sptr<NetActivate>
     if (supplier != nullptr) {
         supplier->RemoveBestRequest(reqId);
         if (callback != nullptr) {
-            sptr<NetHandle> netHandle = supplier->GetNetHandle();
-            callback->NetLost(netHandle);
+            NetConnCallbackEvent event;
+            event.netId = supplier->GetNetId();
+            event.facets = FACET_LOST;
+            callbackBatcher_->Enqueue(callback, event);
         }
     }
     active->SetServiceSupply(nullptr);
     SendRequestToAllNetwork(active);
 }
 
-void NetConnService::FindBestNetworkForAllRequest()
+void NetConnService::ReevaluateSupplier(const sptr<NetSupplier> &supplier)
 {
-    NETMGR_LOG_D("FindBestNetworkForAllRequest Enter");
-    NET_ACTIVATE_MAP::iterator iterActive;
-    sptr<NetSupplier> bestSupplier = nullptr;
-    for (iterActive = netActivates_.begin(); iterActive != netActivates_.end(); ++iterActive) {
-        if (!iterActive->second) {
-            continue;
-        }
-        int score = static_cast<int>(FindBestNetworkForRequest(bestSupplier, iterActive->second));
-        NETMGR_LOG_D("bestSupplier is: [%{public}d, %{public}s]", bestSupplier ? bestSupplier->GetSupplierId() : 0,
-            bestSupplier ? bestSupplier->GetNetSupplierIdent().c_str() : "null");
-        if (iterActive->second == defaultNetActivate_) {
-            MakeDefaultNetWork(defaultNetSupplier_, bestSupplier);
-        }
-        sptr<NetSupplier> oldSupplier = iterActive->second->GetServiceSupply();
-        sptr<INetConnCallback> callback = iterActive->second->GetNetCallback();
-        if (!bestSupplier) {
-            // not found the bestNetwork
-            NotFindBestSupplier(iterActive->first, iterActive->second, oldSupplier, callback);
-            continue;
-        }
+    std::vector<uint32_t> affectedReqIds;
+    netRequestMatcher_.UpdateSupplier(supplier, affectedReqIds);
+    EvaluateRequests(affectedReqIds);
+}
 
-        SendBestScoreAllNetwork(iterActive->first, score, bestSupplier->GetSupplierId());
-        if (bestSupplier == oldSupplier) {
+void NetConnService::EvaluateRequests(const std::vector<uint32_t> &reqIds)
+{
+    NETMGR_LOG_D("EvaluateRequests, affected request num[%{public}zu]", reqIds.size());
+    for (uint32_t reqId : reqIds) {
+        NET_ACTIVATE_MAP::iterator iterActive = netActivates_.find(reqId);
+        if ((iterActive == netActivates_.end()) || (!iterActive->second)) {
             continue;
         }
-        if (oldSupplier) {
-            oldSupplier->RemoveBestRequest(iterActive->first);
-        }
-        iterActive->second->SetServiceSupply(bestSupplier);
-        CallbackForAvailable(bestSupplier, callback);
-        bestSupplier->SelectAsBestNetwork(iterActive->first);
+        EvaluateRequest(iterActive->second);
     }
 }
 
-uint32_t NetConnService::FindBestNetworkForRequest(sptr<NetSupplier> &supplier, sptr<NetActivate> &netActivateNetwork)
+void NetConnService::EvaluateRequest(const sptr<NetActivate> &request)
 {
-    NETMGR_LOG_E("FindBestNetworkForRequest Enter");
-    int bestScore = 0;
-    NET_SUPPLIER_MAP::iterator iter;
-    for (iter = netSuppliers_.begin(); iter != netSuppliers_.end(); ++iter) {
-        NETMGR_LOG_I("supplier info, supplier[%{public}d, %{public}s], realScore[%{public}d], isConnected[%{public}d]",
-            iter->second->GetSupplierId(), iter->second->GetNetSupplierIdent().c_str(),
-            iter->second->GetRealScore(), iter->second->IsConnected());
-        if ((!netActivateNetwork->MatchRequestAndNetwork(iter->second)) || (!iter->second->IsConnected())) {
-            NETMGR_LOG_D("supplier[%{public}d] is not connected or not match request.", iter->second->GetSupplierId());
-            continue;
-        }
-        int score = iter->second->GetRealScore();
-        NETMGR_LOG_D("score : [%{public}d]", score);
-        if (score > bestScore) {
-            bestScore = score;
-            supplier = iter->second;
-        }
+    uint32_t reqId = request->GetRequestId();
+    int32_t score = 0;
+    sptr<NetSupplier> bestSupplier = netRequestMatcher_.GetBestSupplier(reqId, score);
+    NETMGR_LOG_D("request[%{public}u] bestSupplier is: [%{public}d, %{public}s]", reqId,
+        bestSupplier ? bestSupplier->GetSupplierId() : 0,
+        bestSupplier ? bestSupplier->GetNetSupplierIdent().c_str() : "null");
+    if (request == defaultNetActivate_) {
+        MakeDefaultNetWork(defaultNetSupplier_, bestSupplier);
+    }
+    sptr<NetSupplier> oldSupplier = request->GetServiceSupply();
+    sptr<INetConnCallback> callback = request->GetNetCallback();
+    SendBestScoreToHolders(reqId, score, bestSupplier ? bestSupplier->GetSupplierId() : 0);
+    if (!bestSupplier) {
+        // not found the bestNetwork
+        NotFindBestSupplier(reqId, request, oldSupplier, callback);
+        return;
+    }
+
+    if (bestSupplier == oldSupplier) {
+        return;
     }
-    NETMGR_LOG_I("the bestScore[%{public}d], bestSupplier[%{public}d, %{public}s]", bestScore,
-        supplier ? supplier->GetSupplierId() : 0, supplier ? supplier->GetNetSupplierIdent().c_str() : "null");
-    return bestScore;
+    if (oldSupplier) {
+        oldSupplier->RemoveBestRequest(reqId);
+    }
+    request->SetServiceSupply(bestSupplier);
+    CallbackForAvailable(bestSupplier, callback);
+    bestSupplier->SelectAsBestNetwork(reqId);
+    TrackRequestHolder(bestSupplier, reqId);
 }
 
 void NetConnService::SendAllRequestToNetwork(sptr<NetSupplier> supplier)
 {
-    NETMGR_LOG_E("SendAllRequestToNetwork Enter");
+    NETMGR_LOG_D("SendAllRequestToNetwork Enter");
     if (supplier == nullptr) {
         NETMGR_LOG_E("supplier is null");
         return;
     }
-    NET_ACTIVATE_MAP::iterator iter;
-    NETMGR_LOG_D("now is not have request. size = %{public}zd", netActivates_.size());
-    for (iter = netActivates_.begin(); iter != netActivates_.end(); ++iter) {
-        if (!iter->second->MatchRequestAndNetwork(supplier)) {
-            continue;
-        }
-        bool result = supplier->RequestToConnect(iter->first);
+    std::vector<uint32_t> reqIds;
+    netRequestMatcher_.GetMatchedRequests(supplier->GetSupplierId(), reqIds);
+    NETMGR_LOG_D("matched request num = %{public}zu", reqIds.size());
+    for (uint32_t reqId : reqIds) {
+        TrackRequestHolder(supplier, reqId);
+        bool result = supplier->RequestToConnect(reqId);
         if (!result) {
             NETMGR_LOG_E("connect supplier failed, result: %{public}d", result);
         }
@@ -840,12 +1100,11 @@ void NetConnService::SendRequestToAllNetwork(sptr<NetActivate> request)
     }
 
     uint32_t reqId = request->GetRequestId();
-    NET_SUPPLIER_MAP::iterator iter;
-    for (iter = netSuppliers_.begin(); iter != netSuppliers_.end(); ++iter) {
-        if (!request->MatchRequestAndNetwork(iter->second)) {
-            continue;
-        }
-        bool result = iter->second->RequestToConnect(reqId);
+    std::vector<sptr<NetSupplier>> suppliers;
+    netRequestMatcher_.GetMatchedSuppliers(reqId, suppliers);
+    for (auto &supplier : suppliers) {
+        TrackRequestHolder(supplier, reqId);
+        bool result = supplier->RequestToConnect(reqId);
         if (!result) {
             NETMGR_LOG_E("connect service failed, result %{public}d", result);
         }
@@ -853,12 +1112,21 @@ void NetConnService::SendRequestToAllNetwork(sptr<NetActivate> request)
     return;
 }
 
-void NetConnService::SendBestScoreAllNetwork(uint32_t reqId, int32_t bestScore, uint32_t supplierId)
+void NetConnService::SendBestScoreToHolders(uint32_t reqId, int32_t bestScore, uint32_t supplierId)
 {
-    NETMGR_LOG_E("SendBestScoreAllNetwork Enter");
-    NET_SUPPLIER_MAP::iterator iter;
-    for (iter = netSuppliers_.begin(); iter != netSuppliers_.end(); ++iter) {
-        iter->second->ReceiveBestScore(reqId, bestScore, supplierId);
+    std::vector<sptr<NetSupplier>> matched;
+    std::vector<sptr<NetSupplier>> unmatched;
+    netRequestMatcher_.GetHolders(reqId, matched, unmatched);
+    // A holder that no longer satisfies the request releases it, and disconnects if it was its last one.
+    for (auto &supplier : unmatched) {
+        supplier->CancelRequest(reqId);
+        netRequestMatcher_.RemoveHolder(reqId, supplier->GetSupplierId());
+    }
+    for (auto &supplier : matched) {
+        supplier->ReceiveBestScore(reqId, bestScore, supplierId);
+        if (!supplier->HasRequest(reqId)) {
+            netRequestMatcher_.RemoveHolder(reqId, supplier->GetSupplierId());
+        }
     }
 }
 
@@ -868,8 +1136,32 @@ void NetConnService::CallbackForSupplier(sptr<NetSupplier> &supplier, CallbackTy
     if (supplier == nullptr) {
         return;
     }
-    std::set<uint32_t> &bestReqList = supplier->GetBestRequestList();
+    std::unordered_set<uint32_t> &bestReqList = supplier->GetBestRequestList();
     NETMGR_LOG_D("bestReqList size = %{public}zd", bestReqList.size());
+    if (bestReqList.empty()) {
+        return;
+    }
+
+    // One payload copy per supplier change, shared by every request it serves.
+    NetConnCallbackEvent event;
+    switch (type) {
+        case CALL_TYPE_LOST:
+            event = MakeCallbackEvent(supplier, FACET_LOST);
+            break;
+        case CALL_TYPE_UPDATE_CAP:
+            event = MakeCallbackEvent(supplier, FACET_CAPABILITIES);
+            break;
+        case CALL_TYPE_UPDATE_LINK:
+            event = MakeCallbackEvent(supplier, FACET_CONNECTION_PROPERTIES);
+            break;
+        case CALL_TYPE_BLOCK_STATUS:
+            event = MakeCallbackEvent(supplier, FACET_BLOCK_STATUS);
+            break;
+        default:
+            return;
+    }
+
+    std::vector<sptr<INetConnCallback>> callbacks;
     for (auto it = bestReqList.begin(); it != bestReqList.end(); it++) {
         auto reqIt = netActivates_.find(*it);
         if ((reqIt == netActivates_.end()) || (!reqIt->second)) {
@@ -881,37 +1173,29 @@ void NetConnService::CallbackForSupplier(sptr<NetSupplier> &supplier, CallbackTy
             NETMGR_LOG_D("netActivite->callback is nullptr");
             continue;
         }
+        callbacks.push_back(callback);
+    }
+    if (callbacks.empty()) {
+        return;
+    }
 
-        sptr<NetHandle> netHandle = supplier->GetNetHandle();
-        switch (type) {
-            case CALL_TYPE_LOST: {
-                callback->NetLost(netHandle);
-                break;
-            }
-            case CALL_TYPE_UPDATE_CAP: {
-                sptr<NetAllCapabilities> pNetAllCap = std::make_unique<NetAllCapabilities>().release();
-                *pNetAllCap = supplier->GetNetCapabilities();
-                callback->NetCapabilitiesChange(netHandle, pNetAllCap);
-                break;
-            }
-            case CALL_TYPE_UPDATE_LINK: {
-                sptr<NetLinkInfo> pInfo = std::make_unique<NetLinkInfo>().release();
-                *pInfo = supplier->GetNetLinkInfo();
-                callback->NetConnectionPropertiesChange(netHandle, pInfo);
-                break;
-            }
-            case CALL_TYPE_BLOCK_STATUS: {
-                std::set<NetCap> netCaps = supplier->GetNetCaps();
-                bool Metered = (netCaps.find(NET_CAPABILITY_NOT_METERED) != netCaps.end());
-                bool newBlocked = NetManagerCenter::GetInstance().IsUidNetAccess(supplier->GetSupplierUid(), Metered);
-                callback->NetBlockStatusChange(netHandle, newBlocked);
-                break;
-            }
-            default:
-                break;
+    if (type != CALL_TYPE_BLOCK_STATUS) {
+        for (auto &callback : callbacks) {
+            callbackBatcher_->Enqueue(callback, event);
         }
+        return;
     }
-    return;
+    std::set<NetCap> netCaps = supplier->GetNetCaps();
+    bool Metered = (netCaps.find(NET_CAPABILITY_NOT_METERED) != netCaps.end());
+    int32_t uid = supplier->GetSupplierUid();
+    // IsUidNetAccess is a cross-service call, keep it off the state loop as well.
+    NetConnCallbackBatcher *batcher = callbackBatcher_.get();
+    callbackLoop_->Post([batcher, callbacks, event, uid, Metered]() mutable {
+        event.blocked = NetManagerCenter::GetInstance().IsUidNetAccess(uid, Metered);
+        for (auto &callback : callbacks) {
+            batcher->Enqueue(callback, event);
+        }
+    });
 }
 
 void NetConnService::CallbackForAvailable(sptr<NetSupplier> &supplier, const sptr<INetConnCallback> &callback)
@@ -920,15 +1204,24 @@ void NetConnService::CallbackForAvailable(sptr<NetSupplier> &supplier, const spt
         NETMGR_LOG_E("Input parameter is null.");
         return;
     }
-    sptr<NetHandle> netHandle = supplier->GetNetHandle();
-    callback->NetAvailable(netHandle);
-    sptr<NetAllCapabilities> pNetAllCap = std::make_unique<NetAllCapabilities>().release();
-    *pNetAllCap = supplier->GetNetCapabilities();
-    callback->NetCapabilitiesChange(netHandle, pNetAllCap);
-    sptr<NetLinkInfo> pInfo = std::make_unique<NetLinkInfo>().release();
-    *pInfo = supplier->GetNetLinkInfo();
-    callback->NetConnectionPropertiesChange(netHandle, pInfo);
-    return;
+    callbackBatcher_->Enqueue(
+        callback, MakeCallbackEvent(supplier, FACET_AVAILABLE | FACET_CAPABILITIES | FACET_CONNECTION_PROPERTIES));
+}
+
+NetConnCallbackEvent NetConnService::MakeCallbackEvent(sptr<NetSupplier> &supplier, uint32_t facets)
+{
+    NetConnCallbackEvent event;
+    event.netId = supplier->GetNetId();
+    event.facets = facets;
+    if (facets & FACET_CAPABILITIES) {
+        event.netAllCap = std::make_unique<NetAllCapabilities>().release();
+        *event.netAllCap = supplier->GetNetCapabilities();
+    }
+    if (facets & FACET_CONNECTION_PROPERTIES) {
+        event.linkInfo = std::make_unique<NetLinkInfo>().release();
+        *event.linkInfo = supplier->GetNetLinkInfo();
+    }
+    return event;
 }
 
 int32_t NetConnService::GetIfaceNameByType(NetBearType bearerType, const std::string &ident, std::string &ifaceName)
@@ -938,41 +1231,81 @@ int32_t NetConnService::GetIfaceNameByType(NetBearType bearerType, const std::st
         return ERR_INVALID_NETORK_TYPE;
     }
 
-    sptr<NetSupplier> supplier = GetNetSupplierFromList(bearerType, ident);
-    if (supplier == nullptr) {
-        NETMGR_LOG_D("supplier is nullptr.");
-        return ERR_NO_SUPPLIER;
-    }
-
-    sptr<Network> network = supplier->GetNetwork();
-    if (network == nullptr) {
-        NETMGR_LOG_E("network is nullptr");
-        return ERR_NO_NETWORK;
+    std::shared_ptr<const NetConnSnapshot> snapshot = LoadSnapshot();
+    for (const auto &item : snapshot->networks) {
+        if (item.second.bearerType == bearerType && item.second.ident == ident) {
+            ifaceName = item.second.linkInfo.ifaceName_;
+            return ERR_NONE;
+        }
     }
+    NETMGR_LOG_D("supplier is nullptr.");
+    return ERR_NO_SUPPLIER;
+}
 
-    ifaceName = network->GetNetLinkInfo().ifaceName_;
-
-    return ERR_NONE;
+void NetConnService::HandleDetectionResult(uint32_t supplierId, NetDetectionStatus netDetectionState,
+    const std::string &urlRedirect)
+{
+    NETMGR_LOG_D("Enter HandleDetectionResult, state[%{public}d]", netDetectionState);
+    // Called from the network's monitor thread.
+    stateLoop_->Post([this, supplierId, netDetectionState, urlRedirect]() {
+        HandleDetectionResultInner(supplierId, netDetectionState, urlRedirect);
+        PublishSnapshot();
+    });
 }
 
-void NetConnService::HandleDetectionResult(uint32_t supplierId, bool ifValid)
+void NetConnService::HandleDetectionResultInner(uint32_t supplierId, NetDetectionStatus netDetectionState,
+    const std::string &urlRedirect)
 {
-    NETMGR_LOG_D("Enter HandleDetectionResult, ifValid[%{public}d]", ifValid);
     NET_SUPPLIER_MAP::iterator iterSupplier = netSuppliers_.find(supplierId);
     if ((iterSupplier == netSuppliers_.end()) || (iterSupplier->second == nullptr)) {
         NETMGR_LOG_E("supplier doesn't exist.");
         return;
     }
+    sptr<Network> network = iterSupplier->second->GetNetwork();
+    std::vector<sptr<INetDetectionCallback>> callbacks;
+    if (network == nullptr || !network->HandleNetMonitorResult(netDetectionState, urlRedirect, callbacks)) {
+        return;
+    }
+    if (!callbacks.empty()) {
+        NetDetectionResultCode resultCode = Network::NetDetectionResultConvert(netDetectionState);
+        callbackLoop_->Post([callbacks, resultCode, urlRedirect]() {
+            for (const auto &callback : callbacks) {
+                callback->OnNetDetectionResultChanged(resultCode, urlRedirect);
+            }
+        });
+    }
+    bool ifValid = (netDetectionState == VERIFICATION_STATE);
     iterSupplier->second->SetNetValid(ifValid);
     CallbackForSupplier(iterSupplier->second, CALL_TYPE_UPDATE_CAP);
     if (!netScore_->GetServiceScore(iterSupplier->second)) {
         NETMGR_LOG_E("GetServiceScore fail.");
         return;
     }
-    FindBestNetworkForAllRequest();
+    ReevaluateSupplier(iterSupplier->second);
     return;
 }
 
+void NetConnService::HandleDetectionQuality(uint32_t supplierId, bool reachable, int64_t latencyMs)
+{
+    // Called from the network's monitor, under its lock.
+    stateLoop_->Post([this, supplierId, reachable, latencyMs]() {
+        NET_SUPPLIER_MAP::iterator iterSupplier = netSuppliers_.find(supplierId);
+        if ((iterSupplier == netSuppliers_.end()) || (iterSupplier->second == nullptr)) {
+            return;
+        }
+        int32_t oldScore = iterSupplier->second->GetRealScore();
+        netScore_->UpdateProbeResult(supplierId, reachable, latencyMs);
+        if (!netScore_->GetServiceScore(iterSupplier->second)) {
+            NETMGR_LOG_E("GetServiceScore fail.");
+            return;
+        }
+        if (iterSupplier->second->GetRealScore() != oldScore) {
+            ReevaluateSupplier(iterSupplier->second);
+            PublishSnapshot();
+        }
+    });
+}
+
 int32_t NetConnService::SetAirplaneMode(bool state)
 {
     BroadcastInfo info;
@@ -990,19 +1323,24 @@ int32_t NetConnService::RestoreFactoryData()
     NetManagerCenter::GetInstance().ResetEthernetFactory();
     NetManagerCenter::GetInstance().ResetPolicyFactory();
     NetManagerCenter::GetInstance().ResetStatsFactory();
-    defaultNetSupplier_ = nullptr;
-    netActivates_.clear();
-    NETMGR_LOG_D("Reset NetConnService, clear network request complete.");
-    netSuppliers_.clear();
-    networks_.clear();
-    NETMGR_LOG_D("Reset NetConnService, clear registered network complete.");
-    defaultNetSpecifier_ = nullptr;
-    defaultNetActivate_ = nullptr;
-    CreateDefaultRequest();
-    NETMGR_LOG_D("Reset NetConnService, default network complete.");
+    bool posted = stateLoop_->Post([this]() {
+        defaultNetSupplier_ = nullptr;
+        netActivates_.clear();
+        netConnCallbacks_.Clear();
+        netRequestMatcher_.Clear();
+        NETMGR_LOG_D("Reset NetConnService, clear network request complete.");
+        netSuppliers_.clear();
+        networks_.clear();
+        NETMGR_LOG_D("Reset NetConnService, clear registered network complete.");
+        defaultNetSpecifier_ = nullptr;
+        defaultNetActivate_ = nullptr;
+        CreateDefaultRequest();
+        PublishSnapshot();
+        NETMGR_LOG_D("Reset NetConnService, default network complete.");
+    });
     SetAirplaneMode(false);
     NETMGR_LOG_D("Reset NetConnService, turn off airplane mode.");
-    return ERR_NONE;
+    return posted ? ERR_NONE : ERR_SERVICE_STOPPED;
 }
 } // namespace NetManagerStandard
 } // namespace OHOS
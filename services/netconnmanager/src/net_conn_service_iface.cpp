@@ -49,5 +49,10 @@ int32_t NetConnServiceIface::RestrictBackgroundChanged(bool isRestrictBackground
 {
     return DelayedSingleton<NetConnService>::GetInstance()->RestrictBackgroundChanged(isRestrictBackground);
 }
+
+int32_t NetConnServiceIface::ReplayIfaceLinks()
+{
+    return DelayedSingleton<NetConnService>::GetInstance()->ReplayIfaceLinks();
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
\ No newline at end of file
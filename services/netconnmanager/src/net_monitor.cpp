@@ -14,139 +14,219 @@
  */
 #include "net_monitor.h"
 
+#include <cinttypes>
+
 #include "net_mgr_log_wrapper.h"
+#include "net_timer_wheel.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
-NetMonitor::NetMonitor(NetDetectionStateHandler handle)
+NetMonitor::NetMonitor(NetDetectionStateHandler handle, const std::vector<std::string> &probeUrls)
 {
-    isExitNetMonitorThread_ = false;
-    isStopNetMonitor_ = true;
-    isExitNetMonitorThread_ = false;
     netDetectionStatus_ = handle;
     lastDetectionState_ = INVALID_DETECTION_STATE;
+    probeUrls_ = probeUrls;
 }
 
 NetMonitor::~NetMonitor()
 {
-    ExitNetMonitorThread();
+    Stop();
 }
 
-bool NetMonitor::HttpDetection()
+void NetMonitor::Start(const std::string &ifaceName)
 {
-    NETMGR_LOG_D("HttpDetection in. ifaceName_: %{public}s", ifaceName_.c_str());
-    HttpRequest httpRequest;
-    httpRequest.SetIfaceName(ifaceName_);
-
-    std::string httpMsg(DEFAULT_PORTAL_HTTPS_URL);
-    std::string httpHeader;
-    int32_t ret = httpRequest.HttpGetHeader(httpMsg, httpHeader);
-    std::string urlRedirect;
-    if (ret != 0 || httpHeader.empty()) {
-        netDetectionStatus_(NetDetectionStatus::INVALID_DETECTION_STATE, urlRedirect);
+    NETMGR_LOG_D("Enter NetMonitor::Start, ifaceName[%{public}s]", ifaceName.c_str());
+    RoundReport report;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        CancelLocked();
+        generation_++;
+        ifaceName_ = ifaceName;
         lastDetectionState_ = INVALID_DETECTION_STATE;
-        return true;
+        validatedRounds_ = 0;
+        StartRoundLocked(generation_, report);
     }
+    Report(report);
+}
 
-    int32_t retCode = GetUrlRedirectFromResponse(httpHeader, urlRedirect);
-    int32_t statusCode = GetStatusCodeFromResponse(httpHeader);
-    NETMGR_LOG_D("ifaceName[%{public}s], statusCode[%{public}d], retCode[%{public}d]", ifaceName_.c_str(), statusCode,
-        retCode);
-    bool isNotPortal = true;
-    if ((statusCode == OK || (statusCode >= BAD_REQUEST && statusCode <= CLIENT_ERROR_MAX)) &&
-        retCode > PORTAL_CONTENT_LENGTH_MIN) {
-        if (retCode > -1) {
-            netDetectionStatus_(NetDetectionStatus::CAPTIVE_PORTAL_STATE, urlRedirect);
-        }
-        lastDetectionState_ = CAPTIVE_PORTAL_STATE;
-        isNotPortal = false;
-    } else if (statusCode == NO_CONTENT) {
-        netDetectionStatus_(NetDetectionStatus::VERIFICATION_STATE, urlRedirect);
-        lastDetectionState_ = VERIFICATION_STATE;
-        isNotPortal = true;
-    } else if (statusCode != NO_CONTENT && statusCode >= CREATED && statusCode <= URL_REDIRECT_MAX) {
-        if (retCode > -1) {
-            netDetectionStatus_(NetDetectionStatus::CAPTIVE_PORTAL_STATE, urlRedirect);
-        }
-        lastDetectionState_ = CAPTIVE_PORTAL_STATE;
-        isNotPortal = false;
-    } else {
-        netDetectionStatus_(NetDetectionStatus::INVALID_DETECTION_STATE, urlRedirect);
-        lastDetectionState_ = INVALID_DETECTION_STATE;
-        isNotPortal = true;
+void NetMonitor::Stop()
+{
+    NETMGR_LOG_D("Enter NetMonitor::Stop");
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        CancelLocked();
+        generation_++;
     }
-
-    NETMGR_LOG_D("statusCode[%{public}d], urlRedirect[%{public}s]", statusCode, urlRedirect.c_str());
-    return isNotPortal;
+    // A report that passed its generation check before the bump is finished before returning.
+    std::lock_guard<std::mutex> reportLock(reportMutex_);
 }
 
-void NetMonitor::RunNetMonitorThreadFunc()
+void NetMonitor::SetQualityHandler(NetDetectionQualityHandler handle)
 {
-    NETMGR_LOG_D("RunNetMonitorThreadFunc in. ifaceName[%{public}s]", ifaceName_.c_str());
-    int32_t timeoutMs = HTTP_DETECTION_WAIT_TIME_MS;
-    for (;;) {
-        while (isStopNetMonitor_ && !isExitNetMonitorThread_) {
-            NETMGR_LOG_D("waiting for signal");
-            std::unique_lock<std::mutex> lock(mutex_);
-            condition_.wait(lock);
-        }
+    std::unique_lock<std::mutex> lock(mutex_);
+    netDetectionQuality_ = handle;
+}
 
-        if (isExitNetMonitorThread_) {
-            NETMGR_LOG_D("break the loop");
-            break;
-        }
-        HttpDetection();
-        if (!isExitNetMonitorThread_) {
-            std::unique_lock<std::mutex> lock(mutex_);
-            conditionTimeout_.wait_for(lock, std::chrono::milliseconds(timeoutMs));
+void NetMonitor::CancelLocked()
+{
+    if (timerId_ != 0) {
+        NetTimerWheel::GetInstance().Cancel(timerId_);
+        timerId_ = 0;
+    }
+    if (currentRound_ != nullptr) {
+        for (uint64_t probeId : currentRound_->probeIds) {
+            NetProbeEngine::GetInstance().CancelProbe(probeId);
         }
+        currentRound_ = nullptr;
     }
 }
 
-ResultCode NetMonitor::InitNetMonitorThread()
+void NetMonitor::StartRoundLocked(uint64_t generation, RoundReport &report)
 {
-    netMonitorThread_ = std::make_unique<std::thread>(&NetMonitor::RunNetMonitorThreadFunc, this);
-    if (netMonitorThread_ == nullptr) {
-        NETMGR_LOG_E("Start NetMonitor thread failed!");
-        return ResultCode::ERR_NET_MONITOR_OPT_FAILED;
+    if (generation != generation_) {
+        return;
+    }
+    timerId_ = 0;
+    NETMGR_LOG_D("detection round in. ifaceName: %{public}s, probe num: %{public}zu", ifaceName_.c_str(),
+        probeUrls_.size());
+    auto round = std::make_shared<ProbeRound>();
+    round->pending = probeUrls_.size();
+    currentRound_ = round;
+    std::weak_ptr<NetMonitor> weakSelf = shared_from_this();
+    for (const auto &url : probeUrls_) {
+        NetProbeRequest request;
+        request.url = url;
+        request.ifaceName = ifaceName_;
+        uint64_t probeId = NetProbeEngine::GetInstance().StartProbe(
+            request, [weakSelf, generation, round, url](const NetProbeResult &result) {
+                std::shared_ptr<NetMonitor> self = weakSelf.lock();
+                if (self != nullptr) {
+                    self->OnProbeResult(generation, round, url, result);
+                }
+            });
+        if (probeId == 0) {
+            round->pending--;
+            continue;
+        }
+        round->probeIds.push_back(probeId);
+    }
+    if (round->pending == 0) {
+        FinishRoundLocked(INVALID_DETECTION_STATE, "", -1, report);
     }
-    return ResultCode::ERR_NET_MONITOR_OPT_SUCCESS;
 }
 
-void NetMonitor::StopNetMonitorThread()
+void NetMonitor::OnProbeResult(uint64_t generation, const std::shared_ptr<ProbeRound> &round, const std::string &url,
+    const NetProbeResult &result)
 {
-    NETMGR_LOG_D("Enter StopNetMonitorThread");
-    std::unique_lock<std::mutex> lock(mutex_);
-    isStopNetMonitor_ = true;
+    std::string urlRedirect;
+    NetDetectionStatus status = INVALID_DETECTION_STATE;
+    if (result.errCode == 0 && !result.header.empty()) {
+        status = ParseProbeResponse(result.header, urlRedirect);
+    }
+    NETMGR_LOG_D("probe[%{public}s] status[%{public}d], errCode[%{public}d], time[%{public}" PRId64 "]ms",
+        url.c_str(), status, result.errCode, result.totalTimeMs);
+
+    RoundReport report;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (generation != generation_ || round != currentRound_) {
+            return;
+        }
+        round->pending--;
+        if (status != INVALID_DETECTION_STATE || round->pending == 0) {
+            FinishRoundLocked(status, urlRedirect, (status == INVALID_DETECTION_STATE) ? -1 : result.totalTimeMs,
+                report);
+        }
+    }
+    Report(report);
 }
 
-void NetMonitor::SignalNetMonitorThread(const std::string &ifaceName)
+void NetMonitor::FinishRoundLocked(NetDetectionStatus status, const std::string &urlRedirect, int64_t latencyMs,
+    RoundReport &report)
 {
-    NETMGR_LOG_D("Enter SignalNetMonitorThread");
-    std::unique_lock<std::mutex> lock(mutex_);
-    ifaceName_ = ifaceName;
-    lastDetectionState_ = INVALID_DETECTION_STATE;
-    isStopNetMonitor_ = false;
-    condition_.notify_one();
-    conditionTimeout_.notify_one();
-    NETMGR_LOG_D("leave SignalNetMonitorThread!");
+    // The first conclusive probe decides the round, the slower ones are dropped.
+    if (currentRound_ != nullptr) {
+        for (uint64_t probeId : currentRound_->probeIds) {
+            NetProbeEngine::GetInstance().CancelProbe(probeId);
+        }
+        currentRound_ = nullptr;
+    }
+    NETMGR_LOG_D("status[%{public}d], urlRedirect[%{public}s]", status, urlRedirect.c_str());
+    report.due = true;
+    report.generation = generation_;
+    report.status = status;
+    report.urlRedirect = urlRedirect;
+    report.latencyMs = latencyMs;
+    report.stateHandler = netDetectionStatus_;
+    report.qualityHandler = netDetectionQuality_;
+    lastDetectionState_ = status;
+
+    uint64_t generation = generation_;
+    std::weak_ptr<NetMonitor> weakSelf = shared_from_this();
+    timerId_ = NetTimerWheel::GetInstance().Schedule(NextDetectionWaitTime(status), [weakSelf, generation]() {
+        std::shared_ptr<NetMonitor> self = weakSelf.lock();
+        if (self == nullptr) {
+            return;
+        }
+        RoundReport report;
+        {
+            std::unique_lock<std::mutex> lock(self->mutex_);
+            self->StartRoundLocked(generation, report);
+        }
+        self->Report(report);
+    });
 }
 
-void NetMonitor::ExitNetMonitorThread()
+void NetMonitor::Report(const RoundReport &report)
 {
-    NETMGR_LOG_D("Enter ExitNetMonitorThread");
+    if (!report.due) {
+        return;
+    }
+    std::lock_guard<std::mutex> reportLock(reportMutex_);
     {
         std::unique_lock<std::mutex> lock(mutex_);
-        isStopNetMonitor_ = false;
-        isExitNetMonitorThread_ = true;
-        condition_.notify_one();
-        conditionTimeout_.notify_one();
+        if (report.generation != generation_) {
+            return;
+        }
     }
+    if (report.stateHandler) {
+        report.stateHandler(report.status, report.urlRedirect);
+    }
+    if (report.qualityHandler) {
+        report.qualityHandler(report.status == VERIFICATION_STATE, report.latencyMs);
+    }
+}
 
-    if (netMonitorThread_ != nullptr) {
-        netMonitorThread_->join();
-        NETMGR_LOG_D("ExitNetMonitorThread OK");
+NetDetectionStatus NetMonitor::ParseProbeResponse(const std::string &strResponse, std::string &urlRedirect)
+{
+    int32_t retCode = GetUrlRedirectFromResponse(strResponse, urlRedirect);
+    int32_t statusCode = GetStatusCodeFromResponse(strResponse);
+    NETMGR_LOG_D("statusCode[%{public}d], retCode[%{public}d]", statusCode, retCode);
+    if ((statusCode == OK || (statusCode >= BAD_REQUEST && statusCode <= CLIENT_ERROR_MAX)) &&
+        retCode > PORTAL_CONTENT_LENGTH_MIN) {
+        return CAPTIVE_PORTAL_STATE;
+    }
+    if (statusCode == NO_CONTENT) {
+        return VERIFICATION_STATE;
+    }
+    if (statusCode >= CREATED && statusCode <= URL_REDIRECT_MAX && retCode > -1) {
+        return CAPTIVE_PORTAL_STATE;
+    }
+    return INVALID_DETECTION_STATE;
+}
+
+uint32_t NetMonitor::NextDetectionWaitTime(NetDetectionStatus status)
+{
+    // A validated network is re-checked less and less often, anything else keeps the base pace.
+    if (status != VERIFICATION_STATE) {
+        validatedRounds_ = 0;
+    }
+    uint32_t waitTimeMs =
+        NetTimerWheel::Backoff(HTTP_DETECTION_WAIT_TIME_MS, validatedRounds_, HTTP_DETECTION_MAX_WAIT_TIME_MS);
+    if (status == VERIFICATION_STATE) {
+        validatedRounds_++;
     }
+    return NetTimerWheel::Jitter(waitTimeMs, HTTP_DETECTION_JITTER_PERCENT);
 }
 
 int32_t NetMonitor::GetStatusCodeFromResponse(const std::string &strResponse)
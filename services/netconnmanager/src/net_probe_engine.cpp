@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "net_probe_engine.h"
+
+#include <curl/curl.h>
+#include <pthread.h>
+
+#include "net_mgr_log_wrapper.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr int32_t POLL_TIMEOUT_MS = 1000;
+constexpr int64_t US_PER_MS = 1000;
+constexpr long MAX_REDIRECTS = 1L;
+// Returned by the write callback to abort the transfer once the headers are in
+constexpr size_t STOP_TRANSFER = 0;
+const std::string IFACE_PREFIX = "if!";
+} // namespace
+
+struct NetProbeEngine::Probe {
+    uint64_t id = 0;
+    CURL *easy = nullptr;
+    NetProbeCallback callback;
+    std::string url;
+    std::string interface;
+    std::string header;
+    // Released after the easy handle, a share must not go while a handle still uses it
+    std::shared_ptr<Share> share;
+    bool gotBody = false;
+    char errorBuffer[CURL_ERROR_SIZE] = {0};
+};
+
+struct NetProbeEngine::Share {
+    explicit Share(CURLSH *share) : handle(share) {}
+    ~Share()
+    {
+        curl_share_cleanup(handle);
+    }
+
+    CURLSH *handle = nullptr;
+};
+
+NetProbeEngine &NetProbeEngine::GetInstance()
+{
+    static NetProbeEngine instance;
+    return instance;
+}
+
+void NetProbeEngine::GlobalInit()
+{
+    static std::once_flag initFlag;
+    std::call_once(initFlag, []() {
+        CURLcode errCode = curl_global_init(CURL_GLOBAL_ALL);
+        if (errCode != CURLE_OK) {
+            NETMGR_LOG_E("curl_global_init failed, errCode:[%{public}x]!", errCode);
+        }
+    });
+}
+
+NetProbeEngine::NetProbeEngine() : exit_(false), nextProbeId_(1)
+{
+    GlobalInit();
+    multi_ = curl_multi_init();
+    if (multi_ == nullptr) {
+        NETMGR_LOG_E("curl_multi_init failed");
+        return;
+    }
+    thread_ = std::thread([this]() { Run(); });
+    pthread_setname_np(thread_.native_handle(), "NetProbeEngine");
+}
+
+NetProbeEngine::~NetProbeEngine()
+{
+    exit_ = true;
+    if (multi_ != nullptr) {
+        curl_multi_wakeup(multi_);
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    while (!probes_.empty()) {
+        RemoveProbe(probes_.begin()->first);
+    }
+    shares_.clear();
+    if (multi_ != nullptr) {
+        curl_multi_cleanup(multi_);
+    }
+}
+
+uint64_t NetProbeEngine::StartProbe(const NetProbeRequest &request, const NetProbeCallback &callback)
+{
+    if (multi_ == nullptr || request.url.empty() || !callback) {
+        return 0;
+    }
+    Command command;
+    command.probeId = nextProbeId_++;
+    command.request = request;
+    command.callback = callback;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        commands_.push_back(command);
+    }
+    curl_multi_wakeup(multi_);
+    return command.probeId;
+}
+
+void NetProbeEngine::CancelProbe(uint64_t probeId)
+{
+    if (multi_ == nullptr || probeId == 0) {
+        return;
+    }
+    Command command;
+    command.cancel = true;
+    command.probeId = probeId;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        commands_.push_back(command);
+    }
+    curl_multi_wakeup(multi_);
+}
+
+void NetProbeEngine::ReleaseInterface(const std::string &ifaceName)
+{
+    if (multi_ == nullptr) {
+        return;
+    }
+    Command command;
+    command.releaseIface = true;
+    command.request.ifaceName = ifaceName;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        commands_.push_back(command);
+    }
+    curl_multi_wakeup(multi_);
+}
+
+void NetProbeEngine::Run()
+{
+    while (!exit_) {
+        RunCommands();
+        int32_t running = 0;
+        CURLMcode code = curl_multi_perform(multi_, &running);
+        if (code != CURLM_OK) {
+            NETMGR_LOG_E("curl_multi_perform failed: %{public}s", curl_multi_strerror(code));
+        }
+        ReadDoneProbes();
+        curl_multi_poll(multi_, nullptr, 0, POLL_TIMEOUT_MS, nullptr);
+    }
+}
+
+void NetProbeEngine::RunCommands()
+{
+    std::vector<Command> commands;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        commands.swap(commands_);
+    }
+    for (const auto &command : commands) {
+        if (command.cancel) {
+            RemoveProbe(command.probeId);
+        } else if (command.releaseIface) {
+            shares_.erase(command.request.ifaceName);
+        } else {
+            AddProbe(command);
+        }
+    }
+}
+
+void NetProbeEngine::AddProbe(const Command &command)
+{
+    auto probe = std::make_unique<Probe>();
+    probe->id = command.probeId;
+    probe->callback = command.callback;
+    probe->url = command.request.url;
+    probe->easy = curl_easy_init();
+    if (probe->easy == nullptr) {
+        NETMGR_LOG_E("curl_easy_init failed");
+        NetProbeResult result;
+        result.errCode = CURLE_FAILED_INIT;
+        command.callback(result);
+        return;
+    }
+
+    const std::string &ifaceName = command.request.ifaceName;
+    CURL *easy = probe->easy;
+    curl_easy_setopt(easy, CURLOPT_URL, probe->url.c_str());
+    curl_easy_setopt(easy, CURLOPT_PRIVATE, probe.get());
+    curl_easy_setopt(easy, CURLOPT_ERRORBUFFER, probe->errorBuffer);
+    curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION, HeaderCallback);
+    curl_easy_setopt(easy, CURLOPT_HEADERDATA, probe.get());
+    curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, DiscardCallback);
+    curl_easy_setopt(easy, CURLOPT_WRITEDATA, probe.get());
+    // A pooled connection could be the one opened before a portal showed up, or lead to a cached answer. The
+    // TLS session cache is safe to share, resuming a session still sends the request over the new connection.
+    curl_easy_setopt(easy, CURLOPT_FRESH_CONNECT, 1L);
+    curl_easy_setopt(easy, CURLOPT_FORBID_REUSE, 1L);
+    /* the connection succeeds regardless of the peer certificate and the names in it */
+    curl_easy_setopt(easy, CURLOPT_SSL_VERIFYPEER, 0L);
+    curl_easy_setopt(easy, CURLOPT_SSL_VERIFYHOST, 0L);
+    curl_easy_setopt(easy, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(easy, CURLOPT_MAXREDIRS, MAX_REDIRECTS);
+    curl_easy_setopt(easy, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(command.request.connectTimeoutMs));
+    curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, static_cast<long>(command.request.timeoutMs));
+    if (!ifaceName.empty()) {
+        probe->interface = (ifaceName.compare(0, IFACE_PREFIX.length(), IFACE_PREFIX) == 0) ?
+            ifaceName : IFACE_PREFIX + ifaceName;
+        curl_easy_setopt(easy, CURLOPT_INTERFACE, probe->interface.c_str());
+    }
+    probe->share = AcquireShare(ifaceName);
+    if (probe->share != nullptr) {
+        curl_easy_setopt(easy, CURLOPT_SHARE, probe->share->handle);
+    }
+
+    CURLMcode code = curl_multi_add_handle(multi_, easy);
+    if (code != CURLM_OK) {
+        NETMGR_LOG_E("curl_multi_add_handle failed: %{public}s", curl_multi_strerror(code));
+        curl_easy_cleanup(easy);
+        NetProbeResult result;
+        result.errCode = CURLE_FAILED_INIT;
+        command.callback(result);
+        return;
+    }
+    probes_[probe->id] = std::move(probe);
+}
+
+void NetProbeEngine::RemoveProbe(uint64_t probeId)
+{
+    auto it = probes_.find(probeId);
+    if (it == probes_.end()) {
+        return;
+    }
+    curl_multi_remove_handle(multi_, it->second->easy);
+    curl_easy_cleanup(it->second->easy);
+    probes_.erase(it);
+}
+
+void NetProbeEngine::ReadDoneProbes()
+{
+    int32_t remaining = 0;
+    CURLMsg *msg = nullptr;
+    while ((msg = curl_multi_info_read(multi_, &remaining)) != nullptr) {
+        if (msg->msg != CURLMSG_DONE) {
+            continue;
+        }
+        Probe *probe = nullptr;
+        curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &probe);
+        if (probe == nullptr) {
+            continue;
+        }
+        NetProbeResult result;
+        CURLcode errCode = msg->data.result;
+        if (errCode == CURLE_WRITE_ERROR && probe->gotBody) {
+            errCode = CURLE_OK;
+        }
+        result.errCode = static_cast<int32_t>(errCode);
+        if (errCode == CURLE_OK) {
+            curl_off_t totalTimeUs = 0;
+            if (curl_easy_getinfo(probe->easy, CURLINFO_TOTAL_TIME_T, &totalTimeUs) == CURLE_OK) {
+                result.totalTimeMs = static_cast<int64_t>(totalTimeUs / US_PER_MS);
+            }
+        } else {
+            NETMGR_LOG_D("probe[%{public}s] failed: %{public}s, %{public}s", probe->url.c_str(),
+                curl_easy_strerror(errCode), probe->errorBuffer);
+        }
+        result.header.swap(probe->header);
+        NetProbeCallback callback = probe->callback;
+        RemoveProbe(probe->id);
+        callback(result);
+    }
+}
+
+std::shared_ptr<NetProbeEngine::Share> NetProbeEngine::AcquireShare(const std::string &ifaceName)
+{
+    auto it = shares_.find(ifaceName);
+    if (it != shares_.end()) {
+        return it->second;
+    }
+    // Only the engine thread touches the handles, so the share needs no lock callbacks.
+    CURLSH *handle = curl_share_init();
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    curl_share_setopt(handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    auto share = std::make_shared<Share>(handle);
+    shares_[ifaceName] = share;
+    return share;
+}
+
+size_t NetProbeEngine::HeaderCallback(char *data, size_t size, size_t nmemb, void *userp)
+{
+    Probe *probe = static_cast<Probe *>(userp);
+    size_t length = size * nmemb;
+    if (probe != nullptr && data != nullptr) {
+        probe->header.append(data, length);
+    }
+    return length;
+}
+
+size_t NetProbeEngine::DiscardCallback(char *data, size_t size, size_t nmemb, void *userp)
+{
+    // The verdict only needs the status line and the headers, the body of a portal page is not downloaded.
+    Probe *probe = static_cast<Probe *>(userp);
+    if (probe != nullptr) {
+        probe->gotBody = true;
+    }
+    return STOP_TRANSFER;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "net_request_matcher.h"
+
+#include "net_mgr_log_wrapper.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+const std::pair<int32_t, uint32_t> NO_TOP = {0, 0};
+} // namespace
+
+NetRequestMatcher::MatchKey NetRequestMatcher::MakeKey(const sptr<NetActivate> &request)
+{
+    sptr<NetSpecifier> specifier = request->GetNetSpecifier();
+    if (specifier == nullptr) {
+        return MatchKey();
+    }
+    const NetAllCapabilities &caps = specifier->netCapabilities_;
+    return MatchKey(specifier->ident_, caps.netCaps_, caps.bearerTypes_, caps.linkUpBandwidthKbps_,
+        caps.linkDownBandwidthKbps_);
+}
+
+void NetRequestMatcher::AddRequest(const sptr<NetActivate> &request)
+{
+    if (request == nullptr) {
+        return;
+    }
+    uint32_t reqId = request->GetRequestId();
+    RemoveRequest(reqId);
+    MatchKey key = MakeKey(request);
+    requests_[reqId] = request;
+    requestKeys_[reqId] = key;
+
+    auto iterClass = classes_.find(key);
+    if (iterClass != classes_.end()) {
+        iterClass->second.requests.insert(reqId);
+        return;
+    }
+    // First request of its kind, this is the only time a class is matched against every supplier.
+    MatchClass &matchClass = classes_[key];
+    matchClass.requests.insert(reqId);
+    for (const auto &supplier : suppliers_) {
+        UpdateMembership(matchClass, supplier.second);
+    }
+    NETMGR_LOG_D("new match class for request[%{public}u], class num[%{public}zu]", reqId, classes_.size());
+}
+
+void NetRequestMatcher::RemoveRequest(uint32_t reqId)
+{
+    holders_.erase(reqId);
+    auto iterKey = requestKeys_.find(reqId);
+    if (iterKey == requestKeys_.end()) {
+        return;
+    }
+    auto iterClass = classes_.find(iterKey->second);
+    if (iterClass != classes_.end()) {
+        iterClass->second.requests.erase(reqId);
+        if (iterClass->second.requests.empty()) {
+            classes_.erase(iterClass);
+        }
+    }
+    requestKeys_.erase(iterKey);
+    requests_.erase(reqId);
+}
+
+void NetRequestMatcher::UpdateSupplier(const sptr<NetSupplier> &supplier, std::vector<uint32_t> &affectedReqIds)
+{
+    if (supplier == nullptr) {
+        return;
+    }
+    suppliers_[supplier->GetSupplierId()] = supplier;
+    for (auto &matchClass : classes_) {
+        if (UpdateMembership(matchClass.second, supplier)) {
+            CollectRequests(matchClass.second, affectedReqIds);
+        }
+    }
+}
+
+void NetRequestMatcher::RemoveSupplier(uint32_t supplierId, std::vector<uint32_t> &affectedReqIds)
+{
+    if (suppliers_.erase(supplierId) == 0) {
+        return;
+    }
+    for (auto iterHolder = holders_.begin(); iterHolder != holders_.end();) {
+        iterHolder->second.erase(supplierId);
+        if (iterHolder->second.empty()) {
+            iterHolder = holders_.erase(iterHolder);
+        } else {
+            ++iterHolder;
+        }
+    }
+    for (auto &item : classes_) {
+        MatchClass &matchClass = item.second;
+        matchClass.members.erase(supplierId);
+        auto ranked = matchClass.rankedScores.find(supplierId);
+        if (ranked == matchClass.rankedScores.end()) {
+            continue;
+        }
+        RankEntry oldTop = GetTop(matchClass);
+        matchClass.ranking.erase(RankEntry(-ranked->second, supplierId));
+        matchClass.rankedScores.erase(ranked);
+        if (GetTop(matchClass) != oldTop) {
+            CollectRequests(matchClass, affectedReqIds);
+        }
+    }
+}
+
+sptr<NetSupplier> NetRequestMatcher::GetBestSupplier(uint32_t reqId, int32_t &bestScore) const
+{
+    bestScore = 0;
+    auto iterKey = requestKeys_.find(reqId);
+    if (iterKey == requestKeys_.end()) {
+        return nullptr;
+    }
+    auto iterClass = classes_.find(iterKey->second);
+    if (iterClass == classes_.end()) {
+        return nullptr;
+    }
+    RankEntry top = GetTop(iterClass->second);
+    if (top == NO_TOP) {
+        return nullptr;
+    }
+    auto iterSupplier = suppliers_.find(top.second);
+    if (iterSupplier == suppliers_.end()) {
+        return nullptr;
+    }
+    bestScore = -top.first;
+    return iterSupplier->second;
+}
+
+void NetRequestMatcher::GetMatchedSuppliers(uint32_t reqId, std::vector<sptr<NetSupplier>> &suppliers) const
+{
+    auto iterKey = requestKeys_.find(reqId);
+    if (iterKey == requestKeys_.end()) {
+        return;
+    }
+    auto iterClass = classes_.find(iterKey->second);
+    if (iterClass == classes_.end()) {
+        return;
+    }
+    for (uint32_t supplierId : iterClass->second.members) {
+        auto iterSupplier = suppliers_.find(supplierId);
+        if (iterSupplier != suppliers_.end()) {
+            suppliers.push_back(iterSupplier->second);
+        }
+    }
+}
+
+void NetRequestMatcher::GetMatchedRequests(uint32_t supplierId, std::vector<uint32_t> &reqIds) const
+{
+    for (const auto &matchClass : classes_) {
+        if (matchClass.second.members.count(supplierId) != 0) {
+            CollectRequests(matchClass.second, reqIds);
+        }
+    }
+}
+
+void NetRequestMatcher::AddHolder(uint32_t reqId, uint32_t supplierId)
+{
+    holders_[reqId].insert(supplierId);
+}
+
+void NetRequestMatcher::RemoveHolder(uint32_t reqId, uint32_t supplierId)
+{
+    auto iterHolder = holders_.find(reqId);
+    if (iterHolder == holders_.end()) {
+        return;
+    }
+    iterHolder->second.erase(supplierId);
+    if (iterHolder->second.empty()) {
+        holders_.erase(iterHolder);
+    }
+}
+
+void NetRequestMatcher::GetHolders(uint32_t reqId, std::vector<sptr<NetSupplier>> &matched,
+    std::vector<sptr<NetSupplier>> &unmatched) const
+{
+    auto iterHolder = holders_.find(reqId);
+    if (iterHolder == holders_.end()) {
+        return;
+    }
+    const MatchClass *matchClass = nullptr;
+    auto iterKey = requestKeys_.find(reqId);
+    if (iterKey != requestKeys_.end()) {
+        auto iterClass = classes_.find(iterKey->second);
+        matchClass = (iterClass != classes_.end()) ? &iterClass->second : nullptr;
+    }
+    for (uint32_t supplierId : iterHolder->second) {
+        auto iterSupplier = suppliers_.find(supplierId);
+        if (iterSupplier == suppliers_.end()) {
+            continue;
+        }
+        if (matchClass != nullptr && matchClass->members.count(supplierId) != 0) {
+            matched.push_back(iterSupplier->second);
+        } else {
+            unmatched.push_back(iterSupplier->second);
+        }
+    }
+}
+
+void NetRequestMatcher::Clear()
+{
+    classes_.clear();
+    requestKeys_.clear();
+    requests_.clear();
+    suppliers_.clear();
+    holders_.clear();
+}
+
+sptr<NetActivate> NetRequestMatcher::GetSampleRequest(const MatchClass &matchClass) const
+{
+    // All requests of a class have the same specifier content, any of them can answer for the class.
+    if (matchClass.requests.empty()) {
+        return nullptr;
+    }
+    auto iterRequest = requests_.find(*matchClass.requests.begin());
+    if (iterRequest == requests_.end()) {
+        return nullptr;
+    }
+    return iterRequest->second;
+}
+
+bool NetRequestMatcher::UpdateMembership(MatchClass &matchClass, const sptr<NetSupplier> &supplier)
+{
+    uint32_t supplierId = supplier->GetSupplierId();
+    RankEntry oldTop = GetTop(matchClass);
+    sptr<NetActivate> sample = GetSampleRequest(matchClass);
+    bool matched = (sample != nullptr) && sample->MatchRequestAndNetwork(supplier);
+    // A supplier that stops matching may still hold the requests, they have to be re-evaluated to release them.
+    bool left = false;
+    if (matched) {
+        matchClass.members.insert(supplierId);
+    } else {
+        left = matchClass.members.erase(supplierId) != 0;
+    }
+
+    auto ranked = matchClass.rankedScores.find(supplierId);
+    if (ranked != matchClass.rankedScores.end()) {
+        matchClass.ranking.erase(RankEntry(-ranked->second, supplierId));
+        matchClass.rankedScores.erase(ranked);
+    }
+    if (matched && supplier->IsConnected()) {
+        int32_t score = supplier->GetRealScore();
+        matchClass.ranking.insert(RankEntry(-score, supplierId));
+        matchClass.rankedScores[supplierId] = score;
+    }
+    return left || GetTop(matchClass) != oldTop;
+}
+
+NetRequestMatcher::RankEntry NetRequestMatcher::GetTop(const MatchClass &matchClass)
+{
+    // A supplier has to score above zero to serve a request.
+    if (matchClass.ranking.empty() || matchClass.ranking.begin()->first >= 0) {
+        return NO_TOP;
+    }
+    return *matchClass.ranking.begin();
+}
+
+void NetRequestMatcher::CollectRequests(const MatchClass &matchClass, std::vector<uint32_t> &reqIds) const
+{
+    reqIds.insert(reqIds.end(), matchClass.requests.begin(), matchClass.requests.end());
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
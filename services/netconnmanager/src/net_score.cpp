@@ -15,6 +15,11 @@
 
 #include "net_score.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+
 #include "net_mgr_log_wrapper.h"
 
 namespace OHOS {
@@ -24,6 +29,17 @@ constexpr int32_t WIFI_BASE_SCORE   = static_cast<int32_t>(NetTypeScoreValue::WI
     NET_TYPE_SCORE_INTERVAL / WIFI_SIGNAL_BAR;
 constexpr int32_t WIFI_MIN_RSSI     = -100;
 constexpr int32_t WIFI_MAX_RSSI     = -55;
+constexpr double EWMA_WEIGHT = 0.3;
+constexpr double REFERENCE_BANDWIDTH_KBPS = 10000.0;
+// Bandwidth term reaches -1 at 1/16 and +1 at 16 times the reference
+constexpr double BANDWIDTH_OCTAVES = 4.0;
+// Latency term is +1 at 0ms, 0 at the reference and -1 at twice the reference
+constexpr double REFERENCE_LATENCY_MS = 300.0;
+
+static double ClampTerm(double value)
+{
+    return std::max(-1.0, std::min(1.0, value));
+}
 
 NetScore::NetScore() {}
 
@@ -80,11 +96,131 @@ bool NetScore::GetServiceScore(sptr<NetSupplier> &supplier)
         netScore = static_cast<int32_t>(iter->second);
     }
 
+    // A VPN is chosen by the user and always wins over the network it runs on
+    if (bearerType != BEARER_VPN) {
+        netScore += CalculateQualityBonus(supplier);
+    }
     supplier->SetNetScore(netScore);
     if (!(supplier->IfNetValid())) {
         netScore -= NET_VALID_SCORE;
     }
-    supplier->SetRealScore(netScore);
+    supplier->SetRealScore(std::max(netScore, MIN_NET_SCORE));
+    return true;
+}
+
+int32_t NetScore::CalculateQualityBonus(sptr<NetSupplier> &supplier)
+{
+    NetQuality &quality = qualities_[supplier->GetSupplierId()];
+    const auto &netAllCap = supplier->GetNetCapabilities();
+    double bandwidthTerm = 0;
+    if (netAllCap.linkDownBandwidthKbps_ > 0) {
+        bandwidthTerm = ClampTerm(std::log2(netAllCap.linkDownBandwidthKbps_ / REFERENCE_BANDWIDTH_KBPS) /
+            BANDWIDTH_OCTAVES);
+    }
+    double latencyTerm = 0;
+    if (quality.latencySamples > 0) {
+        latencyTerm = ClampTerm((REFERENCE_LATENCY_MS - quality.latencyMs) / REFERENCE_LATENCY_MS);
+    }
+    double stabilityTerm = (quality.samples > 0) ? -quality.lossRate : 0;
+    double unmeteredTerm = (netAllCap.netCaps_.count(NET_CAPABILITY_NOT_METERED) > 0) ? 1 : 0;
+    int32_t bonus = static_cast<int32_t>(std::lround(weights_.bandwidth * bandwidthTerm +
+        weights_.latency * latencyTerm + weights_.stability * stabilityTerm + weights_.unmetered * unmeteredTerm));
+    bonus = std::max(-MAX_QUALITY_BONUS, std::min(MAX_QUALITY_BONUS, bonus));
+    if (!quality.hasBonus || std::abs(bonus - quality.bonus) >= weights_.hysteresis) {
+        quality.bonus = bonus;
+        quality.hasBonus = true;
+    }
+    NETMGR_LOG_D("supplier[%{public}u] quality bonus[%{public}d], candidate[%{public}d]",
+        supplier->GetSupplierId(), quality.bonus, bonus);
+    return quality.bonus;
+}
+
+void NetScore::UpdateProbeResult(uint32_t supplierId, bool reachable, int64_t latencyMs)
+{
+    NetQuality &quality = qualities_[supplierId];
+    double loss = reachable ? 0 : 1;
+    if (quality.samples == 0) {
+        quality.lossRate = loss;
+    } else {
+        quality.lossRate += EWMA_WEIGHT * (loss - quality.lossRate);
+    }
+    quality.samples++;
+    if (!reachable || latencyMs < 0) {
+        return;
+    }
+    if (quality.latencySamples == 0) {
+        quality.latencyMs = static_cast<double>(latencyMs);
+    } else {
+        quality.latencyMs += EWMA_WEIGHT * (static_cast<double>(latencyMs) - quality.latencyMs);
+    }
+    quality.latencySamples++;
+}
+
+void NetScore::RemoveSupplier(uint32_t supplierId)
+{
+    qualities_.erase(supplierId);
+}
+
+void NetScore::SetWeights(const NetScoreWeights &weights)
+{
+    weights_ = weights;
+    // Let the new weights apply at once instead of waiting to leave the dead band.
+    for (auto &item : qualities_) {
+        item.second.hasBonus = false;
+    }
+}
+
+NetScoreWeights NetScore::GetWeights() const
+{
+    return weights_;
+}
+
+static std::string TrimSpace(const std::string &str)
+{
+    const char *space = " \t\r";
+    size_t begin = str.find_first_not_of(space);
+    if (begin == std::string::npos) {
+        return "";
+    }
+    return str.substr(begin, str.find_last_not_of(space) - begin + 1);
+}
+
+bool NetScore::LoadWeights(const std::string &fileName)
+{
+    std::ifstream file(fileName);
+    if (!file.is_open()) {
+        NETMGR_LOG_D("No score weights file [%{public}s], keep the current weights", fileName.c_str());
+        return false;
+    }
+    NetScoreWeights weights = weights_;
+    std::unordered_map<std::string, int32_t *> fields = {
+        {"bandwidth", &weights.bandwidth},
+        {"latency", &weights.latency},
+        {"stability", &weights.stability},
+        {"unmetered", &weights.unmetered},
+        {"hysteresis", &weights.hysteresis}};
+    std::string line;
+    while (std::getline(file, line)) {
+        line = TrimSpace(line.substr(0, line.find('#')));
+        size_t pos = line.find('=');
+        if (line.empty() || pos == std::string::npos) {
+            continue;
+        }
+        std::string name = TrimSpace(line.substr(0, pos));
+        std::string value = TrimSpace(line.substr(pos + 1));
+        auto iter = fields.find(name);
+        char *end = nullptr;
+        long number = std::strtol(value.c_str(), &end, 10);
+        if (iter == fields.end() || value.empty() || *end != '\0' || number < 0 || number > INT32_MAX) {
+            NETMGR_LOG_E("Ignore score weight line [%{public}s]", line.c_str());
+            continue;
+        }
+        *iter->second = static_cast<int32_t>(number);
+    }
+    SetWeights(weights);
+    NETMGR_LOG_I("Score weights bandwidth[%{public}d] latency[%{public}d] stability[%{public}d] "
+        "unmetered[%{public}d] hysteresis[%{public}d]", weights.bandwidth, weights.latency, weights.stability,
+        weights.unmetered, weights.hysteresis);
     return true;
 }
 } // namespace NetManagerStandard
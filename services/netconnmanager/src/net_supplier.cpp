@@ -34,6 +34,8 @@ NetSupplier::NetSupplier(
 {
     netAllCapabilities_.netCaps_ = netCaps;
     netAllCapabilities_.bearerTypes_.insert(bearerType);
+    netCapsMask_ = NetAllCapabilities::ToCapsMask(netAllCapabilities_.netCaps_);
+    bearerTypesMask_ = NetAllCapabilities::ToBearerTypesMask(netAllCapabilities_.bearerTypes_);
 }
 
 NetSupplier::~NetSupplier() {}
@@ -111,11 +113,21 @@ std::set<NetCap> NetSupplier::GetNetCaps()
     return netCaps_;
 }
 
-NetAllCapabilities NetSupplier::GetNetCapabilities() const
+const NetAllCapabilities &NetSupplier::GetNetCapabilities() const
 {
     return netAllCapabilities_;
 }
 
+uint32_t NetSupplier::GetNetCapsMask() const
+{
+    return netCapsMask_;
+}
+
+uint32_t NetSupplier::GetBearerTypesMask() const
+{
+    return bearerTypesMask_;
+}
+
 NetLinkInfo NetSupplier::GetNetLinkInfo() const
 {
     return netLinkInfo_;
@@ -338,8 +350,7 @@ void NetSupplier::ReceiveBestScore(uint32_t reqId, int32_t bestScore, uint32_t s
         SupplierDisconnection(netCaps_);
         return;
     }
-    std::set<uint32_t>::iterator iter = requestList_.find(reqId);
-    if (iter == requestList_.end()) {
+    if (requestList_.find(reqId) == requestList_.end()) {
         NETMGR_LOG_D("NetSupplier::ReceiveBestScore, supplierId[%{public}d], can not find request[%{public}d]",
                      supplierId_, reqId);
         return;
@@ -355,8 +366,7 @@ void NetSupplier::ReceiveBestScore(uint32_t reqId, int32_t bestScore, uint32_t s
 
 int32_t NetSupplier::CancelRequest(uint32_t reqId)
 {
-    std::set<uint32_t>::iterator iter = requestList_.find(reqId);
-    if (iter == requestList_.end()) {
+    if (requestList_.find(reqId) == requestList_.end()) {
         return ERR_SERVICE_NO_REQUEST;
     }
     requestList_.erase(reqId);
@@ -367,6 +377,11 @@ int32_t NetSupplier::CancelRequest(uint32_t reqId)
     return ERR_NONE;
 }
 
+bool NetSupplier::HasRequest(uint32_t reqId) const
+{
+    return requestList_.find(reqId) != requestList_.end();
+}
+
 void NetSupplier::RemoveBestRequest(uint32_t reqId)
 {
     NETMGR_LOG_D("Enter RemoveBestRequest");
@@ -378,7 +393,7 @@ void NetSupplier::RemoveBestRequest(uint32_t reqId)
     return;
 }
 
-std::set<uint32_t>& NetSupplier::GetBestRequestList()
+std::unordered_set<uint32_t>& NetSupplier::GetBestRequestList()
 {
     return bestReqList_;
 }
@@ -394,6 +409,7 @@ void NetSupplier::SetNetValid(bool ifValid)
     if (ifNetValid_) {
         netAllCapabilities_.netCaps_.insert(NET_CAPABILITY_VALIDATED);
     }
+    netCapsMask_ = NetAllCapabilities::ToCapsMask(netAllCapabilities_.netCaps_);
 }
 
 bool NetSupplier::IfNetValid()
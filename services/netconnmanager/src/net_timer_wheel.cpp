@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "net_timer_wheel.h"
+
+#include <algorithm>
+#include <pthread.h>
+#include <random>
+#include <vector>
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint32_t PERCENT = 100;
+constexpr uint32_t MAX_BACKOFF_SHIFT = 31;
+} // namespace
+
+NetTimerWheel &NetTimerWheel::GetInstance()
+{
+    static NetTimerWheel instance;
+    return instance;
+}
+
+NetTimerWheel::NetTimerWheel(uint32_t tickMs, const Clock &clock)
+    : tick_(tickMs == 0 ? DEFAULT_TICK_MS : tickMs), clock_(clock ? clock : std::chrono::steady_clock::now),
+      start_(clock_())
+{
+    thread_ = std::thread([this]() { Run(); });
+    pthread_setname_np(thread_.native_handle(), "NetTimerWheel");
+}
+
+NetTimerWheel::~NetTimerWheel()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        exit_ = true;
+        condition_.notify_one();
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+uint64_t NetTimerWheel::Schedule(uint32_t delayMs, const Callback &callback)
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(clock_() - start_);
+    uint64_t expireMs = static_cast<uint64_t>(elapsed.count()) + delayMs;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (timers_.empty()) {
+        // Nothing is in the wheel, so it can jump to now instead of ticking through the idle time
+        currentTick_ = std::max(currentTick_, static_cast<uint64_t>(elapsed.count() / tick_.count()));
+    }
+    uint64_t expireTick = std::max<uint64_t>((expireMs + tick_.count() - 1) / tick_.count(), currentTick_);
+    uint64_t timerId = nextTimerId_++;
+    Slot &slot = SlotFor(expireTick);
+    slot.push_back(TimerNode {timerId, expireTick, callback});
+    timers_[timerId] = Location {&slot, std::prev(slot.end())};
+    condition_.notify_one();
+    return timerId;
+}
+
+bool NetTimerWheel::Cancel(uint64_t timerId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = timers_.find(timerId);
+    if (it == timers_.end()) {
+        return false;
+    }
+    it->second.slot->erase(it->second.node);
+    timers_.erase(it);
+    return true;
+}
+
+uint32_t NetTimerWheel::Jitter(uint32_t intervalMs, uint32_t jitterPercent)
+{
+    uint32_t range = static_cast<uint32_t>(static_cast<uint64_t>(intervalMs) * jitterPercent / PERCENT);
+    if (range == 0) {
+        return intervalMs;
+    }
+    thread_local std::minstd_rand engine(std::random_device {}());
+    std::uniform_int_distribution<uint32_t> distribution(0, range * 2);
+    return intervalMs - range + distribution(engine);
+}
+
+uint32_t NetTimerWheel::Backoff(uint32_t baseMs, uint32_t attempt, uint32_t maxMs)
+{
+    uint64_t interval = static_cast<uint64_t>(baseMs) << std::min(attempt, MAX_BACKOFF_SHIFT);
+    return static_cast<uint32_t>(std::min<uint64_t>(interval, maxMs));
+}
+
+uint64_t NetTimerWheel::NowTick() const
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(clock_() - start_);
+    return static_cast<uint64_t>(elapsed.count() / tick_.count());
+}
+
+NetTimerWheel::Slot &NetTimerWheel::SlotFor(uint64_t expireTick)
+{
+    if (expireTick < currentTick_) {
+        expireTick = currentTick_;
+    }
+    // Out of reach, the node keeps its real expiry and is placed again when this slot cascades
+    uint64_t delta = std::min(expireTick - currentTick_, MAX_DELTA_TICKS);
+    expireTick = currentTick_ + delta;
+    uint32_t level = 0;
+    while (level + 1 < LEVEL_NUM && delta >= (1ULL << (SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    return wheels_[level][(expireTick >> (SLOT_BITS * level)) & SLOT_MASK];
+}
+
+void NetTimerWheel::Place(Slot &from, Slot::iterator node)
+{
+    Slot &to = SlotFor(node->expireTick);
+    to.splice(to.end(), from, node);
+    timers_[node->id] = Location {&to, node};
+}
+
+void NetTimerWheel::Cascade(uint32_t level)
+{
+    Slot &slot = wheels_[level][(currentTick_ >> (SLOT_BITS * level)) & SLOT_MASK];
+    while (!slot.empty()) {
+        Place(slot, slot.begin());
+    }
+}
+
+void NetTimerWheel::ProcessTick(std::vector<Callback> &expired)
+{
+    // Each time a level wraps, the next slot of the level above is spread over the lower levels.
+    for (uint32_t level = 1; level < LEVEL_NUM; level++) {
+        if (((currentTick_ >> (SLOT_BITS * (level - 1))) & SLOT_MASK) != 0) {
+            break;
+        }
+        Cascade(level);
+    }
+    Slot &slot = wheels_[0][currentTick_ & SLOT_MASK];
+    for (auto &node : slot) {
+        timers_.erase(node.id);
+        expired.push_back(std::move(node.callback));
+    }
+    slot.clear();
+    currentTick_++;
+}
+
+uint64_t NetTimerWheel::NextWakeTick() const
+{
+    // Look ahead on the lowest level only, otherwise wake up at the next cascade.
+    for (uint64_t tick = currentTick_; tick < currentTick_ + SLOT_NUM; tick++) {
+        if (!wheels_[0][tick & SLOT_MASK].empty() || (tick & SLOT_MASK) == 0) {
+            return tick;
+        }
+    }
+    return currentTick_ + SLOT_NUM;
+}
+
+void NetTimerWheel::Run()
+{
+    std::vector<Callback> expired;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!exit_) {
+        if (timers_.empty()) {
+            currentTick_ = std::max(currentTick_, NowTick());
+            condition_.wait(lock);
+            continue;
+        }
+        uint64_t nowTick = NowTick();
+        if (currentTick_ > nowTick) {
+            condition_.wait_for(lock, start_ + tick_ * NextWakeTick() - clock_());
+            continue;
+        }
+        while (currentTick_ <= nowTick) {
+            ProcessTick(expired);
+            // Ticks with neither a timer nor a cascade are skipped when catching up
+            currentTick_ = std::max(currentTick_, std::min(NextWakeTick(), nowTick + 1));
+        }
+        lock.unlock();
+        for (auto &callback : expired) {
+            if (callback) {
+                callback();
+            }
+        }
+        expired.clear();
+        lock.lock();
+    }
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
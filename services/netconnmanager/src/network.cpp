@@ -16,14 +16,16 @@
 #include "network.h"
 #include "netsys_controller.h"
 #include "net_mgr_log_wrapper.h"
+#include "net_probe_engine.h"
 #include "securec.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
-Network::Network(int32_t netId, uint32_t supplierId, NetDetectionHandler handler)
-    : netId_(netId), supplierId_(supplierId), netCallback_(handler)
+Network::Network(int32_t netId, uint32_t supplierId, NetDetectionHandler handler,
+    NetQualityHandler qualityHandler)
+    : netId_(netId), supplierId_(supplierId), netCallback_(handler), netQualityCallback_(qualityHandler)
 {
-    StartDetectionThread();
+    InitNetMonitor();
 }
 
 Network::~Network()
@@ -32,7 +34,7 @@ Network::~Network()
         NETMGR_LOG_E("ReleaseBasicNetwork fail.");
     }
     if (netMonitor_ != nullptr) {
-        netMonitor_->StopNetMonitorThread();
+        netMonitor_->Stop();
     }
 }
 
@@ -84,6 +86,7 @@ bool Network::ReleaseBasicNetwork()
             NetsysController::GetInstance().InterfaceDelAddress(netLinkInfo_.ifaceName_, inetAddr.address_, prefixLen);
         }
         NetsysController::GetInstance().NetworkRemoveInterface(netId_, netLinkInfo_.ifaceName_);
+        NetProbeEngine::GetInstance().ReleaseInterface(netLinkInfo_.ifaceName_);
         NetsysController::GetInstance().NetworkDestroy(netId_);
         NetsysController::GetInstance().DestroyNetworkCache(netId_);
         netLinkInfo_.Initialize();
@@ -124,6 +127,7 @@ void Network::UpdateInterfaces(const NetLinkInfo &netLinkInfo)
     }
     if (!netLinkInfo_.ifaceName_.empty()) {
         NetsysController::GetInstance().NetworkRemoveInterface(netId_, netLinkInfo_.ifaceName_);
+        NetProbeEngine::GetInstance().ReleaseInterface(netLinkInfo_.ifaceName_);
     }
     netLinkInfo_.ifaceName_ = netLinkInfo.ifaceName_;
     NETMGR_LOG_D("Network UpdateInterfaces out.");
@@ -286,7 +290,7 @@ void Network::StartNetDetection()
 {
     NETMGR_LOG_D("Enter Network::StartNetDetection");
     if (netMonitor_ != nullptr) {
-        netMonitor_->SignalNetMonitorThread(netLinkInfo_.ifaceName_);
+        netMonitor_->Start(netLinkInfo_.ifaceName_);
     }
 }
 
@@ -294,7 +298,7 @@ void Network::StopNetDetection()
 {
     NETMGR_LOG_D("Enter Network::StopNetDetection");
     if (netMonitor_ != nullptr) {
-        netMonitor_->StopNetMonitorThread();
+        netMonitor_->Stop();
     }
 }
 
@@ -303,16 +307,28 @@ void Network::SetExternDetection()
     isExternDetection_ = true;
 }
 
-void Network::StartDetectionThread()
+void Network::InitNetMonitor()
 {
     netDetectionState_ = INVALID_DETECTION_STATE;
-    netMonitor_ = std::make_unique<NetMonitor>(
-        std::bind(&Network::HandleNetMonitorResult, this, std::placeholders::_1, std::placeholders::_2));
+    // The result only goes through the handler, the network itself is updated on its owner's thread.
+    uint32_t supplierId = supplierId_;
+    NetDetectionHandler handler = netCallback_;
+    netMonitor_ = std::make_shared<NetMonitor>(
+        [supplierId, handler](NetDetectionStatus netDetectionState, const std::string &urlRedirect) {
+            if (handler) {
+                handler(supplierId, netDetectionState, urlRedirect);
+            }
+        });
     if (netMonitor_ == nullptr) {
-        NETMGR_LOG_E("make_unique NetMonitor failed,netMonitor_ is null!");
+        NETMGR_LOG_E("make_shared NetMonitor failed,netMonitor_ is null!");
         return;
     }
-    netMonitor_->InitNetMonitorThread();
+    if (netQualityCallback_) {
+        NetQualityHandler qualityCallback = netQualityCallback_;
+        netMonitor_->SetQualityHandler([supplierId, qualityCallback](bool reachable, int64_t latencyMs) {
+            qualityCallback(supplierId, reachable, latencyMs);
+        });
+    }
 }
 
 uint64_t Network::GetNetWorkMonitorResult()
@@ -320,7 +336,8 @@ uint64_t Network::GetNetWorkMonitorResult()
     return netDetectionState_;
 }
 
-void Network::HandleNetMonitorResult(NetDetectionStatus netDetectionState, const std::string &urlRedirect)
+bool Network::HandleNetMonitorResult(NetDetectionStatus netDetectionState, const std::string &urlRedirect,
+    std::vector<sptr<INetDetectionCallback>> &callbacks)
 {
     NETMGR_LOG_D("HandleNetMonitorResult, oldState[%{public}d], newState[%{public}d], isExternDetection[%{public}d]",
                  netDetectionState_, netDetectionState, isExternDetection_);
@@ -331,22 +348,12 @@ void Network::HandleNetMonitorResult(NetDetectionStatus netDetectionState, const
     }
     if (needReport) {
         NETMGR_LOG_D("need to report net detection result.");
-        NotifyNetDetectionResult(NetDetectionResultConvert(static_cast<int32_t>(netDetectionState)), urlRedirect);
-        if (netCallback_) {
-            netCallback_(supplierId_, netDetectionState == VERIFICATION_STATE);
-        }
+        callbacks = netDetectionRetCallback_;
     }
     netDetectionState_ = netDetectionState;
     urlRedirect_ = urlRedirect;
     NETMGR_LOG_D("HandleNetMonitorResult out.");
-}
-
-void Network::NotifyNetDetectionResult(NetDetectionResultCode detectionResult, const std::string &urlRedirect)
-{
-    for (auto callback : netDetectionRetCallback_) {
-        NETMGR_LOG_D("start callback!");
-        callback->OnNetDetectionResultChanged(detectionResult, urlRedirect);
-    }
+    return needReport;
 }
 
 NetDetectionResultCode Network::NetDetectionResultConvert(int32_t internalRet)
@@ -219,6 +219,63 @@ int32_t NetConnCallbackProxy::NetBlockStatusChange(sptr<NetHandle> &netHandle, b
     return ret;
 }
 
+int32_t NetConnCallbackProxy::NetCallbackBatch(const sptr<NetConnCallbackBatch> &batch)
+{
+    if (batch == nullptr) {
+        return ERR_NULL_OBJECT;
+    }
+
+    MessageParcel data;
+    if (!WriteInterfaceToken(data)) {
+        NETMGR_LOG_E("WriteInterfaceToken failed");
+        return ERR_FLATTEN_OBJECT;
+    }
+    if (!batch->Marshalling(data)) {
+        NETMGR_LOG_E("proxy Marshalling failed");
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        NETMGR_LOG_E("Remote is null");
+        return ERR_NULL_OBJECT;
+    }
+    MessageParcel reply;
+    MessageOption option;
+    option.SetFlags(MessageOption::TF_ASYNC);
+    int32_t ret = remote->SendRequest(NET_CALLBACK_BATCH, data, reply, option);
+    if (ret != ERR_NONE) {
+        NETMGR_LOG_E("Proxy SendRequest failed, ret code:[%{public}d]", ret);
+    }
+    return ret;
+}
+
+int32_t NetConnCallbackProxy::NetStateVersionChange(uint64_t version)
+{
+    MessageParcel data;
+    if (!WriteInterfaceToken(data)) {
+        NETMGR_LOG_E("WriteInterfaceToken failed");
+        return ERR_FLATTEN_OBJECT;
+    }
+    if (!data.WriteUint64(version)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        NETMGR_LOG_E("Remote is null");
+        return ERR_NULL_OBJECT;
+    }
+    MessageParcel reply;
+    MessageOption option;
+    option.SetFlags(MessageOption::TF_ASYNC);
+    int32_t ret = remote->SendRequest(NET_STATE_VERSION_CHANGE, data, reply, option);
+    if (ret != ERR_NONE) {
+        NETMGR_LOG_E("Proxy SendRequest failed, ret code:[%{public}d]", ret);
+    }
+    return ret;
+}
+
 bool NetConnCallbackProxy::WriteInterfaceToken(MessageParcel &data)
 {
     if (!data.WriteInterfaceToken(NetConnCallbackProxy::GetDescriptor())) {
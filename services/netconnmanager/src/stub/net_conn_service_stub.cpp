@@ -51,6 +51,9 @@ NetConnServiceStub::NetConnServiceStub()
     memberFuncMap_[CMD_NM_REGISTER_NET_SUPPLIER_CALLBACK] = &NetConnServiceStub::OnRegisterNetSupplierCallback;
     memberFuncMap_[CMD_NM_SET_AIRPLANE_MODE] = &NetConnServiceStub::OnSetAirplaneMode;
     memberFuncMap_[CMD_NM_RESTORE_FACTORY_DATA] = &NetConnServiceStub::OnRestoreFactoryData;
+    memberFuncMap_[CMD_NM_REGISTER_NET_STATE_CALLBACK] = &NetConnServiceStub::OnRegisterNetStateCallback;
+    memberFuncMap_[CMD_NM_GET_NET_STATE_PAGE] = &NetConnServiceStub::OnGetNetStatePage;
+    memberFuncMap_[CMD_NM_UNREGISTER_NET_STATE_CALLBACK] = &NetConnServiceStub::OnUnregisterNetStateCallback;
 }
 
 NetConnServiceStub::~NetConnServiceStub() {}
@@ -705,5 +708,60 @@ int32_t NetConnServiceStub::OnRestoreFactoryData(MessageParcel &data, MessagePar
     }
     return ret;
 }
+
+int32_t NetConnServiceStub::OnRegisterNetStateCallback(MessageParcel &data, MessageParcel &reply)
+{
+    sptr<IRemoteObject> remote = data.ReadRemoteObject();
+    if (remote == nullptr) {
+        NETMGR_LOG_E("Callback ptr is nullptr.");
+        return NET_CONN_ERR_GET_REMOTE_OBJECT_FAILED;
+    }
+    sptr<INetConnCallback> callback = iface_cast<INetConnCallback>(remote);
+    if (callback == nullptr) {
+        return NET_CONN_ERR_INPUT_NULL_PTR;
+    }
+
+    uint64_t version = 0;
+    int32_t ret = RegisterNetStateCallback(callback, version);
+    if (!reply.WriteInt32(ret)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+    if (ret == ERR_NONE && !reply.WriteUint64(version)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+    return ret;
+}
+
+int32_t NetConnServiceStub::OnGetNetStatePage(MessageParcel &data, MessageParcel &reply)
+{
+    sptr<Ashmem> page = nullptr;
+    int32_t ret = GetNetStatePage(page);
+    if (!reply.WriteInt32(ret)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+    if (ret == ERR_NONE && !reply.WriteAshmem(page)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+    return ret;
+}
+
+int32_t NetConnServiceStub::OnUnregisterNetStateCallback(MessageParcel &data, MessageParcel &reply)
+{
+    sptr<IRemoteObject> remote = data.ReadRemoteObject();
+    if (remote == nullptr) {
+        NETMGR_LOG_E("Callback ptr is nullptr.");
+        return NET_CONN_ERR_GET_REMOTE_OBJECT_FAILED;
+    }
+    sptr<INetConnCallback> callback = iface_cast<INetConnCallback>(remote);
+    if (callback == nullptr) {
+        return NET_CONN_ERR_INPUT_NULL_PTR;
+    }
+
+    int32_t ret = UnregisterNetStateCallback(callback);
+    if (!reply.WriteInt32(ret)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+    return ret;
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INCLUDE_FIREWALL_CONTROLLER_H__
+#define INCLUDE_FIREWALL_CONTROLLER_H__
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace nmd {
+enum FirewallChain {
+    FIREWALL_CHAIN_NONE = 0,
+    // Deny list: member uids have no network access at all
+    FIREWALL_CHAIN_DENY_ALL = 1,
+    // Deny list: member uids have no access through the interfaces attached to the chain
+    FIREWALL_CHAIN_DENY_METERED = 2,
+    // Allow list: while the chain is enabled only member uids and system uids have network access
+    FIREWALL_CHAIN_ALLOW_IDLE = 3,
+};
+
+/**
+ * Kernel enforced per uid firewall.
+ *
+ * Every chain is an iptables/ip6tables filter chain holding one owner match rule per member uid, reached from
+ * OUTPUT through a root chain owned by netsys. Membership changes are applied as incremental rule inserts and
+ * deletes, batched through iptables-restore --noflush, the chains are never rebuilt. Thread safe.
+ *
+ * IPv4 and IPv6 keep their own view of the chains, a change is computed and committed per family. When one family
+ * fails the call returns -1, and repeating it only applies what that family still misses.
+ */
+class FirewallController {
+public:
+    /**
+     * Feeds one iptables-restore batch to the tool at path, returns 0 if the tool accepted it
+     */
+    using RestoreRunner = std::function<int(const char *path, const std::string &batch)>;
+
+    FirewallController();
+    explicit FirewallController(const RestoreRunner &runner);
+    ~FirewallController() = default;
+
+    /**
+     * @brief Create the chains and hook the root chain into OUTPUT, the deny all chain starts enabled
+     *
+     * @return 0 on success, -1 if iptables could not be updated
+     */
+    int Init();
+
+    /**
+     * @brief Add a uid to, or remove it from, a chain
+     *
+     * @param chain The chain
+     * @param uid The uid
+     * @param member true to add the uid, false to remove it
+     * @return 0 on success or if nothing changed, -1 otherwise
+     */
+    int SetUidRule(FirewallChain chain, uint32_t uid, bool member);
+
+    /**
+     * @brief Replace the members of a chain, only the difference with the current members is applied
+     *
+     * @param chain The chain
+     * @param uids The new members
+     * @return 0 on success, -1 otherwise
+     */
+    int SetUids(FirewallChain chain, const std::vector<uint32_t> &uids);
+
+    /**
+     * @brief Attach a chain to, or detach it from, every interface
+     *
+     * @param chain The chain
+     * @param enable true to attach
+     * @return 0 on success or if nothing changed, -1 otherwise
+     */
+    int EnableChain(FirewallChain chain, bool enable);
+
+    /**
+     * @brief Attach a chain to, or detach it from, one interface
+     *
+     * @param chain The chain
+     * @param iface The interface name
+     * @param attach true to attach
+     * @return 0 on success or if nothing changed, -1 otherwise
+     */
+    int SetChainInterface(FirewallChain chain, const std::string &iface, bool attach);
+
+private:
+    struct ChainState {
+        std::set<uint32_t> uids;
+        std::set<std::string> ifaces;
+        bool enabled = false;
+    };
+
+    static const char *GetChainName(FirewallChain chain);
+    static bool IsAllowChain(FirewallChain chain);
+    static bool IsValidIfaceName(const std::string &iface);
+    static std::string MakeUidRule(char op, FirewallChain chain, uint32_t uid);
+    static std::string MakeHookRule(char op, FirewallChain chain, const std::string &iface);
+    static int RunRestore(const char *path, const std::string &rules);
+    int Apply(size_t family, const std::string &rules);
+    /* Apply the rules built from the state of each family, commit is run on the states whose family succeeded */
+    int UpdateChain(FirewallChain chain, const std::function<std::string(const ChainState &)> &makeRules,
+        const std::function<void(ChainState &)> &commit);
+
+private:
+    static constexpr size_t FAMILY_NUM = 2;
+
+    RestoreRunner runner_;
+    std::mutex mutex_;
+    // Indexed by family, IPv4 first
+    std::map<FirewallChain, ChainState> chains_[FAMILY_NUM];
+};
+} // namespace nmd
+} // namespace OHOS
+#endif // !INCLUDE_FIREWALL_CONTROLLER_H__
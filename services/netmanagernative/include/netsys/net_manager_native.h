@@ -16,6 +16,7 @@
 #ifndef INCLUDE_NET_MANAGER_NATIVE_H__
 #define INCLUDE_NET_MANAGER_NATIVE_H__
 
+#include <firewall_controller.h>
 #include <interface_controller.h>
 #include <memory>
 #include <network_controller.h>
@@ -89,10 +90,16 @@ public:
     long GetTetherRxBytes();
     long GetTetherTxBytes();
 
+    int FirewallSetUidRule(uint32_t chain, uint32_t uid, bool member);
+    int FirewallSetUids(uint32_t chain, const std::vector<uint32_t> &uids);
+    int FirewallEnableChain(uint32_t chain, bool enable);
+    int FirewallSetChainInterface(uint32_t chain, const std::string &iface, bool attach);
+
 private:
     std::shared_ptr<NetworkController> networkController;
     std::shared_ptr<RouteController> routeController;
     std::shared_ptr<InterfaceController> interfaceController;
+    std::shared_ptr<FirewallController> firewallController;
     static std::vector<unsigned int> interfaceIdex;
 };
 } // namespace nmd
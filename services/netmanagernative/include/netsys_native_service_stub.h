@@ -68,6 +68,10 @@ private:
     int32_t CmdStopDhcpClient(MessageParcel &data, MessageParcel &reply);
     int32_t CmdStartDhcpService(MessageParcel &data, MessageParcel &reply);
     int32_t CmdStopDhcpService(MessageParcel &data, MessageParcel &reply);
+    int32_t CmdFirewallSetUidRule(MessageParcel &data, MessageParcel &reply);
+    int32_t CmdFirewallSetUids(MessageParcel &data, MessageParcel &reply);
+    int32_t CmdFirewallEnableChain(MessageParcel &data, MessageParcel &reply);
+    int32_t CmdFirewallSetChainInterface(MessageParcel &data, MessageParcel &reply);
 };
 } // namespace NetsysNative
 } // namespace OHOS
@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "firewall_controller.h"
+
+#include <cctype>
+#include <cerrno>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "netnative_log_wrapper.h"
+
+namespace OHOS {
+namespace nmd {
+namespace {
+constexpr const char *IPTABLES_RESTORE_PATH = "/system/bin/iptables-restore";
+constexpr const char *IP6TABLES_RESTORE_PATH = "/system/bin/ip6tables-restore";
+const char *const RESTORE_PATHS[] = {IPTABLES_RESTORE_PATH, IP6TABLES_RESTORE_PATH};
+constexpr const char *ROOT_CHAIN = "ohfw_OUTPUT";
+constexpr const char *SYSTEM_UID_RANGE = "0-9999";
+constexpr int EXEC_FAILED_EXIT_CODE = 127;
+// Stale OUTPUT hooks left by a previous netsys instance that are removed at init
+constexpr int MAX_STALE_HOOKS = 8;
+const FirewallChain ALL_CHAINS[] = {
+    FIREWALL_CHAIN_DENY_ALL,
+    FIREWALL_CHAIN_DENY_METERED,
+    FIREWALL_CHAIN_ALLOW_IDLE,
+};
+} // namespace
+
+FirewallController::FirewallController() : FirewallController(RunRestore) {}
+
+FirewallController::FirewallController(const RestoreRunner &runner) : runner_(runner)
+{
+    for (auto &chains : chains_) {
+        for (FirewallChain chain : ALL_CHAINS) {
+            chains[chain] = ChainState();
+        }
+    }
+}
+
+const char *FirewallController::GetChainName(FirewallChain chain)
+{
+    switch (chain) {
+        case FIREWALL_CHAIN_DENY_ALL:
+            return "ohfw_deny_all";
+        case FIREWALL_CHAIN_DENY_METERED:
+            return "ohfw_deny_metered";
+        case FIREWALL_CHAIN_ALLOW_IDLE:
+            return "ohfw_allow_idle";
+        default:
+            return nullptr;
+    }
+}
+
+bool FirewallController::IsAllowChain(FirewallChain chain)
+{
+    return chain == FIREWALL_CHAIN_ALLOW_IDLE;
+}
+
+bool FirewallController::IsValidIfaceName(const std::string &iface)
+{
+    if (iface.empty() || iface.size() >= IFNAMSIZ) {
+        return false;
+    }
+    for (char c : iface) {
+        if (!isalnum(static_cast<unsigned char>(c)) && c != '_' && c != '-' && c != '.') {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string FirewallController::MakeUidRule(char op, FirewallChain chain, uint32_t uid)
+{
+    std::string chainName = GetChainName(chain);
+    std::string match = " -m owner --uid-owner " + std::to_string(uid);
+    if (!IsAllowChain(chain)) {
+        return std::string("-") + op + " " + chainName + match + " -j DROP\n";
+    }
+    // Allow rules go in front of the trailing DROP
+    std::string position = (op == 'A') ? ("-I " + chainName + " 1") : ("-D " + chainName);
+    return position + match + " -j RETURN\n";
+}
+
+std::string FirewallController::MakeHookRule(char op, FirewallChain chain, const std::string &iface)
+{
+    std::string rule = std::string("-") + op + " " + ROOT_CHAIN;
+    if (!iface.empty()) {
+        rule += " -o " + iface;
+    }
+    return rule + " -j " + GetChainName(chain) + "\n";
+}
+
+int FirewallController::RunRestore(const char *path, const std::string &rules)
+{
+    int fds[2] = {-1, -1};
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) {
+        NETNATIVE_LOGE("socketpair failed, errno %{public}d", errno);
+        return -1;
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        NETNATIVE_LOGE("fork failed, errno %{public}d", errno);
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+    }
+    if (pid == 0) {
+        // Only async signal safe calls between fork and exec
+        char noflush[] = "--noflush";
+        char waitFlag[] = "-w";
+        char *const argv[] = {const_cast<char *>(path), noflush, waitFlag, nullptr};
+        if (dup2(fds[1], STDIN_FILENO) >= 0) {
+            execv(path, argv);
+        }
+        _exit(EXEC_FAILED_EXIT_CODE);
+    }
+    close(fds[1]);
+    size_t written = 0;
+    while (written < rules.size()) {
+        ssize_t len = send(fds[0], rules.data() + written, rules.size() - written, MSG_NOSIGNAL);
+        if (len < 0 && errno == EINTR) {
+            continue;
+        }
+        if (len <= 0) {
+            break;
+        }
+        written += static_cast<size_t>(len);
+    }
+    close(fds[0]);
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) {
+            NETNATIVE_LOGE("waitpid failed, errno %{public}d", errno);
+            return -1;
+        }
+    }
+    if (written != rules.size() || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        NETNATIVE_LOGE("%{public}s failed, status %{public}d", path, status);
+        return -1;
+    }
+    return 0;
+}
+
+int FirewallController::Apply(size_t family, const std::string &rules)
+{
+    return runner_(RESTORE_PATHS[family], "*filter\n" + rules + "COMMIT\n");
+}
+
+int FirewallController::UpdateChain(FirewallChain chain,
+    const std::function<std::string(const ChainState &)> &makeRules, const std::function<void(ChainState &)> &commit)
+{
+    int ret = 0;
+    for (size_t family = 0; family < FAMILY_NUM; family++) {
+        ChainState &state = chains_[family][chain];
+        std::string rules = makeRules(state);
+        if (rules.empty()) {
+            continue;
+        }
+        if (Apply(family, rules) != 0) {
+            ret = -1;
+            continue;
+        }
+        commit(state);
+    }
+    return ret;
+}
+
+int FirewallController::Init()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string unhook = std::string("-D OUTPUT -j ") + ROOT_CHAIN + "\n";
+    // Declaring a chain in iptables-restore creates it, or flushes it if it already exists
+    std::string rules = std::string(":") + ROOT_CHAIN + " - [0:0]\n";
+    for (FirewallChain chain : ALL_CHAINS) {
+        rules += std::string(":") + GetChainName(chain) + " - [0:0]\n";
+    }
+    const char *idleChain = GetChainName(FIREWALL_CHAIN_ALLOW_IDLE);
+    rules += std::string("-A ") + idleChain + " -o lo -j RETURN\n";
+    rules += std::string("-A ") + idleChain + " -m owner --uid-owner " + SYSTEM_UID_RANGE + " -j RETURN\n";
+    rules += std::string("-A ") + idleChain + " -j DROP\n";
+    rules += MakeHookRule('A', FIREWALL_CHAIN_DENY_ALL, "");
+    rules += std::string("-I OUTPUT -j ") + ROOT_CHAIN + "\n";
+
+    int ret = 0;
+    for (size_t family = 0; family < FAMILY_NUM; family++) {
+        int stale = 0;
+        while (stale < MAX_STALE_HOOKS && Apply(family, unhook) == 0) {
+            ++stale;
+        }
+        for (FirewallChain chain : ALL_CHAINS) {
+            chains_[family][chain] = ChainState();
+        }
+        if (Apply(family, rules) != 0) {
+            NETNATIVE_LOGE("FirewallController init of %{public}s failed", RESTORE_PATHS[family]);
+            ret = -1;
+            continue;
+        }
+        chains_[family][FIREWALL_CHAIN_DENY_ALL].enabled = true;
+    }
+    return ret;
+}
+
+int FirewallController::SetUidRule(FirewallChain chain, uint32_t uid, bool member)
+{
+    if (GetChainName(chain) == nullptr) {
+        NETNATIVE_LOGE("SetUidRule invalid chain %{public}d", chain);
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return UpdateChain(chain, [chain, uid, member](const ChainState &state) {
+        if ((state.uids.count(uid) != 0) == member) {
+            return std::string();
+        }
+        return MakeUidRule(member ? 'A' : 'D', chain, uid);
+    }, [uid, member](ChainState &state) {
+        if (member) {
+            state.uids.insert(uid);
+        } else {
+            state.uids.erase(uid);
+        }
+    });
+}
+
+int FirewallController::SetUids(FirewallChain chain, const std::vector<uint32_t> &uids)
+{
+    if (GetChainName(chain) == nullptr) {
+        NETNATIVE_LOGE("SetUids invalid chain %{public}d", chain);
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::set<uint32_t> target(uids.begin(), uids.end());
+    return UpdateChain(chain, [chain, &target](const ChainState &state) {
+        std::string rules;
+        for (uint32_t uid : state.uids) {
+            if (target.count(uid) == 0) {
+                rules += MakeUidRule('D', chain, uid);
+            }
+        }
+        for (uint32_t uid : target) {
+            if (state.uids.count(uid) == 0) {
+                rules += MakeUidRule('A', chain, uid);
+            }
+        }
+        return rules;
+    }, [&target](ChainState &state) { state.uids = target; });
+}
+
+int FirewallController::EnableChain(FirewallChain chain, bool enable)
+{
+    if (GetChainName(chain) == nullptr) {
+        NETNATIVE_LOGE("EnableChain invalid chain %{public}d", chain);
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return UpdateChain(chain, [chain, enable](const ChainState &state) {
+        return (state.enabled == enable) ? std::string() : MakeHookRule(enable ? 'A' : 'D', chain, "");
+    }, [enable](ChainState &state) { state.enabled = enable; });
+}
+
+int FirewallController::SetChainInterface(FirewallChain chain, const std::string &iface, bool attach)
+{
+    if (GetChainName(chain) == nullptr || !IsValidIfaceName(iface)) {
+        NETNATIVE_LOGE("SetChainInterface invalid chain %{public}d or iface", chain);
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return UpdateChain(chain, [chain, &iface, attach](const ChainState &state) {
+        if ((state.ifaces.count(iface) != 0) == attach) {
+            return std::string();
+        }
+        return MakeHookRule(attach ? 'A' : 'D', chain, iface);
+    }, [&iface, attach](ChainState &state) {
+        if (attach) {
+            state.ifaces.insert(iface);
+        } else {
+            state.ifaces.erase(iface);
+        }
+    });
+}
+} // namespace nmd
+} // namespace OHOS
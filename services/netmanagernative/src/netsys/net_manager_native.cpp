@@ -15,6 +15,7 @@
 
 #include "net_manager_native.h"
 #include <net/if.h>
+#include "firewall_controller.h"
 #include "interface_controller.h"
 #include "netnative_log_wrapper.h"
 #include "network_controller.h"
@@ -28,7 +29,8 @@ namespace nmd {
 NetManagerNative::NetManagerNative()
     : networkController(std::make_shared<NetworkController>()),
       routeController(std::make_shared<RouteController>()),
-      interfaceController(std::make_shared<InterfaceController>())
+      interfaceController(std::make_shared<InterfaceController>()),
+      firewallController(std::make_shared<FirewallController>())
 {}
 
 NetManagerNative::~NetManagerNative() {}
@@ -56,6 +58,9 @@ std::vector<unsigned int> NetManagerNative::GetCurrentInterfaceIndex()
 void NetManagerNative::Init()
 {
     this->GetOriginInterfaceIndex();
+    if (this->firewallController->Init() != 0) {
+        NETNATIVE_LOGE("NetManagerNative::Init firewall init failed");
+    }
 }
 
 int NetManagerNative::NetworkCreatePhysical(int netId, int permission)
@@ -238,5 +243,25 @@ long NetManagerNative::GetTetherTxBytes()
 {
     return 0;
 }
+
+int NetManagerNative::FirewallSetUidRule(uint32_t chain, uint32_t uid, bool member)
+{
+    return this->firewallController->SetUidRule(static_cast<FirewallChain>(chain), uid, member);
+}
+
+int NetManagerNative::FirewallSetUids(uint32_t chain, const std::vector<uint32_t> &uids)
+{
+    return this->firewallController->SetUids(static_cast<FirewallChain>(chain), uids);
+}
+
+int NetManagerNative::FirewallEnableChain(uint32_t chain, bool enable)
+{
+    return this->firewallController->EnableChain(static_cast<FirewallChain>(chain), enable);
+}
+
+int NetManagerNative::FirewallSetChainInterface(uint32_t chain, const std::string &iface, bool attach)
+{
+    return this->firewallController->SetChainInterface(static_cast<FirewallChain>(chain), iface, attach);
+}
 } // namespace nmd
 } // namespace OHOS
@@ -344,5 +344,30 @@ int32_t NetsysNativeService::StopDhcpService(const std::string &iface)
     this->dhcpController_->StopDhcpService(iface);
     return ERR_NONE;
 }
+
+int32_t NetsysNativeService::FirewallSetUidRule(uint32_t chain, uint32_t uid, bool member)
+{
+    NETNATIVE_LOGI("FirewallSetUidRule chain %{public}u uid %{public}u member %{public}d", chain, uid, member);
+    return this->netsysService_->FirewallSetUidRule(chain, uid, member);
+}
+
+int32_t NetsysNativeService::FirewallSetUids(uint32_t chain, const std::vector<uint32_t> &uids)
+{
+    NETNATIVE_LOGI("FirewallSetUids chain %{public}u size %{public}zu", chain, uids.size());
+    return this->netsysService_->FirewallSetUids(chain, uids);
+}
+
+int32_t NetsysNativeService::FirewallEnableChain(uint32_t chain, bool enable)
+{
+    NETNATIVE_LOGI("FirewallEnableChain chain %{public}u enable %{public}d", chain, enable);
+    return this->netsysService_->FirewallEnableChain(chain, enable);
+}
+
+int32_t NetsysNativeService::FirewallSetChainInterface(uint32_t chain, const std::string &iface, bool attach)
+{
+    NETNATIVE_LOGI("FirewallSetChainInterface chain %{public}u iface %{public}s attach %{public}d", chain,
+        iface.c_str(), attach);
+    return this->netsysService_->FirewallSetChainInterface(chain, iface, attach);
+}
 } // namespace NetsysNative
 } // namespace OHOS
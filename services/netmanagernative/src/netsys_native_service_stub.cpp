@@ -29,6 +29,7 @@ namespace NetsysNative {
 using namespace std;
 
 static constexpr const int32_t MAX_FLAG_NUM = 64;
+static constexpr const size_t MAX_FIREWALL_UID_NUM = 65536;
 
 NetsysNativeServiceStub::NetsysNativeServiceStub()
 {
@@ -64,6 +65,10 @@ NetsysNativeServiceStub::NetsysNativeServiceStub()
     opToInterfaceMap_[NETSYS_STOP_DHCP_CLIENT] = &NetsysNativeServiceStub::CmdStopDhcpClient;
     opToInterfaceMap_[NETSYS_START_DHCP_SERVICE] = &NetsysNativeServiceStub::CmdStartDhcpService;
     opToInterfaceMap_[NETSYS_STOP_DHCP_SERVICE] = &NetsysNativeServiceStub::CmdStopDhcpService;
+    opToInterfaceMap_[NETSYS_FIREWALL_SET_UID_RULE] = &NetsysNativeServiceStub::CmdFirewallSetUidRule;
+    opToInterfaceMap_[NETSYS_FIREWALL_SET_UIDS] = &NetsysNativeServiceStub::CmdFirewallSetUids;
+    opToInterfaceMap_[NETSYS_FIREWALL_ENABLE_CHAIN] = &NetsysNativeServiceStub::CmdFirewallEnableChain;
+    opToInterfaceMap_[NETSYS_FIREWALL_SET_CHAIN_INTERFACE] = &NetsysNativeServiceStub::CmdFirewallSetChainInterface;
 }
 
 int32_t NetsysNativeServiceStub::OnRemoteRequest(uint32_t code, MessageParcel &data, MessageParcel &reply,
@@ -612,5 +617,51 @@ int32_t NetsysNativeServiceStub::CmdStopDhcpService(MessageParcel &data, Message
     reply.WriteInt32(result);
     return result;
 }
+
+int32_t NetsysNativeServiceStub::CmdFirewallSetUidRule(MessageParcel &data, MessageParcel &reply)
+{
+    NETNATIVE_LOGI("Begin to dispatch cmd CmdFirewallSetUidRule");
+    uint32_t chain = data.ReadUint32();
+    uint32_t uid = data.ReadUint32();
+    bool member = data.ReadBool();
+    int32_t result = FirewallSetUidRule(chain, uid, member);
+    reply.WriteInt32(result);
+    return result;
+}
+
+int32_t NetsysNativeServiceStub::CmdFirewallSetUids(MessageParcel &data, MessageParcel &reply)
+{
+    NETNATIVE_LOGI("Begin to dispatch cmd CmdFirewallSetUids");
+    uint32_t chain = data.ReadUint32();
+    std::vector<uint32_t> uids;
+    if (!data.ReadUInt32Vector(&uids) || uids.size() > MAX_FIREWALL_UID_NUM) {
+        NETNATIVE_LOGE("CmdFirewallSetUids read uids failed, size %{public}zu", uids.size());
+        return ERR_FLATTEN_OBJECT;
+    }
+    int32_t result = FirewallSetUids(chain, uids);
+    reply.WriteInt32(result);
+    return result;
+}
+
+int32_t NetsysNativeServiceStub::CmdFirewallEnableChain(MessageParcel &data, MessageParcel &reply)
+{
+    NETNATIVE_LOGI("Begin to dispatch cmd CmdFirewallEnableChain");
+    uint32_t chain = data.ReadUint32();
+    bool enable = data.ReadBool();
+    int32_t result = FirewallEnableChain(chain, enable);
+    reply.WriteInt32(result);
+    return result;
+}
+
+int32_t NetsysNativeServiceStub::CmdFirewallSetChainInterface(MessageParcel &data, MessageParcel &reply)
+{
+    NETNATIVE_LOGI("Begin to dispatch cmd CmdFirewallSetChainInterface");
+    uint32_t chain = data.ReadUint32();
+    std::string iface = data.ReadString();
+    bool attach = data.ReadBool();
+    int32_t result = FirewallSetChainInterface(chain, iface, attach);
+    reply.WriteInt32(result);
+    return result;
+}
 } // namespace NetsysNative
 } // namespace OHOS
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_BILLING_CYCLE_H
+#define NET_BILLING_CYCLE_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace OHOS {
+namespace NetManagerStandard {
+enum class NetBillingCycleUnit {
+    DAY,
+    WEEK,
+    MONTH,
+    YEAR,
+};
+
+/**
+ * Billing cycle parsed from a policy periodDuration, a unit letter followed by a number.
+ *
+ * Dx: every x days (1-366) counted from the day of periodStartTime.
+ * Wx: every week starting on weekday x (1 Monday - 7 Sunday).
+ * Mx: every month starting on day x (1-31), clamped to the last day of shorter months.
+ * Yx: every year starting in month x (1-12) on the day of periodStartTime, clamped the same way.
+ *
+ * Periods start at local midnight and are computed in civil time, so days stay whole across DST changes.
+ */
+class NetBillingCycle {
+public:
+    NetBillingCycle() = default;
+    ~NetBillingCycle() = default;
+
+    /**
+     * @brief Parse a periodDuration
+     *
+     * @param periodDuration For example "M1"
+     * @param periodStartTime Seconds since the epoch anchoring day and year cycles, -1 if unset
+     * @param cycle The parsed cycle
+     * @return Returns false if periodDuration is malformed or needs a missing periodStartTime
+     */
+    static bool Parse(const std::string &periodDuration, int64_t periodStartTime, NetBillingCycle &cycle);
+
+    /**
+     * @brief Compute the period containing a time
+     *
+     * @param now Seconds since the epoch
+     * @param start Period start, inclusive
+     * @param end Period end, exclusive
+     * @return Returns false if the local time conversion fails
+     */
+    bool GetPeriod(int64_t now, int64_t &start, int64_t &end) const;
+
+private:
+    NetBillingCycleUnit unit_ = NetBillingCycleUnit::MONTH;
+    int32_t value_ = 1;
+    int64_t anchor_ = -1;
+};
+
+/**
+ * Current period of each policy, recomputed only once the cached period has ended or the policy changed.
+ * Thread safe.
+ */
+class NetBillingCycleCache {
+public:
+    /**
+     * @brief Get the period of a policy containing now
+     *
+     * @param ident Key of the policy
+     * @param periodDuration The policy periodDuration
+     * @param periodStartTime The policy periodStartTime
+     * @param now Seconds since the epoch
+     * @param start Period start, inclusive
+     * @param end Period end, exclusive
+     * @return Returns false if the cycle of the policy is invalid
+     */
+    bool GetPeriod(const std::string &ident, const std::string &periodDuration, int64_t periodStartTime,
+        int64_t now, int64_t &start, int64_t &end);
+    void Remove(const std::string &ident);
+    void Clear();
+
+private:
+    struct CachedPeriod {
+        std::string periodDuration;
+        int64_t periodStartTime = -1;
+        int64_t start = 0;
+        int64_t end = 0;
+    };
+
+    std::mutex mutex_;
+    std::map<std::string, CachedPeriod> periods_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_BILLING_CYCLE_H
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_IFACE_METERED_TABLE_H
+#define NET_IFACE_METERED_TABLE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "net_all_capabilities.h"
+#include "net_policy_quota_policy.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * Whether each interface is metered, joined from the links the connection service reports and the metered flag of
+ * the quota policies. The first quota policy of a bearer type decides for the interface of that bearer.
+ *
+ * Readers never lock, they probe an immutable map published with an atomic pointer store. Writers are serialized by
+ * an internal mutex, they may run on the connection service's state loop.
+ */
+class NetIfaceMeteredTable {
+public:
+    /**
+     * @param ident Supplier ident of the links the quota policies apply to, links of other suppliers are ignored
+     */
+    explicit NetIfaceMeteredTable(const std::string &ident);
+    ~NetIfaceMeteredTable() = default;
+
+    /**
+     * @brief Record a link that came up or went down
+     *
+     * @param bearerType Bearer type of the supplier
+     * @param ident Supplier ident
+     * @param ifaceName Interface of the link
+     * @param up false once the link is gone
+     * @return Returns true if the set of metered interfaces changed
+     */
+    bool UpdateLink(NetBearType bearerType, const std::string &ident, const std::string &ifaceName, bool up);
+
+    /**
+     * @brief Recompute the metered flags after the quota policies changed
+     *
+     * @param quotaPolicies Every quota policy
+     * @return Returns true if the set of metered interfaces changed
+     */
+    bool UpdatePolicies(const std::vector<NetPolicyQuotaPolicy> &quotaPolicies);
+
+    bool IsMetered(const std::string &ifaceName) const;
+    bool GetIfaceName(NetBearType bearerType, std::string &ifaceName) const;
+    std::set<std::string> GetMeteredIfaces() const;
+
+private:
+    using IfaceMap = std::unordered_map<std::string, bool>;
+
+    std::shared_ptr<const IfaceMap> Load() const;
+    bool Publish();
+
+private:
+    const std::string ident_;
+    mutable std::mutex mutex_;
+    // Guarded by mutex_
+    std::map<NetBearType, std::string> links_;
+    std::map<NetBearType, bool> bearerMetered_;
+    // Only ever accessed through std::atomic_load/atomic_store
+    std::shared_ptr<const IfaceMap> ifaces_ = std::make_shared<const IfaceMap>();
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_IFACE_METERED_TABLE_H
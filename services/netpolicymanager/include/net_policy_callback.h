@@ -20,7 +20,9 @@
 #include <vector>
 
 #include "i_net_policy_callback.h"
+#include "net_callback_set.h"
 #include "net_policy_cellular_policy.h"
+#include "net_policy_define.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
@@ -29,12 +31,13 @@ public:
     void RegisterNetPolicyCallback(const sptr<INetPolicyCallback> &callback);
     void UnregisterNetPolicyCallback(const sptr<INetPolicyCallback> &callback);
     int32_t NotifyNetUidPolicyChanged(uint32_t uid, NetUidPolicy policy);
+    int32_t NotifyNetUidPoliciesChanged(const std::vector<uint32_t> &uids, const std::vector<NetUidPolicy> &policies);
     int32_t NotifyNetCellularPolicyChanged(const std::vector<NetPolicyCellularPolicy> &cellularPolicies);
     int32_t NotifyNetStrategySwitch(const std::string &simId, bool enable);
     int32_t NotifyNetBackgroundPolicyChanged(bool isBackgroundPolicyAllow);
 
 private:
-    std::vector<sptr<INetPolicyCallback>> netPolicyCallback_;
+    NetCallbackSet<INetPolicyCallback> netPolicyCallback_ {LIMIT_CALLBACK_NUM};
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -16,19 +16,21 @@
 #ifndef NET_POLICY_DEFINE_H
 #define NET_POLICY_DEFINE_H
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "net_policy_cellular_policy.h"
+#include "net_policy_quota_policy.h"
+#include "net_uid_flat_set.h"
+#include "net_uid_policy_table.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
 const mode_t CHOWN_RWX_USR_GRP = 0770;
-constexpr int16_t PERIODDURATION_POS_NUM_ONE  = 1;
-constexpr int16_t DAY_ONE  = 1;
-constexpr int16_t DAY_THIRTY_ONE = 31;
 constexpr int16_t LIMIT_ACTION_ONE = 1;
 constexpr int16_t LIMIT_ACTION_THREE = 3;
 constexpr int16_t LIMIT_CALLBACK_NUM = 200;
-const std::string POLICY_QUOTA_MONTH_U = "M";
-const std::string POLICY_QUOTA_MONTH_L = "m";
 const std::string POLICY_FILE_NAME = "/data/system/net_policy.json";
 const std::string CONFIG_HOS_VERSION = "hosVersion";
 const std::string CONFIG_UID_POLICY = "uidPolicy";
@@ -58,46 +60,38 @@ const std::string CONFIG_CELLULAR_POLICY_LIMITACTION = "limitAction";
 const std::string CONFIG_CELLULAR_POLICY_USEDBYTES = "usedBytes";
 const std::string CONFIG_CELLULAR_POLICY_USEDTIMEDURATION = "usedTimeDuration";
 const std::string CONFIG_CELLULAR_POLICY_POSSESSOR = "possessor";
+const std::string CONFIG_IDLE_TRUSTLIST = "idleTrustList";
 const std::string BACKGROUND_POLICY_ALLOW = "allow";
 const std::string BACKGROUND_POLICY_REJECT = "reject";
 const std::string IDENT_PREFIX = "usb0";
+const std::string QUOTA_THRESHOLD_IDENT_PREFIX = "quota_";
+const std::string CELLULAR_THRESHOLD_IDENT_PREFIX = "cellular_";
+constexpr uint32_t POLICY_TABLE_NONE = 0;
+constexpr uint32_t POLICY_TABLE_UID = 1 << 0;
+constexpr uint32_t POLICY_TABLE_QUOTA = 1 << 1;
+constexpr uint32_t POLICY_TABLE_CELLULAR = 1 << 2;
+constexpr uint32_t POLICY_TABLE_IDLE = 1 << 3;
+constexpr uint32_t POLICY_TABLE_ALL = POLICY_TABLE_UID | POLICY_TABLE_QUOTA | POLICY_TABLE_CELLULAR | POLICY_TABLE_IDLE;
 
-struct UidPolicy {
-    std::string uid;
-    std::string policy;
-};
-
-struct NetPolicyQuota {
-    std::string netType;
-    std::string simId;
-    std::string periodStartTime;
-    std::string periodDuration;
-    std::string warningBytes;
-    std::string limitBytes;
-    std::string lastLimitSnooze;
-    std::string metered;
-    std::string source;
-};
-
-struct NetPolicyCellular {
-    std::string simId;
-    std::string periodStartTime;
-    std::string periodDuration;
-    std::string title;
-    std::string summary;
-    std::string limitBytes;
-    std::string limitAction;
-    std::string usedBytes;
-    std::string usedTimeDuration;
-    std::string possessor;
+struct NetPolicy {
+    std::string hosVersion;
+    NetUidPolicyTable uidPolicies;
+    bool backgroundPolicy = true;
+    std::vector<NetPolicyQuotaPolicy> quotaPolicies;
+    std::vector<NetPolicyCellularPolicy> cellularPolicies;
+    NetUidFlatSet idleTrustList;
 };
 
-struct NetPolicy {
+// Published copy of NetPolicy, snapshots share every table the change in between did not touch
+struct NetPolicySnapshot {
     std::string hosVersion;
-    std::vector<UidPolicy> uidPolicys;
-    std::string backgroundPolicyStatus_;
-    std::vector<NetPolicyQuota> netQuotaPolicys;
-    std::vector<NetPolicyCellular> netCellularPolicys;
+    bool backgroundPolicy = true;
+    std::shared_ptr<const NetUidPolicyTable> uidPolicies = std::make_shared<const NetUidPolicyTable>();
+    std::shared_ptr<const std::vector<NetPolicyQuotaPolicy>> quotaPolicies =
+        std::make_shared<const std::vector<NetPolicyQuotaPolicy>>();
+    std::shared_ptr<const std::vector<NetPolicyCellularPolicy>> cellularPolicies =
+        std::make_shared<const std::vector<NetPolicyCellularPolicy>>();
+    std::shared_ptr<const NetUidFlatSet> idleTrustList = std::make_shared<const NetUidFlatSet>();
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -16,6 +16,7 @@
 #ifndef NET_POLICY_FILE_H
 #define NET_POLICY_FILE_H
 
+#include <atomic>
 #include <climits>
 #include <fcntl.h>
 #include <fstream>
@@ -23,6 +24,7 @@
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <string>
 #include <sys/sendfile.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -32,10 +34,12 @@
 #include <json/json.h>
 #include "refbase.h"
 
+#include "net_event_loop.h"
 #include "net_policy_cellular_policy.h"
 #include "net_policy_constants.h"
 #include "net_policy_define.h"
 #include "net_policy_quota_policy.h"
+#include "net_uid_verdict_table.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
@@ -45,17 +49,48 @@ enum class NetUidPolicyOpType {
     NET_POLICY_UID_OP_TYPE_UPDATE = 3,
 };
 
+/**
+ * In-memory net policy state, persisted as json.
+ *
+ * Writers serialize on mutex_ and publish an immutable copy of the state after every mutation. Readers, including
+ * the persist thread, only load the published copy and never take a lock.
+ *
+ * Changes are written behind: every mutation marks the state dirty and the whole file is rewritten once per
+ * coalescing window on a dedicated thread, through a temp file, fsync and rename. A failed write is retried with
+ * backoff until it succeeds or a later change rewrites the file.
+ */
 class NetPolicyFile : public virtual RefBase {
 public:
+    explicit NetPolicyFile(const std::string &fileName = POLICY_FILE_NAME);
+    ~NetPolicyFile();
+
     bool InitPolicy();
     bool IsUidPolicyExist(uint32_t uid);
     bool ReadFile(const std::string& fileName, std::string& content);
     bool Json2Obj(const std::string& content, NetPolicy& netPolicy);
+    /**
+     * @brief Serialize the current state and replace the file atomically, synchronously
+     *
+     * @param fileName The file to replace
+     * @return Returns false if the file could not be written, the state stays dirty
+     */
     bool WriteFile(const std::string& fileName);
     bool WriteFile(NetUidPolicyOpType netUidPolicyOpType, uint32_t uid, NetUidPolicy policy);
     bool WriteFile(const std::vector<NetPolicyQuotaPolicy> &quotaPolicies);
     bool WriteFile(const std::vector<NetPolicyCellularPolicy> &cellularPolicies);
     NetUidPolicy GetPolicyByUid(uint32_t uid);
+
+    /**
+     * @brief Apply a batch of uid policies under one lock with one persist, NET_POLICY_NONE deletes the entry
+     *
+     * @param uids The uids, same size as policies
+     * @param policies The policies
+     * @param changedUids out param, uids whose policy actually changed
+     * @param changedPolicies out param, the new policies of changedUids
+     */
+    void SetPoliciesByUids(const std::vector<uint32_t> &uids, const std::vector<NetUidPolicy> &policies,
+        std::vector<uint32_t> &changedUids, std::vector<NetUidPolicy> &changedPolicies);
+    void GetPoliciesByUids(const std::vector<uint32_t> &uids, std::vector<NetUidPolicy> &policies);
     bool GetUidsByPolicy(NetUidPolicy policy, std::vector<uint32_t> &uids);
     NetPolicyResultCode GetNetQuotaPolicies(std::vector<NetPolicyQuotaPolicy> &quotaPolicies);
     NetPolicyResultCode GetNetQuotaPolicy(int8_t netType, const std::string &simId,
@@ -64,25 +99,106 @@ public:
     NetPolicyResultCode SetFactoryPolicy(const std::string &simId);
     NetPolicyResultCode SetBackgroundPolicy(bool backgroundPolicy);
     bool GetBackgroundPolicy();
-    bool IsInterfaceMetered(const std::string &ifaceName);
+
+    /**
+     * @brief Add a uid to, or remove it from, the idle trust list
+     *
+     * @param uid The uid
+     * @param isTrustlist true to add the uid
+     * @return Returns true if the list changed
+     */
+    bool SetIdleTrustlist(uint32_t uid, bool isTrustlist);
+
+    /**
+     * @brief Replace the idle trust list
+     *
+     * @param uids The new list, in any order
+     * @return Returns true if the list changed
+     */
+    bool ReplaceIdleTrustlist(const std::vector<uint32_t> &uids);
+
+    std::vector<uint32_t> GetIdleTrustlist() const
+    {
+        return LoadSnapshot()->idleTrustList->Values();
+    }
+
+    /**
+     * @brief Get the state published by the last writer, lock free
+     *
+     * @return The immutable state, valid for as long as the caller holds it
+     */
+    std::shared_ptr<const NetPolicySnapshot> LoadSnapshot() const;
+
+    /**
+     * @brief Write pending changes now instead of at the end of the coalescing window
+     *
+     * @return Returns false if the changes could not be written, they stay pending
+     */
+    bool Flush();
+
+    /**
+     * @brief Get the number of times the file was replaced since construction
+     */
+    uint32_t GetPersistCount() const
+    {
+        return persistCount_;
+    }
+
+    /**
+     * @brief Get the number of writes that failed in a row, 0 once a write succeeds
+     */
+    uint32_t GetPersistFailures() const
+    {
+        return persistFailures_;
+    }
+
+    /**
+     * @brief Get the precomputed access verdict of a uid without locking
+     *
+     * @param uid The uid
+     * @return NetUidVerdict bits
+     */
+    uint8_t GetUidVerdict(uint32_t uid) const
+    {
+        return verdicts_.GetVerdict(uid);
+    }
 
 private:
     bool FileExists(const std::string& fileName);
     bool CreateFile(const std::string& fileName);
-    void AppendUidPolicy(Json::Value &root);
-    void AppendBackgroundPolicy(Json::Value &root);
-    void AppendQuotaPolicy(Json::Value &root);
-    void AppendCellularPolicy(Json::Value &root);
+    void AppendUidPolicy(const NetPolicySnapshot &netPolicy, Json::Value &root);
+    void AppendBackgroundPolicy(const NetPolicySnapshot &netPolicy, Json::Value &root);
+    void AppendQuotaPolicy(const NetPolicySnapshot &netPolicy, Json::Value &root);
+    void AppendCellularPolicy(const NetPolicySnapshot &netPolicy, Json::Value &root);
+    void AppendIdleTrustlist(const NetPolicySnapshot &netPolicy, Json::Value &root);
     void ParseUidPolicy(const Json::Value &root, NetPolicy& netPolicy);
     void ParseBackgroundPolicy(const Json::Value &root, NetPolicy& netPolicy);
     void ParseQuotaPolicy(const Json::Value &root, NetPolicy& netPolicy);
     void ParseCellularPolicy(const Json::Value &root, NetPolicy& netPolicy);
+    void ParseIdleTrustlist(const Json::Value &root, NetPolicy& netPolicy);
     bool UpdateQuotaPolicyExist(const NetPolicyQuotaPolicy &quotaPolicy);
     bool UpdateCellularPolicyExist(const NetPolicyCellularPolicy &cellularPolicy);
+    void RebuildVerdicts();
+    void PublishSnapshot(uint32_t changedTables);
+    void SchedulePersist();
+    void PostPersist(uint32_t delayMs);
+    std::string BuildContent(const NetPolicySnapshot &netPolicy);
+    bool ReplaceFile(const std::string &fileName, const std::string &content);
 
 private:
+    // Writer side only, guarded by mutex_
     NetPolicy netPolicy_;
+    NetUidVerdictTable verdicts_;
     std::mutex mutex_;
+    // Only ever accessed through std::atomic_load/atomic_store
+    std::shared_ptr<const NetPolicySnapshot> snapshot_ = std::make_shared<const NetPolicySnapshot>();
+    std::string fileName_;
+    std::mutex writeMutex_;
+    std::atomic<bool> dirty_;
+    std::atomic<uint32_t> persistCount_;
+    std::atomic<uint32_t> persistFailures_;
+    std::atomic<bool> persistPending_;
+    NetEventLoop persistLoop_;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
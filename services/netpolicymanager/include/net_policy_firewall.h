@@ -16,18 +16,85 @@
 #ifndef NET_POLICY_FIREWALL_H
 #define NET_POLICY_FIREWALL_H
 
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "net_event_loop.h"
+#include "net_iface_metered_table.h"
 #include "net_policy_file.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
+/**
+ * Mirrors the uid policies into the netsys firewall chains.
+ *
+ * Every netsys call runs in order on a dedicated thread, so callers only queue the change and never wait for the
+ * restore tools, even while they hold the service writer lock.
+ */
 class NetPolicyFirewall : public virtual RefBase {
 public:
     NetPolicyFirewall(sptr<NetPolicyFile> netPolicyFile);
+    ~NetPolicyFirewall();
     bool GetBackgroundPolicyByUid(uint32_t uid);
     NetBackgroundPolicy GetCurrentBackgroundPolicy();
 
+    /**
+     * @brief Update the netsys firewall chains of one uid after its policy changed
+     *
+     * @param uid The uid
+     * @param policy The new policy, NET_POLICY_NONE once it is deleted
+     */
+    void UpdateUidRules(uint32_t uid, NetUidPolicy policy);
+
+    /**
+     * @brief Push the deny chains of every uid policy to netsys, netsys only applies the difference
+     *
+     * Requests queued while one is pending are merged into it.
+     */
+    void SyncUidRules();
+
+    /**
+     * @brief Add a uid to, or remove it from, the idle allow chain
+     *
+     * @param uid The uid
+     * @param isTrustlist true to add the uid
+     */
+    void UpdateIdleTrustlistRule(uint32_t uid, bool isTrustlist);
+
+    /**
+     * @brief Replace the members of the idle allow chain
+     *
+     * @param uids The idle trust list
+     */
+    void SyncIdleTrustlistRules(const std::vector<uint32_t> &uids);
+
+    /**
+     * @brief Attach the deny metered chain to exactly the metered interfaces, may run on any thread
+     *
+     * @param ifaceTable The metered flag of every known interface
+     */
+    void UpdateMeteredIfaces(const NetIfaceMeteredTable &ifaceTable);
+
+    /**
+     * @brief Forget what netsys was told, it restarted with empty chains, the next syncs push everything again
+     */
+    void ResetNetsysState();
+
+private:
+    void DoSyncUidRules();
+    void AttachMeteredIfaces(const std::set<std::string> &ifaces);
+
 private:
     sptr<NetPolicyFile> netPolicyFile_;
+    // Keeps the metered interfaces queued in the order they were read
+    std::mutex meteredIfacesMutex_;
+    // Interfaces the deny metered chain is attached to, only used on firewallLoop_
+    std::set<std::string> meteredIfaces_;
+    std::atomic<bool> uidSyncPending_;
+    NetEventLoop firewallLoop_;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -17,11 +17,15 @@
 #define NET_POLICY_SERVICE_H
 
 #include <mutex>
+#include <set>
 
 #include "singleton.h"
 #include "system_ability.h"
 #include "system_ability_definition.h"
 
+#include "net_billing_cycle.h"
+#include "net_event_loop.h"
+#include "net_iface_metered_table.h"
 #include "net_policy_callback.h"
 #include "net_policy_traffic.h"
 #include "net_policy_firewall.h"
@@ -40,9 +44,14 @@ class NetPolicyService : public SystemAbility,
 public:
     void OnStart() override;
     void OnStop() override;
+    void OnAddSystemAbility(int32_t systemAbilityId, const std::string &deviceId) override;
 
     NetPolicyResultCode SetPolicyByUid(uint32_t uid, NetUidPolicy policy) override;
     NetUidPolicy GetPolicyByUid(uint32_t uid) override;
+    NetPolicyResultCode SetPoliciesByUids(const std::vector<uint32_t> &uids,
+        const std::vector<NetUidPolicy> &policies) override;
+    NetPolicyResultCode GetPoliciesByUids(const std::vector<uint32_t> &uids,
+        std::vector<NetUidPolicy> &policies) override;
     std::vector<uint32_t> GetUidsByPolicy(NetUidPolicy policy) override;
     bool IsUidNetAccess(uint32_t uid, bool metered) override;
     bool IsUidNetAccess(uint32_t uid, const std::string &ifaceName) override;
@@ -59,14 +68,34 @@ public:
     NetBackgroundPolicy GetCurrentBackgroundPolicy() override;
     NetPolicyResultCode SetSnoozePolicy(int8_t netType, const std::string &simId) override;
     NetPolicyResultCode SetIdleTrustlist(uint32_t uid, bool isTrustlist) override;
+    NetPolicyResultCode ReplaceIdleTrustlist(const std::vector<uint32_t> &uids) override;
     NetPolicyResultCode GetIdleTrustlist(std::vector<uint32_t> &uids) override;
-    void CheckNetStatsOverLimit(const std::vector<NetPolicyQuotaPolicy> &quotaPolicies);
-    void CheckNetStatsOverLimit(const std::vector<NetPolicyCellularPolicy> &cellularPolicies);
-    int32_t GetPeriodEndTime();
+    void OnQuotaWarningReached(const NetStatsQuota &quota);
+    void OnQuotaLimitReached(const NetStatsQuota &quota);
+    void OnQuotaPeriodEnded(const NetStatsQuota &quota);
+    void OnIfaceLinkChanged(NetBearType bearerType, const std::string &ident, const std::string &ifaceName, bool up);
     int64_t GetCurrentTime();
 
 private:
     bool Init();
+    /* Runs on linkLoop_, in the order the links changed */
+    void HandleIfaceLinkChanged(NetBearType bearerType, const std::string &ident, const std::string &ifaceName,
+        bool up);
+    /* Push every uid, idle and metered interface rule to netsys, which applies only what it misses */
+    void SyncFirewall();
+    /* Recompute the metered interfaces from the quota policies and move the deny metered chain to them */
+    void UpdateMeteredIfaces();
+    /* Re-arm the thresholds of the idents on linkLoop_, from the policies stored by the time it runs */
+    void PostQuotaThresholds(const std::set<std::string> &idents);
+    /* Everything below runs on linkLoop_, the only thread that arms or removes stats thresholds */
+    void ArmQuotaThresholds();
+    void ArmQuotaThresholds(const std::set<std::string> &idents);
+    bool ArmQuotaThreshold(const std::string &ident, const std::string &periodDuration, int64_t periodStartTime,
+        int64_t warningBytes, int64_t limitBytes, int64_t &usedBytes);
+    /* Arm the stats thresholds of the policies and tell telephony whether each sim may use data */
+    void UpdateQuotaThresholds(const std::vector<NetPolicyQuotaPolicy> &quotaPolicies);
+    void UpdateQuotaThresholds(const std::vector<NetPolicyCellularPolicy> &cellularPolicies);
+    void RemoveQuotaThresholds(const std::set<std::string> &idents);
 
 private:
     enum ServiceRunningState {
@@ -81,8 +110,12 @@ private:
     ServiceRunningState state_;
     sptr<NetPolicyCallback> netPolicyCallback_;
     sptr<NetPolicyServiceCommon> serviceComm_ = nullptr;
-    std::mutex mutex_;
-    std::vector<uint16_t> monthDay_;
+    // Serializes writers only, readers load the policy file snapshot and never wait for a writer or the disk
+    std::mutex writerMutex_;
+    NetBillingCycleCache billingCycles_;
+    NetIfaceMeteredTable ifaceTable_ {IDENT_PREFIX};
+    // Link changes from the connection service, kept off its state loop, and every stats threshold update
+    NetEventLoop linkLoop_ {"NetPolicyLink"};
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -16,13 +16,19 @@
 #define NET_POLICY_SERVICE_COMMON_H
 
 #include "net_policy_base_service.h"
+#include "net_stats_base_service.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
-class NetPolicyServiceCommon : public NetPolicyBaseService {
+class NetPolicyServiceCommon : public NetPolicyBaseService, public NetStatsQuotaCallback {
 public:
     int32_t ResetPolicyFactory() override;
     bool IsUidNetAccess(uint32_t uid, bool metered) override;
+    void OnIfaceLinkChanged(NetBearType bearerType, const std::string &ident, const std::string &ifaceName,
+        bool up) override;
+    void OnQuotaWarningReached(const NetStatsQuota &quota) override;
+    void OnQuotaLimitReached(const NetStatsQuota &quota) override;
+    void OnQuotaPeriodEnded(const NetStatsQuota &quota) override;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
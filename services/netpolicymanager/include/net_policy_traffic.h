@@ -27,41 +27,33 @@
 
 namespace OHOS {
 namespace NetManagerStandard {
-constexpr int16_t NET_POLICY_LEAP_YEAR_ONE = 1;
-constexpr int16_t NET_POLICY_LEAP_YEAR_FOUR = 4;
-constexpr int16_t NET_POLICY_LEAP_YEAR_ONEHUNDRED = 100;
-constexpr int16_t NET_POLICY_LEAP_YEAR_FOURHUNDRED = 400;
-constexpr int16_t NET_POLICY_FEBRUARY = 1;
-constexpr int32_t NET_POLICY_ONEDAYTIME = 86400;
-constexpr int16_t MONTH_TWENTY_EIGHT = 28;
-constexpr int16_t MONTH_THIRTY = 30;
-constexpr int16_t MONTH_THIRTY_ONE = 31;
-
 class NetPolicyTraffic : public virtual RefBase {
 public:
     NetPolicyTraffic(sptr<NetPolicyFile> netPolicyFile);
     NetPolicyResultCode AddPolicyByUid(uint32_t uid, NetUidPolicy policy);
     NetPolicyResultCode SetPolicyByUid(uint32_t uid, NetUidPolicy policy);
     NetPolicyResultCode DeletePolicyByUid(uint32_t uid, NetUidPolicy policy);
+    NetPolicyResultCode SetPoliciesByUids(const std::vector<uint32_t> &uids,
+        const std::vector<NetUidPolicy> &policies, std::vector<uint32_t> &changedUids,
+        std::vector<NetUidPolicy> &changedPolicies);
     bool IsUidPolicyExist(uint32_t uid);
     NetPolicyResultCode SetNetQuotaPolicies(const std::vector<NetPolicyQuotaPolicy> &quotaPolicies);
     NetPolicyResultCode SetCellularPolicies(const std::vector<NetPolicyCellularPolicy> &cellularPolicies);
     NetPolicyResultCode SetSnoozePolicy(int8_t netType, const std::string &simId,
         std::vector<NetPolicyQuotaPolicy> &quotaPolicies);
     NetPolicyResultCode SetIdleTrustlist(uint32_t uid, bool isTrustlist);
+    NetPolicyResultCode ReplaceIdleTrustlist(const std::vector<uint32_t> &uids);
     NetPolicyResultCode GetIdleTrustlist(std::vector<uint32_t> &uids);
-    void ClearIdleTrustList();
 
 private:
     bool IsPolicyValid(NetUidPolicy policy);
     bool IsNetPolicyTypeValid(NetBearType netType);
-    bool IsNetPolicyPeriodDurationValid(const std::string &periodDuration);
+    bool IsNetPolicyPeriodDurationValid(const std::string &periodDuration, int64_t periodStartTime);
     void InitController();
     bool IsQuotaPolicyExist(int8_t netType, const std::string &simId);
 
 private:
     sptr<NetPolicyFile> netPolicyFile_;
-    std::vector<uint32_t> idleTrustList_;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
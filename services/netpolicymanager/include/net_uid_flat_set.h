@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_UID_FLAT_SET_H
+#define NET_UID_FLAT_SET_H
+
+#include <cstdint>
+#include <vector>
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * Set of uids kept as one sorted vector.
+ *
+ * Lookups are binary searches, the contents are handed out in order without copying and a whole list is
+ * replaced with a single sort. Not thread safe, the owner serializes access.
+ */
+class NetUidFlatSet {
+public:
+    NetUidFlatSet() = default;
+    ~NetUidFlatSet() = default;
+
+    /**
+     * @brief Add a uid
+     *
+     * @param uid The uid
+     * @return Returns false if the uid was already present
+     */
+    bool Insert(uint32_t uid);
+
+    /**
+     * @brief Remove a uid
+     *
+     * @param uid The uid
+     * @return Returns false if the uid was not present
+     */
+    bool Erase(uint32_t uid);
+
+    bool Contains(uint32_t uid) const;
+
+    /**
+     * @brief Replace the contents, duplicates are dropped
+     *
+     * @param uids The new uids, in any order
+     * @return Returns true if the contents changed
+     */
+    bool Assign(const std::vector<uint32_t> &uids);
+
+    void Clear();
+
+    const std::vector<uint32_t> &Values() const
+    {
+        return uids_;
+    }
+
+    uint32_t Size() const
+    {
+        return static_cast<uint32_t>(uids_.size());
+    }
+
+    bool Empty() const
+    {
+        return uids_.empty();
+    }
+
+private:
+    std::vector<uint32_t> uids_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_UID_FLAT_SET_H
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_UID_POLICY_TABLE_H
+#define NET_UID_POLICY_TABLE_H
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "net_policy_constants.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+/**
+ * uid to policy map with open addressing and linear probing.
+ *
+ * Every distinct policy value keeps a bitmap over the slots holding it, so listing the uids of one policy
+ * only visits those slots. Not thread safe, the owner serializes access.
+ */
+class NetUidPolicyTable {
+public:
+    NetUidPolicyTable();
+    ~NetUidPolicyTable() = default;
+
+    /**
+     * @brief Insert or overwrite the policy of a uid
+     *
+     * @param uid The uid
+     * @param policy The policy, stored as is, NET_POLICY_NONE included
+     */
+    void Set(uint32_t uid, NetUidPolicy policy);
+
+    /**
+     * @brief Drop the policy of a uid
+     *
+     * @param uid The uid
+     * @return Returns false if the uid had no policy
+     */
+    bool Remove(uint32_t uid);
+
+    /**
+     * @brief Look up the policy of a uid
+     *
+     * @param uid The uid
+     * @param policy out param, left untouched if the uid has no policy
+     * @return Returns true if the uid has a policy
+     */
+    bool Find(uint32_t uid, NetUidPolicy &policy) const;
+
+    bool Contains(uint32_t uid) const;
+
+    /**
+     * @brief Append every uid whose policy equals the given one
+     *
+     * @param policy The policy
+     * @param uids out param, in slot order
+     */
+    void GetUids(NetUidPolicy policy, std::vector<uint32_t> &uids) const;
+
+    void ForEach(const std::function<void(uint32_t uid, NetUidPolicy policy)> &func) const;
+    void Clear();
+    uint32_t Size() const
+    {
+        return size_;
+    }
+
+    /**
+     * @brief Spread dense uids over the low bits used to pick a slot
+     */
+    static uint32_t Hash(uint32_t uid);
+
+private:
+    enum SlotState : uint8_t {
+        SLOT_EMPTY = 0,
+        SLOT_USED,
+        SLOT_DELETED,
+    };
+    struct Slot {
+        uint32_t uid = 0;
+        uint32_t policy = 0;
+        SlotState state = SLOT_EMPTY;
+    };
+    using Bitmap = std::vector<uint64_t>;
+
+    int64_t FindSlot(uint32_t uid) const;
+    void Rehash(uint32_t capacity);
+    Bitmap &GetBitmap(uint32_t policy);
+    const Bitmap *FindBitmap(uint32_t policy) const;
+    void MarkSlot(uint32_t policy, uint32_t index, bool set);
+
+private:
+    std::vector<Slot> slots_;
+    uint32_t size_ = 0;
+    uint32_t deleted_ = 0;
+    // Policy values are few in practice, a linear search over them beats hashing
+    std::vector<std::pair<uint32_t, Bitmap>> policyIndex_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_UID_POLICY_TABLE_H
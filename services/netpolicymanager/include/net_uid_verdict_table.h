@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_UID_VERDICT_TABLE_H
+#define NET_UID_VERDICT_TABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "net_policy_constants.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+enum NetUidVerdict : uint8_t {
+    VERDICT_UNMETERED_ALLOWED = 1 << 0,
+    VERDICT_METERED_ALLOWED = 1 << 1,
+    VERDICT_BACKGROUND_ALLOWED = 1 << 2,
+};
+
+/**
+ * Precomputed network access verdict of every uid that has a policy.
+ *
+ * Readers never wait for the writer: they probe an open addressing table of packed uid and verdict words. Writers
+ * are serialized by the owner. Entries are updated in place and never removed, a uid whose policy is dropped
+ * keeps an entry holding the default verdict. A grown or reset table is published with an atomic shared_ptr
+ * store, the replaced one is freed once the last reader still probing it lets go.
+ */
+class NetUidVerdictTable {
+public:
+    NetUidVerdictTable();
+    ~NetUidVerdictTable() = default;
+
+    /**
+     * @brief Evaluate the uid policy chain once
+     *
+     * @param policy The uid policy
+     * @param backgroundPolicy Whether metered background data is allowed globally
+     * @return NetUidVerdict bits
+     */
+    static uint8_t ComputeVerdict(NetUidPolicy policy, bool backgroundPolicy);
+
+    /**
+     * @brief Get the verdict of a uid, lock free
+     *
+     * @param uid The uid
+     * @return NetUidVerdict bits, the default verdict if the uid has no policy
+     */
+    uint8_t GetVerdict(uint32_t uid) const;
+
+    /**
+     * @brief Recompute the verdict of one uid after its policy changed
+     *
+     * @param uid The uid
+     * @param policy The new policy, NET_POLICY_NONE once it is deleted
+     */
+    void UpdateUid(uint32_t uid, NetUidPolicy policy);
+
+    /**
+     * @brief Recompute the default and every stored verdict after the background policy changed
+     *
+     * @param backgroundPolicy The new background policy
+     */
+    void UpdateBackgroundPolicy(bool backgroundPolicy);
+
+    /**
+     * @brief Drop every uid verdict
+     *
+     * @param backgroundPolicy The background policy the default verdict follows
+     */
+    void Reset(bool backgroundPolicy);
+
+private:
+    struct Table {
+        explicit Table(uint32_t capacity) : mask(capacity - 1), entries(capacity) {}
+        uint32_t mask;
+        std::vector<std::atomic<uint64_t>> entries;
+    };
+
+    static uint64_t MakeEntry(uint32_t uid, NetUidPolicy policy, uint8_t verdict);
+    void Insert(Table &table, uint64_t entry);
+    void Publish(const std::shared_ptr<Table> &table);
+
+private:
+    // Only ever accessed through std::atomic_load/atomic_store
+    std::shared_ptr<const Table> table_;
+    std::atomic<uint8_t> defaultVerdict_;
+    // Writer side only
+    bool backgroundPolicy_ = true;
+    uint32_t count_ = 0;
+    std::shared_ptr<Table> current_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_UID_VERDICT_TABLE_H
@@ -31,6 +31,8 @@ public:
 
 public:
     int32_t NetUidPolicyChanged(uint32_t uid, NetUidPolicy policy) override;
+    int32_t NetUidPoliciesChanged(const std::vector<uint32_t> &uids,
+        const std::vector<NetUidPolicy> &policies) override;
     int32_t NetCellularPolicyChanged(const std::vector<NetPolicyCellularPolicy> &cellularPolicies) override;
     int32_t NetStrategySwitch(const std::string &simId, bool enable) override;
     int32_t NetBackgroundPolicyChanged(bool isBackgroundPolicyAllow) override;
@@ -38,6 +38,8 @@ private:
 private:
     int32_t OnSetPolicyByUid(MessageParcel &data, MessageParcel &reply);
     int32_t OnGetPolicyByUid(MessageParcel &data, MessageParcel &reply);
+    int32_t OnSetPoliciesByUids(MessageParcel &data, MessageParcel &reply);
+    int32_t OnGetPoliciesByUids(MessageParcel &data, MessageParcel &reply);
     int32_t OnGetUidsByPolicy(MessageParcel &data, MessageParcel &reply);
     int32_t OnIsUidNetAccessMetered(MessageParcel &data, MessageParcel &reply);
     int32_t OnIsUidNetAccessIfaceName(MessageParcel &data, MessageParcel &reply);
@@ -54,6 +56,7 @@ private:
     int32_t OnGetCurrentBackgroundPolicy(MessageParcel &data, MessageParcel &reply);
     int32_t OnSnoozePolicy(MessageParcel &data, MessageParcel &reply);
     int32_t OnSetIdleTrustlist(MessageParcel &data, MessageParcel &reply);
+    int32_t OnReplaceIdleTrustlist(MessageParcel &data, MessageParcel &reply);
     int32_t OnGetIdleTrustlist(MessageParcel &data, MessageParcel &reply);
 
 private:
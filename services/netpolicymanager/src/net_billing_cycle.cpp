@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "net_billing_cycle.h"
+
+#include <algorithm>
+#include <cctype>
+#include <ctime>
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr size_t MAX_CYCLE_VALUE_DIGITS = 3;
+constexpr int32_t MAX_CYCLE_DAYS = 366;
+constexpr int32_t DAYS_PER_WEEK = 7;
+constexpr int32_t MONTHS_PER_YEAR = 12;
+constexpr int32_t MAX_MONTH_DAY = 31;
+constexpr int32_t FEBRUARY = 2;
+constexpr int32_t TM_YEAR_BASE = 1900;
+constexpr int32_t DECIMAL_BASE = 10;
+
+struct CivilDate {
+    int32_t year = 0;
+    /* 1 - 12 */
+    int32_t month = 1;
+    int32_t day = 1;
+};
+
+bool IsLeapYear(int32_t year)
+{
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+int32_t DaysInMonth(int32_t year, int32_t month)
+{
+    static const int32_t DAYS[MONTHS_PER_YEAR] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (month == FEBRUARY && IsLeapYear(year)) {
+        return DAYS[month - 1] + 1;
+    }
+    return DAYS[month - 1];
+}
+
+// Day number of a proleptic Gregorian date, 0 at 1970-01-01, independent of time zone and DST
+int64_t DaysFromCivil(const CivilDate &date)
+{
+    int64_t year = date.year - (date.month <= FEBRUARY ? 1 : 0);
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t yearOfEra = year - era * 400;
+    int64_t dayOfYear = (153 * (date.month + (date.month > FEBRUARY ? -3 : 9)) + 2) / 5 + date.day - 1;
+    int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+bool ToLocalDate(int64_t time, CivilDate &date, int32_t *weekday = nullptr)
+{
+    time_t second = static_cast<time_t>(time);
+    struct tm local = {};
+    if (localtime_r(&second, &local) == nullptr) {
+        return false;
+    }
+    date.year = local.tm_year + TM_YEAR_BASE;
+    date.month = local.tm_mon + 1;
+    date.day = local.tm_mday;
+    if (weekday != nullptr) {
+        /* 1 Monday - 7 Sunday */
+        *weekday = (local.tm_wday == 0) ? DAYS_PER_WEEK : local.tm_wday;
+    }
+    return true;
+}
+
+// Local midnight of a date, the day may run past the month and is normalized by mktime
+int64_t LocalMidnight(int32_t year, int32_t month, int64_t day)
+{
+    struct tm local = {};
+    local.tm_year = year - TM_YEAR_BASE;
+    local.tm_mon = month - 1;
+    local.tm_mday = static_cast<int>(day);
+    local.tm_isdst = -1;
+    return static_cast<int64_t>(mktime(&local));
+}
+
+// Local midnight of a day of a month, the month may run outside 1 - 12
+int64_t MonthDayMidnight(int32_t year, int32_t month, int32_t day)
+{
+    int32_t monthIndex = month - 1;
+    year += (monthIndex >= 0) ? (monthIndex / MONTHS_PER_YEAR) : ((monthIndex + 1) / MONTHS_PER_YEAR - 1);
+    monthIndex = ((monthIndex % MONTHS_PER_YEAR) + MONTHS_PER_YEAR) % MONTHS_PER_YEAR;
+    return LocalMidnight(year, monthIndex + 1, std::min(day, DaysInMonth(year, monthIndex + 1)));
+}
+
+int64_t FloorDiv(int64_t value, int64_t divisor)
+{
+    int64_t quotient = value / divisor;
+    return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+}
+} // namespace
+
+bool NetBillingCycle::Parse(const std::string &periodDuration, int64_t periodStartTime, NetBillingCycle &cycle)
+{
+    if (periodDuration.size() < 2 || periodDuration.size() > MAX_CYCLE_VALUE_DIGITS + 1) {
+        return false;
+    }
+    int32_t value = 0;
+    for (size_t i = 1; i < periodDuration.size(); ++i) {
+        if (!isdigit(static_cast<unsigned char>(periodDuration[i]))) {
+            return false;
+        }
+        value = value * DECIMAL_BASE + (periodDuration[i] - '0');
+    }
+
+    int32_t maxValue = 0;
+    switch (toupper(static_cast<unsigned char>(periodDuration[0]))) {
+        case 'D':
+            if (periodStartTime < 0) {
+                return false;
+            }
+            cycle.unit_ = NetBillingCycleUnit::DAY;
+            maxValue = MAX_CYCLE_DAYS;
+            break;
+        case 'W':
+            cycle.unit_ = NetBillingCycleUnit::WEEK;
+            maxValue = DAYS_PER_WEEK;
+            break;
+        case 'M':
+            cycle.unit_ = NetBillingCycleUnit::MONTH;
+            maxValue = MAX_MONTH_DAY;
+            break;
+        case 'Y':
+            cycle.unit_ = NetBillingCycleUnit::YEAR;
+            maxValue = MONTHS_PER_YEAR;
+            break;
+        default:
+            return false;
+    }
+    if (value < 1 || value > maxValue) {
+        return false;
+    }
+    cycle.value_ = value;
+    cycle.anchor_ = periodStartTime;
+    return true;
+}
+
+bool NetBillingCycle::GetPeriod(int64_t now, int64_t &start, int64_t &end) const
+{
+    CivilDate today;
+    int32_t weekday = 0;
+    if (!ToLocalDate(now, today, &weekday)) {
+        return false;
+    }
+
+    switch (unit_) {
+        case NetBillingCycleUnit::DAY: {
+            CivilDate anchor;
+            if (!ToLocalDate(anchor_, anchor)) {
+                return false;
+            }
+            int64_t offset = FloorDiv(DaysFromCivil(today) - DaysFromCivil(anchor), value_) * value_;
+            start = LocalMidnight(anchor.year, anchor.month, anchor.day + offset);
+            end = LocalMidnight(anchor.year, anchor.month, anchor.day + offset + value_);
+            break;
+        }
+        case NetBillingCycleUnit::WEEK: {
+            int32_t daysBack = (weekday - value_ + DAYS_PER_WEEK) % DAYS_PER_WEEK;
+            start = LocalMidnight(today.year, today.month, today.day - daysBack);
+            end = LocalMidnight(today.year, today.month, today.day - daysBack + DAYS_PER_WEEK);
+            break;
+        }
+        case NetBillingCycleUnit::MONTH: {
+            start = MonthDayMidnight(today.year, today.month, value_);
+            int32_t monthShift = (now < start) ? -1 : 0;
+            start = MonthDayMidnight(today.year, today.month + monthShift, value_);
+            end = MonthDayMidnight(today.year, today.month + monthShift + 1, value_);
+            break;
+        }
+        case NetBillingCycleUnit::YEAR: {
+            CivilDate anchor;
+            if (anchor_ >= 0 && !ToLocalDate(anchor_, anchor)) {
+                return false;
+            }
+            start = MonthDayMidnight(today.year, value_, anchor.day);
+            int32_t yearShift = (now < start) ? -1 : 0;
+            start = MonthDayMidnight(today.year + yearShift, value_, anchor.day);
+            end = MonthDayMidnight(today.year + yearShift + 1, value_, anchor.day);
+            break;
+        }
+        default:
+            return false;
+    }
+    return start >= 0 && start <= now && now < end;
+}
+
+bool NetBillingCycleCache::GetPeriod(const std::string &ident, const std::string &periodDuration,
+    int64_t periodStartTime, int64_t now, int64_t &start, int64_t &end)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = periods_.find(ident);
+    if (it != periods_.end() && it->second.periodDuration == periodDuration &&
+        it->second.periodStartTime == periodStartTime && it->second.start <= now && now < it->second.end) {
+        start = it->second.start;
+        end = it->second.end;
+        return true;
+    }
+
+    NetBillingCycle cycle;
+    if (!NetBillingCycle::Parse(periodDuration, periodStartTime, cycle) || !cycle.GetPeriod(now, start, end)) {
+        periods_.erase(ident);
+        return false;
+    }
+    CachedPeriod &cached = periods_[ident];
+    cached.periodDuration = periodDuration;
+    cached.periodStartTime = periodStartTime;
+    cached.start = start;
+    cached.end = end;
+    return true;
+}
+
+void NetBillingCycleCache::Remove(const std::string &ident)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    periods_.erase(ident);
+}
+
+void NetBillingCycleCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    periods_.clear();
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
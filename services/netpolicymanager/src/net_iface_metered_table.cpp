@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "net_iface_metered_table.h"
+
+#include <atomic>
+
+namespace OHOS {
+namespace NetManagerStandard {
+NetIfaceMeteredTable::NetIfaceMeteredTable(const std::string &ident) : ident_(ident) {}
+
+bool NetIfaceMeteredTable::UpdateLink(NetBearType bearerType, const std::string &ident, const std::string &ifaceName,
+    bool up)
+{
+    if (ident != ident_ || ifaceName.empty()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (up) {
+        links_[bearerType] = ifaceName;
+    } else {
+        // A stale down for an interface the bearer already moved away from
+        auto it = links_.find(bearerType);
+        if (it == links_.end() || it->second != ifaceName) {
+            return false;
+        }
+        links_.erase(it);
+    }
+    return Publish();
+}
+
+bool NetIfaceMeteredTable::UpdatePolicies(const std::vector<NetPolicyQuotaPolicy> &quotaPolicies)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    bearerMetered_.clear();
+    for (const auto &quotaPolicy : quotaPolicies) {
+        bearerMetered_.emplace(static_cast<NetBearType>(quotaPolicy.netType_), quotaPolicy.metered_ != 0);
+    }
+    return Publish();
+}
+
+bool NetIfaceMeteredTable::IsMetered(const std::string &ifaceName) const
+{
+    std::shared_ptr<const IfaceMap> ifaces = Load();
+    auto it = ifaces->find(ifaceName);
+    return it != ifaces->end() && it->second;
+}
+
+bool NetIfaceMeteredTable::GetIfaceName(NetBearType bearerType, std::string &ifaceName) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = links_.find(bearerType);
+    if (it == links_.end()) {
+        return false;
+    }
+    ifaceName = it->second;
+    return true;
+}
+
+std::set<std::string> NetIfaceMeteredTable::GetMeteredIfaces() const
+{
+    std::set<std::string> metered;
+    for (const auto &item : *Load()) {
+        if (item.second) {
+            metered.insert(item.first);
+        }
+    }
+    return metered;
+}
+
+std::shared_ptr<const NetIfaceMeteredTable::IfaceMap> NetIfaceMeteredTable::Load() const
+{
+    return std::atomic_load_explicit(&ifaces_, std::memory_order_acquire);
+}
+
+bool NetIfaceMeteredTable::Publish()
+{
+    auto ifaces = std::make_shared<IfaceMap>();
+    for (const auto &link : links_) {
+        auto it = bearerMetered_.find(link.first);
+        if (it != bearerMetered_.end()) {
+            (*ifaces)[link.second] = it->second;
+        }
+    }
+    std::shared_ptr<const IfaceMap> last = Load();
+    bool changed = false;
+    for (const auto &item : *ifaces) {
+        auto it = last->find(item.first);
+        bool wasMetered = it != last->end() && it->second;
+        changed = changed || (wasMetered != item.second);
+    }
+    for (const auto &item : *last) {
+        changed = changed || (item.second && ifaces->count(item.first) == 0);
+    }
+    std::atomic_store_explicit(&ifaces_, std::shared_ptr<const IfaceMap>(std::move(ifaces)),
+        std::memory_order_release);
+    return changed;
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -21,53 +21,36 @@ namespace OHOS {
 namespace NetManagerStandard {
 void NetPolicyCallback::RegisterNetPolicyCallback(const sptr<INetPolicyCallback> &callback)
 {
-    if (callback == nullptr) {
-        NETMGR_LOG_E("The parameter callback is null");
-        return;
+    if (netPolicyCallback_.Add(callback)) {
+        NETMGR_LOG_D("netPolicyCallback_ callback num [%{public}zu]", netPolicyCallback_.Size());
     }
-
-    uint32_t callBackNum = netPolicyCallback_.size();
-    NETMGR_LOG_D("netPolicyCallback_ callback num [%{public}d]", callBackNum);
-    if (callBackNum >= LIMIT_CALLBACK_NUM) {
-        NETMGR_LOG_E("netPolicyCallback_ callback num cannot more than [%{public}d]", LIMIT_CALLBACK_NUM);
-        return;
-    }
-
-    for (uint32_t i = 0; i < callBackNum; i++) {
-        if (callback->AsObject().GetRefPtr() == netPolicyCallback_[i]->AsObject().GetRefPtr()) {
-            NETMGR_LOG_I("netPolicyCallback_ had this callback");
-            return;
-        }
-    }
-
-    netPolicyCallback_.emplace_back(callback);
 }
 
 void NetPolicyCallback::UnregisterNetPolicyCallback(const sptr<INetPolicyCallback> &callback)
 {
-    if (callback == nullptr) {
-        NETMGR_LOG_E("The parameter of callback is null");
-        return;
-    }
-
-    for (auto iter = netPolicyCallback_.begin(); iter != netPolicyCallback_.end(); ++iter) {
-        if (callback->AsObject().GetRefPtr() == (*iter)->AsObject().GetRefPtr()) {
-            netPolicyCallback_.erase(iter);
-            return;
-        }
-    }
+    netPolicyCallback_.Remove(callback);
 }
 
 int32_t NetPolicyCallback::NotifyNetUidPolicyChanged(uint32_t uid, NetUidPolicy policy)
 {
     NETMGR_LOG_I("NotifyNetUidPolicyChanged  uid[%{public}d] policy[%{public}d] netPolicyCallback_[%{public}zd]",
-        uid, static_cast<uint32_t>(policy), netPolicyCallback_.size());
+        uid, static_cast<uint32_t>(policy), netPolicyCallback_.Size());
 
-    for (const auto &callback : netPolicyCallback_) {
-        if (callback != nullptr) {
-            callback->NetUidPolicyChanged(uid, policy);
-        }
-    }
+    netPolicyCallback_.Notify(
+        [uid, policy](const sptr<INetPolicyCallback> &callback) { callback->NetUidPolicyChanged(uid, policy); });
+
+    return static_cast<int32_t>(NetPolicyResultCode::ERR_NONE);
+}
+
+int32_t NetPolicyCallback::NotifyNetUidPoliciesChanged(const std::vector<uint32_t> &uids,
+    const std::vector<NetUidPolicy> &policies)
+{
+    NETMGR_LOG_I("NotifyNetUidPoliciesChanged size[%{public}zu] netPolicyCallback_[%{public}zu]", uids.size(),
+        netPolicyCallback_.Size());
+
+    netPolicyCallback_.Notify([uids, policies](const sptr<INetPolicyCallback> &callback) {
+        callback->NetUidPoliciesChanged(uids, policies);
+    });
 
     return static_cast<int32_t>(NetPolicyResultCode::ERR_NONE);
 }
@@ -75,13 +58,11 @@ int32_t NetPolicyCallback::NotifyNetUidPolicyChanged(uint32_t uid, NetUidPolicy
 int32_t NetPolicyCallback::NotifyNetBackgroundPolicyChanged(bool isBackgroundPolicyAllow)
 {
     NETMGR_LOG_I("NotifyNetBackgroundPolicyChanged  backgroundPolicy[%{public}d] netPolicyCallback_[%{public}d]",
-        isBackgroundPolicyAllow, static_cast<uint32_t>(netPolicyCallback_.size()));
+        isBackgroundPolicyAllow, static_cast<uint32_t>(netPolicyCallback_.Size()));
 
-    for (const auto &callback : netPolicyCallback_) {
-        if (callback != nullptr) {
-            callback->NetBackgroundPolicyChanged(isBackgroundPolicyAllow);
-        }
-    }
+    netPolicyCallback_.Notify([isBackgroundPolicyAllow](const sptr<INetPolicyCallback> &callback) {
+        callback->NetBackgroundPolicyChanged(isBackgroundPolicyAllow);
+    });
 
     return static_cast<int32_t>(NetPolicyResultCode::ERR_NONE);
 }
@@ -94,11 +75,9 @@ int32_t NetPolicyCallback::NotifyNetCellularPolicyChanged(const std::vector<NetP
     }
     NETMGR_LOG_I("NotifyNetCellularPolicyChanged cellularPolicies.size[%{public}zd]", cellularPolicies.size());
 
-    for (const auto &callback : netPolicyCallback_) {
-        if (callback != nullptr) {
-            callback->NetCellularPolicyChanged(cellularPolicies);
-        }
-    }
+    netPolicyCallback_.Notify([cellularPolicies](const sptr<INetPolicyCallback> &callback) {
+        callback->NetCellularPolicyChanged(cellularPolicies);
+    });
 
     return static_cast<int32_t>(NetPolicyResultCode::ERR_NONE);
 }
@@ -108,11 +87,8 @@ int32_t NetPolicyCallback::NotifyNetStrategySwitch(const std::string &simId, boo
     NETMGR_LOG_I("NotifyNetStrategySwitch simId[%{public}s] enable[%{public}d]",
         simId.c_str(), static_cast<int32_t>(enable));
 
-    for (const auto &callback : netPolicyCallback_) {
-        if (callback != nullptr) {
-            callback->NetStrategySwitch(simId, enable);
-        }
-    }
+    netPolicyCallback_.Notify(
+        [simId, enable](const sptr<INetPolicyCallback> &callback) { callback->NetStrategySwitch(simId, enable); });
 
     return static_cast<int32_t>(NetPolicyResultCode::ERR_NONE);
 }
@@ -14,18 +14,66 @@
  */
 #include "net_policy_file.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
 #include <fcntl.h>
 #include <string>
 
 #include <json/json.h>
 
-#include "net_manager_center.h"
 #include "net_mgr_log_wrapper.h"
 #include "net_policy_define.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
 const std::string MONTH_DEFAULT = "M1";
+namespace {
+constexpr int32_t DECIMAL_BASE = 10;
+// Bursts of policy changes, e.g. bulk setup at first boot, end up in a single rewrite
+constexpr uint32_t PERSIST_DELAY_MS = 200;
+constexpr uint32_t PERSIST_RETRY_MS = 1000;
+constexpr uint32_t PERSIST_RETRY_MAX_MS = 60 * 1000;
+const std::string TEMP_FILE_SUFFIX = ".tmp";
+
+// The file keeps every number as a string, numbers written by hand are accepted too
+int64_t JsonToInt64(const Json::Value &value, int64_t defaultValue)
+{
+    if (value.isString()) {
+        std::string str = value.asString();
+        char *end = nullptr;
+        errno = 0;
+        long long number = strtoll(str.c_str(), &end, DECIMAL_BASE);
+        if (str.empty() || *end != '\0' || errno == ERANGE) {
+            return defaultValue;
+        }
+        return static_cast<int64_t>(number);
+    }
+    if (value.isNumeric()) {
+        return value.asInt64();
+    }
+    return defaultValue;
+}
+} // namespace
+
+NetPolicyFile::NetPolicyFile(const std::string &fileName)
+    : fileName_(fileName),
+      dirty_(false),
+      persistCount_(0),
+      persistFailures_(0),
+      persistPending_(false),
+      persistLoop_("NetPolicyPersist")
+{
+    persistLoop_.Start();
+}
+
+NetPolicyFile::~NetPolicyFile()
+{
+    // Stopping the loop runs the pending delayed write
+    persistLoop_.Stop();
+    Flush();
+}
 
 bool NetPolicyFile::FileExists(const std::string& fileName)
 {
@@ -54,36 +102,41 @@ void NetPolicyFile::ParseUidPolicy(const Json::Value &root, NetPolicy &netPolicy
 {
     const Json::Value arrayUidPolicy = root[CONFIG_UID_POLICY];
     uint32_t size = arrayUidPolicy.size();
-    UidPolicy uidPolicy;
     for (uint32_t i = 0; i < size; i++) {
-        uidPolicy.uid= arrayUidPolicy[i][CONFIG_UID].asString();
-        uidPolicy.policy = arrayUidPolicy[i][CONFIG_POLICY].asString();
-        netPolicy.uidPolicys.push_back(uidPolicy);
+        int64_t uid = JsonToInt64(arrayUidPolicy[i][CONFIG_UID], -1);
+        int64_t policy = JsonToInt64(arrayUidPolicy[i][CONFIG_POLICY], -1);
+        if (uid < 0 || uid > UINT32_MAX || policy < 0 || policy > UINT32_MAX) {
+            NETMGR_LOG_E("Skip malformed uid policy at [%{public}d]", i);
+            continue;
+        }
+        netPolicy.uidPolicies.Set(static_cast<uint32_t>(uid), static_cast<NetUidPolicy>(policy));
     }
 }
 
 void NetPolicyFile::ParseBackgroundPolicy(const Json::Value &root, NetPolicy& netPolicy)
 {
     const Json::Value mapBackgroundPolicy = root[CONFIG_BACKGROUND_POLICY];
-    netPolicy.backgroundPolicyStatus_ = mapBackgroundPolicy[CONFIG_BACKGROUND_POLICY_STATUS].asString();
+    netPolicy.backgroundPolicy =
+        (mapBackgroundPolicy[CONFIG_BACKGROUND_POLICY_STATUS].asString() != BACKGROUND_POLICY_REJECT);
 }
 
 void NetPolicyFile::ParseQuotaPolicy(const Json::Value &root, NetPolicy &netPolicy)
 {
     const Json::Value arrayQuotaPolicy = root[CONFIG_QUOTA_POLICY];
     uint32_t size = arrayQuotaPolicy.size();
-    NetPolicyQuota quotaPolicy;
     for (uint32_t i = 0; i < size; i++) {
-        quotaPolicy.netType = arrayQuotaPolicy[i][CONFIG_QUOTA_POLICY_NETTYPE].asString();
-        quotaPolicy.simId = arrayQuotaPolicy[i][CONFIG_QUOTA_POLICY_SUBSCRIBERID].asString();
-        quotaPolicy.periodStartTime = arrayQuotaPolicy[i][CONFIG_QUOTA_POLICY_PERIODSTARTTIME].asString();
-        quotaPolicy.periodDuration = arrayQuotaPolicy[i][CONFIG_QUOTA_POLICY_PERIODDURATION].asString();
-        quotaPolicy.warningBytes = arrayQuotaPolicy[i][CONFIG_QUOTA_POLICY_WARNINGBYTES].asString();
-        quotaPolicy.limitBytes = arrayQuotaPolicy[i][CONFIG_QUOTA_POLICY_LIMITBYTES].asString();
-        quotaPolicy.lastLimitSnooze = arrayQuotaPolicy[i][CONFIG_QUOTA_POLICY_LASTLIMITSNOOZE].asString();
-        quotaPolicy.metered = arrayQuotaPolicy[i][CONFIG_QUOTA_POLICY_METERED].asString();
-        quotaPolicy.source = arrayQuotaPolicy[i][CONFIG_QUOTA_POLICY_SOURCE].asString();
-        netPolicy.netQuotaPolicys.push_back(quotaPolicy);
+        const Json::Value &item = arrayQuotaPolicy[i];
+        NetPolicyQuotaPolicy quotaPolicy;
+        quotaPolicy.netType_ = static_cast<int8_t>(JsonToInt64(item[CONFIG_QUOTA_POLICY_NETTYPE], -1));
+        quotaPolicy.simId_ = item[CONFIG_QUOTA_POLICY_SUBSCRIBERID].asString();
+        quotaPolicy.periodStartTime_ = JsonToInt64(item[CONFIG_QUOTA_POLICY_PERIODSTARTTIME], -1);
+        quotaPolicy.periodDuration_ = item[CONFIG_QUOTA_POLICY_PERIODDURATION].asString();
+        quotaPolicy.warningBytes_ = JsonToInt64(item[CONFIG_QUOTA_POLICY_WARNINGBYTES], -1);
+        quotaPolicy.limitBytes_ = JsonToInt64(item[CONFIG_QUOTA_POLICY_LIMITBYTES], -1);
+        quotaPolicy.lastLimitSnooze_ = JsonToInt64(item[CONFIG_QUOTA_POLICY_LASTLIMITSNOOZE], -1);
+        quotaPolicy.metered_ = static_cast<int8_t>(JsonToInt64(item[CONFIG_QUOTA_POLICY_METERED], -1));
+        quotaPolicy.source_ = static_cast<int8_t>(JsonToInt64(item[CONFIG_QUOTA_POLICY_SOURCE], -1));
+        netPolicy.quotaPolicies.push_back(quotaPolicy);
     }
 }
 
@@ -91,22 +144,40 @@ void NetPolicyFile::ParseCellularPolicy(const Json::Value &root, NetPolicy &netP
 {
     const Json::Value arrayCellularPolicy = root[CONFIG_CELLULAR_POLICY];
     uint32_t size = arrayCellularPolicy.size();
-    NetPolicyCellular cellularPolicy;
     for (uint32_t i = 0; i < size; i++) {
-        cellularPolicy.simId = arrayCellularPolicy[i][CONFIG_CELLULAR_POLICY_SUBSCRIBERID].asString();
-        cellularPolicy.periodStartTime = arrayCellularPolicy[i][CONFIG_CELLULAR_POLICY_PERIODSTARTTIME].asString();
-        cellularPolicy.periodDuration = arrayCellularPolicy[i][CONFIG_CELLULAR_POLICY_PERIODDURATION].asString();
-        cellularPolicy.title = arrayCellularPolicy[i][CONFIG_CELLULAR_POLICY_TITLE].asString();
-        cellularPolicy.summary = arrayCellularPolicy[i][CONFIG_CELLULAR_POLICY_SUMMARY].asString();
-        cellularPolicy.limitBytes = arrayCellularPolicy[i][CONFIG_CELLULAR_POLICY_LIMITBYTES].asString();
-        cellularPolicy.limitAction = arrayCellularPolicy[i][CONFIG_CELLULAR_POLICY_LIMITACTION].asString();
-        cellularPolicy.usedBytes = arrayCellularPolicy[i][CONFIG_CELLULAR_POLICY_USEDBYTES].asString();
-        cellularPolicy.usedTimeDuration = arrayCellularPolicy[i][CONFIG_CELLULAR_POLICY_USEDTIMEDURATION].asString();
-        cellularPolicy.possessor = arrayCellularPolicy[i][CONFIG_CELLULAR_POLICY_POSSESSOR].asString();
-        netPolicy.netCellularPolicys.push_back(cellularPolicy);
+        const Json::Value &item = arrayCellularPolicy[i];
+        NetPolicyCellularPolicy cellularPolicy;
+        cellularPolicy.simId_ = item[CONFIG_CELLULAR_POLICY_SUBSCRIBERID].asString();
+        cellularPolicy.periodStartTime_ = JsonToInt64(item[CONFIG_CELLULAR_POLICY_PERIODSTARTTIME], -1);
+        cellularPolicy.periodDuration_ = item[CONFIG_CELLULAR_POLICY_PERIODDURATION].asString();
+        cellularPolicy.title_ = item[CONFIG_CELLULAR_POLICY_TITLE].asString();
+        cellularPolicy.summary_ = item[CONFIG_CELLULAR_POLICY_SUMMARY].asString();
+        cellularPolicy.limitBytes_ = JsonToInt64(item[CONFIG_CELLULAR_POLICY_LIMITBYTES], -1);
+        cellularPolicy.limitAction_ = static_cast<int32_t>(JsonToInt64(item[CONFIG_CELLULAR_POLICY_LIMITACTION], -1));
+        cellularPolicy.usedBytes_ = JsonToInt64(item[CONFIG_CELLULAR_POLICY_USEDBYTES], -1);
+        cellularPolicy.usedTimeDuration_ = JsonToInt64(item[CONFIG_CELLULAR_POLICY_USEDTIMEDURATION], -1);
+        cellularPolicy.possessor_ = item[CONFIG_CELLULAR_POLICY_POSSESSOR].asString();
+        netPolicy.cellularPolicies.push_back(cellularPolicy);
     }
 }
 
+void NetPolicyFile::ParseIdleTrustlist(const Json::Value &root, NetPolicy &netPolicy)
+{
+    const Json::Value arrayIdleTrustlist = root[CONFIG_IDLE_TRUSTLIST];
+    uint32_t size = arrayIdleTrustlist.size();
+    std::vector<uint32_t> uids;
+    uids.reserve(size);
+    for (uint32_t i = 0; i < size; i++) {
+        int64_t uid = JsonToInt64(arrayIdleTrustlist[i], -1);
+        if (uid < 0 || uid > UINT32_MAX) {
+            NETMGR_LOG_E("Skip malformed idle trust uid at [%{public}d]", i);
+            continue;
+        }
+        uids.push_back(static_cast<uint32_t>(uid));
+    }
+    netPolicy.idleTrustList.Assign(uids);
+}
+
 bool NetPolicyFile::Json2Obj(const std::string &content, NetPolicy &netPolicy)
 {
     if (content.empty()) {
@@ -132,6 +203,8 @@ bool NetPolicyFile::Json2Obj(const std::string &content, NetPolicy &netPolicy)
         ParseQuotaPolicy(root, netPolicy);
         // parse cellular policy from file
         ParseCellularPolicy(root, netPolicy);
+        // parse idle trust list from file
+        ParseIdleTrustlist(root, netPolicy);
     }
 
     return true;
@@ -164,159 +237,240 @@ bool NetPolicyFile::ReadFile(const std::string &fileName, std::string &fileConte
     return true;
 }
 
-void NetPolicyFile::AppendQuotaPolicy(Json::Value &root)
+void NetPolicyFile::AppendQuotaPolicy(const NetPolicySnapshot &netPolicy, Json::Value &root)
 {
-    uint32_t size = netPolicy_.netQuotaPolicys.size();
-    for (uint32_t i = 0; i < size; i++) {
+    for (const auto &item : *netPolicy.quotaPolicies) {
         Json::Value quotaPolicy;
-        quotaPolicy[CONFIG_QUOTA_POLICY_NETTYPE] = netPolicy_.netQuotaPolicys[i].netType;
-        quotaPolicy[CONFIG_QUOTA_POLICY_SUBSCRIBERID] = netPolicy_.netQuotaPolicys[i].simId;
-        quotaPolicy[CONFIG_QUOTA_POLICY_PERIODSTARTTIME] = netPolicy_.netQuotaPolicys[i].periodStartTime;
-        quotaPolicy[CONFIG_QUOTA_POLICY_PERIODDURATION] = netPolicy_.netQuotaPolicys[i].periodDuration;
-        quotaPolicy[CONFIG_QUOTA_POLICY_WARNINGBYTES] = netPolicy_.netQuotaPolicys[i].warningBytes;
-        quotaPolicy[CONFIG_QUOTA_POLICY_LIMITBYTES] = netPolicy_.netQuotaPolicys[i].limitBytes;
-        quotaPolicy[CONFIG_QUOTA_POLICY_LASTLIMITSNOOZE] = netPolicy_.netQuotaPolicys[i].lastLimitSnooze;
-        quotaPolicy[CONFIG_QUOTA_POLICY_METERED] = netPolicy_.netQuotaPolicys[i].metered;
-        quotaPolicy[CONFIG_QUOTA_POLICY_SOURCE] = netPolicy_.netQuotaPolicys[i].source;
+        quotaPolicy[CONFIG_QUOTA_POLICY_NETTYPE] = std::to_string(item.netType_);
+        quotaPolicy[CONFIG_QUOTA_POLICY_SUBSCRIBERID] = item.simId_;
+        quotaPolicy[CONFIG_QUOTA_POLICY_PERIODSTARTTIME] = std::to_string(item.periodStartTime_);
+        quotaPolicy[CONFIG_QUOTA_POLICY_PERIODDURATION] = item.periodDuration_;
+        quotaPolicy[CONFIG_QUOTA_POLICY_WARNINGBYTES] = std::to_string(item.warningBytes_);
+        quotaPolicy[CONFIG_QUOTA_POLICY_LIMITBYTES] = std::to_string(item.limitBytes_);
+        quotaPolicy[CONFIG_QUOTA_POLICY_LASTLIMITSNOOZE] = std::to_string(item.lastLimitSnooze_);
+        quotaPolicy[CONFIG_QUOTA_POLICY_METERED] = std::to_string(item.metered_);
+        quotaPolicy[CONFIG_QUOTA_POLICY_SOURCE] = std::to_string(item.source_);
         root[CONFIG_QUOTA_POLICY].append(quotaPolicy);
     }
 }
 
-void NetPolicyFile::AppendCellularPolicy(Json::Value &root)
+void NetPolicyFile::AppendCellularPolicy(const NetPolicySnapshot &netPolicy, Json::Value &root)
 {
-    uint32_t size = netPolicy_.netCellularPolicys.size();
-    for (uint32_t i = 0; i < size; i++) {
+    for (const auto &item : *netPolicy.cellularPolicies) {
         Json::Value cellularPolicy;
-        cellularPolicy[CONFIG_CELLULAR_POLICY_SUBSCRIBERID] = netPolicy_.netCellularPolicys[i].simId;
-        cellularPolicy[CONFIG_CELLULAR_POLICY_PERIODSTARTTIME] =
-            netPolicy_.netCellularPolicys[i].periodStartTime;
-        cellularPolicy[CONFIG_CELLULAR_POLICY_PERIODDURATION] = netPolicy_.netCellularPolicys[i].periodDuration;
-        cellularPolicy[CONFIG_CELLULAR_POLICY_TITLE] = netPolicy_.netCellularPolicys[i].title;
-        cellularPolicy[CONFIG_CELLULAR_POLICY_SUMMARY] = netPolicy_.netCellularPolicys[i].summary;
-        cellularPolicy[CONFIG_CELLULAR_POLICY_LIMITBYTES] = netPolicy_.netCellularPolicys[i].limitBytes;
-        cellularPolicy[CONFIG_CELLULAR_POLICY_LIMITACTION] = netPolicy_.netCellularPolicys[i].limitAction;
-        cellularPolicy[CONFIG_CELLULAR_POLICY_USEDBYTES] = netPolicy_.netCellularPolicys[i].usedBytes;
-        cellularPolicy[CONFIG_CELLULAR_POLICY_USEDTIMEDURATION] =
-            netPolicy_.netCellularPolicys[i].usedTimeDuration;
-        cellularPolicy[CONFIG_CELLULAR_POLICY_POSSESSOR] = netPolicy_.netCellularPolicys[i].possessor;
+        cellularPolicy[CONFIG_CELLULAR_POLICY_SUBSCRIBERID] = item.simId_;
+        cellularPolicy[CONFIG_CELLULAR_POLICY_PERIODSTARTTIME] = std::to_string(item.periodStartTime_);
+        cellularPolicy[CONFIG_CELLULAR_POLICY_PERIODDURATION] = item.periodDuration_;
+        cellularPolicy[CONFIG_CELLULAR_POLICY_TITLE] = item.title_;
+        cellularPolicy[CONFIG_CELLULAR_POLICY_SUMMARY] = item.summary_;
+        cellularPolicy[CONFIG_CELLULAR_POLICY_LIMITBYTES] = std::to_string(item.limitBytes_);
+        cellularPolicy[CONFIG_CELLULAR_POLICY_LIMITACTION] = std::to_string(item.limitAction_);
+        cellularPolicy[CONFIG_CELLULAR_POLICY_USEDBYTES] = std::to_string(item.usedBytes_);
+        cellularPolicy[CONFIG_CELLULAR_POLICY_USEDTIMEDURATION] = std::to_string(item.usedTimeDuration_);
+        cellularPolicy[CONFIG_CELLULAR_POLICY_POSSESSOR] = item.possessor_;
         root[CONFIG_CELLULAR_POLICY].append(cellularPolicy);
     }
 }
 
-void NetPolicyFile::AppendUidPolicy(Json::Value &root)
+void NetPolicyFile::AppendUidPolicy(const NetPolicySnapshot &netPolicy, Json::Value &root)
 {
-    uint32_t size = netPolicy_.uidPolicys.size();
-    for (uint32_t i = 0; i < size; i++) {
-        Json::Value uidPolicy;
-        uidPolicy[CONFIG_UID] = netPolicy_.uidPolicys[i].uid;
-        uidPolicy[CONFIG_POLICY] = netPolicy_.uidPolicys[i].policy;
-        std::string policy = std::to_string(static_cast<uint32_t>(NetUidPolicy::NET_POLICY_TEMPORARY_ALLOW_METERED));
+    netPolicy.uidPolicies->ForEach([&root](uint32_t uid, NetUidPolicy policy) {
         /* Temporary permission, no need to write files */
-        if (netPolicy_.uidPolicys[i].policy == policy) {
-            continue;
+        if (policy == NetUidPolicy::NET_POLICY_TEMPORARY_ALLOW_METERED) {
+            return;
         }
+        Json::Value uidPolicy;
+        uidPolicy[CONFIG_UID] = std::to_string(uid);
+        uidPolicy[CONFIG_POLICY] = std::to_string(static_cast<uint32_t>(policy));
         root[CONFIG_UID_POLICY].append(uidPolicy);
+    });
+}
+
+void NetPolicyFile::AppendIdleTrustlist(const NetPolicySnapshot &netPolicy, Json::Value &root)
+{
+    Json::Value idleTrustlist(Json::arrayValue);
+    for (uint32_t uid : netPolicy.idleTrustList->Values()) {
+        idleTrustlist.append(std::to_string(uid));
     }
+    root[CONFIG_IDLE_TRUSTLIST] = idleTrustlist;
 }
 
-void NetPolicyFile::AppendBackgroundPolicy(Json::Value &root)
+void NetPolicyFile::AppendBackgroundPolicy(const NetPolicySnapshot &netPolicy, Json::Value &root)
 {
     Json::Value backgroundPolicy;
-    if (netPolicy_.backgroundPolicyStatus_.empty()) {
-        netPolicy_.backgroundPolicyStatus_ = BACKGROUND_POLICY_ALLOW;
-    }
-    backgroundPolicy[CONFIG_BACKGROUND_POLICY_STATUS] = netPolicy_.backgroundPolicyStatus_;
+    backgroundPolicy[CONFIG_BACKGROUND_POLICY_STATUS] =
+        netPolicy.backgroundPolicy ? BACKGROUND_POLICY_ALLOW : BACKGROUND_POLICY_REJECT;
     root[CONFIG_BACKGROUND_POLICY] = backgroundPolicy;
 }
 
+std::string NetPolicyFile::BuildContent(const NetPolicySnapshot &netPolicy)
+{
+    Json::Value root;
+    Json::StreamWriterBuilder builder;
+    std::unique_ptr<Json::StreamWriter> streamWriter(builder.newStreamWriter());
+    root[CONFIG_HOS_VERSION] = Json::Value(netPolicy.hosVersion.empty() ? HOS_VERSION : netPolicy.hosVersion);
+    // uid policy
+    AppendUidPolicy(netPolicy, root);
+    // background policy
+    AppendBackgroundPolicy(netPolicy, root);
+    // quota policy
+    AppendQuotaPolicy(netPolicy, root);
+    // cellular policy
+    AppendCellularPolicy(netPolicy, root);
+    // idle trust list
+    AppendIdleTrustlist(netPolicy, root);
+    std::ostringstream out;
+    streamWriter->write(root, &out);
+    return out.str();
+}
+
+bool NetPolicyFile::ReplaceFile(const std::string &fileName, const std::string &content)
+{
+    std::string tempName = fileName + TEMP_FILE_SUFFIX;
+    int32_t fd = open(tempName.c_str(), O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, CHOWN_RWX_USR_GRP);
+    if (fd < 0) {
+        NETMGR_LOG_E("open [%{public}s] failed, errno[%{public}d]", tempName.c_str(), errno);
+        return false;
+    }
+
+    const char *data = content.c_str();
+    size_t remain = content.size();
+    while (remain > 0) {
+        ssize_t written = write(fd, data, remain);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            NETMGR_LOG_E("write [%{public}s] failed, errno[%{public}d]", tempName.c_str(), errno);
+            close(fd);
+            unlink(tempName.c_str());
+            return false;
+        }
+        data += written;
+        remain -= static_cast<size_t>(written);
+    }
+
+    // The rename must never expose a file whose data is not on disk yet
+    if (fsync(fd) != 0) {
+        NETMGR_LOG_E("fsync [%{public}s] failed, errno[%{public}d]", tempName.c_str(), errno);
+        close(fd);
+        unlink(tempName.c_str());
+        return false;
+    }
+    close(fd);
+
+    if (rename(tempName.c_str(), fileName.c_str()) != 0) {
+        NETMGR_LOG_E("rename to [%{public}s] failed, errno[%{public}d]", fileName.c_str(), errno);
+        unlink(tempName.c_str());
+        return false;
+    }
+
+    // The rename itself is only durable once the directory entry is on disk
+    size_t slash = fileName.find_last_of('/');
+    std::string dirName = (slash == std::string::npos) ? "." : fileName.substr(0, std::max<size_t>(slash, 1));
+    int32_t dirFd = open(dirName.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0) {
+        NETMGR_LOG_E("open [%{public}s] failed, errno[%{public}d]", dirName.c_str(), errno);
+        return false;
+    }
+    bool synced = (fsync(dirFd) == 0);
+    if (!synced) {
+        NETMGR_LOG_E("fsync [%{public}s] failed, errno[%{public}d]", dirName.c_str(), errno);
+    }
+    close(dirFd);
+    return synced;
+}
+
 bool NetPolicyFile::WriteFile(const std::string &fileName)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
     if (fileName.empty()) {
         NETMGR_LOG_D("fileName is empty.");
         return false;
     }
 
-    Json::Value root;
-    Json::StreamWriterBuilder builder;
-    std::unique_ptr<Json::StreamWriter> streamWriter(builder.newStreamWriter());
-    std::fstream file(fileName.c_str(), std::fstream::out);
-    if (file.is_open() == false) {
-        NETMGR_LOG_E("fstream failed.");
+    // Serializes file writers so that an older snapshot never replaces a newer one
+    std::unique_lock<std::mutex> writeLock(writeMutex_);
+    // Cleared before the load, a change published after it marks the state dirty again
+    dirty_ = false;
+    std::string content = BuildContent(*LoadSnapshot());
+
+    if (!ReplaceFile(fileName, content)) {
+        dirty_ = true;
+        persistFailures_++;
         return false;
     }
+    persistFailures_ = 0;
+    persistCount_++;
+    return true;
+}
 
-    if (netPolicy_.hosVersion.empty()) {
-        netPolicy_.hosVersion = HOS_VERSION;
+void NetPolicyFile::SchedulePersist()
+{
+    dirty_ = true;
+    if (persistPending_.exchange(true)) {
+        return;
     }
+    PostPersist(PERSIST_DELAY_MS);
+}
 
-    root[CONFIG_HOS_VERSION] = Json::Value(netPolicy_.hosVersion);
-    // uid policy
-    AppendUidPolicy(root);
-    // background policy
-    AppendBackgroundPolicy(root);
-    // quota policy
-    AppendQuotaPolicy(root);
-    // cellular policy
-    AppendCellularPolicy(root);
-    std::ostringstream out;
-    streamWriter->write(root, &out);
-    file << out.str().c_str();
-    file.close();
+void NetPolicyFile::PostPersist(uint32_t delayMs)
+{
+    bool posted = persistLoop_.PostDelayed([this, delayMs]() {
+        persistPending_ = false;
+        if (!dirty_ || WriteFile(fileName_)) {
+            return;
+        }
+        // Nothing else would write the state again, unless another change comes in first
+        if (!persistPending_.exchange(true)) {
+            uint32_t retryMs = std::min(std::max(delayMs * 2, PERSIST_RETRY_MS), PERSIST_RETRY_MAX_MS);
+            NETMGR_LOG_E("WriteFile failed [%{public}u] times, retry in [%{public}u]ms",
+                persistFailures_.load(), retryMs);
+            PostPersist(retryMs);
+        }
+    }, delayMs);
+    if (!posted) {
+        persistPending_ = false;
+        Flush();
+    }
+}
 
+bool NetPolicyFile::Flush()
+{
+    if (dirty_ && !WriteFile(fileName_)) {
+        NETMGR_LOG_E("WriteFile failed");
+        return false;
+    }
     return true;
 }
 
 bool NetPolicyFile::WriteFile(NetUidPolicyOpType netUidPolicyOpType, uint32_t uid, NetUidPolicy policy)
 {
+    std::unique_lock<std::mutex> lock(mutex_);
     if (netUidPolicyOpType == NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_UPDATE) {
-        for (auto &uidPolicy : netPolicy_.uidPolicys) {
-            if (uidPolicy.uid == std::to_string(uid)) {
-                uidPolicy.policy = std::to_string(static_cast<uint32_t>(policy));
-                break;
-            }
+        if (!netPolicy_.uidPolicies.Contains(uid)) {
+            return true;
         }
+        netPolicy_.uidPolicies.Set(uid, policy);
+        verdicts_.UpdateUid(uid, policy);
     } else if (netUidPolicyOpType == NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_DELETE) {
-        for (auto iter = netPolicy_.uidPolicys.begin(); iter != netPolicy_.uidPolicys.end(); ++iter) {
-            if (iter->uid == std::to_string(uid)) {
-                netPolicy_.uidPolicys.erase(iter);
-                break;
-            }
-        }
+        netPolicy_.uidPolicies.Remove(uid);
+        verdicts_.UpdateUid(uid, NetUidPolicy::NET_POLICY_NONE);
     } else {
-        UidPolicy uidPolicy;
-        uidPolicy.uid = std::to_string(uid);
-        uidPolicy.policy = std::to_string(static_cast<uint32_t>(policy));
-        netPolicy_.uidPolicys.push_back(uidPolicy);
-    }
-
-    if (!WriteFile(POLICY_FILE_NAME)) {
-        NETMGR_LOG_E("WriteFile failed");
-        return false;
+        netPolicy_.uidPolicies.Set(uid, policy);
+        verdicts_.UpdateUid(uid, policy);
     }
+    PublishSnapshot(POLICY_TABLE_UID);
+    lock.unlock();
 
+    SchedulePersist();
     return true;
 }
 
 bool NetPolicyFile::UpdateQuotaPolicyExist(const NetPolicyQuotaPolicy &quotaPolicy)
 {
-    if (netPolicy_.netQuotaPolicys.empty()) {
-        NETMGR_LOG_E("UpdateQuotaPolicyExist netPolicyQuotaPolicys is empty");
-        return false;
-    }
-
-    for (uint32_t i = 0; i < netPolicy_.netQuotaPolicys.size(); ++i) {
-        if (quotaPolicy.simId_ == netPolicy_.netQuotaPolicys[i].simId &&
-            netPolicy_.netQuotaPolicys[i].netType == std::to_string(quotaPolicy.netType_)) {
-            netPolicy_.netQuotaPolicys[i].lastLimitSnooze = std::to_string(quotaPolicy.lastLimitSnooze_);
-            netPolicy_.netQuotaPolicys[i].limitBytes = std::to_string(quotaPolicy.limitBytes_);
-            netPolicy_.netQuotaPolicys[i].metered = std::to_string(quotaPolicy.metered_);
-            netPolicy_.netQuotaPolicys[i].netType = std::to_string(quotaPolicy.netType_);
-            netPolicy_.netQuotaPolicys[i].periodDuration = quotaPolicy.periodDuration_;
-            netPolicy_.netQuotaPolicys[i].periodStartTime = std::to_string(quotaPolicy.periodStartTime_);
-            netPolicy_.netQuotaPolicys[i].source = std::to_string(quotaPolicy.source_);
-            netPolicy_.netQuotaPolicys[i].simId = quotaPolicy.simId_;
-            netPolicy_.netQuotaPolicys[i].warningBytes = std::to_string(quotaPolicy.warningBytes_);
+    for (auto &item : netPolicy_.quotaPolicies) {
+        if (item.simId_ == quotaPolicy.simId_ && item.netType_ == quotaPolicy.netType_) {
+            item = quotaPolicy;
             return true;
         }
     }
@@ -326,51 +480,25 @@ bool NetPolicyFile::UpdateQuotaPolicyExist(const NetPolicyQuotaPolicy &quotaPoli
 
 bool NetPolicyFile::WriteFile(const std::vector<NetPolicyQuotaPolicy> &quotaPolicies)
 {
-    uint32_t vSize = static_cast<uint32_t>(quotaPolicies.size());
-    NetPolicyQuota quotaPolicy;
-    for (uint32_t i = 0; i < vSize; i++) {
-        if (UpdateQuotaPolicyExist(quotaPolicies[i])) {
-            continue;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (const auto &quotaPolicy : quotaPolicies) {
+            if (!UpdateQuotaPolicyExist(quotaPolicy)) {
+                netPolicy_.quotaPolicies.push_back(quotaPolicy);
+            }
         }
-        quotaPolicy.lastLimitSnooze = std::to_string(quotaPolicies[i].lastLimitSnooze_);
-        quotaPolicy.limitBytes = std::to_string(quotaPolicies[i].limitBytes_);
-        quotaPolicy.metered = std::to_string(quotaPolicies[i].metered_);
-        quotaPolicy.netType = std::to_string(quotaPolicies[i].netType_);
-        quotaPolicy.periodDuration = quotaPolicies[i].periodDuration_;
-        quotaPolicy.periodStartTime = std::to_string(quotaPolicies[i].periodStartTime_);
-        quotaPolicy.source = std::to_string(quotaPolicies[i].source_);
-        quotaPolicy.simId = quotaPolicies[i].simId_;
-        quotaPolicy.warningBytes = std::to_string(quotaPolicies[i].warningBytes_);
-        netPolicy_.netQuotaPolicys.push_back(quotaPolicy);
-    }
-
-    if (!WriteFile(POLICY_FILE_NAME)) {
-        NETMGR_LOG_E("WriteFile failed");
-        return false;
+        PublishSnapshot(POLICY_TABLE_QUOTA);
     }
 
+    SchedulePersist();
     return true;
 }
 
 bool NetPolicyFile::UpdateCellularPolicyExist(const NetPolicyCellularPolicy &cellularPolicy)
 {
-    if (netPolicy_.netCellularPolicys.empty()) {
-        NETMGR_LOG_E("UpdateCellularPolicyExist netCellularPolicys is empty");
-        return false;
-    }
-
-    for (uint32_t i = 0; i < netPolicy_.netCellularPolicys.size(); ++i) {
-        if (cellularPolicy.simId_ == netPolicy_.netCellularPolicys[i].simId) {
-            netPolicy_.netCellularPolicys[i].simId = cellularPolicy.simId_;
-            netPolicy_.netCellularPolicys[i].periodStartTime = std::to_string(cellularPolicy.periodStartTime_);
-            netPolicy_.netCellularPolicys[i].periodDuration = cellularPolicy.periodDuration_;
-            netPolicy_.netCellularPolicys[i].title = cellularPolicy.title_;
-            netPolicy_.netCellularPolicys[i].summary = cellularPolicy.summary_;
-            netPolicy_.netCellularPolicys[i].limitBytes = std::to_string(cellularPolicy.limitBytes_);
-            netPolicy_.netCellularPolicys[i].limitAction = std::to_string(cellularPolicy.limitAction_);
-            netPolicy_.netCellularPolicys[i].usedBytes = std::to_string(cellularPolicy.usedBytes_);
-            netPolicy_.netCellularPolicys[i].usedTimeDuration = std::to_string(cellularPolicy.usedTimeDuration_);
-            netPolicy_.netCellularPolicys[i].possessor = cellularPolicy.possessor_;
+    for (auto &item : netPolicy_.cellularPolicies) {
+        if (item.simId_ == cellularPolicy.simId_) {
+            item = cellularPolicy;
             return true;
         }
     }
@@ -380,102 +508,94 @@ bool NetPolicyFile::UpdateCellularPolicyExist(const NetPolicyCellularPolicy &cel
 
 bool NetPolicyFile::WriteFile(const std::vector<NetPolicyCellularPolicy> &cellularPolicies)
 {
-    uint32_t vSize = static_cast<uint32_t>(cellularPolicies.size());
-    NetPolicyCellular cellularPolicy;
-    for (uint32_t i = 0; i < vSize; i++) {
-        if (UpdateCellularPolicyExist(cellularPolicies[i])) {
-            continue;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (const auto &cellularPolicy : cellularPolicies) {
+            if (!UpdateCellularPolicyExist(cellularPolicy)) {
+                netPolicy_.cellularPolicies.push_back(cellularPolicy);
+            }
         }
-        cellularPolicy.simId = cellularPolicies[i].simId_;
-        cellularPolicy.periodStartTime = std::to_string(cellularPolicies[i].periodStartTime_);
-        cellularPolicy.periodDuration = cellularPolicies[i].periodDuration_;
-        cellularPolicy.title = cellularPolicies[i].title_;
-        cellularPolicy.summary = cellularPolicies[i].summary_;
-        cellularPolicy.limitBytes = std::to_string(cellularPolicies[i].limitBytes_);
-        cellularPolicy.limitAction = std::to_string(cellularPolicies[i].limitAction_);
-        cellularPolicy.usedBytes = std::to_string(cellularPolicies[i].usedBytes_);
-        cellularPolicy.usedTimeDuration = std::to_string(cellularPolicies[i].usedTimeDuration_);
-        cellularPolicy.possessor = cellularPolicies[i].possessor_;
-        netPolicy_.netCellularPolicys.push_back(cellularPolicy);
-    }
-
-    if (!WriteFile(POLICY_FILE_NAME)) {
-        NETMGR_LOG_E("WriteFile failed");
-        return false;
+        PublishSnapshot(POLICY_TABLE_CELLULAR);
     }
 
+    SchedulePersist();
     return true;
 }
 
 bool NetPolicyFile::IsUidPolicyExist(uint32_t uid)
 {
-    uint32_t size = netPolicy_.uidPolicys.size();
-    for (uint32_t i = 0; i < size; i++) {
-        if (static_cast<uint32_t>(stol(netPolicy_.uidPolicys[i].uid)) == uid) {
-            return true;
-        }
-    }
-
-    return false;
+    return LoadSnapshot()->uidPolicies->Contains(uid);
 }
 
 NetUidPolicy NetPolicyFile::GetPolicyByUid(uint32_t uid)
 {
-    for (auto &uidPolicy : netPolicy_.uidPolicys) {
-        if (uidPolicy.uid == std::to_string(uid)) {
-            return static_cast<NetUidPolicy>(std::stol(uidPolicy.policy));
+    NetUidPolicy policy = NetUidPolicy::NET_POLICY_NONE;
+    LoadSnapshot()->uidPolicies->Find(uid, policy);
+    return policy;
+}
+
+void NetPolicyFile::SetPoliciesByUids(const std::vector<uint32_t> &uids, const std::vector<NetUidPolicy> &policies,
+    std::vector<uint32_t> &changedUids, std::vector<NetUidPolicy> &changedPolicies)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < uids.size() && i < policies.size(); ++i) {
+            NetUidPolicy current = NetUidPolicy::NET_POLICY_NONE;
+            netPolicy_.uidPolicies.Find(uids[i], current);
+            if (current == policies[i]) {
+                continue;
+            }
+            if (policies[i] == NetUidPolicy::NET_POLICY_NONE) {
+                netPolicy_.uidPolicies.Remove(uids[i]);
+            } else {
+                netPolicy_.uidPolicies.Set(uids[i], policies[i]);
+            }
+            verdicts_.UpdateUid(uids[i], policies[i]);
+            changedUids.push_back(uids[i]);
+            changedPolicies.push_back(policies[i]);
+        }
+        if (!changedUids.empty()) {
+            PublishSnapshot(POLICY_TABLE_UID);
         }
     }
 
-    return NetUidPolicy::NET_POLICY_NONE;
+    if (!changedUids.empty()) {
+        SchedulePersist();
+    }
 }
 
-bool NetPolicyFile::GetUidsByPolicy(NetUidPolicy policy, std::vector<uint32_t> &uids)
+void NetPolicyFile::GetPoliciesByUids(const std::vector<uint32_t> &uids, std::vector<NetUidPolicy> &policies)
 {
-    for (auto &uidPolicy : netPolicy_.uidPolicys) {
-        if (uidPolicy.policy == std::to_string(static_cast<uint32_t>(policy))) {
-            uint32_t uid = static_cast<uint32_t>(std::stol(uidPolicy.uid));
-            uids.push_back(uid);
-        }
+    std::shared_ptr<const NetPolicySnapshot> snapshot = LoadSnapshot();
+    policies.clear();
+    policies.reserve(uids.size());
+    for (uint32_t uid : uids) {
+        NetUidPolicy policy = NetUidPolicy::NET_POLICY_NONE;
+        snapshot->uidPolicies->Find(uid, policy);
+        policies.push_back(policy);
     }
+}
 
+bool NetPolicyFile::GetUidsByPolicy(NetUidPolicy policy, std::vector<uint32_t> &uids)
+{
+    LoadSnapshot()->uidPolicies->GetUids(policy, uids);
     return true;
 }
 
 NetPolicyResultCode NetPolicyFile::GetNetQuotaPolicies(std::vector<NetPolicyQuotaPolicy> &quotaPolicies)
 {
-    NetPolicyQuotaPolicy quotaPolicyTmp;
-    for (auto &quotaPolicy : netPolicy_.netQuotaPolicys) {
-        quotaPolicyTmp.lastLimitSnooze_ = static_cast<int64_t>(std::stoll(quotaPolicy.lastLimitSnooze));
-        quotaPolicyTmp.limitBytes_ = static_cast<int64_t>(std::stoll(quotaPolicy.limitBytes));
-        quotaPolicyTmp.metered_ = static_cast<int8_t>(std::stol(quotaPolicy.metered));
-        quotaPolicyTmp.netType_ = static_cast<int8_t>(std::stol(quotaPolicy.netType));
-        quotaPolicyTmp.periodDuration_ = quotaPolicy.periodDuration;
-        quotaPolicyTmp.periodStartTime_ = static_cast<int64_t>(std::stoll(quotaPolicy.periodStartTime));
-        quotaPolicyTmp.source_ = static_cast<int8_t>(std::stol(quotaPolicy.source));
-        quotaPolicyTmp.simId_ = quotaPolicy.simId;
-        quotaPolicyTmp.warningBytes_ = static_cast<int64_t>(std::stoll(quotaPolicy.warningBytes));
-        quotaPolicies.push_back(quotaPolicyTmp);
-    }
-
+    std::shared_ptr<const NetPolicySnapshot> snapshot = LoadSnapshot();
+    quotaPolicies.insert(quotaPolicies.end(), snapshot->quotaPolicies->begin(), snapshot->quotaPolicies->end());
     return NetPolicyResultCode::ERR_NONE;
 }
 
 NetPolicyResultCode NetPolicyFile::GetNetQuotaPolicy(int8_t netType, const std::string &simId,
     NetPolicyQuotaPolicy &quotaPolicy)
 {
-    for (auto &quotaPolicyTemp : netPolicy_.netQuotaPolicys) {
-        if (netType == static_cast<int8_t>(std::stol(quotaPolicyTemp.netType)) &&
-            simId == quotaPolicyTemp.simId) {
-            quotaPolicy.lastLimitSnooze_ = static_cast<int64_t>(std::stoll(quotaPolicyTemp.lastLimitSnooze));
-            quotaPolicy.limitBytes_ = static_cast<int64_t>(std::stoll(quotaPolicyTemp.limitBytes));
-            quotaPolicy.metered_ = static_cast<int8_t>(std::stol(quotaPolicyTemp.metered));
-            quotaPolicy.netType_ = static_cast<int8_t>(std::stol(quotaPolicyTemp.netType));
-            quotaPolicy.periodDuration_ = quotaPolicyTemp.periodDuration;
-            quotaPolicy.periodStartTime_ = static_cast<int64_t>(std::stoll(quotaPolicyTemp.periodStartTime));
-            quotaPolicy.source_ = static_cast<int8_t>(std::stol(quotaPolicyTemp.source));
-            quotaPolicy.simId_ = quotaPolicyTemp.simId;
-            quotaPolicy.warningBytes_ = static_cast<int64_t>(std::stoll(quotaPolicyTemp.warningBytes));
+    std::shared_ptr<const NetPolicySnapshot> snapshot = LoadSnapshot();
+    for (const auto &item : *snapshot->quotaPolicies) {
+        if (netType == item.netType_ && simId == item.simId_) {
+            quotaPolicy = item;
             return NetPolicyResultCode::ERR_NONE;
         }
     }
@@ -483,116 +603,152 @@ NetPolicyResultCode NetPolicyFile::GetNetQuotaPolicy(int8_t netType, const std::
     return NetPolicyResultCode::ERR_QUOTA_POLICY_NOT_EXIST;
 }
 
-bool NetPolicyFile::IsInterfaceMetered(const std::string &ifaceName)
-{
-    for (auto &quotaPolicy : netPolicy_.netQuotaPolicys) {
-        int8_t netType = static_cast<int8_t>(std::stol(quotaPolicy.netType));
-        NetBearType bearerType = static_cast<NetBearType>(netType);
-        std::string policyIfaceName;
-        int32_t ret = NetManagerCenter::GetInstance().GetIfaceNameByType(bearerType,
-            IDENT_PREFIX, policyIfaceName);
-        if (ret != 0 || policyIfaceName.empty()) {
-            continue;
-        }
-        if (ifaceName.compare(policyIfaceName) == 0) {
-            return static_cast<bool>(std::stol(quotaPolicy.metered));
-        }
-    }
-    return false;
-}
-
 NetPolicyResultCode NetPolicyFile::GetCellularPolicies(std::vector<NetPolicyCellularPolicy> &cellularPolicies)
 {
-    NetPolicyCellularPolicy cellularPolicyTmp;
-    for (auto &cellularPolicy : netPolicy_.netCellularPolicys) {
-        cellularPolicyTmp.simId_ = cellularPolicy.simId;
-        cellularPolicyTmp.periodStartTime_ = static_cast<int64_t>(std::stoll(cellularPolicy.periodStartTime));
-        cellularPolicyTmp.periodDuration_ = cellularPolicy.periodDuration;
-        cellularPolicyTmp.title_ = cellularPolicy.title;
-        cellularPolicyTmp.summary_ = cellularPolicy.summary;
-        cellularPolicyTmp.limitBytes_ = static_cast<int64_t>(std::stoll(cellularPolicy.limitBytes));
-        cellularPolicyTmp.limitAction_ = static_cast<int32_t>(std::stol(cellularPolicy.limitAction));
-        cellularPolicyTmp.usedBytes_ = static_cast<int64_t>(std::stoll(cellularPolicy.usedBytes));
-        cellularPolicyTmp.usedTimeDuration_ = static_cast<int64_t>(std::stoll(cellularPolicy.usedTimeDuration));
-        cellularPolicyTmp.possessor_ = cellularPolicy.possessor;
-        cellularPolicies.push_back(cellularPolicyTmp);
-    }
-
+    std::shared_ptr<const NetPolicySnapshot> snapshot = LoadSnapshot();
+    cellularPolicies.insert(cellularPolicies.end(), snapshot->cellularPolicies->begin(),
+        snapshot->cellularPolicies->end());
     return NetPolicyResultCode::ERR_NONE;
 }
 
 NetPolicyResultCode NetPolicyFile::SetFactoryPolicy(const std::string &simId)
 {
-    netPolicy_.uidPolicys.clear();
-    netPolicy_.backgroundPolicyStatus_ = BACKGROUND_POLICY_ALLOW;
+    std::unique_lock<std::mutex> lock(mutex_);
+    netPolicy_.uidPolicies.Clear();
+    netPolicy_.backgroundPolicy = true;
+    netPolicy_.idleTrustList.Clear();
+    verdicts_.Reset(netPolicy_.backgroundPolicy);
 
     if (simId.empty()) {
-        netPolicy_.netQuotaPolicys.clear();
-        netPolicy_.netCellularPolicys.clear();
+        netPolicy_.quotaPolicies.clear();
+        netPolicy_.cellularPolicies.clear();
     } else {
-        for (auto iter = netPolicy_.netQuotaPolicys.begin(); iter != netPolicy_.netQuotaPolicys.end(); ++iter) {
-            if (simId == iter->simId) {
-                netPolicy_.netQuotaPolicys.erase(iter);
+        for (auto iter = netPolicy_.quotaPolicies.begin(); iter != netPolicy_.quotaPolicies.end(); ++iter) {
+            if (simId == iter->simId_) {
+                netPolicy_.quotaPolicies.erase(iter);
                 break;
             }
         }
 
-        for (auto iter = netPolicy_.netCellularPolicys.begin(); iter != netPolicy_.netCellularPolicys.end(); ++iter) {
-            if (simId == iter->simId) {
-                netPolicy_.netCellularPolicys.erase(iter);
+        for (auto iter = netPolicy_.cellularPolicies.begin(); iter != netPolicy_.cellularPolicies.end(); ++iter) {
+            if (simId == iter->simId_) {
+                netPolicy_.cellularPolicies.erase(iter);
                 break;
             }
         }
     }
+    PublishSnapshot(POLICY_TABLE_ALL);
+    lock.unlock();
 
-    if (!WriteFile(POLICY_FILE_NAME)) {
-        NETMGR_LOG_E("WriteFile failed");
-        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
-    }
-
+    SchedulePersist();
     return NetPolicyResultCode::ERR_NONE;
 }
 
 NetPolicyResultCode NetPolicyFile::SetBackgroundPolicy(bool backgroundPolicy)
 {
-    if (backgroundPolicy) {
-        netPolicy_.backgroundPolicyStatus_ = BACKGROUND_POLICY_ALLOW;
-    } else {
-        netPolicy_.backgroundPolicyStatus_ = BACKGROUND_POLICY_REJECT;
-    }
-
-    if (!WriteFile(POLICY_FILE_NAME)) {
-        NETMGR_LOG_E("WriteFile failed");
-        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        netPolicy_.backgroundPolicy = backgroundPolicy;
+        verdicts_.UpdateBackgroundPolicy(backgroundPolicy);
+        PublishSnapshot(POLICY_TABLE_NONE);
     }
 
+    SchedulePersist();
     return NetPolicyResultCode::ERR_NONE;
 }
 
 bool NetPolicyFile::GetBackgroundPolicy()
 {
-    if (netPolicy_.backgroundPolicyStatus_.compare(BACKGROUND_POLICY_ALLOW) == 0) {
-        return true;
+    return LoadSnapshot()->backgroundPolicy;
+}
+
+bool NetPolicyFile::SetIdleTrustlist(uint32_t uid, bool isTrustlist)
+{
+    bool changed = false;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed = isTrustlist ? netPolicy_.idleTrustList.Insert(uid) : netPolicy_.idleTrustList.Erase(uid);
+        if (changed) {
+            PublishSnapshot(POLICY_TABLE_IDLE);
+        }
     }
-    return false;
+
+    if (changed) {
+        SchedulePersist();
+    }
+    return changed;
+}
+
+bool NetPolicyFile::ReplaceIdleTrustlist(const std::vector<uint32_t> &uids)
+{
+    bool changed = false;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed = netPolicy_.idleTrustList.Assign(uids);
+        if (changed) {
+            PublishSnapshot(POLICY_TABLE_IDLE);
+        }
+    }
+
+    if (changed) {
+        SchedulePersist();
+    }
+    return changed;
 }
 
 bool NetPolicyFile::InitPolicy()
 {
     NETMGR_LOG_I("InitPolicyFile.");
     std::string content;
-    if (!ReadFile(POLICY_FILE_NAME, content)) {
-        if (!CreateFile(POLICY_FILE_NAME)) {
-            NETMGR_LOG_D("CreateFile [%{public}s] failed", POLICY_FILE_NAME.c_str());
+    if (!ReadFile(fileName_, content)) {
+        if (!CreateFile(fileName_)) {
+            NETMGR_LOG_D("CreateFile [%{public}s] failed", fileName_.c_str());
             return false;
         }
     }
 
+    std::unique_lock<std::mutex> lock(mutex_);
     if (!content.empty() && !Json2Obj(content, netPolicy_)) {
         NETMGR_LOG_E("Analysis fileconfig failed");
         return false;
     }
+    RebuildVerdicts();
+    PublishSnapshot(POLICY_TABLE_ALL);
     return true;
 }
+
+void NetPolicyFile::RebuildVerdicts()
+{
+    verdicts_.Reset(netPolicy_.backgroundPolicy);
+    netPolicy_.uidPolicies.ForEach([this](uint32_t uid, NetUidPolicy policy) { verdicts_.UpdateUid(uid, policy); });
+}
+
+std::shared_ptr<const NetPolicySnapshot> NetPolicyFile::LoadSnapshot() const
+{
+    return std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+}
+
+void NetPolicyFile::PublishSnapshot(uint32_t changedTables)
+{
+    // Tables that did not change are shared with the previous snapshot instead of copied
+    auto snapshot = std::make_shared<NetPolicySnapshot>(*LoadSnapshot());
+    snapshot->hosVersion = netPolicy_.hosVersion;
+    snapshot->backgroundPolicy = netPolicy_.backgroundPolicy;
+    if (changedTables & POLICY_TABLE_UID) {
+        snapshot->uidPolicies = std::make_shared<const NetUidPolicyTable>(netPolicy_.uidPolicies);
+    }
+    if (changedTables & POLICY_TABLE_QUOTA) {
+        snapshot->quotaPolicies = std::make_shared<const std::vector<NetPolicyQuotaPolicy>>(netPolicy_.quotaPolicies);
+    }
+    if (changedTables & POLICY_TABLE_CELLULAR) {
+        snapshot->cellularPolicies =
+            std::make_shared<const std::vector<NetPolicyCellularPolicy>>(netPolicy_.cellularPolicies);
+    }
+    if (changedTables & POLICY_TABLE_IDLE) {
+        snapshot->idleTrustList = std::make_shared<const NetUidFlatSet>(netPolicy_.idleTrustList);
+    }
+    std::atomic_store_explicit(&snapshot_, std::shared_ptr<const NetPolicySnapshot>(snapshot),
+        std::memory_order_release);
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -16,51 +16,35 @@
 
 #include "ipc_skeleton.h"
 
+#include "net_mgr_log_wrapper.h"
+#include "netsys_controller.h"
+
 namespace OHOS {
 namespace NetManagerStandard {
-NetPolicyFirewall::NetPolicyFirewall(sptr<NetPolicyFile> netPolicyFile) : netPolicyFile_(netPolicyFile)
+namespace {
+bool IsMeteredRejected(NetUidPolicy policy)
 {
+    // Without a foreground signal a uid restricted in background is restricted on metered networks
+    return policy == NetUidPolicy::NET_POLICY_REJECT_METERED ||
+        policy == NetUidPolicy::NET_POLICY_REJECT_METERED_BACKGROUND;
 }
+} // namespace
 
-bool NetPolicyFirewall::GetBackgroundPolicyByUid(uint32_t uid)
+NetPolicyFirewall::NetPolicyFirewall(sptr<NetPolicyFile> netPolicyFile)
+    : netPolicyFile_(netPolicyFile), uidSyncPending_(false), firewallLoop_("NetPolicyFw")
 {
-    NetUidPolicy uidPolicy = netPolicyFile_->GetPolicyByUid(uid);
-    if ((static_cast<uint32_t>(uidPolicy) &
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_REJECT_ALL)) ==
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_REJECT_ALL)) {
-        return false;
-    } else if ((static_cast<uint32_t>(uidPolicy) &
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_ALLOW_ALL)) ==
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_ALLOW_ALL)) {
-        return true;
-    }
-
-    if ((static_cast<uint32_t>(uidPolicy) &
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_REJECT_METERED)) ==
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_REJECT_METERED)) {
-        return false;
-    } else if ((static_cast<uint32_t>(uidPolicy) &
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_ALLOW_METERED)) ==
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_ALLOW_METERED) ||
-        (static_cast<uint32_t>(uidPolicy) &
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_TEMPORARY_ALLOW_METERED)) ==
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_TEMPORARY_ALLOW_METERED)) {
-        return true;
-    }
+    firewallLoop_.Start();
+}
 
-    if ((static_cast<uint32_t>(uidPolicy) &
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_REJECT_METERED_BACKGROUND)) ==
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_REJECT_METERED_BACKGROUND)) {
-        return false;
-    } else if (netPolicyFile_->GetBackgroundPolicy()) {
-        return true;
-    } else if ((static_cast<uint32_t>(uidPolicy) &
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_ALLOW_METERED_BACKGROUND)) ==
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_ALLOW_METERED_BACKGROUND)) {
-        return true;
-    }
+NetPolicyFirewall::~NetPolicyFirewall()
+{
+    // Runs what is still queued
+    firewallLoop_.Stop();
+}
 
-    return false;
+bool NetPolicyFirewall::GetBackgroundPolicyByUid(uint32_t uid)
+{
+    return (netPolicyFile_->GetUidVerdict(uid) & VERDICT_BACKGROUND_ALLOWED) != 0;
 }
 
 NetBackgroundPolicy NetPolicyFirewall::GetCurrentBackgroundPolicy()
@@ -83,5 +67,105 @@ NetBackgroundPolicy NetPolicyFirewall::GetCurrentBackgroundPolicy()
 
     return NetBackgroundPolicy::NET_BACKGROUND_POLICY_ENABLED;
 }
+
+void NetPolicyFirewall::UpdateUidRules(uint32_t uid, NetUidPolicy policy)
+{
+    // netsys skips the chain whose membership does not change, so only one of the two calls runs the restore tools
+    firewallLoop_.Post([uid, policy]() {
+        int32_t ret = NetsysController::GetInstance().FirewallSetUidRule(NETSYS_FIREWALL_CHAIN_DENY_ALL, uid,
+            policy == NetUidPolicy::NET_POLICY_REJECT_ALL);
+        if (ret != 0) {
+            NETMGR_LOG_E("Update deny all rule of uid[%{public}u] failed, ret[%{public}d]", uid, ret);
+        }
+        ret = NetsysController::GetInstance().FirewallSetUidRule(NETSYS_FIREWALL_CHAIN_DENY_METERED, uid,
+            IsMeteredRejected(policy));
+        if (ret != 0) {
+            NETMGR_LOG_E("Update deny metered rule of uid[%{public}u] failed, ret[%{public}d]", uid, ret);
+        }
+    });
+}
+
+void NetPolicyFirewall::SyncUidRules()
+{
+    if (uidSyncPending_.exchange(true)) {
+        return;
+    }
+    firewallLoop_.Post([this]() {
+        uidSyncPending_ = false;
+        DoSyncUidRules();
+    });
+}
+
+void NetPolicyFirewall::DoSyncUidRules()
+{
+    std::vector<uint32_t> denyAll;
+    netPolicyFile_->GetUidsByPolicy(NetUidPolicy::NET_POLICY_REJECT_ALL, denyAll);
+    std::vector<uint32_t> denyMetered;
+    netPolicyFile_->GetUidsByPolicy(NetUidPolicy::NET_POLICY_REJECT_METERED, denyMetered);
+    netPolicyFile_->GetUidsByPolicy(NetUidPolicy::NET_POLICY_REJECT_METERED_BACKGROUND, denyMetered);
+    int32_t ret = NetsysController::GetInstance().FirewallSetUids(NETSYS_FIREWALL_CHAIN_DENY_ALL, denyAll);
+    if (ret != 0) {
+        NETMGR_LOG_E("Sync deny all rules failed, ret[%{public}d]", ret);
+    }
+    ret = NetsysController::GetInstance().FirewallSetUids(NETSYS_FIREWALL_CHAIN_DENY_METERED, denyMetered);
+    if (ret != 0) {
+        NETMGR_LOG_E("Sync deny metered rules failed, ret[%{public}d]", ret);
+    }
+}
+
+void NetPolicyFirewall::UpdateIdleTrustlistRule(uint32_t uid, bool isTrustlist)
+{
+    firewallLoop_.Post([uid, isTrustlist]() {
+        int32_t ret = NetsysController::GetInstance().FirewallSetUidRule(NETSYS_FIREWALL_CHAIN_ALLOW_IDLE, uid,
+            isTrustlist);
+        if (ret != 0) {
+            NETMGR_LOG_E("Update idle rule of uid[%{public}u] failed, ret[%{public}d]", uid, ret);
+        }
+    });
+}
+
+void NetPolicyFirewall::SyncIdleTrustlistRules(const std::vector<uint32_t> &uids)
+{
+    firewallLoop_.Post([uids]() {
+        int32_t ret = NetsysController::GetInstance().FirewallSetUids(NETSYS_FIREWALL_CHAIN_ALLOW_IDLE, uids);
+        if (ret != 0) {
+            NETMGR_LOG_E("Sync idle rules failed, ret[%{public}d]", ret);
+        }
+    });
+}
+
+void NetPolicyFirewall::UpdateMeteredIfaces(const NetIfaceMeteredTable &ifaceTable)
+{
+    // Read and queued under the lock, so the last caller always applies the newest set
+    std::lock_guard<std::mutex> lock(meteredIfacesMutex_);
+    std::set<std::string> ifaces = ifaceTable.GetMeteredIfaces();
+    firewallLoop_.Post([this, ifaces]() { AttachMeteredIfaces(ifaces); });
+}
+
+void NetPolicyFirewall::AttachMeteredIfaces(const std::set<std::string> &ifaces)
+{
+    std::set<std::string> attached;
+    for (const auto &iface : meteredIfaces_) {
+        if (ifaces.count(iface) == 0 && NetsysController::GetInstance().FirewallSetChainInterface(
+            NETSYS_FIREWALL_CHAIN_DENY_METERED, iface, false) != 0) {
+            NETMGR_LOG_E("Detach deny metered chain from [%{public}s] failed", iface.c_str());
+            attached.insert(iface);
+        }
+    }
+    for (const auto &iface : ifaces) {
+        if (meteredIfaces_.count(iface) != 0 || NetsysController::GetInstance().FirewallSetChainInterface(
+            NETSYS_FIREWALL_CHAIN_DENY_METERED, iface, true) == 0) {
+            attached.insert(iface);
+        } else {
+            NETMGR_LOG_E("Attach deny metered chain to [%{public}s] failed", iface.c_str());
+        }
+    }
+    meteredIfaces_.swap(attached);
+}
+
+void NetPolicyFirewall::ResetNetsysState()
+{
+    firewallLoop_.Post([this]() { meteredIfaces_.clear(); });
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
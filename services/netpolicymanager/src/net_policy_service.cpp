@@ -16,6 +16,7 @@
 
 #include <sys/time.h>
 #include <unistd.h>
+#include <algorithm>
 #include <cinttypes>
 
 #include "system_ability_definition.h"
@@ -42,12 +43,13 @@ NetPolicyService::NetPolicyService()
     netPolicyTraffic_ = (std::make_unique<NetPolicyTraffic>(netPolicyFile_)).release();
     netPolicyFirewall_ = (std::make_unique<NetPolicyFirewall>(netPolicyFile_)).release();
     netPolicyCallback_ = (std::make_unique<NetPolicyCallback>()).release();
-    monthDay_ = {MONTH_THIRTY_ONE, MONTH_TWENTY_EIGHT, MONTH_THIRTY_ONE, MONTH_THIRTY,
-        MONTH_THIRTY_ONE, MONTH_THIRTY, MONTH_THIRTY_ONE, MONTH_THIRTY_ONE, MONTH_THIRTY,
-        MONTH_THIRTY_ONE, MONTH_THIRTY, MONTH_THIRTY_ONE};
+    linkLoop_.Start();
 }
 
-NetPolicyService::~NetPolicyService() {}
+NetPolicyService::~NetPolicyService()
+{
+    linkLoop_.Stop();
+}
 
 void NetPolicyService::OnStart()
 {
@@ -68,6 +70,10 @@ void NetPolicyService::OnStart()
 
 void NetPolicyService::OnStop()
 {
+    if (!netPolicyFile_->Flush()) {
+        NETMGR_LOG_E("policy changes not persisted, [%{public}u] writes failed",
+            netPolicyFile_->GetPersistFailures());
+    }
     state_ = STATE_STOPPED;
     registerToService_ = false;
 }
@@ -94,37 +100,58 @@ bool NetPolicyService::Init()
     }
     serviceComm_ = (std::make_unique<NetPolicyServiceCommon>()).release();
     NetManagerCenter::GetInstance().RegisterPolicyService(serviceComm_);
+
+    SyncFirewall();
+    // A restarted netsys starts with empty chains
+    AddSystemAbilityListener(COMM_NETSYS_NATIVE_SYS_ABILITY_ID);
+
+    if (!linkLoop_.Post([this]() { ArmQuotaThresholds(); })) {
+        NETMGR_LOG_E("Drop quota thresholds of the stored policies");
+    }
     return true;
 }
 
+void NetPolicyService::OnAddSystemAbility(int32_t systemAbilityId, const std::string &deviceId)
+{
+    if (systemAbilityId != COMM_NETSYS_NATIVE_SYS_ABILITY_ID) {
+        return;
+    }
+    // Also reported for the instance Init already synced with, netsys then has nothing to apply
+    NETMGR_LOG_I("netsys is up, resync the firewall");
+    std::unique_lock<std::mutex> lock(writerMutex_);
+    netPolicyFirewall_->ResetNetsysState();
+    SyncFirewall();
+}
+
+void NetPolicyService::SyncFirewall()
+{
+    std::vector<uint32_t> idleTrustList;
+    netPolicyTraffic_->GetIdleTrustlist(idleTrustList);
+    netPolicyFirewall_->SyncUidRules();
+    netPolicyFirewall_->SyncIdleTrustlistRules(idleTrustList);
+    UpdateMeteredIfaces();
+}
+
 NetPolicyResultCode NetPolicyService::SetPolicyByUid(uint32_t uid, NetUidPolicy policy)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(writerMutex_);
     NetPolicyResultCode ret = NetPolicyResultCode::ERR_INTERNAL_ERROR;
     NETMGR_LOG_I("SetPolicyByUid info: uid[%{public}d] policy[%{public}d]", uid, static_cast<uint32_t>(policy));
-    /* delete uid policy */
     if (policy == NetUidPolicy::NET_POLICY_NONE) {
+        /* delete uid policy */
         ret = netPolicyTraffic_->DeletePolicyByUid(uid, policy);
-        lock.unlock();
-        if (ret == NetPolicyResultCode::ERR_NONE) {
-            netPolicyCallback_->NotifyNetUidPolicyChanged(uid, policy);
-        }
-        return ret;
-    }
-
-    /* update policy */
-    if (!netPolicyFile_->IsUidPolicyExist(uid)) {
+    } else if (!netPolicyFile_->IsUidPolicyExist(uid)) {
         ret = netPolicyTraffic_->AddPolicyByUid(uid, policy);
-        lock.unlock();
-        if (ret == NetPolicyResultCode::ERR_NONE) {
-            netPolicyCallback_->NotifyNetUidPolicyChanged(uid, policy);
-        }
     } else {
+        /* update policy */
         ret = netPolicyTraffic_->SetPolicyByUid(uid, policy);
-        lock.unlock();
-        if (ret == NetPolicyResultCode::ERR_NONE) {
-            netPolicyCallback_->NotifyNetUidPolicyChanged(uid, policy);
-        }
+    }
+    if (ret == NetPolicyResultCode::ERR_NONE) {
+        netPolicyFirewall_->UpdateUidRules(uid, policy);
+    }
+    lock.unlock();
+    if (ret == NetPolicyResultCode::ERR_NONE) {
+        netPolicyCallback_->NotifyNetUidPolicyChanged(uid, policy);
     }
 
     return ret;
@@ -132,14 +159,43 @@ NetPolicyResultCode NetPolicyService::SetPolicyByUid(uint32_t uid, NetUidPolicy
 
 NetUidPolicy NetPolicyService::GetPolicyByUid(uint32_t uid)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
     NETMGR_LOG_I("GetPolicyByUid info: uid[%{public}d]", uid);
     return netPolicyFile_->GetPolicyByUid(uid);
 }
 
+NetPolicyResultCode NetPolicyService::SetPoliciesByUids(const std::vector<uint32_t> &uids,
+    const std::vector<NetUidPolicy> &policies)
+{
+    std::unique_lock<std::mutex> lock(writerMutex_);
+    NETMGR_LOG_I("SetPoliciesByUids info: size[%{public}zu]", uids.size());
+    std::vector<uint32_t> changedUids;
+    std::vector<NetUidPolicy> changedPolicies;
+    NetPolicyResultCode ret = netPolicyTraffic_->SetPoliciesByUids(uids, policies, changedUids, changedPolicies);
+    if (ret == NetPolicyResultCode::ERR_NONE && !changedUids.empty()) {
+        // One diff per chain instead of a netsys round trip per uid
+        netPolicyFirewall_->SyncUidRules();
+    }
+    lock.unlock();
+    if (ret == NetPolicyResultCode::ERR_NONE && !changedUids.empty()) {
+        netPolicyCallback_->NotifyNetUidPoliciesChanged(changedUids, changedPolicies);
+    }
+
+    return ret;
+}
+
+NetPolicyResultCode NetPolicyService::GetPoliciesByUids(const std::vector<uint32_t> &uids,
+    std::vector<NetUidPolicy> &policies)
+{
+    if (uids.size() > MAX_UID_POLICY_BATCH_SIZE) {
+        NETMGR_LOG_E("GetPoliciesByUids invalid batch size[%{public}zu]", uids.size());
+        return NetPolicyResultCode::ERR_INVALID_UID;
+    }
+    netPolicyFile_->GetPoliciesByUids(uids, policies);
+    return NetPolicyResultCode::ERR_NONE;
+}
+
 std::vector<uint32_t> NetPolicyService::GetUidsByPolicy(NetUidPolicy policy)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
     NETMGR_LOG_I("GetUidsByPolicy info: policy[%{public}d]", static_cast<uint32_t>(policy));
     std::vector<uint32_t> uids;
     if (!netPolicyFile_->GetUidsByPolicy(policy, uids)) {
@@ -151,60 +207,53 @@ std::vector<uint32_t> NetPolicyService::GetUidsByPolicy(NetUidPolicy policy)
 
 bool NetPolicyService::IsUidNetAccess(uint32_t uid, bool metered)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
-    NETMGR_LOG_I("IsUidNetAccess info: uid[%{public}d]", uid);
+    // Hot path for every connection decision, the verdict table is read without taking any lock
+    uint8_t verdict = netPolicyFile_->GetUidVerdict(uid);
+    return (verdict & (metered ? VERDICT_METERED_ALLOWED : VERDICT_UNMETERED_ALLOWED)) != 0;
+}
 
-    NetUidPolicy uidPolicy = netPolicyFile_->GetPolicyByUid(uid);
-    if ((static_cast<uint32_t>(uidPolicy) &
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_REJECT_ALL)) ==
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_REJECT_ALL)) {
-        return false;
-    } else if ((static_cast<uint32_t>(uidPolicy) &
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_ALLOW_ALL)) ==
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_ALLOW_ALL)) {
-        return true;
-    }
+bool NetPolicyService::IsUidNetAccess(uint32_t uid, const std::string &ifaceName)
+{
+    bool metered = ifaceTable_.IsMetered(ifaceName);
 
-    if (!metered) {
-        return true;
-    } else if ((static_cast<uint32_t>(uidPolicy) &
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_REJECT_METERED)) ==
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_REJECT_METERED)) {
-        return false;
-    } else if ((static_cast<uint32_t>(uidPolicy) &
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_ALLOW_METERED)) ==
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_ALLOW_METERED) ||
-        (static_cast<uint32_t>(uidPolicy) &
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_TEMPORARY_ALLOW_METERED)) ==
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_TEMPORARY_ALLOW_METERED)) {
-        return true;
-    }
-
-    if ((static_cast<uint32_t>(uidPolicy) &
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_REJECT_METERED_BACKGROUND)) ==
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_REJECT_METERED_BACKGROUND)) {
-        return false;
-    } else if (netPolicyFile_->GetBackgroundPolicy()) {
-        return true;
-    } else if ((static_cast<uint32_t>(uidPolicy) &
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_ALLOW_METERED_BACKGROUND)) ==
-        static_cast<uint32_t>(NetUidPolicy::NET_POLICY_ALLOW_METERED_BACKGROUND)) {
-        return true;
-    }
+    return IsUidNetAccess(uid, metered);
+}
 
-    return false;
+void NetPolicyService::OnIfaceLinkChanged(NetBearType bearerType, const std::string &ident,
+    const std::string &ifaceName, bool up)
+{
+    // Called on the connection service's state loop, which must not wait for netsys or the stats service
+    bool posted = linkLoop_.Post([this, bearerType, ident, ifaceName, up]() {
+        HandleIfaceLinkChanged(bearerType, ident, ifaceName, up);
+    });
+    if (!posted) {
+        NETMGR_LOG_E("Drop link change of [%{public}s]", ifaceName.c_str());
+    }
 }
 
-bool NetPolicyService::IsUidNetAccess(uint32_t uid, const std::string &ifaceName)
+void NetPolicyService::HandleIfaceLinkChanged(NetBearType bearerType, const std::string &ident,
+    const std::string &ifaceName, bool up)
 {
-    bool metered = netPolicyFile_->IsInterfaceMetered(ifaceName);
+    if (ifaceTable_.UpdateLink(bearerType, ident, ifaceName, up)) {
+        netPolicyFirewall_->UpdateMeteredIfaces(ifaceTable_);
+    }
+    if (!up || bearerType != BEARER_CELLULAR || ident != IDENT_PREFIX) {
+        return;
+    }
+    // Thresholds can only be armed on a live interface, this also covers links replayed after Init
+    ArmQuotaThresholds();
+}
 
-    return IsUidNetAccess(uid, metered);
+void NetPolicyService::UpdateMeteredIfaces()
+{
+    std::vector<NetPolicyQuotaPolicy> quotaPolicies;
+    netPolicyFile_->GetNetQuotaPolicies(quotaPolicies);
+    ifaceTable_.UpdatePolicies(quotaPolicies);
+    netPolicyFirewall_->UpdateMeteredIfaces(ifaceTable_);
 }
 
 int32_t NetPolicyService::RegisterNetPolicyCallback(const sptr<INetPolicyCallback> &callback)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
     if (callback == nullptr) {
         NETMGR_LOG_E("RegisterNetPolicyCallback parameter callback is null");
         return static_cast<int32_t>(NetPolicyResultCode::ERR_INTERNAL_ERROR);
@@ -217,7 +266,6 @@ int32_t NetPolicyService::RegisterNetPolicyCallback(const sptr<INetPolicyCallbac
 
 int32_t NetPolicyService::UnregisterNetPolicyCallback(const sptr<INetPolicyCallback> &callback)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
     if (callback == nullptr) {
         NETMGR_LOG_E("UnregisterNetPolicyCallback parameter callback is null");
         return static_cast<int32_t>(NetPolicyResultCode::ERR_INTERNAL_ERROR);
@@ -236,132 +284,145 @@ std::int64_t NetPolicyService::GetCurrentTime()
     return tv.tv_sec;
 }
 
-int32_t NetPolicyService::GetPeriodEndTime()
+void NetPolicyService::PostQuotaThresholds(const std::set<std::string> &idents)
 {
-    struct tm *timeNow;
-    time_t second = time(nullptr);
-    if (!second) {
-        NETMGR_LOG_E("time second error");
-        return -1;
-    }
-    timeNow = localtime(&second);
-    if (timeNow == nullptr) {
-        NETMGR_LOG_E("timeNow is nullptr");
-        return -1;
+    // Binder threads and the stats sampler get here with the policies they saw. Reading them again on linkLoop_
+    // keeps a late caller from arming a threshold that a newer policy already replaced.
+    bool posted = linkLoop_.Post([this, idents]() { ArmQuotaThresholds(idents); });
+    if (!posted) {
+        NETMGR_LOG_E("Drop threshold update of [%{public}zu] quotas", idents.size());
     }
+}
 
-    if (timeNow->tm_mon == NET_POLICY_FEBRUARY
-        && ((timeNow->tm_year % NET_POLICY_LEAP_YEAR_FOUR == 0
-        && timeNow->tm_year % NET_POLICY_LEAP_YEAR_ONEHUNDRED != 0)
-        || timeNow->tm_year % NET_POLICY_LEAP_YEAR_FOURHUNDRED == 0)) {
-        return (monthDay_[timeNow->tm_mon] + NET_POLICY_LEAP_YEAR_ONE) * NET_POLICY_ONEDAYTIME;
-    } else {
-        return monthDay_[timeNow->tm_mon] * NET_POLICY_ONEDAYTIME;
-    }
+void NetPolicyService::ArmQuotaThresholds()
+{
+    std::vector<NetPolicyQuotaPolicy> quotaPolicies;
+    std::vector<NetPolicyCellularPolicy> cellularPolicies;
+    netPolicyFile_->GetNetQuotaPolicies(quotaPolicies);
+    netPolicyFile_->GetCellularPolicies(cellularPolicies);
+    UpdateQuotaThresholds(quotaPolicies);
+    UpdateQuotaThresholds(cellularPolicies);
 }
 
-void NetPolicyService::CheckNetStatsOverLimit(const std::vector<NetPolicyCellularPolicy> &cellularPolicies)
+void NetPolicyService::ArmQuotaThresholds(const std::set<std::string> &idents)
 {
-    if (cellularPolicies.empty()) {
-        NETMGR_LOG_W("cellularPolicies size is 0.");
-        return;
-    }
+    std::vector<NetPolicyQuotaPolicy> quotaPolicies;
+    std::vector<NetPolicyCellularPolicy> cellularPolicies;
+    netPolicyFile_->GetNetQuotaPolicies(quotaPolicies);
+    netPolicyFile_->GetCellularPolicies(cellularPolicies);
+    quotaPolicies.erase(std::remove_if(quotaPolicies.begin(), quotaPolicies.end(),
+        [&idents](const NetPolicyQuotaPolicy &quotaPolicy) {
+            return idents.count(QUOTA_THRESHOLD_IDENT_PREFIX + quotaPolicy.simId_) == 0;
+        }), quotaPolicies.end());
+    cellularPolicies.erase(std::remove_if(cellularPolicies.begin(), cellularPolicies.end(),
+        [&idents](const NetPolicyCellularPolicy &cellularPolicy) {
+            return idents.count(CELLULAR_THRESHOLD_IDENT_PREFIX + cellularPolicy.simId_) == 0;
+        }), cellularPolicies.end());
+    UpdateQuotaThresholds(quotaPolicies);
+    UpdateQuotaThresholds(cellularPolicies);
+}
 
-    int32_t periodEndTime = GetPeriodEndTime();
-    if (periodEndTime <= 0) {
-        NETMGR_LOG_E("periodEndTime error.");
-        return;
+bool NetPolicyService::ArmQuotaThreshold(const std::string &ident, const std::string &periodDuration,
+    int64_t periodStartTime, int64_t warningBytes, int64_t limitBytes, int64_t &usedBytes)
+{
+    NetStatsQuota quota;
+    quota.ident = ident;
+    quota.warningBytes = warningBytes;
+    quota.limitBytes = limitBytes;
+    if (!ifaceTable_.GetIfaceName(BEARER_CELLULAR, quota.iface)) {
+        NETMGR_LOG_E("No cellular link for [%{public}s]", ident.c_str());
+        return false;
+    }
+    if (!billingCycles_.GetPeriod(ident, periodDuration, periodStartTime, GetCurrentTime(), quota.periodStart,
+        quota.periodEnd)) {
+        NETMGR_LOG_E("invalid period [%{public}s] start [%{public}" PRId64 "]", periodDuration.c_str(),
+            periodStartTime);
+        return false;
+    }
+    int32_t ret = NetManagerCenter::GetInstance().SetIfaceQuota(quota, serviceComm_, usedBytes);
+    if (ret != 0) {
+        NETMGR_LOG_E("SetIfaceQuota ret [%{public}d] ident [%{public}s]", ret, ident.c_str());
+        return false;
     }
+    NETMGR_LOG_I("SetIfaceQuota ident [%{public}s] usedBytes [%{public}" PRId64 "]", ident.c_str(), usedBytes);
+    return true;
+}
 
-    std::string ifaceName;
-    for (uint32_t i = 0; i < cellularPolicies.size(); ++i) {
+void NetPolicyService::UpdateQuotaThresholds(const std::vector<NetPolicyCellularPolicy> &cellularPolicies)
+{
+    for (const auto &cellularPolicy : cellularPolicies) {
+        std::string ident = CELLULAR_THRESHOLD_IDENT_PREFIX + cellularPolicy.simId_;
         /* -1 : unlimited */
-        if (cellularPolicies[i].limitBytes_ == -1) {
-            if (netPolicyCallback_ != nullptr) {
-                netPolicyCallback_->NotifyNetStrategySwitch(cellularPolicies[i].simId_, true);
-            }
-            continue;
-        }
-        int32_t ret = NetManagerCenter::GetInstance().GetIfaceNameByType(BEARER_CELLULAR,
-            IDENT_PREFIX, ifaceName);
-        if (ret != 0 || ifaceName.empty()) {
-            NETMGR_LOG_E("GetIfaceNameByType ret [%{public}d] ifaceName [%{public}s]", ret, ifaceName.c_str());
+        if (cellularPolicy.limitBytes_ == -1) {
+            NetManagerCenter::GetInstance().RemoveIfaceQuota(ident);
+            billingCycles_.Remove(ident);
+            netPolicyCallback_->NotifyNetStrategySwitch(cellularPolicy.simId_, true);
             continue;
         }
-        NetStatsInfo netStatsInfo;
-        ret = NetManagerCenter::GetInstance().GetIfaceStatsDetail(ifaceName, cellularPolicies[i].periodStartTime_,
-            cellularPolicies[i].periodStartTime_ + periodEndTime, netStatsInfo);
-        if (ret != 0) {
-            NETMGR_LOG_E("GetIfaceStatsDetail ret [%{public}d] ifaceName [%{public}s]", ret, ifaceName.c_str());
+        int64_t usedBytes = 0;
+        if (!ArmQuotaThreshold(ident, cellularPolicy.periodDuration_, cellularPolicy.periodStartTime_, -1,
+            cellularPolicy.limitBytes_, usedBytes)) {
             continue;
         }
-        NETMGR_LOG_I("GetIfaceStatsDetail txBytes_[%{public}" PRId64 "] rxBytes_[%{public}" PRId64 "]",
-            netStatsInfo.txBytes_, netStatsInfo.rxBytes_);
         /*  The traffic exceeds the limit. You need to notify telephony to shut down the network. */
-        if (netStatsInfo.txBytes_ + netStatsInfo.rxBytes_ < cellularPolicies[i].limitBytes_) {
-            if (netPolicyCallback_ != nullptr) {
-                netPolicyCallback_->NotifyNetStrategySwitch(cellularPolicies[i].simId_, true);
-            }
-        } else {
-            if (netPolicyCallback_ != nullptr) {
-                netPolicyCallback_->NotifyNetStrategySwitch(cellularPolicies[i].simId_, false);
-            }
-        }
+        netPolicyCallback_->NotifyNetStrategySwitch(cellularPolicy.simId_, usedBytes < cellularPolicy.limitBytes_);
     }
 }
 
-void NetPolicyService::CheckNetStatsOverLimit(const std::vector<NetPolicyQuotaPolicy> &quotaPolicies)
+void NetPolicyService::UpdateQuotaThresholds(const std::vector<NetPolicyQuotaPolicy> &quotaPolicies)
 {
-    if (quotaPolicies.empty()) {
-        NETMGR_LOG_W("quotaPolicies size is 0.");
-        return;
-    }
-
-    int32_t periodEndTime = GetPeriodEndTime();
-    if (periodEndTime <= 0) {
-        NETMGR_LOG_E("periodEndTime error.");
-        return;
-    }
-
-    std::string ifaceName;
-    for (uint32_t i = 0; i < quotaPolicies.size(); ++i) {
+    for (const auto &quotaPolicy : quotaPolicies) {
         /* only control cellular traffic */
-        if (static_cast<NetBearType>(quotaPolicies[i].netType_) != BEARER_CELLULAR) {
-            NETMGR_LOG_I("need not notify telephony netType_[%{public}d]", quotaPolicies[i].netType_);
+        if (static_cast<NetBearType>(quotaPolicy.netType_) != BEARER_CELLULAR) {
+            NETMGR_LOG_I("need not notify telephony netType_[%{public}d]", quotaPolicy.netType_);
             continue;
         }
-        NetBearType bearerType = static_cast<NetBearType>(quotaPolicies[i].netType_);
-        int32_t ret = NetManagerCenter::GetInstance().GetIfaceNameByType(
-            bearerType, IDENT_PREFIX, ifaceName);
-        if (ret != 0 || ifaceName.empty()) {
-            NETMGR_LOG_E("GetIfaceNameByType ret [%{public}d] ifaceName [%{public}s]", ret, ifaceName.c_str());
+        int64_t usedBytes = 0;
+        if (!ArmQuotaThreshold(QUOTA_THRESHOLD_IDENT_PREFIX + quotaPolicy.simId_, quotaPolicy.periodDuration_,
+            quotaPolicy.periodStartTime_, quotaPolicy.warningBytes_, quotaPolicy.limitBytes_, usedBytes)) {
             continue;
         }
-        NetStatsInfo netStatsInfo;
-        ret = NetManagerCenter::GetInstance().GetIfaceStatsDetail(ifaceName, quotaPolicies[i].periodStartTime_,
-            quotaPolicies[i].periodStartTime_ + periodEndTime, netStatsInfo);
-        if (ret != 0) {
-            NETMGR_LOG_E("GetIfaceStatsDetail ret [%{public}d] ifaceName [%{public}s]", ret, ifaceName.c_str());
-            continue;
-        }
-        NETMGR_LOG_I("GetIfaceStatsDetail txBytes_[%{public}" PRId64 "] rxBytes_[%{public}" PRId64 "]",
-            netStatsInfo.txBytes_, netStatsInfo.rxBytes_);
-
         /* Sleep time is not up Or nerverSnooze : lastLimitSnooze_=1 */
-        if ((quotaPolicies[i].lastLimitSnooze_ >= quotaPolicies[i].periodStartTime_ ||
-            quotaPolicies[i].lastLimitSnooze_ == -1)
-            && (netStatsInfo.txBytes_ + netStatsInfo.rxBytes_ < quotaPolicies[i].limitBytes_)) {
-            if (netPolicyCallback_ != nullptr) {
-                netPolicyCallback_->NotifyNetStrategySwitch(quotaPolicies[i].simId_, true);
-            }
-        } else {
-            if (netPolicyCallback_ != nullptr) {
-                netPolicyCallback_->NotifyNetStrategySwitch(quotaPolicies[i].simId_, false);
-            }
+        bool snoozeAllowed = quotaPolicy.lastLimitSnooze_ >= quotaPolicy.periodStartTime_ ||
+            quotaPolicy.lastLimitSnooze_ == -1;
+        netPolicyCallback_->NotifyNetStrategySwitch(quotaPolicy.simId_,
+            snoozeAllowed && usedBytes < quotaPolicy.limitBytes_);
+    }
+}
+
+void NetPolicyService::RemoveQuotaThresholds(const std::set<std::string> &idents)
+{
+    for (const std::string &ident : idents) {
+        NetManagerCenter::GetInstance().RemoveIfaceQuota(ident);
+        billingCycles_.Remove(ident);
+    }
+}
+
+void NetPolicyService::OnQuotaWarningReached(const NetStatsQuota &quota)
+{
+    NETMGR_LOG_I("quota [%{public}s] reached warningBytes [%{public}" PRId64 "] on [%{public}s]",
+        quota.ident.c_str(), quota.warningBytes, quota.iface.c_str());
+}
+
+void NetPolicyService::OnQuotaLimitReached(const NetStatsQuota &quota)
+{
+    NETMGR_LOG_I("quota [%{public}s] reached limitBytes [%{public}" PRId64 "] on [%{public}s]",
+        quota.ident.c_str(), quota.limitBytes, quota.iface.c_str());
+    for (const std::string &prefix : {QUOTA_THRESHOLD_IDENT_PREFIX, CELLULAR_THRESHOLD_IDENT_PREFIX}) {
+        if (quota.ident.compare(0, prefix.size(), prefix) == 0) {
+            netPolicyCallback_->NotifyNetStrategySwitch(quota.ident.substr(prefix.size()), false);
+            return;
         }
     }
 }
 
+void NetPolicyService::OnQuotaPeriodEnded(const NetStatsQuota &quota)
+{
+    NETMGR_LOG_I("quota [%{public}s] period ended", quota.ident.c_str());
+    /* Arm the policy that owned the quota again, which starts its next period */
+    PostQuotaThresholds({quota.ident});
+}
+
 NetPolicyResultCode NetPolicyService::SetNetQuotaPolicies(const std::vector<NetPolicyQuotaPolicy> &quotaPolicies)
 {
     NETMGR_LOG_I("SetNetQuotaPolicies quotaPolicySize[%{public}zd]", quotaPolicies.size());
@@ -369,12 +430,19 @@ NetPolicyResultCode NetPolicyService::SetNetQuotaPolicies(const std::vector<NetP
         return NetPolicyResultCode::ERR_INTERNAL_ERROR;
     }
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(writerMutex_);
     NetPolicyResultCode ret = netPolicyTraffic_->SetNetQuotaPolicies(quotaPolicies);
+    if (ret == NetPolicyResultCode::ERR_NONE) {
+        UpdateMeteredIfaces();
+    }
     lock.unlock();
     if (ret == NetPolicyResultCode::ERR_NONE) {
         /* Judge whether the flow exceeds the limit */
-        CheckNetStatsOverLimit(quotaPolicies);
+        std::set<std::string> idents;
+        for (const auto &quotaPolicy : quotaPolicies) {
+            idents.insert(QUOTA_THRESHOLD_IDENT_PREFIX + quotaPolicy.simId_);
+        }
+        PostQuotaThresholds(idents);
     }
 
     return ret;
@@ -382,7 +450,6 @@ NetPolicyResultCode NetPolicyService::SetNetQuotaPolicies(const std::vector<NetP
 
 NetPolicyResultCode NetPolicyService::GetNetQuotaPolicies(std::vector<NetPolicyQuotaPolicy> &quotaPolicies)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
     NETMGR_LOG_I("GetNetQuotaPolicies begin");
     return netPolicyFile_->GetNetQuotaPolicies(quotaPolicies);
 }
@@ -395,12 +462,16 @@ NetPolicyResultCode NetPolicyService::SetCellularPolicies(const std::vector<NetP
         return NetPolicyResultCode::ERR_INTERNAL_ERROR;
     }
 
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(writerMutex_);
     NetPolicyResultCode ret = netPolicyTraffic_->SetCellularPolicies(cellularPolicies);
     lock.unlock();
     if (ret == NetPolicyResultCode::ERR_NONE) {
         /* Judge whether the flow exceeds the limit */
-        CheckNetStatsOverLimit(cellularPolicies);
+        std::set<std::string> idents;
+        for (const auto &cellularPolicy : cellularPolicies) {
+            idents.insert(CELLULAR_THRESHOLD_IDENT_PREFIX + cellularPolicy.simId_);
+        }
+        PostQuotaThresholds(idents);
         netPolicyCallback_->NotifyNetCellularPolicyChanged(cellularPolicies);
     }
 
@@ -409,22 +480,43 @@ NetPolicyResultCode NetPolicyService::SetCellularPolicies(const std::vector<NetP
 
 NetPolicyResultCode NetPolicyService::GetCellularPolicies(std::vector<NetPolicyCellularPolicy> &cellularPolicies)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
     NETMGR_LOG_I("GetCellularPolicies begin");
     return netPolicyFile_->GetCellularPolicies(cellularPolicies);
 }
 
 NetPolicyResultCode NetPolicyService::SetFactoryPolicy(const std::string &simId)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(writerMutex_);
     NETMGR_LOG_I("SetFactoryPolicy begin");
-    netPolicyTraffic_->ClearIdleTrustList();
-    return netPolicyFile_->SetFactoryPolicy(simId);
+    // The idents are taken before the reset drops the policies, the removal queues behind any pending arming
+    std::vector<NetPolicyQuotaPolicy> quotaPolicies;
+    std::vector<NetPolicyCellularPolicy> cellularPolicies;
+    netPolicyFile_->GetNetQuotaPolicies(quotaPolicies);
+    netPolicyFile_->GetCellularPolicies(cellularPolicies);
+    std::set<std::string> idents;
+    for (const auto &quotaPolicy : quotaPolicies) {
+        if (simId.empty() || quotaPolicy.simId_ == simId) {
+            idents.insert(QUOTA_THRESHOLD_IDENT_PREFIX + quotaPolicy.simId_);
+        }
+    }
+    for (const auto &cellularPolicy : cellularPolicies) {
+        if (simId.empty() || cellularPolicy.simId_ == simId) {
+            idents.insert(CELLULAR_THRESHOLD_IDENT_PREFIX + cellularPolicy.simId_);
+        }
+    }
+    if (!linkLoop_.Post([this, idents]() { RemoveQuotaThresholds(idents); })) {
+        NETMGR_LOG_E("Drop threshold removal of [%{public}zu] quotas", idents.size());
+    }
+    NetPolicyResultCode ret = netPolicyFile_->SetFactoryPolicy(simId);
+    netPolicyFirewall_->SyncUidRules();
+    netPolicyFirewall_->SyncIdleTrustlistRules(std::vector<uint32_t>());
+    UpdateMeteredIfaces();
+    return ret;
 }
 
 NetPolicyResultCode NetPolicyService::SetBackgroundPolicy(bool backgroundPolicy)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(writerMutex_);
     NETMGR_LOG_I("SetBackgroundPolicy begin");
 
     bool oldBackgroundPolicy = netPolicyFile_->GetBackgroundPolicy();
@@ -445,21 +537,17 @@ NetPolicyResultCode NetPolicyService::SetBackgroundPolicy(bool backgroundPolicy)
 
 bool NetPolicyService::GetBackgroundPolicy()
 {
-    std::unique_lock<std::mutex> lock(mutex_);
     NETMGR_LOG_I("GetBackgroundPolicy begin");
     return netPolicyFile_->GetBackgroundPolicy();
 }
 
 bool NetPolicyService::GetBackgroundPolicyByUid(uint32_t uid)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
-    NETMGR_LOG_I("GetBackgroundPolicyByUid begin");
     return netPolicyFirewall_->GetBackgroundPolicyByUid(uid);
 }
 
 NetBackgroundPolicy NetPolicyService::GetCurrentBackgroundPolicy()
 {
-    std::unique_lock<std::mutex> lock(mutex_);
     NETMGR_LOG_I("GetCurrentBackgroundPolicy begin");
     return netPolicyFirewall_->GetCurrentBackgroundPolicy();
 }
@@ -469,7 +557,7 @@ NetPolicyResultCode NetPolicyService::SetSnoozePolicy(int8_t netType, const std:
     NETMGR_LOG_I("SetSnoozePolicy begin");
 
     NetPolicyQuotaPolicy quotaPolicy;
-    std::unique_lock<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(writerMutex_);
     NetPolicyResultCode ret = netPolicyFile_->GetNetQuotaPolicy(netType, simId, quotaPolicy);
     if (NetPolicyResultCode::ERR_NONE != ret) {
         NETMGR_LOG_E("SetSnoozePolicy GetQuotaPolicy failed");
@@ -482,7 +570,7 @@ NetPolicyResultCode NetPolicyService::SetSnoozePolicy(int8_t netType, const std:
     lock.unlock();
     if (ret == NetPolicyResultCode::ERR_NONE) {
         /* Judge whether the flow exceeds the limit */
-        CheckNetStatsOverLimit(quotaPolicies);
+        PostQuotaThresholds({QUOTA_THRESHOLD_IDENT_PREFIX + simId});
     }
 
     return ret;
@@ -493,13 +581,28 @@ NetPolicyResultCode NetPolicyService::SetIdleTrustlist(uint32_t uid, bool isTrus
     NETMGR_LOG_I("SetIdleTrustlist info: uid[%{public}d] isTrustlist[%{public}d]", uid,
         static_cast<uint32_t>(isTrustlist));
 
-    std::unique_lock<std::mutex> lock(mutex_);
-    return netPolicyTraffic_->SetIdleTrustlist(uid, isTrustlist);
+    std::unique_lock<std::mutex> lock(writerMutex_);
+    NetPolicyResultCode ret = netPolicyTraffic_->SetIdleTrustlist(uid, isTrustlist);
+    if (ret == NetPolicyResultCode::ERR_NONE) {
+        netPolicyFirewall_->UpdateIdleTrustlistRule(uid, isTrustlist);
+    }
+    return ret;
+}
+
+NetPolicyResultCode NetPolicyService::ReplaceIdleTrustlist(const std::vector<uint32_t> &uids)
+{
+    NETMGR_LOG_I("ReplaceIdleTrustlist info: size[%{public}zu]", uids.size());
+
+    std::unique_lock<std::mutex> lock(writerMutex_);
+    NetPolicyResultCode ret = netPolicyTraffic_->ReplaceIdleTrustlist(uids);
+    if (ret == NetPolicyResultCode::ERR_NONE) {
+        netPolicyFirewall_->SyncIdleTrustlistRules(uids);
+    }
+    return ret;
 }
 
 NetPolicyResultCode NetPolicyService::GetIdleTrustlist(std::vector<uint32_t> &uids)
 {
-    std::unique_lock<std::mutex> lock(mutex_);
     NETMGR_LOG_I("GetIdleTrustlist begin");
     return netPolicyTraffic_->GetIdleTrustlist(uids);
 }
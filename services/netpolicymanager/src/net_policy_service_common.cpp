@@ -28,5 +28,26 @@ bool NetPolicyServiceCommon::IsUidNetAccess(uint32_t uid, bool metered)
 {
     return DelayedSingleton<NetPolicyService>::GetInstance()->IsUidNetAccess(uid, metered);
 }
+
+void NetPolicyServiceCommon::OnIfaceLinkChanged(NetBearType bearerType, const std::string &ident,
+    const std::string &ifaceName, bool up)
+{
+    DelayedSingleton<NetPolicyService>::GetInstance()->OnIfaceLinkChanged(bearerType, ident, ifaceName, up);
+}
+
+void NetPolicyServiceCommon::OnQuotaWarningReached(const NetStatsQuota &quota)
+{
+    DelayedSingleton<NetPolicyService>::GetInstance()->OnQuotaWarningReached(quota);
+}
+
+void NetPolicyServiceCommon::OnQuotaLimitReached(const NetStatsQuota &quota)
+{
+    DelayedSingleton<NetPolicyService>::GetInstance()->OnQuotaLimitReached(quota);
+}
+
+void NetPolicyServiceCommon::OnQuotaPeriodEnded(const NetStatsQuota &quota)
+{
+    DelayedSingleton<NetPolicyService>::GetInstance()->OnQuotaPeriodEnded(quota);
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
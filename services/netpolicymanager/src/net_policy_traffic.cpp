@@ -23,6 +23,7 @@
 
 #include "system_ability_definition.h"
 
+#include "net_billing_cycle.h"
 #include "net_policy_cellular_policy.h"
 #include "net_policy_constants.h"
 #include "net_policy_define.h"
@@ -134,6 +135,31 @@ NetPolicyResultCode NetPolicyTraffic::DeletePolicyByUid(uint32_t uid, NetUidPoli
     return NetPolicyResultCode::ERR_NONE;
 }
 
+NetPolicyResultCode NetPolicyTraffic::SetPoliciesByUids(const std::vector<uint32_t> &uids,
+    const std::vector<NetUidPolicy> &policies, std::vector<uint32_t> &changedUids,
+    std::vector<NetUidPolicy> &changedPolicies)
+{
+    if (netPolicyFile_ == nullptr) {
+        NETMGR_LOG_E("SetPoliciesByUids netPolicyFile is null");
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    if (uids.size() != policies.size() || uids.size() > MAX_UID_POLICY_BATCH_SIZE) {
+        NETMGR_LOG_E("SetPoliciesByUids invalid batch size[%{public}zu]", uids.size());
+        return NetPolicyResultCode::ERR_INVALID_POLICY;
+    }
+
+    // Validate the whole batch first so that it is applied entirely or not at all.
+    for (NetUidPolicy policy : policies) {
+        if (!IsPolicyValid(policy)) {
+            return NetPolicyResultCode::ERR_INVALID_POLICY;
+        }
+    }
+
+    netPolicyFile_->SetPoliciesByUids(uids, policies, changedUids, changedPolicies);
+    return NetPolicyResultCode::ERR_NONE;
+}
+
 NetPolicyResultCode NetPolicyTraffic::SetNetQuotaPolicies(const std::vector<NetPolicyQuotaPolicy> &quotaPolicies)
 {
     if (quotaPolicies.empty()) {
@@ -148,8 +174,8 @@ NetPolicyResultCode NetPolicyTraffic::SetNetQuotaPolicies(const std::vector<NetP
             return NetPolicyResultCode::ERR_INVALID_QUOTA_POLICY;
         }
 
-        if (!IsNetPolicyPeriodDurationValid(quotaPolicies[i].periodDuration_)) {
-            NETMGR_LOG_E("periodDuration [%{public}s] must Mx", quotaPolicies[i].periodDuration_.c_str());
+        if (!IsNetPolicyPeriodDurationValid(quotaPolicies[i].periodDuration_, quotaPolicies[i].periodStartTime_)) {
+            NETMGR_LOG_E("periodDuration [%{public}s] is invalid", quotaPolicies[i].periodDuration_.c_str());
             return NetPolicyResultCode::ERR_INVALID_QUOTA_POLICY;
         }
     }
@@ -162,23 +188,11 @@ NetPolicyResultCode NetPolicyTraffic::SetNetQuotaPolicies(const std::vector<NetP
     return NetPolicyResultCode::ERR_NONE;
 }
 
-bool NetPolicyTraffic::IsNetPolicyPeriodDurationValid(const std::string &periodDuration)
+bool NetPolicyTraffic::IsNetPolicyPeriodDurationValid(const std::string &periodDuration, int64_t periodStartTime)
 {
-    if (periodDuration.empty()) {
-        NETMGR_LOG_E("periodDuration is empty");
-        return false;
-    }
-
-    std::string subString = periodDuration.substr(0, PERIODDURATION_POS_NUM_ONE);
-    if (subString != POLICY_QUOTA_MONTH_U && subString != POLICY_QUOTA_MONTH_L) {
-        NETMGR_LOG_E("periodDuration must Mx");
-        return false;
-    }
-
-    subString = periodDuration.substr(PERIODDURATION_POS_NUM_ONE, periodDuration.length() - PERIODDURATION_POS_NUM_ONE);
-    int32_t day = static_cast<int32_t>(std::stol(subString));
-    if (day > DAY_THIRTY_ONE || day < DAY_ONE) {
-        NETMGR_LOG_E("periodDuration must Mx, x is [%{public}d] - [%{public}d]", DAY_ONE, DAY_THIRTY_ONE);
+    NetBillingCycle cycle;
+    if (!NetBillingCycle::Parse(periodDuration, periodStartTime, cycle)) {
+        NETMGR_LOG_E("periodDuration must be Dx, Wx, Mx or Yx, Dx needs a periodStartTime");
         return false;
     }
 
@@ -193,8 +207,9 @@ NetPolicyResultCode NetPolicyTraffic::SetCellularPolicies(const std::vector<NetP
     }
 
     for (uint32_t i = 0; i < cellularPolicies.size(); ++i) {
-        if (!IsNetPolicyPeriodDurationValid(cellularPolicies[i].periodDuration_)) {
-            NETMGR_LOG_E("periodDuration [%{public}s] must Mx", cellularPolicies[i].periodDuration_.c_str());
+        if (!IsNetPolicyPeriodDurationValid(cellularPolicies[i].periodDuration_,
+            cellularPolicies[i].periodStartTime_)) {
+            NETMGR_LOG_E("periodDuration [%{public}s] is invalid", cellularPolicies[i].periodDuration_.c_str());
             return NetPolicyResultCode::ERR_INVALID_QUOTA_POLICY;
         }
 
@@ -264,39 +279,36 @@ NetPolicyResultCode NetPolicyTraffic::SetIdleTrustlist(uint32_t uid, bool isTrus
         return NetPolicyResultCode::ERR_INTERNAL_ERROR;
     }
 
-    /* If it exists, update it directly */
-    for (auto iter = idleTrustList_.begin(); iter != idleTrustList_.end(); ++iter) {
-        if (uid == *iter) {
-            if (!isTrustlist) {
-                idleTrustList_.erase(iter);
-                return NetPolicyResultCode::ERR_NONE;
-            } else {
-                return NetPolicyResultCode::ERR_NONE;
-            }
-        }
-    }
-    /* Does not exist, add it */
-    if (isTrustlist) {
-        idleTrustList_.emplace_back(uid);
-    }
-    /* Determine whether the app is idle ? than update netsys's interface. */
+    netPolicyFile_->SetIdleTrustlist(uid, isTrustlist);
     return NetPolicyResultCode::ERR_NONE;
 }
 
-NetPolicyResultCode NetPolicyTraffic::GetIdleTrustlist(std::vector<uint32_t> &uids)
+NetPolicyResultCode NetPolicyTraffic::ReplaceIdleTrustlist(const std::vector<uint32_t> &uids)
 {
-    if (idleTrustList_.empty()) {
-        NETMGR_LOG_I("idleTrustList_ is empty.");
-    } else {
-        uids = idleTrustList_;
+    if (netPolicyFile_ == nullptr) {
+        NETMGR_LOG_E("ReplaceIdleTrustlist netPolicyFile is null");
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
     }
 
+    if (uids.size() > MAX_UID_POLICY_BATCH_SIZE) {
+        NETMGR_LOG_E("ReplaceIdleTrustlist invalid batch size[%{public}zu]", uids.size());
+        return NetPolicyResultCode::ERR_INVALID_UID;
+    }
+
+    netPolicyFile_->ReplaceIdleTrustlist(uids);
     return NetPolicyResultCode::ERR_NONE;
 }
 
-void NetPolicyTraffic::ClearIdleTrustList()
+NetPolicyResultCode NetPolicyTraffic::GetIdleTrustlist(std::vector<uint32_t> &uids)
 {
-    idleTrustList_.clear();
+    if (netPolicyFile_ == nullptr) {
+        NETMGR_LOG_E("GetIdleTrustlist netPolicyFile is null");
+        return NetPolicyResultCode::ERR_INTERNAL_ERROR;
+    }
+
+    std::vector<uint32_t> idleTrustlist = netPolicyFile_->GetIdleTrustlist();
+    uids.assign(idleTrustlist.begin(), idleTrustlist.end());
+    return NetPolicyResultCode::ERR_NONE;
 }
 } // namespace NetManagerStandard
 } // namespace OHOS
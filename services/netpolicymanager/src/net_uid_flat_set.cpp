@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "net_uid_flat_set.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace NetManagerStandard {
+bool NetUidFlatSet::Insert(uint32_t uid)
+{
+    auto it = std::lower_bound(uids_.begin(), uids_.end(), uid);
+    if (it != uids_.end() && *it == uid) {
+        return false;
+    }
+    uids_.insert(it, uid);
+    return true;
+}
+
+bool NetUidFlatSet::Erase(uint32_t uid)
+{
+    auto it = std::lower_bound(uids_.begin(), uids_.end(), uid);
+    if (it == uids_.end() || *it != uid) {
+        return false;
+    }
+    uids_.erase(it);
+    return true;
+}
+
+bool NetUidFlatSet::Contains(uint32_t uid) const
+{
+    return std::binary_search(uids_.begin(), uids_.end(), uid);
+}
+
+bool NetUidFlatSet::Assign(const std::vector<uint32_t> &uids)
+{
+    std::vector<uint32_t> sorted(uids);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    if (sorted == uids_) {
+        return false;
+    }
+    uids_.swap(sorted);
+    return true;
+}
+
+void NetUidFlatSet::Clear()
+{
+    uids_.clear();
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
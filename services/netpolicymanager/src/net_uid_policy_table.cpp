@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "net_uid_policy_table.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint32_t MIN_CAPACITY = 16;
+constexpr uint32_t BITS_PER_WORD = 64;
+// Grow once used plus deleted slots pass three quarters of the table
+constexpr uint32_t LOAD_NUMERATOR = 3;
+constexpr uint32_t LOAD_DENOMINATOR = 4;
+constexpr uint32_t HASH_MULTIPLIER_FIRST = 0x85ebca6b;
+constexpr uint32_t HASH_MULTIPLIER_SECOND = 0xc2b2ae35;
+constexpr uint32_t HASH_SHIFT_FIRST = 16;
+constexpr uint32_t HASH_SHIFT_SECOND = 13;
+
+uint32_t RoundUpCapacity(uint32_t count)
+{
+    uint32_t capacity = MIN_CAPACITY;
+    while (capacity < count) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+} // namespace
+
+NetUidPolicyTable::NetUidPolicyTable() : slots_(MIN_CAPACITY) {}
+
+uint32_t NetUidPolicyTable::Hash(uint32_t uid)
+{
+    // Application uids are dense, mix them so that the low bits used for the slot spread out
+    uint32_t hash = uid;
+    hash ^= hash >> HASH_SHIFT_FIRST;
+    hash *= HASH_MULTIPLIER_FIRST;
+    hash ^= hash >> HASH_SHIFT_SECOND;
+    hash *= HASH_MULTIPLIER_SECOND;
+    hash ^= hash >> HASH_SHIFT_FIRST;
+    return hash;
+}
+
+int64_t NetUidPolicyTable::FindSlot(uint32_t uid) const
+{
+    uint32_t mask = static_cast<uint32_t>(slots_.size()) - 1;
+    for (uint32_t index = Hash(uid) & mask;; index = (index + 1) & mask) {
+        const Slot &slot = slots_[index];
+        if (slot.state == SLOT_EMPTY) {
+            return -1;
+        }
+        if (slot.state == SLOT_USED && slot.uid == uid) {
+            return index;
+        }
+    }
+}
+
+void NetUidPolicyTable::Set(uint32_t uid, NetUidPolicy policy)
+{
+    uint32_t value = static_cast<uint32_t>(policy);
+    int64_t found = FindSlot(uid);
+    if (found >= 0) {
+        Slot &slot = slots_[found];
+        if (slot.policy != value) {
+            MarkSlot(slot.policy, static_cast<uint32_t>(found), false);
+            slot.policy = value;
+            MarkSlot(value, static_cast<uint32_t>(found), true);
+        }
+        return;
+    }
+
+    if ((size_ + deleted_ + 1) * LOAD_DENOMINATOR > slots_.size() * LOAD_NUMERATOR) {
+        Rehash(RoundUpCapacity((size_ + 1) * 2));
+    }
+    uint32_t mask = static_cast<uint32_t>(slots_.size()) - 1;
+    uint32_t index = Hash(uid) & mask;
+    while (slots_[index].state == SLOT_USED) {
+        index = (index + 1) & mask;
+    }
+    if (slots_[index].state == SLOT_DELETED) {
+        --deleted_;
+    }
+    slots_[index] = Slot {uid, value, SLOT_USED};
+    MarkSlot(value, index, true);
+    ++size_;
+}
+
+bool NetUidPolicyTable::Remove(uint32_t uid)
+{
+    int64_t found = FindSlot(uid);
+    if (found < 0) {
+        return false;
+    }
+    Slot &slot = slots_[found];
+    MarkSlot(slot.policy, static_cast<uint32_t>(found), false);
+    slot.state = SLOT_DELETED;
+    --size_;
+    ++deleted_;
+    return true;
+}
+
+bool NetUidPolicyTable::Find(uint32_t uid, NetUidPolicy &policy) const
+{
+    int64_t found = FindSlot(uid);
+    if (found < 0) {
+        return false;
+    }
+    policy = static_cast<NetUidPolicy>(slots_[found].policy);
+    return true;
+}
+
+bool NetUidPolicyTable::Contains(uint32_t uid) const
+{
+    return FindSlot(uid) >= 0;
+}
+
+void NetUidPolicyTable::GetUids(NetUidPolicy policy, std::vector<uint32_t> &uids) const
+{
+    const Bitmap *bitmap = FindBitmap(static_cast<uint32_t>(policy));
+    if (bitmap == nullptr) {
+        return;
+    }
+    for (uint32_t word = 0; word < bitmap->size(); ++word) {
+        uint64_t bits = (*bitmap)[word];
+        while (bits != 0) {
+            uint32_t bit = static_cast<uint32_t>(__builtin_ctzll(bits));
+            uids.push_back(slots_[word * BITS_PER_WORD + bit].uid);
+            bits &= bits - 1;
+        }
+    }
+}
+
+void NetUidPolicyTable::ForEach(const std::function<void(uint32_t uid, NetUidPolicy policy)> &func) const
+{
+    for (const auto &slot : slots_) {
+        if (slot.state == SLOT_USED) {
+            func(slot.uid, static_cast<NetUidPolicy>(slot.policy));
+        }
+    }
+}
+
+void NetUidPolicyTable::Clear()
+{
+    slots_.assign(MIN_CAPACITY, Slot());
+    policyIndex_.clear();
+    size_ = 0;
+    deleted_ = 0;
+}
+
+void NetUidPolicyTable::Rehash(uint32_t capacity)
+{
+    std::vector<Slot> oldSlots(capacity);
+    oldSlots.swap(slots_);
+    policyIndex_.clear();
+    size_ = 0;
+    deleted_ = 0;
+    uint32_t mask = capacity - 1;
+    for (const auto &slot : oldSlots) {
+        if (slot.state != SLOT_USED) {
+            continue;
+        }
+        uint32_t index = Hash(slot.uid) & mask;
+        while (slots_[index].state == SLOT_USED) {
+            index = (index + 1) & mask;
+        }
+        slots_[index] = slot;
+        MarkSlot(slot.policy, index, true);
+        ++size_;
+    }
+}
+
+NetUidPolicyTable::Bitmap &NetUidPolicyTable::GetBitmap(uint32_t policy)
+{
+    for (auto &entry : policyIndex_) {
+        if (entry.first == policy) {
+            return entry.second;
+        }
+    }
+    uint32_t words = (static_cast<uint32_t>(slots_.size()) + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    policyIndex_.emplace_back(policy, Bitmap(words, 0));
+    return policyIndex_.back().second;
+}
+
+const NetUidPolicyTable::Bitmap *NetUidPolicyTable::FindBitmap(uint32_t policy) const
+{
+    for (const auto &entry : policyIndex_) {
+        if (entry.first == policy) {
+            return &entry.second;
+        }
+    }
+    return nullptr;
+}
+
+void NetUidPolicyTable::MarkSlot(uint32_t policy, uint32_t index, bool set)
+{
+    uint64_t mask = uint64_t(1) << (index % BITS_PER_WORD);
+    Bitmap &bitmap = GetBitmap(policy);
+    if (set) {
+        bitmap[index / BITS_PER_WORD] |= mask;
+    } else {
+        bitmap[index / BITS_PER_WORD] &= ~mask;
+    }
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
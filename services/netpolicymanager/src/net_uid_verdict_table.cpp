@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "net_uid_verdict_table.h"
+
+#include "net_uid_policy_table.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+namespace {
+constexpr uint32_t MIN_CAPACITY = 64;
+constexpr uint32_t LOAD_NUMERATOR = 3;
+constexpr uint32_t LOAD_DENOMINATOR = 4;
+// Entry layout: uid in the high half, then the policy, an occupied bit and the verdict bits
+constexpr uint32_t UID_SHIFT = 32;
+constexpr uint32_t POLICY_SHIFT = 16;
+constexpr uint64_t POLICY_MASK = 0xff;
+constexpr uint64_t ENTRY_OCCUPIED = 1 << 8;
+constexpr uint64_t VERDICT_MASK = 0xff;
+constexpr uint8_t VERDICT_ALL = VERDICT_UNMETERED_ALLOWED | VERDICT_METERED_ALLOWED | VERDICT_BACKGROUND_ALLOWED;
+
+bool HasPolicy(NetUidPolicy policy, NetUidPolicy flag)
+{
+    return (static_cast<uint32_t>(policy) & static_cast<uint32_t>(flag)) == static_cast<uint32_t>(flag);
+}
+
+bool IsMeteredAllowed(NetUidPolicy policy, bool backgroundPolicy)
+{
+    if (HasPolicy(policy, NetUidPolicy::NET_POLICY_REJECT_METERED)) {
+        return false;
+    }
+    if (HasPolicy(policy, NetUidPolicy::NET_POLICY_ALLOW_METERED) ||
+        HasPolicy(policy, NetUidPolicy::NET_POLICY_TEMPORARY_ALLOW_METERED)) {
+        return true;
+    }
+    if (HasPolicy(policy, NetUidPolicy::NET_POLICY_REJECT_METERED_BACKGROUND)) {
+        return false;
+    }
+    return backgroundPolicy || HasPolicy(policy, NetUidPolicy::NET_POLICY_ALLOW_METERED_BACKGROUND);
+}
+
+uint32_t EntryUid(uint64_t entry)
+{
+    return static_cast<uint32_t>(entry >> UID_SHIFT);
+}
+
+NetUidPolicy EntryPolicy(uint64_t entry)
+{
+    return static_cast<NetUidPolicy>((entry >> POLICY_SHIFT) & POLICY_MASK);
+}
+} // namespace
+
+NetUidVerdictTable::NetUidVerdictTable()
+    : defaultVerdict_(ComputeVerdict(NetUidPolicy::NET_POLICY_NONE, true))
+{
+    Reset(true);
+}
+
+uint8_t NetUidVerdictTable::ComputeVerdict(NetUidPolicy policy, bool backgroundPolicy)
+{
+    if (HasPolicy(policy, NetUidPolicy::NET_POLICY_REJECT_ALL)) {
+        return 0;
+    }
+    if (HasPolicy(policy, NetUidPolicy::NET_POLICY_ALLOW_ALL)) {
+        return VERDICT_ALL;
+    }
+    // Background access has always been judged by the same chain as metered access
+    if (IsMeteredAllowed(policy, backgroundPolicy)) {
+        return VERDICT_ALL;
+    }
+    return VERDICT_UNMETERED_ALLOWED;
+}
+
+uint8_t NetUidVerdictTable::GetVerdict(uint32_t uid) const
+{
+    std::shared_ptr<const Table> table = std::atomic_load_explicit(&table_, std::memory_order_acquire);
+    for (uint32_t index = NetUidPolicyTable::Hash(uid) & table->mask;; index = (index + 1) & table->mask) {
+        uint64_t entry = table->entries[index].load(std::memory_order_acquire);
+        if (entry == 0) {
+            return defaultVerdict_.load(std::memory_order_acquire);
+        }
+        if (EntryUid(entry) == uid) {
+            return static_cast<uint8_t>(entry & VERDICT_MASK);
+        }
+    }
+}
+
+uint64_t NetUidVerdictTable::MakeEntry(uint32_t uid, NetUidPolicy policy, uint8_t verdict)
+{
+    // Valid policies are single bits below 1 << 7, the mask only guards against a corrupted file
+    return (static_cast<uint64_t>(uid) << UID_SHIFT) |
+        ((static_cast<uint64_t>(policy) & POLICY_MASK) << POLICY_SHIFT) | ENTRY_OCCUPIED | verdict;
+}
+
+void NetUidVerdictTable::Insert(Table &table, uint64_t entry)
+{
+    uint32_t uid = EntryUid(entry);
+    for (uint32_t index = NetUidPolicyTable::Hash(uid) & table.mask;; index = (index + 1) & table.mask) {
+        uint64_t current = table.entries[index].load(std::memory_order_relaxed);
+        if (current == 0 || EntryUid(current) == uid) {
+            table.entries[index].store(entry, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+void NetUidVerdictTable::UpdateUid(uint32_t uid, NetUidPolicy policy)
+{
+    uint64_t entry = MakeEntry(uid, policy, ComputeVerdict(policy, backgroundPolicy_));
+    for (uint32_t index = NetUidPolicyTable::Hash(uid) & current_->mask;; index = (index + 1) & current_->mask) {
+        uint64_t existing = current_->entries[index].load(std::memory_order_relaxed);
+        if (existing == 0) {
+            break;
+        }
+        if (EntryUid(existing) == uid) {
+            current_->entries[index].store(entry, std::memory_order_release);
+            return;
+        }
+    }
+
+    if ((count_ + 1) * LOAD_DENOMINATOR > current_->entries.size() * LOAD_NUMERATOR) {
+        auto grown = std::make_shared<Table>(static_cast<uint32_t>(current_->entries.size()) * 2);
+        for (const auto &slot : current_->entries) {
+            uint64_t existing = slot.load(std::memory_order_relaxed);
+            if (existing != 0) {
+                Insert(*grown, existing);
+            }
+        }
+        Publish(grown);
+    }
+    Insert(*current_, entry);
+    ++count_;
+}
+
+void NetUidVerdictTable::UpdateBackgroundPolicy(bool backgroundPolicy)
+{
+    backgroundPolicy_ = backgroundPolicy;
+    defaultVerdict_.store(ComputeVerdict(NetUidPolicy::NET_POLICY_NONE, backgroundPolicy), std::memory_order_release);
+    for (auto &slot : current_->entries) {
+        uint64_t entry = slot.load(std::memory_order_relaxed);
+        if (entry == 0) {
+            continue;
+        }
+        NetUidPolicy policy = EntryPolicy(entry);
+        slot.store(MakeEntry(EntryUid(entry), policy, ComputeVerdict(policy, backgroundPolicy)),
+            std::memory_order_release);
+    }
+}
+
+void NetUidVerdictTable::Reset(bool backgroundPolicy)
+{
+    backgroundPolicy_ = backgroundPolicy;
+    defaultVerdict_.store(ComputeVerdict(NetUidPolicy::NET_POLICY_NONE, backgroundPolicy), std::memory_order_release);
+    count_ = 0;
+    Publish(std::make_shared<Table>(MIN_CAPACITY));
+}
+
+void NetUidVerdictTable::Publish(const std::shared_ptr<Table> &table)
+{
+    current_ = table;
+    std::atomic_store_explicit(&table_, std::shared_ptr<const Table>(table), std::memory_order_release);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
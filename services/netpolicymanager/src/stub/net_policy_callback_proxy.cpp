@@ -56,6 +56,43 @@ int32_t NetPolicyCallbackProxy::NetUidPolicyChanged(uint32_t uid, NetUidPolicy p
     return ret;
 }
 
+int32_t NetPolicyCallbackProxy::NetUidPoliciesChanged(const std::vector<uint32_t> &uids,
+    const std::vector<NetUidPolicy> &policies)
+{
+    MessageParcel data;
+    if (!WriteInterfaceToken(data)) {
+        NETMGR_LOG_E("WriteInterfaceToken failed");
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    std::vector<uint32_t> rawPolicies;
+    rawPolicies.reserve(policies.size());
+    for (NetUidPolicy policy : policies) {
+        rawPolicies.push_back(static_cast<uint32_t>(policy));
+    }
+    if (!data.WriteUInt32Vector(uids) || !data.WriteUInt32Vector(rawPolicies)) {
+        return ERR_NULL_OBJECT;
+    }
+
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        NETMGR_LOG_E("Remote is null");
+        return ERR_NULL_OBJECT;
+    }
+
+    MessageParcel reply;
+    MessageOption option;
+    int32_t ret = remote->SendRequest(NET_POLICY_UIDPOLICIES_CHANGED, data, reply, option);
+    if (ret == IPC_STUB_UNKNOW_TRANS_ERR) {
+        // The client was built before the batch code, it only understands the changes one by one
+        return INetPolicyCallback::NetUidPoliciesChanged(uids, policies);
+    }
+    if (ret != ERR_NONE) {
+        NETMGR_LOG_E("Proxy SendRequest failed, ret code:[%{public}d]", ret);
+    }
+    return ret;
+}
+
 int32_t NetPolicyCallbackProxy::NetBackgroundPolicyChanged(bool isBackgroundPolicyAllow)
 {
     MessageParcel data;
@@ -24,6 +24,8 @@ NetPolicyServiceStub::NetPolicyServiceStub()
 {
     memberFuncMap_[CMD_NSM_SET_UID_POLICY] = &NetPolicyServiceStub::OnSetPolicyByUid;
     memberFuncMap_[CMD_NSM_GET_UID_POLICY] = &NetPolicyServiceStub::OnGetPolicyByUid;
+    memberFuncMap_[CMD_NSM_SET_UID_POLICIES] = &NetPolicyServiceStub::OnSetPoliciesByUids;
+    memberFuncMap_[CMD_NSM_GET_UID_POLICIES] = &NetPolicyServiceStub::OnGetPoliciesByUids;
     memberFuncMap_[CMD_NSM_GET_UIDS] = &NetPolicyServiceStub::OnGetUidsByPolicy;
     memberFuncMap_[CMD_NSM_IS_NET_ACCESS_METERED] = &NetPolicyServiceStub::OnIsUidNetAccessMetered;
     memberFuncMap_[CMD_NSM_IS_NET_ACCESS_IFACENAME] = &NetPolicyServiceStub::OnIsUidNetAccessIfaceName;
@@ -36,6 +38,7 @@ NetPolicyServiceStub::NetPolicyServiceStub()
     memberFuncMap_[CMD_NSM_FACTORY_RESET] = &NetPolicyServiceStub::OnSetFactoryPolicy;
     memberFuncMap_[CMD_NSM_SNOOZE_POLICY] = &NetPolicyServiceStub::OnSnoozePolicy;
     memberFuncMap_[CMD_NSM_SET_IDLE_TRUSTLIST] = &NetPolicyServiceStub::OnSetIdleTrustlist;
+    memberFuncMap_[CMD_NSM_REPLACE_IDLE_TRUSTLIST] = &NetPolicyServiceStub::OnReplaceIdleTrustlist;
     memberFuncMap_[CMD_NSM_GET_IDLE_TRUSTLIST] = &NetPolicyServiceStub::OnGetIdleTrustlist;
     memberFuncMap_[CMD_NSM_SET_BACKGROUND_POLICY] = &NetPolicyServiceStub::OnSetBackgroundPolicy;
     memberFuncMap_[CMD_NSM_GET_BACKGROUND_POLICY] = &NetPolicyServiceStub::OnGetBackgroundPolicy;
@@ -99,6 +102,66 @@ int32_t NetPolicyServiceStub::OnGetPolicyByUid(MessageParcel &data, MessageParce
     return ERR_NONE;
 }
 
+int32_t NetPolicyServiceStub::OnSetPoliciesByUids(MessageParcel &data, MessageParcel &reply)
+{
+    std::vector<uint32_t> uids;
+    std::vector<uint32_t> rawPolicies;
+    if (!data.ReadUInt32Vector(&uids) || !data.ReadUInt32Vector(&rawPolicies)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    NetPolicyResultCode result = NetPolicyResultCode::ERR_INVALID_POLICY;
+    if (uids.size() == rawPolicies.size() && uids.size() <= MAX_UID_POLICY_BATCH_SIZE) {
+        std::vector<NetUidPolicy> policies;
+        policies.reserve(rawPolicies.size());
+        for (uint32_t policy : rawPolicies) {
+            policies.push_back(static_cast<NetUidPolicy>(policy));
+        }
+        result = SetPoliciesByUids(uids, policies);
+    }
+
+    if (!reply.WriteInt32(static_cast<int32_t>(result))) {
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    return ERR_NONE;
+}
+
+int32_t NetPolicyServiceStub::OnGetPoliciesByUids(MessageParcel &data, MessageParcel &reply)
+{
+    std::vector<uint32_t> uids;
+    if (!data.ReadUInt32Vector(&uids)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    if (uids.size() > MAX_UID_POLICY_BATCH_SIZE) {
+        if (!reply.WriteInt32(static_cast<int32_t>(NetPolicyResultCode::ERR_INVALID_UID))) {
+            return ERR_FLATTEN_OBJECT;
+        }
+        return ERR_NONE;
+    }
+
+    std::vector<NetUidPolicy> policies;
+    NetPolicyResultCode result = GetPoliciesByUids(uids, policies);
+    if (!reply.WriteInt32(static_cast<int32_t>(result))) {
+        return ERR_FLATTEN_OBJECT;
+    }
+    if (result != NetPolicyResultCode::ERR_NONE) {
+        return ERR_NONE;
+    }
+
+    std::vector<uint32_t> rawPolicies;
+    rawPolicies.reserve(policies.size());
+    for (NetUidPolicy policy : policies) {
+        rawPolicies.push_back(static_cast<uint32_t>(policy));
+    }
+    if (!reply.WriteUInt32Vector(rawPolicies)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    return ERR_NONE;
+}
+
 int32_t NetPolicyServiceStub::OnGetUidsByPolicy(MessageParcel &data, MessageParcel &reply)
 {
     uint32_t policy;
@@ -347,6 +410,25 @@ int32_t NetPolicyServiceStub::OnSetIdleTrustlist(MessageParcel &data, MessagePar
     return ERR_NONE;
 }
 
+int32_t NetPolicyServiceStub::OnReplaceIdleTrustlist(MessageParcel &data, MessageParcel &reply)
+{
+    std::vector<uint32_t> uids;
+    if (!data.ReadUInt32Vector(&uids)) {
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    NetPolicyResultCode result = NetPolicyResultCode::ERR_INVALID_UID;
+    if (uids.size() <= MAX_UID_POLICY_BATCH_SIZE) {
+        result = ReplaceIdleTrustlist(uids);
+    }
+
+    if (!reply.WriteInt32(static_cast<int32_t>(result))) {
+        return ERR_FLATTEN_OBJECT;
+    }
+
+    return ERR_NONE;
+}
+
 int32_t NetPolicyServiceStub::OnGetIdleTrustlist(MessageParcel &data, MessageParcel &reply)
 {
     std::vector<uint32_t> uids;
@@ -20,6 +20,8 @@
 #include <vector>
 
 #include "i_net_stats_callback.h"
+#include "net_callback_set.h"
+#include "net_stats_constants.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
@@ -31,7 +33,7 @@ public:
     int32_t NotifyNetUidStatsChanged(const std::string &iface, uint32_t uid);
 
 private:
-    std::vector<sptr<INetStatsCallback>> netStatsCallback_;
+    NetCallbackSet<INetStatsCallback> netStatsCallback_ {LIMIT_STATS_CALLBACK_NUM};
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NET_STATS_QUOTA_TRACKER_H
+#define NET_STATS_QUOTA_TRACKER_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "net_stats_base_service.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+enum class NetStatsQuotaEventType {
+    WARNING_REACHED,
+    LIMIT_REACHED,
+    PERIOD_ENDED,
+};
+
+struct NetStatsQuotaEvent {
+    NetStatsQuotaEventType type;
+    NetStatsQuota quota;
+    sptr<NetStatsQuotaCallback> callback;
+};
+
+/**
+ * Running per interface byte counters for the armed quotas.
+ *
+ * Each sample of the kernel interface counters is folded into every quota of that interface, so a threshold
+ * check costs O(1) per quota instead of a scan of the stats history. Thread safe.
+ */
+class NetStatsQuotaTracker {
+public:
+    NetStatsQuotaTracker() = default;
+    ~NetStatsQuotaTracker() = default;
+
+    /**
+     * @brief Arm a quota, replacing any quota with the same ident
+     *
+     * @param quota The quota
+     * @param usedBytes Bytes already used in the period, up to the moment rxBytes and txBytes were read
+     * @param rxBytes Current kernel rx counter of the interface
+     * @param txBytes Current kernel tx counter of the interface
+     * @param callback Receiver of the events of this quota
+     */
+    void SetQuota(const NetStatsQuota &quota, int64_t usedBytes, int64_t rxBytes, int64_t txBytes,
+        const sptr<NetStatsQuotaCallback> &callback);
+
+    /**
+     * @brief Disarm a quota
+     *
+     * @param ident The quota ident
+     * @return Returns false if no such quota is armed
+     */
+    bool RemoveQuota(const std::string &ident);
+
+    /**
+     * @brief Fold one counter sample into the quotas of an interface
+     *
+     * @param iface The interface
+     * @param rxBytes Kernel rx counter of the interface
+     * @param txBytes Kernel tx counter of the interface
+     * @param now Sample time in seconds since the epoch
+     * @return Returns the thresholds crossed and the periods ended by this sample, in that order per quota
+     */
+    std::vector<NetStatsQuotaEvent> OnSample(const std::string &iface, int64_t rxBytes, int64_t txBytes,
+        int64_t now);
+
+    std::vector<std::string> GetIfaces() const;
+    bool GetUsedBytes(const std::string &ident, int64_t &usedBytes) const;
+    void Clear();
+
+private:
+    struct QuotaEntry {
+        NetStatsQuota quota;
+        int64_t usedBytes = 0;
+        bool warned = false;
+        bool limited = false;
+        sptr<NetStatsQuotaCallback> callback;
+    };
+
+    struct IfaceCounter {
+        int64_t rxBytes = 0;
+        int64_t txBytes = 0;
+        std::map<std::string, QuotaEntry> quotas;
+    };
+
+    static int64_t CounterDelta(int64_t last, int64_t current);
+    bool RemoveQuotaLocked(const std::string &ident);
+
+private:
+    mutable std::mutex mutex_;
+    std::map<std::string, IfaceCounter> ifaces_;
+    std::map<std::string, std::string> identIfaces_;
+};
+} // namespace NetManagerStandard
+} // namespace OHOS
+#endif // NET_STATS_QUOTA_TRACKER_H
@@ -24,11 +24,13 @@
 #include "net_stats_service_stub.h"
 #include "net_stats_service_iface.h"
 #include "net_stats_csv.h"
+#include "net_stats_quota_tracker.h"
 #include "timer.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
 constexpr uint32_t INTERVAL_UPDATE_STATS_TIME_MS = 1800000; // half an hour
+constexpr uint32_t INTERVAL_SAMPLE_QUOTA_TIME_MS = 30000; // half a minute
 class NetStatsService : public SystemAbility,
     public NetStatsServiceStub,
     public std::enable_shared_from_this<NetStatsService> {
@@ -48,9 +50,13 @@ public:
         uint32_t start, uint32_t end, const NetStatsInfo &stats) override;
     NetStatsResultCode UpdateStatsData() override;
     NetStatsResultCode ResetFactory() override;
+    NetStatsResultCode SetIfaceQuota(const NetStatsQuota &quota, const sptr<NetStatsQuotaCallback> &callback,
+        int64_t &usedBytes);
+    NetStatsResultCode RemoveIfaceQuota(const std::string &ident);
 private:
     bool Init();
     void InitListener();
+    void SampleIfaceQuotas();
 
 private:
     enum ServiceRunningState {
@@ -60,7 +66,10 @@ private:
 
     bool registerToService_;
     ServiceRunningState state_;
+    // Destroyed after the timers, whose threads sample into it
+    NetStatsQuotaTracker quotaTracker_;
     Timer updateStatsTimer_;
+    Timer sampleQuotaTimer_;
     sptr<NetStatsCallback> netStatsCallback_;
     std::shared_ptr<NetStatsListener> subscriber_ = nullptr;
     std::unique_ptr<NetStatsCsv> netStatsCsv_ = nullptr;
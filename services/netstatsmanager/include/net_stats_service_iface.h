@@ -23,6 +23,9 @@ class NetStatsServiceIface : public NetStatsBaseService {
 public:
     int32_t GetIfaceStatsDetail(const std::string &iface, uint32_t start, uint32_t end, NetStatsInfo &info) override;
     int32_t ResetStatsFactory() override;
+    int32_t SetIfaceQuota(const NetStatsQuota &quota, const sptr<NetStatsQuotaCallback> &callback,
+        int64_t &usedBytes) override;
+    int32_t RemoveIfaceQuota(const std::string &ident) override;
 };
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -21,52 +21,22 @@ namespace OHOS {
 namespace NetManagerStandard {
 void NetStatsCallback::RegisterNetStatsCallback(const sptr<INetStatsCallback> &callback)
 {
-    if (callback == nullptr) {
-        NETMGR_LOG_E("The parameter callback is null");
-        return;
+    if (netStatsCallback_.Add(callback)) {
+        NETMGR_LOG_D("netStatsCallback_ callback num [%{public}zu]", netStatsCallback_.Size());
     }
-
-    uint32_t callBackNum = netStatsCallback_.size();
-    NETMGR_LOG_D("netStatsCallback_ callback num [%{public}d]", callBackNum);
-    if (callBackNum >= LIMIT_STATS_CALLBACK_NUM) {
-        NETMGR_LOG_E("netStatsCallback_ callback num cannot more than [%{public}d]", LIMIT_STATS_CALLBACK_NUM);
-        return;
-    }
-
-    for (uint32_t i = 0; i < callBackNum; i++) {
-        if (callback->AsObject().GetRefPtr() == netStatsCallback_[i]->AsObject().GetRefPtr()) {
-            NETMGR_LOG_I("netStatsCallback_ had this callback");
-            return;
-        }
-    }
-
-    netStatsCallback_.emplace_back(callback);
 }
 
 void NetStatsCallback::UnregisterNetStatsCallback(const sptr<INetStatsCallback> &callback)
 {
-    if (callback == nullptr) {
-        NETMGR_LOG_E("The parameter of callback is null");
-        return;
-    }
-
-    for (auto iter = netStatsCallback_.begin(); iter != netStatsCallback_.end(); ++iter) {
-        if (callback->AsObject().GetRefPtr() == (*iter)->AsObject().GetRefPtr()) {
-            netStatsCallback_.erase(iter);
-            return;
-        }
-    }
+    netStatsCallback_.Remove(callback);
 }
 
 int32_t NetStatsCallback::NotifyNetIfaceStatsChanged(const std::string &iface)
 {
     NETMGR_LOG_D("NotifyNetIfaceStatsChanged info: iface[%{public}s]", iface.c_str());
 
-    for (const auto &callback : netStatsCallback_) {
-        if (callback != nullptr) {
-            callback->NetIfaceStatsChanged(iface);
-        }
-    }
+    netStatsCallback_.Notify(
+        [iface](const sptr<INetStatsCallback> &callback) { callback->NetIfaceStatsChanged(iface); });
 
     return static_cast<int32_t>(NetStatsResultCode::ERR_NONE);
 }
@@ -75,11 +45,8 @@ int32_t NetStatsCallback::NotifyNetUidStatsChanged(const std::string &iface, uin
 {
     NETMGR_LOG_D("UpdateIfacesStats info: iface[%{public}s] uid[%{public}d]", iface.c_str(), uid);
 
-    for (const auto &callback : netStatsCallback_) {
-        if (callback != nullptr) {
-            callback->NetUidStatsChanged(iface, uid);
-        }
-    }
+    netStatsCallback_.Notify(
+        [iface, uid](const sptr<INetStatsCallback> &callback) { callback->NetUidStatsChanged(iface, uid); });
 
     return static_cast<int32_t>(NetStatsResultCode::ERR_NONE);
 }
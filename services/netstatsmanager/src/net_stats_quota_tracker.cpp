@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "net_stats_quota_tracker.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+int64_t NetStatsQuotaTracker::CounterDelta(int64_t last, int64_t current)
+{
+    // A counter that went backwards was reset, everything it holds now is new traffic
+    return (current >= last) ? (current - last) : current;
+}
+
+void NetStatsQuotaTracker::SetQuota(const NetStatsQuota &quota, int64_t usedBytes, int64_t rxBytes,
+    int64_t txBytes, const sptr<NetStatsQuotaCallback> &callback)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    RemoveQuotaLocked(quota.ident);
+
+    auto inserted = ifaces_.emplace(quota.iface, IfaceCounter());
+    IfaceCounter &counter = inserted.first->second;
+    if (inserted.second) {
+        counter.rxBytes = rxBytes;
+        counter.txBytes = txBytes;
+    } else {
+        // usedBytes already holds the traffic since the last sample, which the next sample adds again
+        usedBytes -= CounterDelta(counter.rxBytes, rxBytes) + CounterDelta(counter.txBytes, txBytes);
+    }
+
+    QuotaEntry entry;
+    entry.quota = quota;
+    entry.usedBytes = usedBytes;
+    entry.warned = quota.warningBytes >= 0 && usedBytes >= quota.warningBytes;
+    entry.limited = quota.limitBytes >= 0 && usedBytes >= quota.limitBytes;
+    entry.callback = callback;
+    counter.quotas[quota.ident] = entry;
+    identIfaces_[quota.ident] = quota.iface;
+}
+
+bool NetStatsQuotaTracker::RemoveQuota(const std::string &ident)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return RemoveQuotaLocked(ident);
+}
+
+bool NetStatsQuotaTracker::RemoveQuotaLocked(const std::string &ident)
+{
+    auto identIt = identIfaces_.find(ident);
+    if (identIt == identIfaces_.end()) {
+        return false;
+    }
+    auto ifaceIt = ifaces_.find(identIt->second);
+    if (ifaceIt != ifaces_.end()) {
+        ifaceIt->second.quotas.erase(ident);
+        if (ifaceIt->second.quotas.empty()) {
+            ifaces_.erase(ifaceIt);
+        }
+    }
+    identIfaces_.erase(identIt);
+    return true;
+}
+
+std::vector<NetStatsQuotaEvent> NetStatsQuotaTracker::OnSample(const std::string &iface, int64_t rxBytes,
+    int64_t txBytes, int64_t now)
+{
+    std::vector<NetStatsQuotaEvent> events;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto ifaceIt = ifaces_.find(iface);
+    if (ifaceIt == ifaces_.end()) {
+        return events;
+    }
+    IfaceCounter &counter = ifaceIt->second;
+    int64_t delta = CounterDelta(counter.rxBytes, rxBytes) + CounterDelta(counter.txBytes, txBytes);
+    counter.rxBytes = rxBytes;
+    counter.txBytes = txBytes;
+
+    for (auto it = counter.quotas.begin(); it != counter.quotas.end();) {
+        QuotaEntry &entry = it->second;
+        entry.usedBytes += delta;
+        if (!entry.warned && entry.quota.warningBytes >= 0 && entry.usedBytes >= entry.quota.warningBytes) {
+            entry.warned = true;
+            events.push_back({NetStatsQuotaEventType::WARNING_REACHED, entry.quota, entry.callback});
+        }
+        if (!entry.limited && entry.quota.limitBytes >= 0 && entry.usedBytes >= entry.quota.limitBytes) {
+            entry.limited = true;
+            events.push_back({NetStatsQuotaEventType::LIMIT_REACHED, entry.quota, entry.callback});
+        }
+        if (now >= entry.quota.periodEnd) {
+            events.push_back({NetStatsQuotaEventType::PERIOD_ENDED, entry.quota, entry.callback});
+            identIfaces_.erase(it->first);
+            it = counter.quotas.erase(it);
+            continue;
+        }
+        ++it;
+    }
+    if (counter.quotas.empty()) {
+        ifaces_.erase(ifaceIt);
+    }
+    return events;
+}
+
+std::vector<std::string> NetStatsQuotaTracker::GetIfaces() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> ifaces;
+    ifaces.reserve(ifaces_.size());
+    for (const auto &item : ifaces_) {
+        ifaces.push_back(item.first);
+    }
+    return ifaces;
+}
+
+bool NetStatsQuotaTracker::GetUsedBytes(const std::string &ident, int64_t &usedBytes) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto identIt = identIfaces_.find(ident);
+    if (identIt == identIfaces_.end()) {
+        return false;
+    }
+    usedBytes = ifaces_.at(identIt->second).quotas.at(ident).usedBytes;
+    return true;
+}
+
+void NetStatsQuotaTracker::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ifaces_.clear();
+    identIfaces_.clear();
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
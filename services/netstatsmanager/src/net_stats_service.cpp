@@ -25,6 +25,7 @@
 #include "net_stats_csv.h"
 #include "net_manager_center.h"
 #include "net_mgr_log_wrapper.h"
+#include "netsys_controller.h"
 
 namespace OHOS {
 namespace NetManagerStandard {
@@ -38,7 +39,11 @@ NetStatsService::NetStatsService()
     netStatsCallback_ = (std::make_unique<NetStatsCallback>()).release();
 }
 
-NetStatsService::~NetStatsService() {}
+NetStatsService::~NetStatsService()
+{
+    // The sampling thread reads quotaTracker_, it has to end before any member goes away
+    sampleQuotaTimer_.Stop();
+}
 
 static void UpdateStatsTimer()
 {
@@ -78,6 +83,7 @@ void NetStatsService::OnStart()
 
     InitListener();
     updateStatsTimer_.Start(INTERVAL_UPDATE_STATS_TIME_MS, UpdateStatsTimer);
+    sampleQuotaTimer_.Start(INTERVAL_SAMPLE_QUOTA_TIME_MS, [this]() { SampleIfaceQuotas(); });
 
     state_ = STATE_RUNNING;
     gettimeofday(&tv, NULL);
@@ -251,5 +257,77 @@ NetStatsResultCode NetStatsService::ResetFactory()
     NETMGR_LOG_I("ResetFactory begin");
     return netStatsCsv_->ResetFactory();
 }
+
+NetStatsResultCode NetStatsService::SetIfaceQuota(const NetStatsQuota &quota,
+    const sptr<NetStatsQuotaCallback> &callback, int64_t &usedBytes)
+{
+    NETMGR_LOG_I("SetIfaceQuota ident[%{public}s] iface[%{public}s] limitBytes[%{public}" PRId64 "]",
+        quota.ident.c_str(), quota.iface.c_str(), quota.limitBytes);
+    if (callback == nullptr || quota.ident.empty() || quota.periodStart >= quota.periodEnd) {
+        NETMGR_LOG_E("SetIfaceQuota invalid quota or callback");
+        return NetStatsResultCode::ERR_INVALID_PARAMETER;
+    }
+    if (!netStatsCsv_->ExistsIface(quota.iface)) {
+        NETMGR_LOG_E("iface not exist");
+        return NetStatsResultCode::ERR_INVALID_PARAMETER;
+    }
+
+    // Record a fresh sample so the history covers the period up to now
+    if (!netStatsCsv_->UpdateIfaceStatsCsv(quota.iface)) {
+        NETMGR_LOG_E("UpdateIfaceStatsCsv failed");
+        return NetStatsResultCode::ERR_INTERNAL_ERROR;
+    }
+    int64_t rxBytes = NetsysController::GetInstance().GetIfaceRxBytes(quota.iface);
+    int64_t txBytes = NetsysController::GetInstance().GetIfaceTxBytes(quota.iface);
+    int64_t now = static_cast<int64_t>(time(nullptr));
+    usedBytes = 0;
+    if (now > quota.periodStart) {
+        NetStatsInfo statsInfo;
+        NetStatsResultCode result = netStatsCsv_->GetIfaceBytes(quota.iface, static_cast<uint32_t>(quota.periodStart),
+            static_cast<uint32_t>(now), statsInfo);
+        if (result == NetStatsResultCode::ERR_NONE) {
+            usedBytes = statsInfo.rxBytes_ + statsInfo.txBytes_;
+        }
+    }
+    quotaTracker_.SetQuota(quota, usedBytes, rxBytes, txBytes, callback);
+    return NetStatsResultCode::ERR_NONE;
+}
+
+NetStatsResultCode NetStatsService::RemoveIfaceQuota(const std::string &ident)
+{
+    NETMGR_LOG_I("RemoveIfaceQuota ident[%{public}s]", ident.c_str());
+    quotaTracker_.RemoveQuota(ident);
+    return NetStatsResultCode::ERR_NONE;
+}
+
+void NetStatsService::SampleIfaceQuotas()
+{
+    int64_t now = static_cast<int64_t>(time(nullptr));
+    for (const std::string &iface : quotaTracker_.GetIfaces()) {
+        int64_t rxBytes = NetsysController::GetInstance().GetIfaceRxBytes(iface);
+        int64_t txBytes = NetsysController::GetInstance().GetIfaceTxBytes(iface);
+        std::vector<NetStatsQuotaEvent> events = quotaTracker_.OnSample(iface, rxBytes, txBytes, now);
+        for (const NetStatsQuotaEvent &event : events) {
+            if (event.callback == nullptr) {
+                continue;
+            }
+            switch (event.type) {
+                case NetStatsQuotaEventType::WARNING_REACHED:
+                    event.callback->OnQuotaWarningReached(event.quota);
+                    netStatsCallback_->NotifyNetIfaceStatsChanged(iface);
+                    break;
+                case NetStatsQuotaEventType::LIMIT_REACHED:
+                    event.callback->OnQuotaLimitReached(event.quota);
+                    netStatsCallback_->NotifyNetIfaceStatsChanged(iface);
+                    break;
+                case NetStatsQuotaEventType::PERIOD_ENDED:
+                    event.callback->OnQuotaPeriodEnded(event.quota);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
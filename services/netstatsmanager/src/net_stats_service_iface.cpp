@@ -32,5 +32,19 @@ int32_t NetStatsServiceIface::ResetStatsFactory()
     NetStatsResultCode result = DelayedSingleton<NetStatsService>::GetInstance()->ResetFactory();
     return static_cast<int32_t>(result);
 }
+
+int32_t NetStatsServiceIface::SetIfaceQuota(const NetStatsQuota &quota, const sptr<NetStatsQuotaCallback> &callback,
+    int64_t &usedBytes)
+{
+    NetStatsResultCode result = DelayedSingleton<NetStatsService>::GetInstance()->SetIfaceQuota(quota, callback,
+        usedBytes);
+    return static_cast<int32_t>(result);
+}
+
+int32_t NetStatsServiceIface::RemoveIfaceQuota(const std::string &ident)
+{
+    NetStatsResultCode result = DelayedSingleton<NetStatsService>::GetInstance()->RemoveIfaceQuota(ident);
+    return static_cast<int32_t>(result);
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
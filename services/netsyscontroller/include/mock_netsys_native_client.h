@@ -81,6 +81,10 @@ const std::string MOCK_STOPDHCPCLIENT_API = "StopDhcpClient";
 const std::string MOCK_REGISTERNOTIFYCALLBACK_API = "RegisterNotifyCallback";
 const std::string MOCK_STARTDHCPSERVICE_API = "StartDhcpService";
 const std::string MOCK_STOPDHCPSERVICE_API = "StopDhcpService";
+const std::string MOCK_FIREWALLSETUIDRULE_API = "FirewallSetUidRule";
+const std::string MOCK_FIREWALLSETUIDS_API = "FirewallSetUids";
+const std::string MOCK_FIREWALLENABLECHAIN_API = "FirewallEnableChain";
+const std::string MOCK_FIREWALLSETCHAININTERFACE_API = "FirewallSetChainInterface";
 
 class MockNetsysNativeClient {
 public:
@@ -546,6 +550,45 @@ public:
      * @return Return the return value of the netsys interface call.
      */
     int32_t StopDhcpService(const std::string &iface);
+
+    /**
+     * @brief Add a uid to, or remove it from, a netsys firewall chain.
+     *
+     * @param chain firewall chain, see NetsysFirewallChain
+     * @param uid uid
+     * @param member true to add the uid, false to remove it
+     * @return Return the return value of the netsys interface call.
+     */
+    int32_t FirewallSetUidRule(uint32_t chain, uint32_t uid, bool member);
+
+    /**
+     * @brief Replace the uids of a netsys firewall chain.
+     *
+     * @param chain firewall chain, see NetsysFirewallChain
+     * @param uids the new members of the chain
+     * @return Return the return value of the netsys interface call.
+     */
+    int32_t FirewallSetUids(uint32_t chain, const std::vector<uint32_t> &uids);
+
+    /**
+     * @brief Enable or disable a netsys firewall chain on every interface.
+     *
+     * @param chain firewall chain, see NetsysFirewallChain
+     * @param enable true to enable
+     * @return Return the return value of the netsys interface call.
+     */
+    int32_t FirewallEnableChain(uint32_t chain, bool enable);
+
+    /**
+     * @brief Enable or disable a netsys firewall chain on one interface.
+     *
+     * @param chain firewall chain, see NetsysFirewallChain
+     * @param iface interface name
+     * @param attach true to enable
+     * @return Return the return value of the netsys interface call.
+     */
+    int32_t FirewallSetChainInterface(uint32_t chain, const std::string &iface, bool attach);
+
 private:
     int64_t GetIfaceBytes(const std::string &interfaceName, const std::string &filename);
     int64_t GetAllBytes(const std::string &filename);
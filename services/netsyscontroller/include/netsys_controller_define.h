@@ -32,6 +32,14 @@ enum NetsysContrlResultCode {
     ERR_START_DHCPSERVICE_FAILED = (-2),
     ERR_STOP_DHCPSERVICE_FAILED = (-3),
 };
+
+// Mirrors nmd::FirewallChain in netsys
+enum NetsysFirewallChain {
+    NETSYS_FIREWALL_CHAIN_NONE = 0,
+    NETSYS_FIREWALL_CHAIN_DENY_ALL = 1,
+    NETSYS_FIREWALL_CHAIN_DENY_METERED = 2,
+    NETSYS_FIREWALL_CHAIN_ALLOW_IDLE = 3,
+};
 } // namespace NetManagerStandard
 } // namespace OHOS
 #endif // NETSYS_CONTROLLER_DEFINE_H
@@ -643,5 +643,32 @@ int32_t MockNetsysNativeClient::StopDhcpService(const std::string &iface)
 {
     return 0;
 }
+
+int32_t MockNetsysNativeClient::FirewallSetUidRule(uint32_t chain, uint32_t uid, bool member)
+{
+    NETMGR_LOG_D("MockNetsysNativeClient::FirewallSetUidRule: chain[%{public}u], uid[%{public}u], member[%{public}d]",
+        chain, uid, member);
+    return 0;
+}
+
+int32_t MockNetsysNativeClient::FirewallSetUids(uint32_t chain, const std::vector<uint32_t> &uids)
+{
+    NETMGR_LOG_D("MockNetsysNativeClient::FirewallSetUids: chain[%{public}u], size[%{public}zu]", chain,
+        uids.size());
+    return 0;
+}
+
+int32_t MockNetsysNativeClient::FirewallEnableChain(uint32_t chain, bool enable)
+{
+    NETMGR_LOG_D("MockNetsysNativeClient::FirewallEnableChain: chain[%{public}u], enable[%{public}d]", chain, enable);
+    return 0;
+}
+
+int32_t MockNetsysNativeClient::FirewallSetChainInterface(uint32_t chain, const std::string &iface, bool attach)
+{
+    NETMGR_LOG_D("MockNetsysNativeClient::FirewallSetChainInterface: chain[%{public}u], iface[%{public}s], "
+        "attach[%{public}d]", chain, iface.c_str(), attach);
+    return 0;
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
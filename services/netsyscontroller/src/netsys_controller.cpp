@@ -563,5 +563,47 @@ int32_t NetsysController::StopDhcpService(const std::string &iface)
     NETMGR_LOG_D("NetsysController::StopDhcpService: ifaceFd[%{public}s]", iface.c_str());
     return netsysService_->StopDhcpService(iface);
 }
+
+int32_t NetsysController::FirewallSetUidRule(uint32_t chain, uint32_t uid, bool member)
+{
+    NETMGR_LOG_D("NetsysController::FirewallSetUidRule: chain[%{public}u], uid[%{public}u], member[%{public}d]",
+        chain, uid, member);
+    if (netsysService_ == nullptr) {
+        NETMGR_LOG_E("netsysService_ is null");
+        return ERR_SERVICE_UPDATE_NET_LINK_INFO_FAIL;
+    }
+    return netsysService_->FirewallSetUidRule(chain, uid, member);
+}
+
+int32_t NetsysController::FirewallSetUids(uint32_t chain, const std::vector<uint32_t> &uids)
+{
+    NETMGR_LOG_D("NetsysController::FirewallSetUids: chain[%{public}u], size[%{public}zu]", chain, uids.size());
+    if (netsysService_ == nullptr) {
+        NETMGR_LOG_E("netsysService_ is null");
+        return ERR_SERVICE_UPDATE_NET_LINK_INFO_FAIL;
+    }
+    return netsysService_->FirewallSetUids(chain, uids);
+}
+
+int32_t NetsysController::FirewallEnableChain(uint32_t chain, bool enable)
+{
+    NETMGR_LOG_D("NetsysController::FirewallEnableChain: chain[%{public}u], enable[%{public}d]", chain, enable);
+    if (netsysService_ == nullptr) {
+        NETMGR_LOG_E("netsysService_ is null");
+        return ERR_SERVICE_UPDATE_NET_LINK_INFO_FAIL;
+    }
+    return netsysService_->FirewallEnableChain(chain, enable);
+}
+
+int32_t NetsysController::FirewallSetChainInterface(uint32_t chain, const std::string &iface, bool attach)
+{
+    NETMGR_LOG_D("NetsysController::FirewallSetChainInterface: chain[%{public}u], iface[%{public}s], "
+        "attach[%{public}d]", chain, iface.c_str(), attach);
+    if (netsysService_ == nullptr) {
+        NETMGR_LOG_E("netsysService_ is null");
+        return ERR_SERVICE_UPDATE_NET_LINK_INFO_FAIL;
+    }
+    return netsysService_->FirewallSetChainInterface(chain, iface, attach);
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
\ No newline at end of file
@@ -520,5 +520,41 @@ int32_t NetsysControllerServiceImpl::StopDhcpService(const std::string &iface)
     }
     return netsysClient_.StopDhcpService(iface);
 }
+
+int32_t NetsysControllerServiceImpl::FirewallSetUidRule(uint32_t chain, uint32_t uid, bool member)
+{
+    NETMGR_LOG_D("NetsysControllerServiceImpl::FirewallSetUidRule");
+    if (mockNetsysClient_.CheckMockApi(MOCK_FIREWALLSETUIDRULE_API)) {
+        return mockNetsysClient_.FirewallSetUidRule(chain, uid, member);
+    }
+    return netsysClient_.FirewallSetUidRule(chain, uid, member);
+}
+
+int32_t NetsysControllerServiceImpl::FirewallSetUids(uint32_t chain, const std::vector<uint32_t> &uids)
+{
+    NETMGR_LOG_D("NetsysControllerServiceImpl::FirewallSetUids");
+    if (mockNetsysClient_.CheckMockApi(MOCK_FIREWALLSETUIDS_API)) {
+        return mockNetsysClient_.FirewallSetUids(chain, uids);
+    }
+    return netsysClient_.FirewallSetUids(chain, uids);
+}
+
+int32_t NetsysControllerServiceImpl::FirewallEnableChain(uint32_t chain, bool enable)
+{
+    NETMGR_LOG_D("NetsysControllerServiceImpl::FirewallEnableChain");
+    if (mockNetsysClient_.CheckMockApi(MOCK_FIREWALLENABLECHAIN_API)) {
+        return mockNetsysClient_.FirewallEnableChain(chain, enable);
+    }
+    return netsysClient_.FirewallEnableChain(chain, enable);
+}
+
+int32_t NetsysControllerServiceImpl::FirewallSetChainInterface(uint32_t chain, const std::string &iface, bool attach)
+{
+    NETMGR_LOG_D("NetsysControllerServiceImpl::FirewallSetChainInterface");
+    if (mockNetsysClient_.CheckMockApi(MOCK_FIREWALLSETCHAININTERFACE_API)) {
+        return mockNetsysClient_.FirewallSetChainInterface(chain, iface, attach);
+    }
+    return netsysClient_.FirewallSetChainInterface(chain, iface, attach);
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
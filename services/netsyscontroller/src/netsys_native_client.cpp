@@ -744,5 +744,61 @@ int32_t NetsysNativeClient::StopDhcpService(const std::string &iface)
     }
     return netsysNativeService_->StopDhcpService(iface);
 }
+
+sptr<OHOS::NetsysNative::INetsysService> NetsysNativeClient::GetFirewallService()
+{
+    std::lock_guard<std::mutex> lock(firewallServiceMutex_);
+    if (firewallService_ != nullptr && firewallService_->AsObject() != nullptr &&
+        !firewallService_->AsObject()->IsObjectDead()) {
+        return firewallService_;
+    }
+    // netsys restarted, the policy service resyncs its rules right after that and must reach the new instance
+    firewallService_ = GetProxy();
+    return firewallService_;
+}
+
+int32_t NetsysNativeClient::FirewallSetUidRule(uint32_t chain, uint32_t uid, bool member)
+{
+    NETMGR_LOG_I("NetsysNativeClient FirewallSetUidRule");
+    sptr<OHOS::NetsysNative::INetsysService> service = GetFirewallService();
+    if (service == nullptr) {
+        NETMGR_LOG_E("FirewallSetUidRule netsys service is null");
+        return ERR_NATIVESERVICE_NOTFIND;
+    }
+    return service->FirewallSetUidRule(chain, uid, member);
+}
+
+int32_t NetsysNativeClient::FirewallSetUids(uint32_t chain, const std::vector<uint32_t> &uids)
+{
+    NETMGR_LOG_I("NetsysNativeClient FirewallSetUids");
+    sptr<OHOS::NetsysNative::INetsysService> service = GetFirewallService();
+    if (service == nullptr) {
+        NETMGR_LOG_E("FirewallSetUids netsys service is null");
+        return ERR_NATIVESERVICE_NOTFIND;
+    }
+    return service->FirewallSetUids(chain, uids);
+}
+
+int32_t NetsysNativeClient::FirewallEnableChain(uint32_t chain, bool enable)
+{
+    NETMGR_LOG_I("NetsysNativeClient FirewallEnableChain");
+    sptr<OHOS::NetsysNative::INetsysService> service = GetFirewallService();
+    if (service == nullptr) {
+        NETMGR_LOG_E("FirewallEnableChain netsys service is null");
+        return ERR_NATIVESERVICE_NOTFIND;
+    }
+    return service->FirewallEnableChain(chain, enable);
+}
+
+int32_t NetsysNativeClient::FirewallSetChainInterface(uint32_t chain, const std::string &iface, bool attach)
+{
+    NETMGR_LOG_I("NetsysNativeClient FirewallSetChainInterface");
+    sptr<OHOS::NetsysNative::INetsysService> service = GetFirewallService();
+    if (service == nullptr) {
+        NETMGR_LOG_E("FirewallSetChainInterface netsys service is null");
+        return ERR_NATIVESERVICE_NOTFIND;
+    }
+    return service->FirewallSetChainInterface(chain, iface, attach);
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+
+#include <gtest/gtest.h>
+
+#include "net_activate.h"
+#include "net_conn_callback_stub.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+using namespace testing::ext;
+namespace {
+constexpr uint32_t REQUEST_TIMEOUT_MS = 50;
+constexpr uint32_t BATCH_WINDOW_MS = 10;
+constexpr int32_t WAIT_TIMEOUT_MS = 2000;
+
+class BatchRecorder : public NetConnCallbackStub {
+public:
+    int32_t NetCallbackBatch(const sptr<NetConnCallbackBatch> &batch) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.insert(events_.end(), batch->events_.begin(), batch->events_.end());
+        cond_.notify_all();
+        return ERR_NONE;
+    }
+
+    bool WaitFor(size_t num)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cond_.wait_for(lock, std::chrono::milliseconds(WAIT_TIMEOUT_MS),
+            [this, num]() { return events_.size() >= num; });
+    }
+
+    std::vector<NetConnCallbackEvent> GetEvents()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return events_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::vector<NetConnCallbackEvent> events_;
+};
+
+sptr<NetSpecifier> MakeSpecifier(const std::set<NetCap> &caps, const std::set<NetBearType> &types)
+{
+    sptr<NetSpecifier> specifier = (std::make_unique<NetSpecifier>()).release();
+    specifier->SetCapabilities(caps);
+    specifier->SetTypes(types);
+    return specifier;
+}
+} // namespace
+
+class NetActivateTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+HWTEST_F(NetActivateTest, TimeoutQueuesNetUnavailable, TestSize.Level1)
+{
+    NetEventLoop loop("NetActivateTest");
+    loop.Start();
+    NetConnCallbackBatcher batcher(loop, BATCH_WINDOW_MS);
+    sptr<BatchRecorder> recorder = (std::make_unique<BatchRecorder>()).release();
+    std::promise<uint32_t> fired;
+    sptr<NetActivate> request = (std::make_unique<NetActivate>(MakeSpecifier({NET_CAPABILITY_INTERNET}, {}),
+        recorder, [&fired](uint32_t &reqId) {
+            fired.set_value(reqId);
+            return 0;
+        }, REQUEST_TIMEOUT_MS)).release();
+
+    auto future = fired.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::milliseconds(WAIT_TIMEOUT_MS)), std::future_status::ready);
+    EXPECT_EQ(future.get(), request->GetRequestId());
+
+    // The service runs the expiry on its state loop, NetUnavailable then goes through the batcher.
+    EXPECT_TRUE(loop.Invoke([&request, &batcher]() { return request->TimeOutNetAvailable(batcher); }, false));
+    ASSERT_TRUE(recorder->WaitFor(1));
+    loop.Stop();
+    std::vector<NetConnCallbackEvent> events = recorder->GetEvents();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].facets, FACET_UNAVAILABLE);
+}
+
+HWTEST_F(NetActivateTest, SuppliedRequestDoesNotExpire, TestSize.Level1)
+{
+    NetEventLoop loop("NetActivateTest");
+    loop.Start();
+    NetConnCallbackBatcher batcher(loop, BATCH_WINDOW_MS);
+    sptr<BatchRecorder> recorder = (std::make_unique<BatchRecorder>()).release();
+    sptr<NetActivate> request = (std::make_unique<NetActivate>(MakeSpecifier({NET_CAPABILITY_INTERNET}, {}),
+        recorder, nullptr, 0)).release();
+    std::set<NetCap> netCaps {NET_CAPABILITY_INTERNET};
+    request->SetServiceSupply((std::make_unique<NetSupplier>(BEARER_WIFI, "ident", netCaps)).release());
+
+    EXPECT_FALSE(loop.Invoke([&request, &batcher]() { return request->TimeOutNetAvailable(batcher); }, true));
+    loop.Stop();
+    EXPECT_TRUE(recorder->GetEvents().empty());
+}
+
+HWTEST_F(NetActivateTest, MatchByCapabilitiesAndBearer, TestSize.Level1)
+{
+    std::set<NetCap> netCaps {NET_CAPABILITY_INTERNET, NET_CAPABILITY_NOT_METERED};
+    sptr<NetSupplier> wifi = (std::make_unique<NetSupplier>(BEARER_WIFI, "ident", netCaps)).release();
+    auto match = [&wifi](const std::set<NetCap> &caps, const std::set<NetBearType> &types) {
+        sptr<NetActivate> request =
+            (std::make_unique<NetActivate>(MakeSpecifier(caps, types), nullptr, nullptr, 0)).release();
+        return request->MatchRequestAndNetwork(wifi);
+    };
+    EXPECT_TRUE(match({}, {}));
+    EXPECT_TRUE(match({NET_CAPABILITY_INTERNET, NET_CAPABILITY_NOT_METERED}, {}));
+    EXPECT_FALSE(match({NET_CAPABILITY_INTERNET, NET_CAPABILITY_MMS}, {}));
+    EXPECT_TRUE(match({NET_CAPABILITY_INTERNET}, {BEARER_CELLULAR, BEARER_WIFI}));
+    EXPECT_FALSE(match({NET_CAPABILITY_INTERNET}, {BEARER_CELLULAR}));
+}
+
+HWTEST_F(NetActivateTest, NullSpecifierNeverMatches, TestSize.Level1)
+{
+    std::set<NetCap> netCaps {NET_CAPABILITY_INTERNET};
+    sptr<NetSupplier> wifi = (std::make_unique<NetSupplier>(BEARER_WIFI, "ident", netCaps)).release();
+    sptr<NetActivate> request = (std::make_unique<NetActivate>(nullptr, nullptr, nullptr, 0)).release();
+    EXPECT_FALSE(request->MatchRequestAndNetwork(wifi));
+    EXPECT_FALSE(request->MatchRequestAndNetwork(nullptr));
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
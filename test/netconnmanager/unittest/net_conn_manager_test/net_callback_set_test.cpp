@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+
+#include <gtest/gtest.h>
+
+#include "ipc_object_stub.h"
+#include "iremote_broker.h"
+
+#include "net_callback_set.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+using namespace testing::ext;
+namespace {
+constexpr uint32_t TEST_LIMIT = 2;
+constexpr uint32_t TEST_WORKER_NUM = 2;
+constexpr uint32_t FIRST_COOKIE = 7;
+constexpr uint32_t SECOND_COOKIE = 9;
+constexpr int32_t NOTIFY_ROUNDS = 50;
+constexpr uint32_t WAIT_TIME_MS = 2000;
+
+class TestRemote : public IPCObjectStub {
+public:
+    bool AddDeathRecipient(const sptr<DeathRecipient> &recipient) override
+    {
+        if (onAdd_) {
+            onAdd_();
+        }
+        if (!watchable_) {
+            return false;
+        }
+        recipient_ = recipient;
+        return true;
+    }
+
+    bool RemoveDeathRecipient(const sptr<DeathRecipient> &recipient) override
+    {
+        recipient_ = nullptr;
+        return true;
+    }
+
+    void Die()
+    {
+        sptr<DeathRecipient> recipient = recipient_;
+        if (recipient != nullptr) {
+            recipient->OnRemoteDied(this);
+        }
+    }
+
+    bool HasRecipient() const
+    {
+        return recipient_ != nullptr;
+    }
+
+    std::function<void()> onAdd_;
+    bool watchable_ = true;
+
+private:
+    sptr<DeathRecipient> recipient_;
+};
+
+class ITestCallback : public IRemoteBroker {
+public:
+    DECLARE_INTERFACE_DESCRIPTOR(u"OHOS.NetManagerStandard.ITestCallback");
+    virtual void OnEvent(int32_t value) = 0;
+};
+
+class TestCallback : public ITestCallback {
+public:
+    TestCallback() : remote_((std::make_unique<TestRemote>()).release()) {}
+
+    sptr<IRemoteObject> AsObject() override
+    {
+        return remote_;
+    }
+
+    void OnEvent(int32_t value) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Every client must see the notifications in order.
+        if (value != lastValue_ + 1) {
+            outOfOrder_ = true;
+        }
+        lastValue_ = value;
+        condition_.notify_all();
+    }
+
+    bool WaitFor(int32_t value)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return condition_.wait_for(lock, std::chrono::milliseconds(WAIT_TIME_MS),
+            [this, value]() { return lastValue_ >= value; });
+    }
+
+    bool IsOutOfOrder()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return outOfOrder_;
+    }
+
+    sptr<TestRemote> remote_;
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    int32_t lastValue_ = 0;
+    bool outOfOrder_ = false;
+};
+} // namespace
+
+class NetCallbackSetTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+HWTEST_F(NetCallbackSetTest, AddFindRemove, TestSize.Level1)
+{
+    NetWorkerPool workers("NetCbSetTest", TEST_WORKER_NUM);
+    NetCallbackSet<ITestCallback> callbacks(TEST_LIMIT, workers);
+    sptr<TestCallback> first = (std::make_unique<TestCallback>()).release();
+    sptr<TestCallback> second = (std::make_unique<TestCallback>()).release();
+    sptr<TestCallback> third = (std::make_unique<TestCallback>()).release();
+
+    EXPECT_TRUE(callbacks.Add(first, FIRST_COOKIE));
+    EXPECT_FALSE(callbacks.Add(first, SECOND_COOKIE));
+    EXPECT_TRUE(callbacks.Add(second, SECOND_COOKIE));
+    EXPECT_FALSE(callbacks.Add(third));
+    EXPECT_EQ(callbacks.Size(), TEST_LIMIT);
+    EXPECT_TRUE(first->remote_->HasRecipient());
+
+    uint32_t cookie = 0;
+    EXPECT_TRUE(callbacks.Find(second, cookie));
+    EXPECT_EQ(cookie, SECOND_COOKIE);
+    EXPECT_FALSE(callbacks.Find(third, cookie));
+
+    EXPECT_TRUE(callbacks.Remove(first));
+    EXPECT_FALSE(callbacks.Remove(first));
+    EXPECT_FALSE(first->remote_->HasRecipient());
+    EXPECT_TRUE(callbacks.Add(third));
+}
+
+HWTEST_F(NetCallbackSetTest, DeadClientRemoved, TestSize.Level1)
+{
+    NetWorkerPool workers("NetCbSetTest", TEST_WORKER_NUM);
+    NetCallbackSet<ITestCallback> callbacks(0, workers);
+    sptr<TestCallback> alive = (std::make_unique<TestCallback>()).release();
+    sptr<TestCallback> dead = (std::make_unique<TestCallback>()).release();
+    uint32_t diedCookie = 0;
+    callbacks.SetDiedHandler([&diedCookie](const sptr<ITestCallback> &, uint32_t cookie) { diedCookie = cookie; });
+    callbacks.Add(alive, FIRST_COOKIE);
+    callbacks.Add(dead, SECOND_COOKIE);
+
+    dead->remote_->Die();
+    EXPECT_EQ(diedCookie, SECOND_COOKIE);
+    EXPECT_EQ(callbacks.Size(), 1u);
+    uint32_t cookie = 0;
+    EXPECT_FALSE(callbacks.Find(dead, cookie));
+    EXPECT_TRUE(callbacks.Find(alive, cookie));
+
+    // A second death report for the same client is ignored.
+    diedCookie = 0;
+    dead->remote_->Die();
+    EXPECT_EQ(diedCookie, 0u);
+}
+
+HWTEST_F(NetCallbackSetTest, NotifyKeepsPerClientOrder, TestSize.Level1)
+{
+    NetWorkerPool workers("NetCbSetTest", TEST_WORKER_NUM);
+    NetCallbackSet<ITestCallback> callbacks(0, workers);
+    std::vector<sptr<TestCallback>> clients;
+    for (uint32_t i = 0; i < TEST_WORKER_NUM + 1; i++) {
+        sptr<TestCallback> client = (std::make_unique<TestCallback>()).release();
+        callbacks.Add(client);
+        clients.push_back(client);
+    }
+    for (int32_t value = 1; value <= NOTIFY_ROUNDS; value++) {
+        callbacks.Notify([value](const sptr<ITestCallback> &callback) { callback->OnEvent(value); });
+    }
+    for (auto &client : clients) {
+        EXPECT_TRUE(client->WaitFor(NOTIFY_ROUNDS));
+        EXPECT_FALSE(client->IsOutOfOrder());
+    }
+}
+
+HWTEST_F(NetCallbackSetTest, RecipientAttachedUnlocked, TestSize.Level1)
+{
+    NetWorkerPool workers("NetCbSetTest", TEST_WORKER_NUM);
+    NetCallbackSet<ITestCallback> callbacks(0, workers);
+    sptr<TestCallback> client = (std::make_unique<TestCallback>()).release();
+
+    // The binder driver may block on other threads that use the set meanwhile
+    bool setUsable = false;
+    uint32_t cookie = 0;
+    client->remote_->onAdd_ = [&callbacks, &client, &setUsable, &cookie]() {
+        auto lookup = std::async(std::launch::async, [&callbacks, &client, &cookie]() {
+            return callbacks.Find(client, cookie);
+        });
+        setUsable = lookup.wait_for(std::chrono::milliseconds(WAIT_TIME_MS)) == std::future_status::ready &&
+            lookup.get();
+    };
+    EXPECT_TRUE(callbacks.Add(client, FIRST_COOKIE));
+    EXPECT_TRUE(setUsable);
+    EXPECT_EQ(cookie, FIRST_COOKIE);
+    EXPECT_TRUE(client->remote_->HasRecipient());
+
+    // A client that cannot be watched stays registered
+    sptr<TestCallback> local = (std::make_unique<TestCallback>()).release();
+    local->remote_->watchable_ = false;
+    EXPECT_TRUE(callbacks.Add(local));
+    EXPECT_TRUE(callbacks.Find(local, cookie));
+    EXPECT_TRUE(callbacks.Remove(local));
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
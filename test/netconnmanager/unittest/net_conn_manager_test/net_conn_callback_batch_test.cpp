@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include <gtest/gtest.h>
+
+#include "net_conn_callback_batch.h"
+#include "net_conn_callback_batcher.h"
+#include "net_conn_callback_stub.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+using namespace testing::ext;
+namespace {
+constexpr int32_t NET_ID_WIFI = 101;
+constexpr int32_t NET_ID_CELLULAR = 102;
+constexpr uint32_t UP_BANDWIDTH = 100;
+constexpr uint32_t NEW_UP_BANDWIDTH = 200;
+constexpr uint32_t BATCH_WINDOW_MS = 100;
+constexpr int32_t DELIVERY_TIMEOUT_MS = 2000;
+
+NetConnCallbackEvent MakeCapEvent(int32_t netId, uint32_t upBandwidth)
+{
+    NetConnCallbackEvent event;
+    event.netId = netId;
+    event.facets = FACET_CAPABILITIES;
+    event.netAllCap = (std::make_unique<NetAllCapabilities>()).release();
+    event.netAllCap->linkUpBandwidthKbps_ = upBandwidth;
+    event.netAllCap->netCaps_.insert(NET_CAPABILITY_INTERNET);
+    return event;
+}
+
+NetConnCallbackEvent MakeEvent(int32_t netId, uint32_t facets)
+{
+    NetConnCallbackEvent event;
+    event.netId = netId;
+    event.facets = facets;
+    return event;
+}
+
+class BatchRecorder : public NetConnCallbackStub {
+public:
+    int32_t NetCallbackBatch(const sptr<NetConnCallbackBatch> &batch) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        batches_.push_back(batch->events_);
+        cond_.notify_all();
+        return ERR_NONE;
+    }
+
+    bool WaitFor(size_t num)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cond_.wait_for(lock, std::chrono::milliseconds(DELIVERY_TIMEOUT_MS),
+            [this, num]() { return batches_.size() >= num; });
+    }
+
+    std::vector<std::vector<NetConnCallbackEvent>> GetBatches()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return batches_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::vector<std::vector<NetConnCallbackEvent>> batches_;
+};
+} // namespace
+
+class NetConnCallbackBatchTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+HWTEST_F(NetConnCallbackBatchTest, MergeSameNetwork, TestSize.Level1)
+{
+    NetConnCallbackBatch batch;
+    batch.Add(MakeEvent(NET_ID_WIFI, FACET_AVAILABLE));
+    batch.Add(MakeCapEvent(NET_ID_WIFI, UP_BANDWIDTH));
+    batch.Add(MakeCapEvent(NET_ID_CELLULAR, UP_BANDWIDTH));
+    batch.Add(MakeCapEvent(NET_ID_WIFI, NEW_UP_BANDWIDTH));
+
+    // Only the last event takes a merge, so nothing moves ahead of the cellular change.
+    ASSERT_EQ(batch.events_.size(), 3u);
+    EXPECT_EQ(batch.events_[0].netId, NET_ID_WIFI);
+    EXPECT_EQ(batch.events_[0].facets, FACET_AVAILABLE | FACET_CAPABILITIES);
+    EXPECT_EQ(batch.events_[0].netAllCap->linkUpBandwidthKbps_, UP_BANDWIDTH);
+    EXPECT_EQ(batch.events_[1].netId, NET_ID_CELLULAR);
+    EXPECT_EQ(batch.events_[2].netId, NET_ID_WIFI);
+
+    batch.Add(MakeCapEvent(NET_ID_WIFI, UP_BANDWIDTH));
+    ASSERT_EQ(batch.events_.size(), 3u);
+    EXPECT_EQ(batch.events_[2].netAllCap->linkUpBandwidthKbps_, UP_BANDWIDTH);
+}
+
+HWTEST_F(NetConnCallbackBatchTest, NoMergeThatReordersFacets, TestSize.Level1)
+{
+    NetConnCallbackBatch batch;
+    batch.Add(MakeEvent(NET_ID_WIFI, FACET_BLOCK_STATUS));
+    batch.Add(MakeCapEvent(NET_ID_WIFI, UP_BANDWIDTH));
+    batch.Add(MakeEvent(NET_ID_WIFI, FACET_LOST));
+
+    ASSERT_EQ(batch.events_.size(), 2u);
+    EXPECT_EQ(batch.events_[0].facets, FACET_BLOCK_STATUS);
+    EXPECT_EQ(batch.events_[1].facets, FACET_CAPABILITIES | FACET_LOST);
+}
+
+HWTEST_F(NetConnCallbackBatchTest, NoMergeAcrossLost, TestSize.Level1)
+{
+    NetConnCallbackBatch batch;
+    batch.Add(MakeCapEvent(NET_ID_WIFI, UP_BANDWIDTH));
+    batch.Add(MakeEvent(NET_ID_WIFI, FACET_LOST));
+    batch.Add(MakeEvent(NET_ID_WIFI, FACET_AVAILABLE));
+
+    ASSERT_EQ(batch.events_.size(), 2u);
+    EXPECT_EQ(batch.events_[0].facets, FACET_CAPABILITIES | FACET_LOST);
+    EXPECT_EQ(batch.events_[1].facets, FACET_AVAILABLE);
+}
+
+HWTEST_F(NetConnCallbackBatchTest, MarshallingRoundTrip, TestSize.Level1)
+{
+    NetConnCallbackBatch batch;
+    batch.Add(MakeCapEvent(NET_ID_WIFI, UP_BANDWIDTH));
+    NetConnCallbackEvent blockEvent = MakeEvent(NET_ID_CELLULAR, FACET_BLOCK_STATUS);
+    blockEvent.blocked = true;
+    batch.Add(blockEvent);
+
+    Parcel parcel;
+    ASSERT_TRUE(batch.Marshalling(parcel));
+    sptr<NetConnCallbackBatch> result = NetConnCallbackBatch::Unmarshalling(parcel);
+    ASSERT_NE(result, nullptr);
+    ASSERT_EQ(result->events_.size(), 2u);
+    ASSERT_NE(result->events_[0].netAllCap, nullptr);
+    EXPECT_EQ(result->events_[0].netAllCap->linkUpBandwidthKbps_, UP_BANDWIDTH);
+    EXPECT_EQ(result->events_[0].netAllCap->netCaps_.count(NET_CAPABILITY_INTERNET), 1u);
+    EXPECT_EQ(result->events_[0].linkInfo, nullptr);
+    EXPECT_EQ(result->events_[1].netId, NET_ID_CELLULAR);
+    EXPECT_TRUE(result->events_[1].blocked);
+}
+
+HWTEST_F(NetConnCallbackBatchTest, LoneEventGoesOutAtOnce, TestSize.Level1)
+{
+    NetEventLoop loop("BatcherTest");
+    loop.Start();
+    NetConnCallbackBatcher batcher(loop, BATCH_WINDOW_MS);
+    sptr<BatchRecorder> recorder = (std::make_unique<BatchRecorder>()).release();
+    sptr<INetConnCallback> callback = recorder;
+
+    auto start = std::chrono::steady_clock::now();
+    batcher.Enqueue(callback, MakeEvent(NET_ID_WIFI, FACET_UNAVAILABLE));
+    ASSERT_TRUE(recorder->WaitFor(1));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(BATCH_WINDOW_MS));
+    loop.Stop();
+
+    auto batches = recorder->GetBatches();
+    ASSERT_EQ(batches.size(), 1u);
+    ASSERT_EQ(batches[0].size(), 1u);
+    EXPECT_EQ(batches[0][0].facets, FACET_UNAVAILABLE);
+}
+
+HWTEST_F(NetConnCallbackBatchTest, WindowKeepsQueueOrder, TestSize.Level1)
+{
+    NetEventLoop loop("BatcherTest");
+    loop.Start();
+    NetConnCallbackBatcher batcher(loop, BATCH_WINDOW_MS);
+    sptr<BatchRecorder> recorder = (std::make_unique<BatchRecorder>()).release();
+    sptr<INetConnCallback> callback = recorder;
+
+    // Queued in one loop task, the first event opens the window and the others wait for it to close.
+    loop.Invoke([&batcher, &callback]() {
+        batcher.Enqueue(callback, MakeEvent(NET_ID_WIFI, FACET_AVAILABLE));
+        batcher.Enqueue(callback, MakeCapEvent(NET_ID_WIFI, UP_BANDWIDTH));
+        batcher.Enqueue(callback, MakeEvent(NET_ID_CELLULAR, FACET_BLOCK_STATUS));
+        batcher.Enqueue(callback, MakeEvent(NET_ID_WIFI, FACET_CONNECTION_PROPERTIES | FACET_LOST));
+        batcher.Enqueue(callback, MakeCapEvent(NET_ID_CELLULAR, NEW_UP_BANDWIDTH));
+        batcher.Enqueue(callback, MakeCapEvent(NET_ID_WIFI, NEW_UP_BANDWIDTH));
+    });
+    ASSERT_TRUE(recorder->WaitFor(2));
+    loop.Stop();
+
+    auto batches = recorder->GetBatches();
+    ASSERT_EQ(batches.size(), 2u);
+    ASSERT_EQ(batches[0].size(), 1u);
+    EXPECT_EQ(batches[0][0].facets, FACET_AVAILABLE);
+
+    // Nothing is back to back for the same network here, so every event stays where it was queued.
+    const std::vector<NetConnCallbackEvent> &events = batches[1];
+    ASSERT_EQ(events.size(), 5u);
+    EXPECT_EQ(events[0].netId, NET_ID_WIFI);
+    EXPECT_EQ(events[0].facets, FACET_CAPABILITIES);
+    EXPECT_EQ(events[1].netId, NET_ID_CELLULAR);
+    EXPECT_EQ(events[1].facets, FACET_BLOCK_STATUS);
+    EXPECT_EQ(events[2].netId, NET_ID_WIFI);
+    EXPECT_EQ(events[2].facets, FACET_CONNECTION_PROPERTIES | FACET_LOST);
+    EXPECT_EQ(events[3].netId, NET_ID_CELLULAR);
+    EXPECT_EQ(events[3].facets, FACET_CAPABILITIES);
+    EXPECT_EQ(events[4].netId, NET_ID_WIFI);
+    EXPECT_EQ(events[4].facets, FACET_CAPABILITIES);
+}
+
+HWTEST_F(NetConnCallbackBatchTest, WindowKeepsOrderAcrossNetworks, TestSize.Level1)
+{
+    NetEventLoop loop("BatcherTest");
+    loop.Start();
+    NetConnCallbackBatcher batcher(loop, BATCH_WINDOW_MS);
+    sptr<BatchRecorder> recorder = (std::make_unique<BatchRecorder>()).release();
+    sptr<INetConnCallback> callback = recorder;
+
+    // A client following the default network must see wifi lost before the cellular updates that follow it.
+    loop.Invoke([&batcher, &callback]() {
+        batcher.Enqueue(callback, MakeEvent(NET_ID_WIFI, FACET_AVAILABLE));
+        batcher.Enqueue(callback, MakeEvent(NET_ID_CELLULAR, FACET_AVAILABLE));
+        batcher.Enqueue(callback, MakeEvent(NET_ID_WIFI, FACET_LOST));
+        batcher.Enqueue(callback, MakeCapEvent(NET_ID_CELLULAR, UP_BANDWIDTH));
+        batcher.Enqueue(callback, MakeCapEvent(NET_ID_CELLULAR, NEW_UP_BANDWIDTH));
+    });
+    ASSERT_TRUE(recorder->WaitFor(2));
+    loop.Stop();
+
+    auto batches = recorder->GetBatches();
+    ASSERT_EQ(batches.size(), 2u);
+    const std::vector<NetConnCallbackEvent> &events = batches[1];
+    ASSERT_EQ(events.size(), 3u);
+    EXPECT_EQ(events[0].netId, NET_ID_CELLULAR);
+    EXPECT_EQ(events[0].facets, FACET_AVAILABLE);
+    EXPECT_EQ(events[1].netId, NET_ID_WIFI);
+    EXPECT_EQ(events[1].facets, FACET_LOST);
+    EXPECT_EQ(events[2].netId, NET_ID_CELLULAR);
+    EXPECT_EQ(events[2].facets, FACET_CAPABILITIES);
+    EXPECT_EQ(events[2].netAllCap->linkUpBandwidthKbps_, NEW_UP_BANDWIDTH);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -13,6 +13,12 @@
  * limitations under the License.
  */
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include "iservice_registry.h"
@@ -28,6 +34,42 @@ namespace OHOS {
 namespace NetManagerStandard {
 constexpr int WAIT_TIME_SECOND_LONG = 5;
 constexpr int WAIT_TIME_SECOND_NET_DETECTION = 2;
+constexpr int32_t CALLBACK_CHURN_NUM = 16;
+constexpr int32_t LINK_UPDATE_NUM = 32;
+constexpr int32_t LINK_MTU_BASE = 1400;
+constexpr int32_t STATE_WAIT_MS = 2000;
+constexpr int32_t STATE_POLL_MS = 10;
+
+class NetStateVersionRecorder : public NetConnCallbackStub {
+public:
+    int32_t NetStateVersionChange(uint64_t version) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        version_ = version;
+        count_++;
+        cond_.notify_all();
+        return 0;
+    }
+
+    bool WaitForNewer(uint64_t version)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cond_.wait_for(lock, std::chrono::milliseconds(STATE_WAIT_MS),
+            [this, version]() { return version_ > version; });
+    }
+
+    int32_t GetCount()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    uint64_t version_ = 0;
+    int32_t count_ = 0;
+};
 using namespace testing::ext;
 class NetConnManagerTest : public testing::Test {
 public:
@@ -502,5 +544,213 @@ HWTEST_F(NetConnManagerTest, NetConnManager014, TestSize.Level1)
     ASSERT_TRUE(result == NetConnResultCode::NET_CONN_SUCCESS);
     std::cout << info.ToString("\n") << std::endl;
 }
+
+/**
+ * @tc.name: NetConnManager015
+ * @tc.desc: Test NetConnManager RegisterNetConnCallback and UnregisterNetConnCallback lookups by callback.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetConnManagerTest, NetConnManager015, TestSize.Level1)
+{
+    auto client = DelayedSingleton<NetConnClient>::GetInstance();
+    sptr<NetConnCallbackTest> callback = GetINetConnCallbackSample();
+    int32_t result = client->RegisterNetConnCallback(callback);
+    ASSERT_TRUE(result == NetConnResultCode::NET_CONN_SUCCESS);
+    result = client->RegisterNetConnCallback(callback);
+    EXPECT_TRUE(result != NetConnResultCode::NET_CONN_SUCCESS);
+    result = client->UnregisterNetConnCallback(callback);
+    EXPECT_TRUE(result == NetConnResultCode::NET_CONN_SUCCESS);
+    result = client->UnregisterNetConnCallback(callback);
+    EXPECT_TRUE(result != NetConnResultCode::NET_CONN_SUCCESS);
+
+    // Callbacks registered together are each found again on unregister, in any order
+    std::vector<sptr<NetConnCallbackTest>> callbacks;
+    for (int32_t i = 0; i < CALLBACK_CHURN_NUM; i++) {
+        callbacks.push_back(GetINetConnCallbackSample());
+        result = client->RegisterNetConnCallback(callbacks.back());
+        ASSERT_TRUE(result == NetConnResultCode::NET_CONN_SUCCESS);
+    }
+    for (auto it = callbacks.rbegin(); it != callbacks.rend(); ++it) {
+        result = client->UnregisterNetConnCallback(*it);
+        EXPECT_TRUE(result == NetConnResultCode::NET_CONN_SUCCESS);
+    }
+}
+
+/**
+ * @tc.name: NetConnManager016
+ * @tc.desc: Test NetConnManager getters see every update and keep answering while the link changes.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetConnManagerTest, NetConnManager016, TestSize.Level1)
+{
+    auto client = DelayedSingleton<NetConnClient>::GetInstance();
+    std::set<NetCap> netCaps {NET_CAPABILITY_INTERNET};
+    uint32_t supplierId = 0;
+    int32_t result = client->RegisterNetSupplier(BEARER_ETHERNET, "ident16", netCaps, supplierId);
+    ASSERT_TRUE(result == NetConnResultCode::NET_CONN_SUCCESS);
+    sptr<NetLinkInfo> netLinkInfo = GetUpdateLinkInfoSample();
+    netLinkInfo->ifaceName_ = "snapshot0";
+    result = client->UpdateNetLinkInfo(supplierId, netLinkInfo);
+    ASSERT_TRUE(result == NetConnResultCode::NET_CONN_SUCCESS);
+
+    // The update is visible as soon as it returns
+    std::list<sptr<NetHandle>> netList;
+    result = client->GetAllNets(netList);
+    ASSERT_TRUE(result == NetConnResultCode::NET_CONN_SUCCESS);
+    sptr<NetHandle> netHandle = nullptr;
+    for (auto &it : netList) {
+        NetLinkInfo info;
+        if (client->GetConnectionProperties(*it, info) == NetConnResultCode::NET_CONN_SUCCESS &&
+            info.ifaceName_ == netLinkInfo->ifaceName_) {
+            netHandle = it;
+        }
+    }
+    ASSERT_TRUE(netHandle != nullptr);
+
+    std::atomic<bool> stop = false;
+    std::atomic<int32_t> failures = 0;
+    std::thread reader([&client, &netHandle, &stop, &failures]() {
+        while (!stop) {
+            NetLinkInfo info;
+            NetAllCapabilities netAllCap;
+            if (client->GetConnectionProperties(*netHandle, info) != NetConnResultCode::NET_CONN_SUCCESS ||
+                client->GetNetCapabilities(*netHandle, netAllCap) != NetConnResultCode::NET_CONN_SUCCESS) {
+                failures++;
+            }
+        }
+    });
+    for (int32_t i = 0; i < LINK_UPDATE_NUM; i++) {
+        netLinkInfo->mtu_ = static_cast<uint16_t>(LINK_MTU_BASE + i);
+        EXPECT_TRUE(client->UpdateNetLinkInfo(supplierId, netLinkInfo) == NetConnResultCode::NET_CONN_SUCCESS);
+    }
+    stop = true;
+    reader.join();
+    EXPECT_EQ(failures, 0);
+
+    NetLinkInfo info;
+    result = client->GetConnectionProperties(*netHandle, info);
+    ASSERT_TRUE(result == NetConnResultCode::NET_CONN_SUCCESS);
+    EXPECT_EQ(info.mtu_, netLinkInfo->mtu_);
+}
+
+/**
+ * @tc.name: NetConnManager017
+ * @tc.desc: Test NetConnManager RegisterNetStateCallback and UnregisterNetStateCallback.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetConnManagerTest, NetConnManager017, TestSize.Level1)
+{
+    sptr<INetConnService> proxy = NetConnManagerTest::GetProxy();
+    if (proxy == nullptr) {
+        return;
+    }
+    auto client = DelayedSingleton<NetConnClient>::GetInstance();
+    std::set<NetCap> netCaps {NET_CAPABILITY_INTERNET};
+    uint32_t supplierId = 0;
+    int32_t result = client->RegisterNetSupplier(BEARER_ETHERNET, "ident17", netCaps, supplierId);
+    ASSERT_TRUE(result == NetConnResultCode::NET_CONN_SUCCESS);
+    sptr<NetLinkInfo> netLinkInfo = GetUpdateLinkInfoSample();
+    netLinkInfo->ifaceName_ = "version0";
+
+    sptr<NetStateVersionRecorder> recorder = (std::make_unique<NetStateVersionRecorder>()).release();
+    uint64_t version = 0;
+    result = proxy->RegisterNetStateCallback(recorder, version);
+    ASSERT_TRUE(result == NetConnResultCode::NET_CONN_SUCCESS);
+    result = client->UpdateNetLinkInfo(supplierId, netLinkInfo);
+    ASSERT_TRUE(result == NetConnResultCode::NET_CONN_SUCCESS);
+    EXPECT_TRUE(recorder->WaitForNewer(version));
+
+    result = proxy->UnregisterNetStateCallback(recorder);
+    EXPECT_TRUE(result == NetConnResultCode::NET_CONN_SUCCESS);
+    result = proxy->UnregisterNetStateCallback(recorder);
+    EXPECT_TRUE(result != NetConnResultCode::NET_CONN_SUCCESS);
+
+    // Notifications already on their way may still land, none come after them
+    std::this_thread::sleep_for(std::chrono::milliseconds(STATE_WAIT_MS));
+    int32_t count = recorder->GetCount();
+    netLinkInfo->mtu_ = LINK_MTU_BASE;
+    result = client->UpdateNetLinkInfo(supplierId, netLinkInfo);
+    ASSERT_TRUE(result == NetConnResultCode::NET_CONN_SUCCESS);
+    std::this_thread::sleep_for(std::chrono::milliseconds(STATE_WAIT_MS));
+    EXPECT_EQ(recorder->GetCount(), count);
+}
+
+/**
+ * @tc.name: NetConnManager018
+ * @tc.desc: Test NetConnManager state cache reads what the service published last.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetConnManagerTest, NetConnManager018, TestSize.Level1)
+{
+    auto client = DelayedSingleton<NetConnClient>::GetInstance();
+    std::set<NetCap> netCaps {NET_CAPABILITY_INTERNET};
+    uint32_t supplierId = 0;
+    int32_t result = client->RegisterNetSupplier(BEARER_ETHERNET, "ident18", netCaps, supplierId);
+    ASSERT_TRUE(result == NetConnResultCode::NET_CONN_SUCCESS);
+    sptr<NetLinkInfo> netLinkInfo = GetUpdateLinkInfoSample();
+    netLinkInfo->ifaceName_ = "cache0";
+    netLinkInfo->mtu_ = LINK_MTU_BASE;
+    result = client->UpdateNetLinkInfo(supplierId, netLinkInfo);
+    ASSERT_TRUE(result == NetConnResultCode::NET_CONN_SUCCESS);
+
+    std::list<sptr<NetHandle>> netList;
+    client->GetAllNets(netList);
+    sptr<NetHandle> netHandle = nullptr;
+    for (auto &it : netList) {
+        NetLinkInfo info;
+        if (client->GetConnectionProperties(*it, info) == NetConnResultCode::NET_CONN_SUCCESS &&
+            info.ifaceName_ == netLinkInfo->ifaceName_) {
+            netHandle = it;
+        }
+    }
+    ASSERT_TRUE(netHandle != nullptr);
+
+    client->SetStateCacheEnabled(true);
+    NetLinkInfo info;
+    EXPECT_TRUE(client->GetConnectionProperties(*netHandle, info) == NetConnResultCode::NET_CONN_SUCCESS);
+    EXPECT_EQ(info.mtu_, LINK_MTU_BASE);
+
+    // The new version reaches the cache asynchronously, after that the cache never serves the old link
+    netLinkInfo->mtu_ = LINK_MTU_BASE + 1;
+    result = client->UpdateNetLinkInfo(supplierId, netLinkInfo);
+    EXPECT_TRUE(result == NetConnResultCode::NET_CONN_SUCCESS);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(STATE_WAIT_MS);
+    do {
+        client->GetConnectionProperties(*netHandle, info);
+        if (info.mtu_ == netLinkInfo->mtu_) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(STATE_POLL_MS));
+    } while (std::chrono::steady_clock::now() < deadline);
+    client->SetStateCacheEnabled(false);
+    EXPECT_EQ(info.mtu_, netLinkInfo->mtu_);
+}
+
+/**
+ * @tc.name: NetConnManager019
+ * @tc.desc: Test NetConnManager GetDefaultNet and HasDefaultNet answer the same with and without the state page.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetConnManagerTest, NetConnManager019, TestSize.Level1)
+{
+    auto client = DelayedSingleton<NetConnClient>::GetInstance();
+    NetHandle ipcHandle;
+    int32_t ipcResult = client->GetDefaultNet(ipcHandle);
+    bool ipcFlag = false;
+    client->HasDefaultNet(ipcFlag);
+
+    client->SetStatePageEnabled(true);
+    NetHandle pageHandle;
+    int32_t pageResult = client->GetDefaultNet(pageHandle);
+    bool pageFlag = false;
+    client->HasDefaultNet(pageFlag);
+    client->SetStatePageEnabled(false);
+
+    EXPECT_EQ(pageResult, ipcResult);
+    EXPECT_EQ(pageFlag, ipcFlag);
+    if (ipcResult == NetConnResultCode::NET_CONN_SUCCESS) {
+        EXPECT_EQ(pageHandle.GetNetId(), ipcHandle.GetNetId());
+    }
+}
 } // namespace NetManagerStandard
 } // namespace OHOS
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "net_conn_state_page.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+using namespace testing::ext;
+namespace {
+constexpr int32_t NET_ID_WIFI = 101;
+constexpr uint32_t WRITE_ROUNDS = 20000;
+
+NetStateSummary MakeSummary(uint64_t version)
+{
+    // Every field is derived from the version so that a torn read is detectable
+    NetStateSummary state;
+    state.version = version;
+    state.defaultNetId = NET_ID_WIFI + static_cast<int32_t>(version);
+    state.flags = STATE_FLAG_DEFAULT_NET | ((version & 1) ? STATE_FLAG_METERED : STATE_FLAG_VALIDATED);
+    state.bearerTypes = static_cast<uint32_t>(version);
+    state.linkUpBandwidthKbps = static_cast<uint32_t>(version * 2);
+    state.linkDownBandwidthKbps = static_cast<uint32_t>(version * 3);
+    return state;
+}
+
+bool IsConsistent(const NetStateSummary &state)
+{
+    NetStateSummary expect = MakeSummary(state.version);
+    return state.defaultNetId == expect.defaultNetId && state.flags == expect.flags &&
+        state.bearerTypes == expect.bearerTypes && state.linkUpBandwidthKbps == expect.linkUpBandwidthKbps &&
+        state.linkDownBandwidthKbps == expect.linkDownBandwidthKbps;
+}
+} // namespace
+
+class NetConnStatePageTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp()
+    {
+        buffer_.assign(sizeof(NetConnStatePage), 0);
+        page_ = NetConnStatePage::Create(buffer_.data());
+    }
+    void TearDown() {}
+
+protected:
+    std::vector<uint64_t> buffer_;
+    NetConnStatePage *page_ = nullptr;
+};
+
+HWTEST_F(NetConnStatePageTest, WriteThenRead, TestSize.Level1)
+{
+    const NetConnStatePage *reader = NetConnStatePage::Attach(buffer_.data(), sizeof(NetConnStatePage));
+    ASSERT_NE(reader, nullptr);
+    NetStateSummary state;
+    ASSERT_TRUE(reader->Read(state));
+    EXPECT_EQ(state.version, 0u);
+    EXPECT_EQ(state.flags, 0u);
+
+    page_->Write(MakeSummary(1));
+    ASSERT_TRUE(reader->Read(state));
+    EXPECT_EQ(state.version, 1u);
+    EXPECT_TRUE(IsConsistent(state));
+}
+
+HWTEST_F(NetConnStatePageTest, AttachRejectsBadMapping, TestSize.Level1)
+{
+    EXPECT_EQ(NetConnStatePage::Attach(nullptr, sizeof(NetConnStatePage)), nullptr);
+    EXPECT_EQ(NetConnStatePage::Attach(buffer_.data(), sizeof(NetConnStatePage) - 1), nullptr);
+    std::vector<uint64_t> empty(buffer_.size(), 0);
+    EXPECT_EQ(NetConnStatePage::Attach(empty.data(), sizeof(NetConnStatePage)), nullptr);
+}
+
+HWTEST_F(NetConnStatePageTest, ReadNeverTorn, TestSize.Level1)
+{
+    const NetConnStatePage *reader = NetConnStatePage::Attach(buffer_.data(), sizeof(NetConnStatePage));
+    ASSERT_NE(reader, nullptr);
+    // No ASSERT from here until the writer is joined
+    std::atomic<bool> done(false);
+    std::thread writer([this, &done]() {
+        for (uint64_t version = 1; version <= WRITE_ROUNDS; ++version) {
+            page_->Write(MakeSummary(version));
+        }
+        done = true;
+    });
+    uint64_t lastVersion = 0;
+    uint32_t torn = 0;
+    while (!done) {
+        NetStateSummary state;
+        if (!reader->Read(state) || state.version == 0) {
+            continue;
+        }
+        torn += IsConsistent(state) ? 0 : 1;
+        EXPECT_GE(state.version, lastVersion);
+        lastVersion = state.version;
+    }
+    writer.join();
+    EXPECT_EQ(torn, 0u);
+    NetStateSummary state;
+    ASSERT_TRUE(reader->Read(state));
+    EXPECT_EQ(state.version, WRITE_ROUNDS);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "net_event_loop.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+using namespace testing::ext;
+namespace {
+constexpr int32_t PRODUCER_NUM = 4;
+constexpr int32_t TASK_NUM_PER_PRODUCER = 1000;
+} // namespace
+
+class NetEventLoopTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp();
+    void TearDown();
+
+public:
+    std::unique_ptr<NetEventLoop> loop_ = nullptr;
+};
+
+void NetEventLoopTest::SetUp()
+{
+    loop_ = std::make_unique<NetEventLoop>("NetEventLoopTest");
+    loop_->Start();
+}
+
+void NetEventLoopTest::TearDown()
+{
+    loop_->Stop();
+}
+
+HWTEST_F(NetEventLoopTest, PostFromManyThreads, TestSize.Level1)
+{
+    int32_t counter = 0;
+    std::vector<std::thread> producers;
+    for (int32_t i = 0; i < PRODUCER_NUM; ++i) {
+        producers.emplace_back([this, &counter]() {
+            for (int32_t j = 0; j < TASK_NUM_PER_PRODUCER; ++j) {
+                // Not atomic on purpose: tasks must never run concurrently.
+                ASSERT_TRUE(loop_->Post([&counter]() { ++counter; }));
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    int32_t result = loop_->Invoke([&counter]() { return counter; });
+    ASSERT_EQ(result, PRODUCER_NUM * TASK_NUM_PER_PRODUCER);
+}
+
+HWTEST_F(NetEventLoopTest, KeepsPostOrder, TestSize.Level1)
+{
+    std::vector<int32_t> order;
+    for (int32_t i = 0; i < TASK_NUM_PER_PRODUCER; ++i) {
+        loop_->Post([&order, i]() { order.push_back(i); });
+    }
+    loop_->Invoke([]() { return true; });
+    ASSERT_EQ(order.size(), static_cast<size_t>(TASK_NUM_PER_PRODUCER));
+    for (int32_t i = 0; i < TASK_NUM_PER_PRODUCER; ++i) {
+        ASSERT_EQ(order[i], i);
+    }
+}
+
+HWTEST_F(NetEventLoopTest, InvokeFromLoopThread, TestSize.Level1)
+{
+    bool nested = loop_->Invoke([this]() {
+        return loop_->IsInLoopThread() && loop_->Invoke([this]() { return loop_->IsInLoopThread(); });
+    });
+    ASSERT_TRUE(nested);
+    ASSERT_FALSE(loop_->IsInLoopThread());
+}
+
+HWTEST_F(NetEventLoopTest, PostAfterStop, TestSize.Level1)
+{
+    loop_->Stop();
+    ASSERT_FALSE(loop_->Post([]() {}));
+    bool ran = false;
+    EXPECT_EQ(loop_->Invoke([&ran]() {
+        ran = true;
+        return 1;
+    }, -1), -1);
+    EXPECT_EQ(loop_->Invoke([]() { return 1; }), 0);
+    EXPECT_FALSE(ran);
+}
+
+HWTEST_F(NetEventLoopTest, AcceptedPostsRunDespiteStop, TestSize.Level1)
+{
+    std::atomic<int32_t> accepted(0);
+    std::atomic<int32_t> ran(0);
+    std::vector<std::thread> producers;
+    for (int32_t i = 0; i < PRODUCER_NUM; ++i) {
+        producers.emplace_back([this, &accepted, &ran]() {
+            for (int32_t j = 0; j < TASK_NUM_PER_PRODUCER; ++j) {
+                if (loop_->Post([&ran]() { ++ran; })) {
+                    ++accepted;
+                }
+            }
+        });
+    }
+    loop_->Stop();
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    EXPECT_EQ(ran.load(), accepted.load());
+}
+
+HWTEST_F(NetEventLoopTest, StopFromLoopThread, TestSize.Level1)
+{
+    std::atomic<bool> afterStop(false);
+    loop_->Invoke([this, &afterStop]() {
+        loop_->Stop();
+        afterStop = true;
+    });
+    EXPECT_TRUE(afterStop);
+    EXPECT_FALSE(loop_->IsRunning());
+    EXPECT_FALSE(loop_->Post([]() {}));
+
+    // The next Start joins the old thread before running a new one
+    ASSERT_TRUE(loop_->Start());
+    EXPECT_TRUE(loop_->Invoke([this]() { return loop_->IsInLoopThread(); }));
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
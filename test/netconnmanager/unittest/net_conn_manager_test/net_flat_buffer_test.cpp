@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <arpa/inet.h>
+
+#include <gtest/gtest.h>
+
+#include "net_all_capabilities.h"
+#include "net_flat_buffer.h"
+#include "net_link_info.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+using namespace testing::ext;
+namespace {
+// Enough routes to take the flat buffer past the size a reader accepts
+constexpr uint32_t LARGE_ROUTE_NUM = 4000;
+
+INetAddr MakeAddr(uint8_t type, const std::string &address, const std::string &netMask, uint8_t prefixlen)
+{
+    INetAddr netAddr;
+    netAddr.type_ = type;
+    netAddr.family_ = (type == INetAddr::IPV6) ? AF_INET6 : AF_INET;
+    netAddr.prefixlen_ = prefixlen;
+    netAddr.address_ = address;
+    netAddr.netMask_ = netMask;
+    netAddr.hostName_ = "netAddr";
+    return netAddr;
+}
+
+NetLinkInfo MakeLinkInfo()
+{
+    NetLinkInfo linkInfo;
+    linkInfo.ifaceName_ = "wlan0";
+    linkInfo.domain_ = "example.com";
+    linkInfo.mtu_ = 1500;
+    linkInfo.tcpBufferSizes_ = "524288,1048576,2097152,262144,524288,1048576";
+    linkInfo.netAddrList_.push_back(MakeAddr(INetAddr::IPV4, "192.168.1.10", "255.255.255.0", 24));
+    linkInfo.netAddrList_.push_back(MakeAddr(INetAddr::IPV6, "fe80::1", "", 64));
+    // Text that does not survive a raw round trip goes as text
+    linkInfo.dnsList_.push_back(MakeAddr(INetAddr::IPV6, "2001:DB8::53", "", 0));
+    linkInfo.dnsList_.push_back(MakeAddr(INetAddr::UNKNOWN, "dns.example.com", "", 0));
+    Route route;
+    route.iface_ = "wlan0";
+    route.destination_ = MakeAddr(INetAddr::IPV4, "0.0.0.0", "0.0.0.0", 0);
+    route.gateway_ = MakeAddr(INetAddr::IPV4, "192.168.1.1", "", 0);
+    route.rtnType_ = RTN_UNREACHABLE;
+    route.mtu_ = 1400;
+    route.isHost_ = true;
+    route.isDefaultRoute_ = true;
+    linkInfo.routeList_.push_back(route);
+    return linkInfo;
+}
+
+void ExpectSameLinkInfo(const NetLinkInfo &expected, const NetLinkInfo &actual)
+{
+    EXPECT_EQ(expected.ifaceName_, actual.ifaceName_);
+    EXPECT_EQ(expected.domain_, actual.domain_);
+    EXPECT_EQ(expected.mtu_, actual.mtu_);
+    EXPECT_EQ(expected.tcpBufferSizes_, actual.tcpBufferSizes_);
+    EXPECT_EQ(expected.netAddrList_, actual.netAddrList_);
+    EXPECT_EQ(expected.dnsList_, actual.dnsList_);
+    ASSERT_EQ(expected.routeList_.size(), actual.routeList_.size());
+    const Route &expectedRoute = expected.routeList_.front();
+    const Route &actualRoute = actual.routeList_.front();
+    EXPECT_EQ(expectedRoute, actualRoute);
+    EXPECT_EQ(expectedRoute.rtnType_, actualRoute.rtnType_);
+    EXPECT_EQ(expectedRoute.mtu_, actualRoute.mtu_);
+    EXPECT_EQ(expectedRoute.isHost_, actualRoute.isHost_);
+    EXPECT_EQ(expectedRoute.hasGateway_, actualRoute.hasGateway_);
+    EXPECT_EQ(expectedRoute.isDefaultRoute_, actualRoute.isDefaultRoute_);
+}
+} // namespace
+
+class NetFlatBufferTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown()
+    {
+        SetNetLegacyWireFormat(false);
+    }
+};
+
+HWTEST_F(NetFlatBufferTest, LinkInfoRoundTripsInBothFormats, TestSize.Level1)
+{
+    NetLinkInfo linkInfo = MakeLinkInfo();
+    Parcel parcel;
+    ASSERT_TRUE(linkInfo.Marshalling(parcel));
+    SetNetLegacyWireFormat(true);
+    ASSERT_TRUE(linkInfo.Marshalling(parcel));
+    SetNetLegacyWireFormat(false);
+
+    // The reader tells the formats apart on its own
+    sptr<NetLinkInfo> flat = NetLinkInfo::Unmarshalling(parcel);
+    ASSERT_NE(flat, nullptr);
+    ExpectSameLinkInfo(linkInfo, *flat);
+    sptr<NetLinkInfo> legacy = NetLinkInfo::Unmarshalling(parcel);
+    ASSERT_NE(legacy, nullptr);
+    ExpectSameLinkInfo(linkInfo, *legacy);
+}
+
+HWTEST_F(NetFlatBufferTest, OversizedLinkInfoFallsBackToLegacy, TestSize.Level1)
+{
+    NetLinkInfo linkInfo = MakeLinkInfo();
+    Route route = linkInfo.routeList_.front();
+    for (uint32_t i = 1; i < LARGE_ROUTE_NUM; i++) {
+        linkInfo.routeList_.push_back(route);
+    }
+    Parcel parcel;
+    ASSERT_TRUE(linkInfo.Marshalling(parcel));
+
+    int32_t lead = 0;
+    ASSERT_TRUE(parcel.ReadInt32(lead));
+    EXPECT_NE(lead, NET_FLAT_MAGIC);
+    parcel.RewindRead(0);
+    sptr<NetLinkInfo> legacy = NetLinkInfo::Unmarshalling(parcel);
+    ASSERT_NE(legacy, nullptr);
+    EXPECT_EQ(legacy->routeList_.size(), LARGE_ROUTE_NUM);
+    ExpectSameLinkInfo(linkInfo, *legacy);
+}
+
+HWTEST_F(NetFlatBufferTest, TruncatedBufferIsRejected, TestSize.Level1)
+{
+    NetFlatWriter writer;
+    writer.PutUint8(NET_FLAT_VERSION);
+    writer.PutString("wlan0");
+    Parcel parcel;
+    ASSERT_TRUE(writer.WriteTo(parcel));
+    EXPECT_EQ(NetLinkInfo::Unmarshalling(parcel), nullptr);
+}
+
+HWTEST_F(NetFlatBufferTest, CapabilitiesGoAsMasks, TestSize.Level1)
+{
+    NetAllCapabilities netAllCap;
+    netAllCap.linkUpBandwidthKbps_ = 100;
+    netAllCap.linkDownBandwidthKbps_ = 200;
+    netAllCap.netCaps_ = {NET_CAPABILITY_MMS, NET_CAPABILITY_INTERNET, NET_CAPABILITY_VALIDATED};
+    netAllCap.bearerTypes_ = {BEARER_CELLULAR, BEARER_WIFI_AWARE};
+    Parcel parcel;
+    ASSERT_TRUE(netAllCap.Marshalling(parcel));
+    SetNetLegacyWireFormat(true);
+    ASSERT_TRUE(netAllCap.Marshalling(parcel));
+
+    NetAllCapabilities flat;
+    ASSERT_TRUE(flat.Unmarshalling(parcel));
+    NetAllCapabilities legacy;
+    ASSERT_TRUE(legacy.Unmarshalling(parcel));
+    for (const NetAllCapabilities *actual : {&flat, &legacy}) {
+        EXPECT_EQ(actual->linkUpBandwidthKbps_, netAllCap.linkUpBandwidthKbps_);
+        EXPECT_EQ(actual->linkDownBandwidthKbps_, netAllCap.linkDownBandwidthKbps_);
+        EXPECT_EQ(actual->netCaps_, netAllCap.netCaps_);
+        EXPECT_EQ(actual->bearerTypes_, netAllCap.bearerTypes_);
+    }
+}
+
+HWTEST_F(NetFlatBufferTest, UnknownCapabilityReachesReceiver, TestSize.Level1)
+{
+    NetAllCapabilities netAllCap;
+    netAllCap.netCaps_ = {NET_CAPABILITY_INTERNET, static_cast<NetCap>(NET_CAPABILITY_INTERNAL_DEFAULT + 1)};
+    netAllCap.bearerTypes_ = {static_cast<NetBearType>(BEARER_DEFAULT)};
+    Parcel parcel;
+    ASSERT_TRUE(netAllCap.Marshalling(parcel));
+    SetNetLegacyWireFormat(true);
+    ASSERT_TRUE(netAllCap.Marshalling(parcel));
+
+    // Neither format may turn the request into one without requirements
+    for (int32_t i = 0; i < 2; i++) {
+        NetAllCapabilities actual;
+        ASSERT_TRUE(actual.Unmarshalling(parcel));
+        EXPECT_EQ(actual.netCaps_, netAllCap.netCaps_);
+        EXPECT_EQ(actual.bearerTypes_, netAllCap.bearerTypes_);
+        EXPECT_FALSE(actual.CapsIsValid());
+    }
+}
+
+HWTEST_F(NetFlatBufferTest, EqualityCoversEveryField, TestSize.Level1)
+{
+    NetLinkInfo linkInfo = MakeLinkInfo();
+    EXPECT_TRUE(linkInfo == MakeLinkInfo());
+    linkInfo.dnsList_.pop_back();
+    EXPECT_FALSE(linkInfo == MakeLinkInfo());
+    linkInfo = MakeLinkInfo();
+    linkInfo.mtu_ = 0;
+    EXPECT_FALSE(linkInfo == MakeLinkInfo());
+
+    NetAllCapabilities netAllCap;
+    netAllCap.netCaps_ = {NET_CAPABILITY_INTERNET};
+    NetAllCapabilities other = netAllCap;
+    EXPECT_TRUE(netAllCap == other);
+    other.linkDownBandwidthKbps_ = 100;
+    EXPECT_FALSE(netAllCap == other);
+    other = netAllCap;
+    other.bearerTypes_ = {BEARER_WIFI};
+    EXPECT_FALSE(netAllCap == other);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <arpa/inet.h>
+#include <future>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "net_monitor.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+using namespace testing::ext;
+namespace {
+constexpr int32_t WAIT_RESULT_TIMEOUT_S = 10;
+constexpr int32_t REQUEST_BUFFER_SIZE = 1024;
+constexpr int64_t PROBE_TRANSFER_TIMEOUT_MS = 2000;
+const std::string RESPONSE_NO_CONTENT = "HTTP/1.1 204 No Content\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+const std::string RESPONSE_LOGIN_PAGE = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+
+std::string MakePortalResponse(const std::string &loginUrl)
+{
+    return "HTTP/1.1 302 Found\r\nLocation: " + loginUrl + "?id=1\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+}
+
+/**
+ * Local stand-in for the probe servers, answers every request on 127.0.0.1 with a canned response.
+ * An empty response makes it accept connections and never answer.
+ */
+class LocalHttpServer {
+public:
+    explicit LocalHttpServer(const std::string &response) : response_(response)
+    {
+        listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        socklen_t len = sizeof(addr);
+        if (bind(listenFd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 || listen(listenFd_, 1) != 0 ||
+            getsockname(listenFd_, reinterpret_cast<sockaddr *>(&addr), &len) != 0) {
+            return;
+        }
+        port_ = ntohs(addr.sin_port);
+        thread_ = std::thread([this]() { Serve(); });
+    }
+
+    ~LocalHttpServer()
+    {
+        shutdown(listenFd_, SHUT_RDWR);
+        close(listenFd_);
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        for (int32_t fd : silentFds_) {
+            close(fd);
+        }
+    }
+
+    std::string Url(const std::string &path = "/generate_204") const
+    {
+        return "http://127.0.0.1:" + std::to_string(port_) + path;
+    }
+
+private:
+    void Serve()
+    {
+        for (;;) {
+            int32_t fd = accept(listenFd_, nullptr, nullptr);
+            if (fd < 0) {
+                return;
+            }
+            if (response_.empty()) {
+                silentFds_.push_back(fd);
+                continue;
+            }
+            char buffer[REQUEST_BUFFER_SIZE] = {0};
+            read(fd, buffer, sizeof(buffer));
+            write(fd, response_.c_str(), response_.size());
+            close(fd);
+        }
+    }
+
+    std::string response_;
+    int32_t listenFd_ = -1;
+    uint16_t port_ = 0;
+    std::thread thread_;
+    std::vector<int32_t> silentFds_;
+};
+
+NetDetectionStatus RunOneRound(const std::vector<std::string> &probeUrls, std::string &urlRedirect)
+{
+    std::promise<std::pair<NetDetectionStatus, std::string>> result;
+    std::atomic<bool> reported(false);
+    auto monitor = std::make_shared<NetMonitor>(
+        [&result, &reported](NetDetectionStatus status, const std::string &url) {
+            if (!reported.exchange(true)) {
+                result.set_value({status, url});
+            }
+        },
+        probeUrls);
+    monitor->Start("");
+    auto future = result.get_future();
+    bool ready = future.wait_for(std::chrono::seconds(WAIT_RESULT_TIMEOUT_S)) == std::future_status::ready;
+    monitor->Stop();
+    if (!ready) {
+        return INVALID_DETECTION_STATE;
+    }
+    auto value = future.get();
+    urlRedirect = value.second;
+    return value.first;
+}
+} // namespace
+
+class NetMonitorTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+HWTEST_F(NetMonitorTest, ValidatedByNoContent, TestSize.Level1)
+{
+    LocalHttpServer server(RESPONSE_NO_CONTENT);
+    std::string urlRedirect;
+    EXPECT_EQ(RunOneRound({server.Url()}, urlRedirect), VERIFICATION_STATE);
+}
+
+HWTEST_F(NetMonitorTest, PortalByRedirect, TestSize.Level1)
+{
+    LocalHttpServer loginServer(RESPONSE_LOGIN_PAGE);
+    LocalHttpServer server(MakePortalResponse(loginServer.Url("/login")));
+    std::string urlRedirect;
+    EXPECT_EQ(RunOneRound({server.Url()}, urlRedirect), CAPTIVE_PORTAL_STATE);
+    EXPECT_EQ(urlRedirect, loginServer.Url("/login"));
+}
+
+HWTEST_F(NetMonitorTest, ConclusiveProbeWins, TestSize.Level1)
+{
+    LocalHttpServer server(RESPONSE_NO_CONTENT);
+    std::string urlRedirect;
+    // The first probe is refused, the round still concludes from the second one.
+    EXPECT_EQ(RunOneRound({"http://127.0.0.1:1/generate_204", server.Url()}, urlRedirect), VERIFICATION_STATE);
+}
+
+HWTEST_F(NetMonitorTest, SlowProbeCancelled, TestSize.Level1)
+{
+    LocalHttpServer silentServer("");
+    LocalHttpServer server(RESPONSE_NO_CONTENT);
+    std::string urlRedirect;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(RunOneRound({silentServer.Url(), server.Url()}, urlRedirect), VERIFICATION_STATE);
+    auto elapsedMs =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_LT(elapsedMs, PROBE_TRANSFER_TIMEOUT_MS);
+}
+
+HWTEST_F(NetMonitorTest, HandlerRunsWithoutMonitorLock, TestSize.Level1)
+{
+    LocalHttpServer server(RESPONSE_NO_CONTENT);
+    std::promise<NetDetectionStatus> result;
+    std::atomic<bool> reported(false);
+    std::weak_ptr<NetMonitor> weakMonitor;
+    auto monitor = std::make_shared<NetMonitor>(
+        [&result, &reported, &weakMonitor](NetDetectionStatus status, const std::string &url) {
+            // Calling back into the monitor deadlocks if the handler runs under its lock.
+            std::shared_ptr<NetMonitor> self = weakMonitor.lock();
+            if (self != nullptr) {
+                self->SetQualityHandler(nullptr);
+            }
+            if (!reported.exchange(true)) {
+                result.set_value(status);
+            }
+        },
+        std::vector<std::string> {server.Url()});
+    weakMonitor = monitor;
+    monitor->Start("");
+    auto future = result.get_future();
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(WAIT_RESULT_TIMEOUT_S)), std::future_status::ready);
+    monitor->Stop();
+    EXPECT_EQ(future.get(), VERIFICATION_STATE);
+}
+
+HWTEST_F(NetMonitorTest, AllProbesFail, TestSize.Level1)
+{
+    std::string urlRedirect;
+    EXPECT_EQ(RunOneRound({"http://127.0.0.1:1/generate_204"}, urlRedirect), INVALID_DETECTION_STATE);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <map>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "net_probe_engine.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+using namespace testing::ext;
+namespace {
+constexpr int32_t POLL_INTERVAL_MS = 50;
+constexpr int32_t PROBE_WAIT_MS = 5000;
+constexpr int64_t PROBE_TIMEOUT_MS = 3000;
+constexpr size_t READ_BUFFER_SIZE = 1024;
+constexpr size_t PARTIAL_BODY_SIZE = 16 * 1024;
+const std::string NO_CONTENT_RESPONSE = "HTTP/1.1 204 No Content\r\nContent-Length: 0\r\n\r\n";
+const std::string LARGE_BODY_RESPONSE = "HTTP/1.1 200 OK\r\nContent-Length: 1048576\r\n\r\n";
+
+/**
+ * Answers every request on 127.0.0.1 with a fixed response and keeps the connections open. With partialBody it
+ * sends only the start of the announced body, a client waiting for the rest hangs until its timeout.
+ */
+class LocalHttpServer {
+public:
+    LocalHttpServer(const std::string &response, bool partialBody) : response_(response)
+    {
+        if (partialBody) {
+            response_.append(PARTIAL_BODY_SIZE, 'x');
+        }
+        listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t len = sizeof(addr);
+        if (listenFd_ < 0 || bind(listenFd_, reinterpret_cast<sockaddr *>(&addr), len) != 0 ||
+            listen(listenFd_, SOMAXCONN) != 0 || getsockname(listenFd_, reinterpret_cast<sockaddr *>(&addr), &len)) {
+            return;
+        }
+        port_ = ntohs(addr.sin_port);
+        thread_ = std::thread([this]() { Run(); });
+    }
+
+    ~LocalHttpServer()
+    {
+        exit_ = true;
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        for (auto &client : clients_) {
+            close(client.first);
+        }
+        if (listenFd_ >= 0) {
+            close(listenFd_);
+        }
+    }
+
+    std::string GetUrl() const
+    {
+        return "http://127.0.0.1:" + std::to_string(port_) + "/generate_204";
+    }
+
+    uint16_t GetPort() const
+    {
+        return port_;
+    }
+
+    int32_t GetAcceptCount() const
+    {
+        return acceptCount_;
+    }
+
+private:
+    void Run()
+    {
+        while (!exit_) {
+            std::vector<pollfd> fds = {{listenFd_, POLLIN, 0}};
+            for (auto &client : clients_) {
+                fds.push_back({client.first, POLLIN, 0});
+            }
+            if (poll(fds.data(), fds.size(), POLL_INTERVAL_MS) <= 0) {
+                continue;
+            }
+            if (fds[0].revents & POLLIN) {
+                int32_t fd = accept(listenFd_, nullptr, nullptr);
+                if (fd >= 0) {
+                    clients_[fd].clear();
+                    acceptCount_++;
+                }
+            }
+            for (size_t i = 1; i < fds.size(); i++) {
+                if (fds[i].revents != 0) {
+                    ReadRequest(fds[i].fd);
+                }
+            }
+        }
+    }
+
+    void ReadRequest(int32_t fd)
+    {
+        char buffer[READ_BUFFER_SIZE];
+        ssize_t len = read(fd, buffer, sizeof(buffer));
+        if (len <= 0) {
+            close(fd);
+            clients_.erase(fd);
+            return;
+        }
+        std::string &request = clients_[fd];
+        request.append(buffer, len);
+        if (request.find("\r\n\r\n") != std::string::npos) {
+            request.clear();
+            send(fd, response_.data(), response_.size(), MSG_NOSIGNAL);
+        }
+    }
+
+private:
+    std::string response_;
+    int32_t listenFd_ = -1;
+    uint16_t port_ = 0;
+    std::thread thread_;
+    std::atomic<bool> exit_ = false;
+    std::atomic<int32_t> acceptCount_ = 0;
+    // Owned by thread_
+    std::map<int32_t, std::string> clients_;
+};
+
+std::future<NetProbeResult> StartProbe(const std::string &url, uint64_t &probeId)
+{
+    NetProbeRequest request;
+    request.url = url;
+    request.timeoutMs = PROBE_TIMEOUT_MS;
+    auto promise = std::make_shared<std::promise<NetProbeResult>>();
+    std::future<NetProbeResult> future = promise->get_future();
+    probeId = NetProbeEngine::GetInstance().StartProbe(request, [promise](const NetProbeResult &result) {
+        promise->set_value(result);
+    });
+    return future;
+}
+
+bool WaitProbe(std::future<NetProbeResult> &future, NetProbeResult &result)
+{
+    if (future.wait_for(std::chrono::milliseconds(PROBE_WAIT_MS)) != std::future_status::ready) {
+        return false;
+    }
+    result = future.get();
+    return true;
+}
+
+bool RunProbe(const std::string &url, NetProbeResult &result)
+{
+    uint64_t probeId = 0;
+    std::future<NetProbeResult> future = StartProbe(url, probeId);
+    return probeId != 0 && WaitProbe(future, result);
+}
+} // namespace
+
+class NetProbeEngineTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+HWTEST_F(NetProbeEngineTest, EveryProbeOpensAFreshConnection, TestSize.Level1)
+{
+    LocalHttpServer server(NO_CONTENT_RESPONSE, false);
+    ASSERT_NE(server.GetPort(), 0);
+    NetProbeResult first;
+    ASSERT_TRUE(RunProbe(server.GetUrl(), first));
+    EXPECT_EQ(first.errCode, 0);
+    EXPECT_NE(first.header.find("204"), std::string::npos);
+
+    // The server keeps the connection alive, the second probe still must not reuse it.
+    NetProbeResult second;
+    ASSERT_TRUE(RunProbe(server.GetUrl(), second));
+    EXPECT_EQ(second.errCode, 0);
+    EXPECT_EQ(server.GetAcceptCount(), 2);
+}
+
+HWTEST_F(NetProbeEngineTest, ProbeStopsAfterHeaders, TestSize.Level1)
+{
+    LocalHttpServer server(LARGE_BODY_RESPONSE, true);
+    ASSERT_NE(server.GetPort(), 0);
+    auto start = std::chrono::steady_clock::now();
+    NetProbeResult result;
+    ASSERT_TRUE(RunProbe(server.GetUrl(), result));
+
+    // Waiting for the rest of the body would end in a timeout instead.
+    EXPECT_EQ(result.errCode, 0);
+    EXPECT_NE(result.header.find("200 OK"), std::string::npos);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(PROBE_TIMEOUT_MS));
+}
+
+HWTEST_F(NetProbeEngineTest, ReleasedInterfaceKeepsRunningProbes, TestSize.Level1)
+{
+    LocalHttpServer server(LARGE_BODY_RESPONSE, true);
+    ASSERT_NE(server.GetPort(), 0);
+    uint64_t probeId = 0;
+    std::future<NetProbeResult> future = StartProbe(server.GetUrl(), probeId);
+    ASSERT_NE(probeId, 0u);
+
+    // The probe still holds the caches of the interface, the next probe gets new ones
+    NetProbeEngine::GetInstance().ReleaseInterface("");
+    NetProbeResult result;
+    ASSERT_TRUE(WaitProbe(future, result));
+    EXPECT_EQ(result.errCode, 0);
+    NetProbeResult next;
+    ASSERT_TRUE(RunProbe(server.GetUrl(), next));
+    EXPECT_EQ(next.errCode, 0);
+    EXPECT_EQ(server.GetAcceptCount(), 2);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
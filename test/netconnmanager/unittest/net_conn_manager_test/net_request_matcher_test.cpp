@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "net_request_matcher.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+using namespace testing::ext;
+namespace {
+constexpr int32_t LOW_SCORE = 30;
+constexpr int32_t HIGH_SCORE = 60;
+
+sptr<NetActivate> MakeRequest(const std::set<NetCap> &caps, const std::set<NetBearType> &types)
+{
+    sptr<NetSpecifier> specifier = (std::make_unique<NetSpecifier>()).release();
+    specifier->SetCapabilities(caps);
+    specifier->SetTypes(types);
+    return (std::make_unique<NetActivate>(specifier, nullptr, nullptr, 0)).release();
+}
+
+sptr<NetSupplier> MakeConnectedSupplier(NetBearType bearerType, int32_t score)
+{
+    std::set<NetCap> netCaps {NET_CAPABILITY_INTERNET};
+    sptr<NetSupplier> supplier = (std::make_unique<NetSupplier>(bearerType, "ident", netCaps)).release();
+    supplier->UpdateNetConnState(NET_CONN_STATE_CONNECTED);
+    supplier->SetRealScore(score);
+    return supplier;
+}
+} // namespace
+
+class NetRequestMatcherTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+HWTEST_F(NetRequestMatcherTest, BestSupplierFollowsScore, TestSize.Level1)
+{
+    NetRequestMatcher matcher;
+    sptr<NetActivate> request = MakeRequest({NET_CAPABILITY_INTERNET}, {});
+    matcher.AddRequest(request);
+
+    std::vector<uint32_t> affected;
+    sptr<NetSupplier> cellular = MakeConnectedSupplier(BEARER_CELLULAR, HIGH_SCORE);
+    matcher.UpdateSupplier(cellular, affected);
+    ASSERT_EQ(affected.size(), 1u);
+
+    int32_t bestScore = 0;
+    ASSERT_EQ(matcher.GetBestSupplier(request->GetRequestId(), bestScore), cellular);
+    ASSERT_EQ(bestScore, HIGH_SCORE);
+
+    // A lower scored supplier does not change the result, so nothing has to be re-evaluated.
+    affected.clear();
+    sptr<NetSupplier> wifi = MakeConnectedSupplier(BEARER_WIFI, LOW_SCORE);
+    matcher.UpdateSupplier(wifi, affected);
+    ASSERT_TRUE(affected.empty());
+
+    affected.clear();
+    wifi->SetRealScore(HIGH_SCORE + 1);
+    matcher.UpdateSupplier(wifi, affected);
+    ASSERT_EQ(affected.size(), 1u);
+    ASSERT_EQ(matcher.GetBestSupplier(request->GetRequestId(), bestScore), wifi);
+
+    affected.clear();
+    matcher.RemoveSupplier(wifi->GetSupplierId(), affected);
+    ASSERT_EQ(affected.size(), 1u);
+    ASSERT_EQ(matcher.GetBestSupplier(request->GetRequestId(), bestScore), cellular);
+}
+
+HWTEST_F(NetRequestMatcherTest, OnlyMatchingClassesAreAffected, TestSize.Level1)
+{
+    NetRequestMatcher matcher;
+    sptr<NetActivate> wifiRequest = MakeRequest({NET_CAPABILITY_INTERNET}, {BEARER_WIFI});
+    sptr<NetActivate> cellularRequest = MakeRequest({NET_CAPABILITY_INTERNET}, {BEARER_CELLULAR});
+    matcher.AddRequest(wifiRequest);
+    matcher.AddRequest(cellularRequest);
+
+    std::vector<uint32_t> affected;
+    sptr<NetSupplier> wifi = MakeConnectedSupplier(BEARER_WIFI, HIGH_SCORE);
+    matcher.UpdateSupplier(wifi, affected);
+    ASSERT_EQ(affected.size(), 1u);
+    ASSERT_EQ(affected[0], wifiRequest->GetRequestId());
+
+    int32_t bestScore = 0;
+    ASSERT_EQ(matcher.GetBestSupplier(cellularRequest->GetRequestId(), bestScore), nullptr);
+    std::vector<uint32_t> reqIds;
+    matcher.GetMatchedRequests(wifi->GetSupplierId(), reqIds);
+    ASSERT_EQ(reqIds.size(), 1u);
+
+    matcher.RemoveRequest(wifiRequest->GetRequestId());
+    ASSERT_EQ(matcher.GetBestSupplier(wifiRequest->GetRequestId(), bestScore), nullptr);
+}
+
+HWTEST_F(NetRequestMatcherTest, HolderThatStopsMatchingReleasesRequest, TestSize.Level1)
+{
+    NetRequestMatcher matcher;
+    sptr<NetActivate> request = MakeRequest({NET_CAPABILITY_INTERNET}, {});
+    request->GetNetSpecifier()->netCapabilities_.linkUpBandwidthKbps_ = HIGH_SCORE;
+    matcher.AddRequest(request);
+    uint32_t reqId = request->GetRequestId();
+
+    std::vector<uint32_t> affected;
+    std::set<NetCap> netCaps {NET_CAPABILITY_INTERNET};
+    sptr<NetSupplier> wifi = (std::make_unique<NetSupplier>(BEARER_WIFI, "ident", netCaps)).release();
+    NetSupplierInfo info;
+    info.linkUpBandwidthKbps_ = HIGH_SCORE;
+    wifi->UpdateNetSupplierInfo(info);
+    matcher.UpdateSupplier(wifi, affected);
+    wifi->RequestToConnect(reqId);
+    matcher.AddHolder(reqId, wifi->GetSupplierId());
+    ASSERT_TRUE(wifi->HasRequest(reqId));
+
+    // The supplier is still connecting, so no best supplier changes, yet it has to let go of the request.
+    affected.clear();
+    info.linkUpBandwidthKbps_ = LOW_SCORE;
+    wifi->UpdateNetSupplierInfo(info);
+    matcher.UpdateSupplier(wifi, affected);
+    ASSERT_EQ(affected.size(), 1u);
+
+    std::vector<sptr<NetSupplier>> matched;
+    std::vector<sptr<NetSupplier>> unmatched;
+    matcher.GetHolders(reqId, matched, unmatched);
+    ASSERT_TRUE(matched.empty());
+    ASSERT_EQ(unmatched.size(), 1u);
+    ASSERT_EQ(unmatched[0], wifi);
+    unmatched[0]->CancelRequest(reqId);
+    matcher.RemoveHolder(reqId, wifi->GetSupplierId());
+    EXPECT_FALSE(wifi->HasRequest(reqId));
+
+    unmatched.clear();
+    matcher.GetHolders(reqId, matched, unmatched);
+    EXPECT_TRUE(unmatched.empty());
+}
+
+HWTEST_F(NetRequestMatcherTest, OnlyHoldersAreCancelled, TestSize.Level1)
+{
+    NetRequestMatcher matcher;
+    sptr<NetActivate> request = MakeRequest({NET_CAPABILITY_INTERNET}, {});
+    matcher.AddRequest(request);
+    uint32_t reqId = request->GetRequestId();
+
+    std::vector<uint32_t> affected;
+    sptr<NetSupplier> wifi = MakeConnectedSupplier(BEARER_WIFI, HIGH_SCORE);
+    sptr<NetSupplier> cellular = MakeConnectedSupplier(BEARER_CELLULAR, LOW_SCORE);
+    matcher.UpdateSupplier(wifi, affected);
+    matcher.UpdateSupplier(cellular, affected);
+    matcher.AddHolder(reqId, wifi->GetSupplierId());
+
+    // Both suppliers match, only the one the request was sent to holds it
+    std::vector<sptr<NetSupplier>> holders;
+    matcher.GetHolders(reqId, holders, holders);
+    ASSERT_EQ(holders.size(), 1u);
+    EXPECT_EQ(holders[0], wifi);
+
+    holders.clear();
+    matcher.RemoveSupplier(wifi->GetSupplierId(), affected);
+    matcher.GetHolders(reqId, holders, holders);
+    EXPECT_TRUE(holders.empty());
+
+    matcher.AddHolder(reqId, cellular->GetSupplierId());
+    matcher.RemoveRequest(reqId);
+    matcher.GetHolders(reqId, holders, holders);
+    EXPECT_TRUE(holders.empty());
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
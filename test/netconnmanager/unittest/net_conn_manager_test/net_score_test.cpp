@@ -13,16 +13,62 @@
  * limitations under the License.
  */
 
+#include "net_request_matcher.h"
 #include "net_score.h"
 
 #include "net_mgr_log_wrapper.h"
 #include "net_conn_types.h"
 
+#include <cstdio>
+#include <fstream>
 #include <gtest/gtest.h>
 
 namespace OHOS {
 namespace NetManagerStandard {
 using namespace testing::ext;
+namespace {
+constexpr int64_t FAST_LATENCY_MS = 30;
+constexpr int64_t SLOW_LATENCY_MS = 900;
+constexpr int64_t REFERENCE_LATENCY_FOR_TEST = 300;
+constexpr int64_t JITTER_LATENCY_MS = 500;
+constexpr int32_t SAMPLE_ROUNDS = 10;
+constexpr uint32_t FAST_BANDWIDTH_KBPS = 1000000;
+constexpr const char *WEIGHTS_FILE = "/data/net_score_weights_test.conf";
+
+sptr<NetSupplier> MakeSupplier(NetBearType bearerType, const std::string &ident, const std::set<NetCap> &netCaps,
+    bool valid)
+{
+    sptr<NetSupplier> supplier = (std::make_unique<NetSupplier>(bearerType, ident, netCaps)).release();
+    supplier->SetNetValid(valid);
+    return supplier;
+}
+
+// Every quality term at its best
+sptr<NetSupplier> MakeBestQualitySupplier(NetScore &netScore, NetBearType bearerType, bool valid)
+{
+    sptr<NetSupplier> supplier = MakeSupplier(bearerType, "best",
+        {NET_CAPABILITY_INTERNET, NET_CAPABILITY_NOT_METERED}, valid);
+    NetSupplierInfo info;
+    info.isAvailable_ = true;
+    info.linkDownBandwidthKbps_ = FAST_BANDWIDTH_KBPS;
+    supplier->UpdateNetSupplierInfo(info);
+    for (int32_t i = 0; i < SAMPLE_ROUNDS; i++) {
+        netScore.UpdateProbeResult(supplier->GetSupplierId(), true, 0);
+    }
+    return supplier;
+}
+
+// Every quality term at its worst
+sptr<NetSupplier> MakeWorstQualitySupplier(NetScore &netScore, NetBearType bearerType, bool valid)
+{
+    sptr<NetSupplier> supplier = MakeSupplier(bearerType, "worst", {NET_CAPABILITY_INTERNET}, valid);
+    for (int32_t i = 0; i < SAMPLE_ROUNDS; i++) {
+        netScore.UpdateProbeResult(supplier->GetSupplierId(), (i % 2) == 0, SLOW_LATENCY_MS);
+    }
+    return supplier;
+}
+} // namespace
+
 class NetScoreTest : public testing::Test {
 public:
     static void SetUpTestCase();
@@ -73,5 +119,136 @@ HWTEST_F(NetScoreTest, GetServiceScore, TestSize.Level1)
     ASSERT_TRUE(supplier->GetNetScore() == static_cast<int32_t>(NetTypeScoreValue::CELLULAR_VALUE));
     ASSERT_TRUE(supplier->GetRealScore() == static_cast<int32_t>(NetTypeScoreValue::CELLULAR_VALUE));
 }
+
+HWTEST_F(NetScoreTest, SlowNetworkLosesWithinBearer, TestSize.Level1)
+{
+    std::set<NetCap> netCaps {NET_CAPABILITY_INTERNET};
+    sptr<NetSupplier> slow = MakeSupplier(BEARER_CELLULAR, "slow", netCaps, true);
+    sptr<NetSupplier> fast = MakeSupplier(BEARER_CELLULAR, "fast", netCaps, true);
+    for (int32_t i = 0; i < SAMPLE_ROUNDS; i++) {
+        netScore_->UpdateProbeResult(slow->GetSupplierId(), (i % 2) == 0, SLOW_LATENCY_MS);
+        netScore_->UpdateProbeResult(fast->GetSupplierId(), true, FAST_LATENCY_MS);
+    }
+    ASSERT_TRUE(netScore_->GetServiceScore(slow));
+    ASSERT_TRUE(netScore_->GetServiceScore(fast));
+    EXPECT_LT(slow->GetRealScore(), fast->GetRealScore());
+
+    // Without the quality terms both score as their bearer type.
+    netScore_->SetWeights({0, 0, 0, 0, 0});
+    ASSERT_TRUE(netScore_->GetServiceScore(slow));
+    ASSERT_TRUE(netScore_->GetServiceScore(fast));
+    EXPECT_EQ(slow->GetRealScore(), static_cast<int32_t>(NetTypeScoreValue::CELLULAR_VALUE));
+    EXPECT_EQ(fast->GetRealScore(), static_cast<int32_t>(NetTypeScoreValue::CELLULAR_VALUE));
+}
+
+HWTEST_F(NetScoreTest, BestWifiStaysBelowEthernetAndVpn, TestSize.Level1)
+{
+    sptr<NetSupplier> wifi = MakeBestQualitySupplier(*netScore_, BEARER_WIFI, true);
+    sptr<NetSupplier> ethernet = MakeWorstQualitySupplier(*netScore_, BEARER_ETHERNET, true);
+    sptr<NetSupplier> vpn = MakeWorstQualitySupplier(*netScore_, BEARER_VPN, true);
+    ASSERT_TRUE(netScore_->GetServiceScore(wifi));
+    ASSERT_TRUE(netScore_->GetServiceScore(ethernet));
+    ASSERT_TRUE(netScore_->GetServiceScore(vpn));
+    EXPECT_EQ(wifi->GetRealScore(), static_cast<int32_t>(NetTypeScoreValue::WIFI_VALUE) + MAX_QUALITY_BONUS);
+    EXPECT_EQ(ethernet->GetRealScore(),
+        static_cast<int32_t>(NetTypeScoreValue::ETHERNET_VALUE) - MAX_QUALITY_BONUS);
+    EXPECT_LT(wifi->GetRealScore(), ethernet->GetRealScore());
+    EXPECT_EQ(vpn->GetRealScore(), static_cast<int32_t>(NetTypeScoreValue::VPN_VALUE));
+}
+
+HWTEST_F(NetScoreTest, UnvalidatedNeverBeatsValidated, TestSize.Level1)
+{
+    sptr<NetSupplier> wifi = MakeBestQualitySupplier(*netScore_, BEARER_WIFI, false);
+    sptr<NetSupplier> cellular = MakeWorstQualitySupplier(*netScore_, BEARER_CELLULAR, true);
+    sptr<NetSupplier> bluetooth = MakeWorstQualitySupplier(*netScore_, BEARER_BLUETOOTH, false);
+    ASSERT_TRUE(netScore_->GetServiceScore(wifi));
+    ASSERT_TRUE(netScore_->GetServiceScore(cellular));
+    ASSERT_TRUE(netScore_->GetServiceScore(bluetooth));
+    EXPECT_LT(wifi->GetRealScore(), cellular->GetRealScore());
+    EXPECT_GE(bluetooth->GetRealScore(), MIN_NET_SCORE);
+}
+
+HWTEST_F(NetScoreTest, HysteresisHoldsScore, TestSize.Level1)
+{
+    std::set<NetCap> netCaps {NET_CAPABILITY_INTERNET};
+    sptr<NetSupplier> supplier = (std::make_unique<NetSupplier>(BEARER_CELLULAR, "ident", netCaps)).release();
+    supplier->SetNetValid(true);
+    netScore_->UpdateProbeResult(supplier->GetSupplierId(), true, REFERENCE_LATENCY_FOR_TEST);
+    ASSERT_TRUE(netScore_->GetServiceScore(supplier));
+    int32_t score = supplier->GetRealScore();
+
+    // A small latency swing stays inside the dead band.
+    netScore_->UpdateProbeResult(supplier->GetSupplierId(), true, JITTER_LATENCY_MS);
+    ASSERT_TRUE(netScore_->GetServiceScore(supplier));
+    EXPECT_EQ(supplier->GetRealScore(), score);
+
+    // A lasting change moves the score.
+    for (int32_t i = 0; i < SAMPLE_ROUNDS; i++) {
+        netScore_->UpdateProbeResult(supplier->GetSupplierId(), true, SLOW_LATENCY_MS);
+    }
+    ASSERT_TRUE(netScore_->GetServiceScore(supplier));
+    EXPECT_LT(supplier->GetRealScore(), score);
+}
+
+HWTEST_F(NetScoreTest, WeightsDecideBestSupplier, TestSize.Level1)
+{
+    NetRequestMatcher matcher;
+    sptr<NetSpecifier> specifier = (std::make_unique<NetSpecifier>()).release();
+    specifier->SetCapabilities({NET_CAPABILITY_INTERNET});
+    sptr<NetActivate> request = (std::make_unique<NetActivate>(specifier, nullptr, nullptr, 0)).release();
+    matcher.AddRequest(request);
+
+    // Two cellular networks, the slow one is not metered
+    sptr<NetSupplier> slow = MakeSupplier(BEARER_CELLULAR, "slow",
+        {NET_CAPABILITY_INTERNET, NET_CAPABILITY_NOT_METERED}, true);
+    sptr<NetSupplier> fast = MakeSupplier(BEARER_CELLULAR, "fast", {NET_CAPABILITY_INTERNET}, true);
+    for (sptr<NetSupplier> supplier : {slow, fast}) {
+        supplier->UpdateNetConnState(NET_CONN_STATE_CONNECTED);
+    }
+    for (int32_t i = 0; i < SAMPLE_ROUNDS; i++) {
+        netScore_->UpdateProbeResult(slow->GetSupplierId(), (i % 2) == 0, SLOW_LATENCY_MS);
+        netScore_->UpdateProbeResult(fast->GetSupplierId(), true, FAST_LATENCY_MS);
+    }
+    auto rescore = [this, &matcher, &slow, &fast]() {
+        std::vector<uint32_t> affected;
+        for (sptr<NetSupplier> supplier : {slow, fast}) {
+            netScore_->GetServiceScore(supplier);
+            matcher.UpdateSupplier(supplier, affected);
+        }
+    };
+    int32_t bestScore = 0;
+    rescore();
+    EXPECT_EQ(matcher.GetBestSupplier(request->GetRequestId(), bestScore), fast);
+
+    // Once only the metered state counts the unmetered network is selected
+    netScore_->SetWeights({0, 0, 0, NetScoreWeights().unmetered, 0});
+    rescore();
+    EXPECT_EQ(matcher.GetBestSupplier(request->GetRequestId(), bestScore), slow);
+}
+
+HWTEST_F(NetScoreTest, LoadWeightsFromFile, TestSize.Level1)
+{
+    NetScoreWeights defaults;
+    EXPECT_FALSE(netScore_->LoadWeights(WEIGHTS_FILE));
+    EXPECT_EQ(netScore_->GetWeights().latency, defaults.latency);
+
+    std::ofstream file(WEIGHTS_FILE);
+    file << "# product tuning\n"
+         << "latency = 20\n"
+         << "unmetered=0 # metered state does not count\n"
+         << "bandwidth=-1\n"
+         << "stability=abc\n"
+         << "unknown=1\n";
+    file.close();
+    EXPECT_TRUE(netScore_->LoadWeights(WEIGHTS_FILE));
+    std::remove(WEIGHTS_FILE);
+
+    NetScoreWeights weights = netScore_->GetWeights();
+    EXPECT_EQ(weights.latency, 20);
+    EXPECT_EQ(weights.unmetered, 0);
+    EXPECT_EQ(weights.bandwidth, defaults.bandwidth);
+    EXPECT_EQ(weights.stability, defaults.stability);
+    EXPECT_EQ(weights.hysteresis, defaults.hysteresis);
+}
 } // namespace NetManagerStandard
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "net_timer_wheel.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+using namespace testing::ext;
+namespace {
+constexpr uint32_t TEST_TICK_MS = 1;
+constexpr uint32_t SHORT_DELAY_MS = 5;
+constexpr uint32_t MIDDLE_DELAY_MS = 70;
+// Beyond the lowest two levels at a 1ms tick, so the timer is cascaded twice before it fires
+constexpr uint32_t LONG_DELAY_MS = 4200;
+constexpr uint32_t WAIT_MARGIN_MS = 1000;
+constexpr uint32_t BASE_INTERVAL_MS = 1000;
+constexpr uint32_t MAX_INTERVAL_MS = 8000;
+constexpr uint32_t JITTER_PERCENT = 10;
+constexpr int32_t JITTER_ROUNDS = 100;
+// Longer than the wheel reaches at a 1ms tick, about 4.66h
+constexpr int64_t IDLE_MS = 47LL * 3600 * 1000;
+constexpr uint32_t BEYOND_REACH_MS = 20000000;
+constexpr uint32_t PAST_TOP_LEVEL_MS = 17000000;
+
+// Time only moves when the test says so
+class ManualClock {
+public:
+    std::chrono::steady_clock::time_point Now() const
+    {
+        return base_ + std::chrono::milliseconds(offsetMs_.load());
+    }
+
+    void Advance(int64_t ms)
+    {
+        offsetMs_ += ms;
+    }
+
+private:
+    std::chrono::steady_clock::time_point base_ = std::chrono::steady_clock::now();
+    std::atomic<int64_t> offsetMs_ = 0;
+};
+
+// Returns once the wheel has processed every tick up to now, anything due by then has fired before
+bool WaitCaughtUp(NetTimerWheel &wheel)
+{
+    std::promise<void> marker;
+    wheel.Schedule(0, [&marker]() { marker.set_value(); });
+    return marker.get_future().wait_for(std::chrono::milliseconds(WAIT_MARGIN_MS)) == std::future_status::ready;
+}
+} // namespace
+
+class NetTimerWheelTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+HWTEST_F(NetTimerWheelTest, FiresInDeadlineOrder, TestSize.Level1)
+{
+    NetTimerWheel wheel(TEST_TICK_MS);
+    std::mutex mutex;
+    std::vector<uint32_t> fired;
+    std::promise<void> done;
+    auto record = [&mutex, &fired, &done](uint32_t delayMs) {
+        std::lock_guard<std::mutex> lock(mutex);
+        fired.push_back(delayMs);
+        if (delayMs == LONG_DELAY_MS) {
+            done.set_value();
+        }
+    };
+    auto start = std::chrono::steady_clock::now();
+    wheel.Schedule(LONG_DELAY_MS, [&record]() { record(LONG_DELAY_MS); });
+    wheel.Schedule(MIDDLE_DELAY_MS, [&record]() { record(MIDDLE_DELAY_MS); });
+    wheel.Schedule(SHORT_DELAY_MS, [&record]() { record(SHORT_DELAY_MS); });
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::milliseconds(LONG_DELAY_MS + WAIT_MARGIN_MS)),
+        std::future_status::ready);
+    auto elapsedMs =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_GE(elapsedMs, LONG_DELAY_MS);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<uint32_t> expected = {SHORT_DELAY_MS, MIDDLE_DELAY_MS, LONG_DELAY_MS};
+    EXPECT_EQ(fired, expected);
+}
+
+HWTEST_F(NetTimerWheelTest, CancelPreventsCallback, TestSize.Level1)
+{
+    NetTimerWheel wheel(TEST_TICK_MS);
+    std::atomic<bool> cancelledFired(false);
+    std::promise<void> done;
+    uint64_t timerId = wheel.Schedule(SHORT_DELAY_MS, [&cancelledFired]() { cancelledFired = true; });
+    EXPECT_TRUE(wheel.Cancel(timerId));
+    EXPECT_FALSE(wheel.Cancel(timerId));
+    wheel.Schedule(MIDDLE_DELAY_MS, [&done]() { done.set_value(); });
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::milliseconds(MIDDLE_DELAY_MS + WAIT_MARGIN_MS)),
+        std::future_status::ready);
+    EXPECT_FALSE(cancelledFired);
+}
+
+HWTEST_F(NetTimerWheelTest, ScheduleFromCallback, TestSize.Level1)
+{
+    NetTimerWheel wheel(TEST_TICK_MS);
+    std::promise<void> done;
+    wheel.Schedule(SHORT_DELAY_MS, [&wheel, &done]() {
+        wheel.Schedule(SHORT_DELAY_MS, [&done]() { done.set_value(); });
+    });
+    EXPECT_EQ(done.get_future().wait_for(std::chrono::milliseconds(WAIT_MARGIN_MS)), std::future_status::ready);
+}
+
+HWTEST_F(NetTimerWheelTest, IdleWheelJumpsToNow, TestSize.Level1)
+{
+    ManualClock clock;
+    NetTimerWheel wheel(TEST_TICK_MS, [&clock]() { return clock.Now(); });
+    clock.Advance(IDLE_MS);
+    std::promise<void> done;
+    wheel.Schedule(SHORT_DELAY_MS, [&done]() { done.set_value(); });
+    std::future<void> future = done.get_future();
+    EXPECT_EQ(future.wait_for(std::chrono::milliseconds(SHORT_DELAY_MS)), std::future_status::timeout);
+
+    // A wheel still at the tick it went idle on would have to tick through two days first
+    clock.Advance(SHORT_DELAY_MS);
+    EXPECT_EQ(future.wait_for(std::chrono::milliseconds(WAIT_MARGIN_MS)), std::future_status::ready);
+}
+
+HWTEST_F(NetTimerWheelTest, DelayBeyondReachIsNotTruncated, TestSize.Level1)
+{
+    ManualClock clock;
+    NetTimerWheel wheel(TEST_TICK_MS, [&clock]() { return clock.Now(); });
+    std::promise<void> done;
+    wheel.Schedule(BEYOND_REACH_MS, [&done]() { done.set_value(); });
+    std::future<void> future = done.get_future();
+
+    // Past the top level reach, a truncated timer would have fired by now
+    clock.Advance(PAST_TOP_LEVEL_MS);
+    ASSERT_TRUE(WaitCaughtUp(wheel));
+    EXPECT_EQ(future.wait_for(std::chrono::milliseconds(0)), std::future_status::timeout);
+
+    clock.Advance(BEYOND_REACH_MS - PAST_TOP_LEVEL_MS);
+    EXPECT_EQ(future.wait_for(std::chrono::milliseconds(WAIT_MARGIN_MS)), std::future_status::ready);
+}
+
+HWTEST_F(NetTimerWheelTest, BackoffAndJitter, TestSize.Level1)
+{
+    EXPECT_EQ(NetTimerWheel::Backoff(BASE_INTERVAL_MS, 0, MAX_INTERVAL_MS), BASE_INTERVAL_MS);
+    EXPECT_EQ(NetTimerWheel::Backoff(BASE_INTERVAL_MS, 2, MAX_INTERVAL_MS), BASE_INTERVAL_MS * 4);
+    EXPECT_EQ(NetTimerWheel::Backoff(BASE_INTERVAL_MS, 100, MAX_INTERVAL_MS), MAX_INTERVAL_MS);
+    for (int32_t i = 0; i < JITTER_ROUNDS; i++) {
+        uint32_t interval = NetTimerWheel::Jitter(BASE_INTERVAL_MS, JITTER_PERCENT);
+        EXPECT_GE(interval, BASE_INTERVAL_MS * (100 - JITTER_PERCENT) / 100);
+        EXPECT_LE(interval, BASE_INTERVAL_MS * (100 + JITTER_PERCENT) / 100);
+    }
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
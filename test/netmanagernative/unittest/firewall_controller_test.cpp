@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "netsys_native_service_proxy.h"
+#include "iservice_registry.h"
+#include "system_ability_definition.h"
+#include "firewall_controller.h"
+
+namespace OHOS {
+namespace NetsysNative {
+using namespace testing::ext;
+namespace {
+constexpr uint32_t TEST_UID = 20010099;
+constexpr uint32_t OTHER_TEST_UID = 20010100;
+const std::string IPV4_RESTORE = "/system/bin/iptables-restore";
+const std::string IPV6_RESTORE = "/system/bin/ip6tables-restore";
+
+// Records the batches instead of running the tools, the tool at failingPath_ rejects everything
+class RestoreRecorder {
+public:
+    nmd::FirewallController::RestoreRunner GetRunner()
+    {
+        return [this](const char *path, const std::string &batch) {
+            batches_.emplace_back(path, batch);
+            return (failingPath_ == path) ? -1 : 0;
+        };
+    }
+
+    std::vector<std::pair<std::string, std::string>> batches_;
+    std::string failingPath_;
+};
+
+sptr<INetsysService> GetFirewallProxy()
+{
+    auto samgr = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
+    if (samgr == nullptr) {
+        return nullptr;
+    }
+    return iface_cast<INetsysService>(samgr->GetSystemAbility(COMM_NETSYS_NATIVE_SYS_ABILITY_ID));
+}
+} // namespace
+
+class FirewallControllerTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+
+void FirewallControllerTest::SetUpTestCase() {}
+
+void FirewallControllerTest::TearDownTestCase() {}
+
+void FirewallControllerTest::SetUp() {}
+
+void FirewallControllerTest::TearDown() {}
+
+/**
+ * @tc.name: FirewallControllerTest001
+ * @tc.desc: Test a uid joins and leaves the deny all chain, repeated changes are no-ops.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FirewallControllerTest, FirewallControllerTest001, TestSize.Level1)
+{
+    sptr<INetsysService> netsysNativeService = GetFirewallProxy();
+    ASSERT_NE(netsysNativeService, nullptr);
+
+    EXPECT_EQ(netsysNativeService->FirewallSetUidRule(nmd::FIREWALL_CHAIN_DENY_ALL, TEST_UID, true), 0);
+    EXPECT_EQ(netsysNativeService->FirewallSetUidRule(nmd::FIREWALL_CHAIN_DENY_ALL, TEST_UID, true), 0);
+    EXPECT_EQ(netsysNativeService->FirewallSetUids(nmd::FIREWALL_CHAIN_DENY_ALL, {}), 0);
+    EXPECT_EQ(netsysNativeService->FirewallSetUidRule(nmd::FIREWALL_CHAIN_DENY_ALL, TEST_UID, false), 0);
+}
+
+/**
+ * @tc.name: FirewallControllerTest002
+ * @tc.desc: Test unknown chains and malformed interface names are rejected.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FirewallControllerTest, FirewallControllerTest002, TestSize.Level1)
+{
+    sptr<INetsysService> netsysNativeService = GetFirewallProxy();
+    ASSERT_NE(netsysNativeService, nullptr);
+
+    EXPECT_NE(netsysNativeService->FirewallSetUidRule(nmd::FIREWALL_CHAIN_NONE, TEST_UID, true), 0);
+    EXPECT_NE(netsysNativeService->FirewallEnableChain(nmd::FIREWALL_CHAIN_NONE, true), 0);
+    EXPECT_NE(netsysNativeService->FirewallSetChainInterface(nmd::FIREWALL_CHAIN_DENY_METERED, "", true), 0);
+    EXPECT_NE(netsysNativeService->FirewallSetChainInterface(nmd::FIREWALL_CHAIN_DENY_METERED, "-j ACCEPT", true),
+        0);
+}
+
+/**
+ * @tc.name: FirewallControllerTest003
+ * @tc.desc: Test the rules written for each change, both families get the same batch.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FirewallControllerTest, FirewallControllerTest003, TestSize.Level1)
+{
+    RestoreRecorder recorder;
+    nmd::FirewallController controller(recorder.GetRunner());
+    auto expectBatch = [&recorder](const std::string &rules) {
+        ASSERT_EQ(recorder.batches_.size(), 2u);
+        EXPECT_EQ(recorder.batches_[0].first, IPV4_RESTORE);
+        EXPECT_EQ(recorder.batches_[1].first, IPV6_RESTORE);
+        for (const auto &batch : recorder.batches_) {
+            EXPECT_EQ(batch.second, "*filter\n" + rules + "COMMIT\n");
+        }
+        recorder.batches_.clear();
+    };
+
+    EXPECT_EQ(controller.SetUidRule(nmd::FIREWALL_CHAIN_DENY_ALL, TEST_UID, true), 0);
+    expectBatch("-A ohfw_deny_all -m owner --uid-owner 20010099 -j DROP\n");
+    EXPECT_EQ(controller.SetUidRule(nmd::FIREWALL_CHAIN_DENY_ALL, TEST_UID, true), 0);
+    EXPECT_TRUE(recorder.batches_.empty());
+
+    EXPECT_EQ(controller.SetUids(nmd::FIREWALL_CHAIN_DENY_ALL, {OTHER_TEST_UID}), 0);
+    expectBatch("-D ohfw_deny_all -m owner --uid-owner 20010099 -j DROP\n"
+        "-A ohfw_deny_all -m owner --uid-owner 20010100 -j DROP\n");
+
+    EXPECT_EQ(controller.SetUidRule(nmd::FIREWALL_CHAIN_ALLOW_IDLE, TEST_UID, true), 0);
+    expectBatch("-I ohfw_allow_idle 1 -m owner --uid-owner 20010099 -j RETURN\n");
+    EXPECT_EQ(controller.SetUidRule(nmd::FIREWALL_CHAIN_ALLOW_IDLE, TEST_UID, false), 0);
+    expectBatch("-D ohfw_allow_idle -m owner --uid-owner 20010099 -j RETURN\n");
+
+    EXPECT_EQ(controller.SetChainInterface(nmd::FIREWALL_CHAIN_DENY_METERED, "rmnet0", true), 0);
+    expectBatch("-A ohfw_OUTPUT -o rmnet0 -j ohfw_deny_metered\n");
+    EXPECT_EQ(controller.EnableChain(nmd::FIREWALL_CHAIN_ALLOW_IDLE, true), 0);
+    expectBatch("-A ohfw_OUTPUT -j ohfw_allow_idle\n");
+}
+
+/**
+ * @tc.name: FirewallControllerTest004
+ * @tc.desc: Test a family that failed is the only one retried, the other one is not applied twice.
+ * @tc.type: FUNC
+ */
+HWTEST_F(FirewallControllerTest, FirewallControllerTest004, TestSize.Level1)
+{
+    RestoreRecorder recorder;
+    nmd::FirewallController controller(recorder.GetRunner());
+    recorder.failingPath_ = IPV6_RESTORE;
+    EXPECT_NE(controller.SetUidRule(nmd::FIREWALL_CHAIN_DENY_ALL, TEST_UID, true), 0);
+    EXPECT_NE(controller.SetUids(nmd::FIREWALL_CHAIN_DENY_METERED, {TEST_UID, OTHER_TEST_UID}), 0);
+    EXPECT_EQ(recorder.batches_.size(), 4u);
+
+    recorder.failingPath_.clear();
+    recorder.batches_.clear();
+    EXPECT_EQ(controller.SetUidRule(nmd::FIREWALL_CHAIN_DENY_ALL, TEST_UID, true), 0);
+    EXPECT_EQ(controller.SetUids(nmd::FIREWALL_CHAIN_DENY_METERED, {TEST_UID, OTHER_TEST_UID}), 0);
+    ASSERT_EQ(recorder.batches_.size(), 2u);
+    EXPECT_EQ(recorder.batches_[0].first, IPV6_RESTORE);
+    EXPECT_EQ(recorder.batches_[1].first, IPV6_RESTORE);
+
+    recorder.batches_.clear();
+    EXPECT_EQ(controller.SetUidRule(nmd::FIREWALL_CHAIN_DENY_ALL, TEST_UID, true), 0);
+    EXPECT_TRUE(recorder.batches_.empty());
+}
+} // namespace NetsysNative
+} // namespace OHOS
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <ctime>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "net_billing_cycle.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+using namespace testing::ext;
+namespace {
+constexpr int64_t ONE_HOUR = 3600;
+constexpr int64_t ONE_DAY = 86400;
+constexpr int32_t TM_YEAR_BASE = 1900;
+
+int64_t LocalTime(int32_t year, int32_t month, int32_t day, int32_t hour)
+{
+    struct tm local = {};
+    local.tm_year = year - TM_YEAR_BASE;
+    local.tm_mon = month - 1;
+    local.tm_mday = day;
+    local.tm_hour = hour;
+    local.tm_isdst = -1;
+    return static_cast<int64_t>(mktime(&local));
+}
+
+bool GetPeriod(const std::string &periodDuration, int64_t periodStartTime, int64_t now, int64_t &start,
+    int64_t &end)
+{
+    NetBillingCycle cycle;
+    return NetBillingCycle::Parse(periodDuration, periodStartTime, cycle) && cycle.GetPeriod(now, start, end);
+}
+} // namespace
+
+class NetBillingCycleTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() {}
+    void TearDown() {}
+
+private:
+    static std::string oldTimeZone_;
+    static bool hadTimeZone_;
+};
+
+std::string NetBillingCycleTest::oldTimeZone_;
+bool NetBillingCycleTest::hadTimeZone_ = false;
+
+void NetBillingCycleTest::SetUpTestCase()
+{
+    const char *timeZone = getenv("TZ");
+    hadTimeZone_ = timeZone != nullptr;
+    oldTimeZone_ = hadTimeZone_ ? timeZone : "";
+    // A zone with DST, so day lengths of 23 and 25 hours are exercised
+    setenv("TZ", "America/New_York", 1);
+    tzset();
+}
+
+void NetBillingCycleTest::TearDownTestCase()
+{
+    if (hadTimeZone_) {
+        setenv("TZ", oldTimeZone_.c_str(), 1);
+    } else {
+        unsetenv("TZ");
+    }
+    tzset();
+}
+
+HWTEST_F(NetBillingCycleTest, ParseRejectsMalformed, TestSize.Level1)
+{
+    NetBillingCycle cycle;
+    EXPECT_TRUE(NetBillingCycle::Parse("M1", -1, cycle));
+    EXPECT_TRUE(NetBillingCycle::Parse("m31", -1, cycle));
+    EXPECT_TRUE(NetBillingCycle::Parse("W7", -1, cycle));
+    EXPECT_TRUE(NetBillingCycle::Parse("Y12", -1, cycle));
+    EXPECT_TRUE(NetBillingCycle::Parse("D366", 0, cycle));
+    EXPECT_FALSE(NetBillingCycle::Parse("D1", -1, cycle));
+    EXPECT_FALSE(NetBillingCycle::Parse("M", -1, cycle));
+    EXPECT_FALSE(NetBillingCycle::Parse("M0", -1, cycle));
+    EXPECT_FALSE(NetBillingCycle::Parse("M32", -1, cycle));
+    EXPECT_FALSE(NetBillingCycle::Parse("W8", -1, cycle));
+    EXPECT_FALSE(NetBillingCycle::Parse("Y13", -1, cycle));
+    EXPECT_FALSE(NetBillingCycle::Parse("M1x", -1, cycle));
+    EXPECT_FALSE(NetBillingCycle::Parse("Q1", -1, cycle));
+    EXPECT_FALSE(NetBillingCycle::Parse("M0001", -1, cycle));
+}
+
+HWTEST_F(NetBillingCycleTest, MonthClampsAndCrossesYear, TestSize.Level1)
+{
+    int64_t start = 0;
+    int64_t end = 0;
+    ASSERT_TRUE(GetPeriod("M31", -1, LocalTime(2021, 2, 15, 12), start, end));
+    EXPECT_EQ(start, LocalTime(2021, 1, 31, 0));
+    EXPECT_EQ(end, LocalTime(2021, 2, 28, 0));
+
+    ASSERT_TRUE(GetPeriod("M31", -1, LocalTime(2020, 2, 29, 1), start, end));
+    EXPECT_EQ(start, LocalTime(2020, 2, 29, 0));
+    EXPECT_EQ(end, LocalTime(2020, 3, 31, 0));
+
+    ASSERT_TRUE(GetPeriod("M15", -1, LocalTime(2022, 1, 3, 9), start, end));
+    EXPECT_EQ(start, LocalTime(2021, 12, 15, 0));
+    EXPECT_EQ(end, LocalTime(2022, 1, 15, 0));
+}
+
+HWTEST_F(NetBillingCycleTest, DaysStayWholeAcrossDst, TestSize.Level1)
+{
+    int64_t start = 0;
+    int64_t end = 0;
+    // 2021-03-14 lost an hour in New York
+    ASSERT_TRUE(GetPeriod("D1", LocalTime(2021, 1, 1, 8), LocalTime(2021, 3, 14, 12), start, end));
+    EXPECT_EQ(start, LocalTime(2021, 3, 14, 0));
+    EXPECT_EQ(end - start, ONE_DAY - ONE_HOUR);
+
+    ASSERT_TRUE(GetPeriod("W1", -1, LocalTime(2021, 11, 10, 12), start, end));
+    EXPECT_EQ(start, LocalTime(2021, 11, 8, 0));
+    EXPECT_EQ(end, LocalTime(2021, 11, 15, 0));
+
+    // The week of 2021-11-07 gained an hour
+    ASSERT_TRUE(GetPeriod("W7", -1, LocalTime(2021, 11, 7, 12), start, end));
+    EXPECT_EQ(start, LocalTime(2021, 11, 7, 0));
+    EXPECT_EQ(end - start, 7 * ONE_DAY + ONE_HOUR);
+
+    ASSERT_TRUE(GetPeriod("D10", LocalTime(2021, 3, 1, 18), LocalTime(2021, 3, 20, 0), start, end));
+    EXPECT_EQ(start, LocalTime(2021, 3, 11, 0));
+    EXPECT_EQ(end, LocalTime(2021, 3, 21, 0));
+}
+
+HWTEST_F(NetBillingCycleTest, YearUsesAnchorDay, TestSize.Level1)
+{
+    int64_t start = 0;
+    int64_t end = 0;
+    ASSERT_TRUE(GetPeriod("Y2", LocalTime(2020, 7, 29, 10), LocalTime(2021, 2, 1, 0), start, end));
+    EXPECT_EQ(start, LocalTime(2020, 2, 29, 0));
+    EXPECT_EQ(end, LocalTime(2021, 2, 28, 0));
+}
+
+HWTEST_F(NetBillingCycleTest, CacheKeepsPeriodUntilItEnds, TestSize.Level1)
+{
+    NetBillingCycleCache cache;
+    int64_t start = 0;
+    int64_t end = 0;
+    int64_t now = LocalTime(2021, 5, 20, 12);
+    ASSERT_TRUE(cache.GetPeriod("quota_1", "M1", -1, now, start, end));
+    EXPECT_EQ(start, LocalTime(2021, 5, 1, 0));
+
+    int64_t cachedEnd = end;
+    ASSERT_TRUE(cache.GetPeriod("quota_1", "M1", -1, cachedEnd - 1, start, end));
+    EXPECT_EQ(end, cachedEnd);
+    ASSERT_TRUE(cache.GetPeriod("quota_1", "M1", -1, cachedEnd, start, end));
+    EXPECT_EQ(start, cachedEnd);
+
+    ASSERT_TRUE(cache.GetPeriod("quota_1", "M10", -1, now, start, end));
+    EXPECT_EQ(start, LocalTime(2021, 5, 10, 0));
+    EXPECT_FALSE(cache.GetPeriod("quota_1", "X1", -1, now, start, end));
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
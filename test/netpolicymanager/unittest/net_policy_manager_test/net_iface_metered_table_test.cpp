@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "net_iface_metered_table.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+using namespace testing::ext;
+namespace {
+const std::string TEST_IDENT = "usb0";
+const std::string CELLULAR_IFACE = "rmnet0";
+const std::string WIFI_IFACE = "wlan0";
+
+NetPolicyQuotaPolicy MakePolicy(NetBearType bearerType, bool metered)
+{
+    NetPolicyQuotaPolicy quotaPolicy;
+    quotaPolicy.netType_ = static_cast<int8_t>(bearerType);
+    quotaPolicy.metered_ = metered ? 1 : 0;
+    return quotaPolicy;
+}
+} // namespace
+
+class NetIfaceMeteredTableTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+HWTEST_F(NetIfaceMeteredTableTest, JoinsLinksAndPolicies, TestSize.Level1)
+{
+    NetIfaceMeteredTable table(TEST_IDENT);
+    EXPECT_FALSE(table.UpdateLink(BEARER_CELLULAR, TEST_IDENT, CELLULAR_IFACE, true));
+    EXPECT_FALSE(table.IsMetered(CELLULAR_IFACE));
+
+    // The first policy of a bearer decides
+    EXPECT_TRUE(table.UpdatePolicies({MakePolicy(BEARER_CELLULAR, true), MakePolicy(BEARER_CELLULAR, false),
+        MakePolicy(BEARER_WIFI, false)}));
+    EXPECT_TRUE(table.IsMetered(CELLULAR_IFACE));
+    EXPECT_FALSE(table.UpdateLink(BEARER_WIFI, TEST_IDENT, WIFI_IFACE, true));
+    EXPECT_FALSE(table.IsMetered(WIFI_IFACE));
+    EXPECT_EQ(table.GetMeteredIfaces(), std::set<std::string>({CELLULAR_IFACE}));
+
+    std::string ifaceName;
+    ASSERT_TRUE(table.GetIfaceName(BEARER_CELLULAR, ifaceName));
+    EXPECT_EQ(ifaceName, CELLULAR_IFACE);
+
+    EXPECT_TRUE(table.UpdatePolicies({}));
+    EXPECT_FALSE(table.IsMetered(CELLULAR_IFACE));
+}
+
+HWTEST_F(NetIfaceMeteredTableTest, LinkMovesAndGoesDown, TestSize.Level1)
+{
+    NetIfaceMeteredTable table(TEST_IDENT);
+    table.UpdatePolicies({MakePolicy(BEARER_CELLULAR, true)});
+    EXPECT_FALSE(table.UpdateLink(BEARER_CELLULAR, "other", CELLULAR_IFACE, true));
+    EXPECT_TRUE(table.UpdateLink(BEARER_CELLULAR, TEST_IDENT, CELLULAR_IFACE, true));
+
+    // The link moved to a new interface before the down of the old one arrived
+    EXPECT_TRUE(table.UpdateLink(BEARER_CELLULAR, TEST_IDENT, "rmnet1", true));
+    EXPECT_FALSE(table.UpdateLink(BEARER_CELLULAR, TEST_IDENT, CELLULAR_IFACE, false));
+    EXPECT_FALSE(table.IsMetered(CELLULAR_IFACE));
+    EXPECT_TRUE(table.IsMetered("rmnet1"));
+
+    EXPECT_TRUE(table.UpdateLink(BEARER_CELLULAR, TEST_IDENT, "rmnet1", false));
+    EXPECT_FALSE(table.IsMetered("rmnet1"));
+    std::string ifaceName;
+    EXPECT_FALSE(table.GetIfaceName(BEARER_CELLULAR, ifaceName));
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
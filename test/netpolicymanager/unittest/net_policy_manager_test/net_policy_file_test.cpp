@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "net_policy_file.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+using namespace testing::ext;
+namespace {
+constexpr uint32_t BURST_NUM = 50;
+constexpr uint32_t BURST_UID_BASE = 10000;
+constexpr int32_t PERSIST_WAIT_MS = 5000;
+constexpr int32_t POLL_MS = 10;
+constexpr uint32_t SWAP_ROUNDS = 200;
+// Well past the coalescing window, a second write would have happened by then
+constexpr int32_t SETTLE_MS = 600;
+const std::string TEST_DIR_TEMPLATE = "/data/local/tmp/net_policy_file_XXXXXX";
+
+bool WaitUntil(const std::function<bool()> &done)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(PERSIST_WAIT_MS);
+    while (!done()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(POLL_MS));
+    }
+    return true;
+}
+
+bool LoadFile(const std::string &fileName, NetPolicy &netPolicy)
+{
+    sptr<NetPolicyFile> reader = (std::make_unique<NetPolicyFile>(fileName)).release();
+    std::string content;
+    return reader->ReadFile(fileName, content) && reader->Json2Obj(content, netPolicy);
+}
+} // namespace
+
+class NetPolicyFileTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+
+    void SetUp()
+    {
+        std::string dirTemplate = TEST_DIR_TEMPLATE;
+        char *dir = mkdtemp(&dirTemplate[0]);
+        ASSERT_NE(dir, nullptr);
+        dir_ = dir;
+    }
+
+    void TearDown()
+    {
+        for (const std::string &name : {"/sub/net_policy.json", "/sub/net_policy.json.tmp", "/net_policy.json",
+            "/net_policy.json.tmp"}) {
+            unlink((dir_ + name).c_str());
+        }
+        rmdir((dir_ + "/sub").c_str());
+        rmdir(dir_.c_str());
+    }
+
+protected:
+    std::string dir_;
+};
+
+HWTEST_F(NetPolicyFileTest, ChangesAreWrittenBehind, TestSize.Level1)
+{
+    std::string fileName = dir_ + "/net_policy.json";
+    sptr<NetPolicyFile> policyFile = (std::make_unique<NetPolicyFile>(fileName)).release();
+    EXPECT_EQ(policyFile->SetBackgroundPolicy(false), NetPolicyResultCode::ERR_NONE);
+
+    // The setter returns with the change visible to readers, the file follows after the window
+    EXPECT_FALSE(policyFile->GetBackgroundPolicy());
+    EXPECT_EQ(policyFile->GetPersistCount(), 0u);
+    ASSERT_TRUE(WaitUntil([&policyFile]() { return policyFile->GetPersistCount() == 1; }));
+    NetPolicy netPolicy;
+    ASSERT_TRUE(LoadFile(fileName, netPolicy));
+    EXPECT_FALSE(netPolicy.backgroundPolicy);
+    EXPECT_TRUE(policyFile->Flush());
+    EXPECT_EQ(policyFile->GetPersistCount(), 1u);
+}
+
+HWTEST_F(NetPolicyFileTest, BurstIsCoalesced, TestSize.Level1)
+{
+    std::string fileName = dir_ + "/net_policy.json";
+    sptr<NetPolicyFile> policyFile = (std::make_unique<NetPolicyFile>(fileName)).release();
+    for (uint32_t i = 0; i < BURST_NUM; i++) {
+        policyFile->WriteFile(NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_ADD, BURST_UID_BASE + i,
+            NetUidPolicy::NET_POLICY_REJECT_METERED_BACKGROUND);
+    }
+    ASSERT_TRUE(WaitUntil([&policyFile]() { return policyFile->GetPersistCount() > 0; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(SETTLE_MS));
+    EXPECT_EQ(policyFile->GetPersistCount(), 1u);
+
+    NetPolicy netPolicy;
+    ASSERT_TRUE(LoadFile(fileName, netPolicy));
+    for (uint32_t i = 0; i < BURST_NUM; i++) {
+        EXPECT_TRUE(netPolicy.uidPolicies.Contains(BURST_UID_BASE + i));
+    }
+}
+
+HWTEST_F(NetPolicyFileTest, FailedWriteIsRetried, TestSize.Level1)
+{
+    // The directory is missing at first, so the temp file cannot be created
+    std::string fileName = dir_ + "/sub/net_policy.json";
+    sptr<NetPolicyFile> policyFile = (std::make_unique<NetPolicyFile>(fileName)).release();
+    policyFile->SetBackgroundPolicy(false);
+    ASSERT_TRUE(WaitUntil([&policyFile]() { return policyFile->GetPersistFailures() > 0; }));
+    EXPECT_FALSE(policyFile->Flush());
+    EXPECT_EQ(policyFile->GetPersistCount(), 0u);
+
+    // No further change comes in, the retry alone has to get the state on disk
+    ASSERT_EQ(mkdir((dir_ + "/sub").c_str(), S_IRWXU), 0);
+    ASSERT_TRUE(WaitUntil([&policyFile]() { return policyFile->GetPersistCount() == 1; }));
+    EXPECT_EQ(policyFile->GetPersistFailures(), 0u);
+    NetPolicy netPolicy;
+    ASSERT_TRUE(LoadFile(fileName, netPolicy));
+    EXPECT_FALSE(netPolicy.backgroundPolicy);
+}
+
+HWTEST_F(NetPolicyFileTest, UnchangedTablesAreShared, TestSize.Level1)
+{
+    sptr<NetPolicyFile> policyFile = (std::make_unique<NetPolicyFile>(dir_ + "/net_policy.json")).release();
+    policyFile->WriteFile(NetUidPolicyOpType::NET_POLICY_UID_OP_TYPE_ADD, BURST_UID_BASE,
+        NetUidPolicy::NET_POLICY_REJECT_METERED_BACKGROUND);
+    std::shared_ptr<const NetPolicySnapshot> before = policyFile->LoadSnapshot();
+    policyFile->SetBackgroundPolicy(false);
+    std::shared_ptr<const NetPolicySnapshot> after = policyFile->LoadSnapshot();
+    EXPECT_TRUE(before->backgroundPolicy);
+    EXPECT_FALSE(after->backgroundPolicy);
+    EXPECT_EQ(before->uidPolicies, after->uidPolicies);
+    EXPECT_EQ(before->quotaPolicies, after->quotaPolicies);
+    EXPECT_EQ(before->cellularPolicies, after->cellularPolicies);
+    EXPECT_EQ(before->idleTrustList, after->idleTrustList);
+
+    policyFile->SetIdleTrustlist(BURST_UID_BASE, true);
+    std::shared_ptr<const NetPolicySnapshot> last = policyFile->LoadSnapshot();
+    EXPECT_EQ(after->uidPolicies, last->uidPolicies);
+    EXPECT_NE(after->idleTrustList, last->idleTrustList);
+    EXPECT_TRUE(policyFile->Flush());
+}
+
+HWTEST_F(NetPolicyFileTest, ReadersNeverSeeHalfABatch, TestSize.Level1)
+{
+    sptr<NetPolicyFile> policyFile = (std::make_unique<NetPolicyFile>(dir_ + "/net_policy.json")).release();
+    std::vector<uint32_t> uids;
+    for (uint32_t i = 0; i < BURST_NUM; i++) {
+        uids.push_back(BURST_UID_BASE + i);
+    }
+    std::vector<NetUidPolicy> rejects(uids.size(), NetUidPolicy::NET_POLICY_REJECT_METERED_BACKGROUND);
+    std::vector<NetUidPolicy> allows(uids.size(), NetUidPolicy::NET_POLICY_ALLOW_METERED_BACKGROUND);
+    std::atomic<bool> done = false;
+    std::thread writer([&]() {
+        for (uint32_t i = 0; i < SWAP_ROUNDS; i++) {
+            std::vector<uint32_t> changedUids;
+            std::vector<NetUidPolicy> changedPolicies;
+            policyFile->SetPoliciesByUids(uids, (i % 2 == 0) ? rejects : allows, changedUids, changedPolicies);
+        }
+        done = true;
+    });
+
+    // Every batch is published at once, a reader sees all uids on one policy or the other
+    uint32_t mixed = 0;
+    while (!done) {
+        std::vector<NetUidPolicy> policies;
+        policyFile->GetPoliciesByUids(uids, policies);
+        if (policies.size() != uids.size()) {
+            mixed++;
+            continue;
+        }
+        for (NetUidPolicy policy : policies) {
+            mixed += (policy != policies.front()) ? 1 : 0;
+        }
+    }
+    writer.join();
+    EXPECT_EQ(mixed, 0u);
+    EXPECT_TRUE(policyFile->Flush());
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -30,6 +30,8 @@ constexpr int32_t TRIGER_DELAY_US = 100000;
 constexpr int32_t TEST_CONSTANT_NUM = 3;
 const std::string TEST_STRING_PERIODDURATION = "M1";
 constexpr int32_t BACKGROUND_POLICY_TEST_UID = 123;
+constexpr uint32_t BATCH_POLICY_TEST_UID_FIRST = 2001;
+constexpr uint32_t BATCH_POLICY_TEST_UID_SECOND = 2002;
 
 using namespace testing::ext;
 class NetPolicyManagerTest : public testing::Test {
@@ -323,5 +325,76 @@ HWTEST_F(NetPolicyManagerTest, NetPolicyManager018, TestSize.Level1)
     NetBackgroundPolicy result = DelayedSingleton<NetPolicyClient>::GetInstance()->GetCurrentBackgroundPolicy();
     ASSERT_TRUE(result == NetBackgroundPolicy::NET_BACKGROUND_POLICY_DISABLE);
 }
+
+/**
+ * @tc.name: NetPolicyManager019
+ * @tc.desc: Test NetPolicyManager SetPoliciesByUids and GetPoliciesByUids.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetPolicyManagerTest, NetPolicyManager019, TestSize.Level1)
+{
+    std::vector<uint32_t> uids = {BATCH_POLICY_TEST_UID_FIRST, BATCH_POLICY_TEST_UID_SECOND};
+    std::vector<NetUidPolicy> policies = {NetUidPolicy::NET_POLICY_REJECT_ALL, NetUidPolicy::NET_POLICY_ALLOW_METERED};
+    NetPolicyResultCode result = DelayedSingleton<NetPolicyClient>::GetInstance()->SetPoliciesByUids(uids, policies);
+    ASSERT_TRUE(result == NetPolicyResultCode::ERR_NONE);
+
+    std::vector<NetUidPolicy> current;
+    result = DelayedSingleton<NetPolicyClient>::GetInstance()->GetPoliciesByUids(uids, current);
+    ASSERT_TRUE(result == NetPolicyResultCode::ERR_NONE);
+    ASSERT_TRUE(current == policies);
+
+    std::vector<NetUidPolicy> none(uids.size(), NetUidPolicy::NET_POLICY_NONE);
+    result = DelayedSingleton<NetPolicyClient>::GetInstance()->SetPoliciesByUids(uids, none);
+    ASSERT_TRUE(result == NetPolicyResultCode::ERR_NONE);
+    result = DelayedSingleton<NetPolicyClient>::GetInstance()->GetPoliciesByUids(uids, current);
+    ASSERT_TRUE(result == NetPolicyResultCode::ERR_NONE);
+    ASSERT_TRUE(current == none);
+}
+
+/**
+ * @tc.name: NetPolicyManager020
+ * @tc.desc: Test NetPolicyManager SetPoliciesByUids rejects the whole batch on one invalid entry.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetPolicyManagerTest, NetPolicyManager020, TestSize.Level1)
+{
+    std::vector<uint32_t> uids = {BATCH_POLICY_TEST_UID_FIRST, BATCH_POLICY_TEST_UID_SECOND};
+    std::vector<NetUidPolicy> policies = {NetUidPolicy::NET_POLICY_REJECT_ALL,
+        static_cast<NetUidPolicy>(TEST_CONSTANT_NUM)};
+    NetPolicyResultCode result = DelayedSingleton<NetPolicyClient>::GetInstance()->SetPoliciesByUids(uids, policies);
+    ASSERT_TRUE(result == NetPolicyResultCode::ERR_INVALID_POLICY);
+
+    NetUidPolicy policy = DelayedSingleton<NetPolicyClient>::GetInstance()->GetPolicyByUid(BATCH_POLICY_TEST_UID_FIRST);
+    ASSERT_TRUE(policy == NetUidPolicy::NET_POLICY_NONE);
+
+    policies.pop_back();
+    result = DelayedSingleton<NetPolicyClient>::GetInstance()->SetPoliciesByUids(uids, policies);
+    ASSERT_TRUE(result == NetPolicyResultCode::ERR_INVALID_POLICY);
+}
+
+/**
+ * @tc.name: NetPolicyManager021
+ * @tc.desc: Test NetPolicyManager ReplaceIdleTrustlist keeps the trust list sorted and free of duplicates.
+ * @tc.type: FUNC
+ */
+HWTEST_F(NetPolicyManagerTest, NetPolicyManager021, TestSize.Level1)
+{
+    std::vector<uint32_t> uids = {BATCH_POLICY_TEST_UID_SECOND, BATCH_POLICY_TEST_UID_FIRST,
+        BATCH_POLICY_TEST_UID_SECOND};
+    NetPolicyResultCode result = DelayedSingleton<NetPolicyClient>::GetInstance()->ReplaceIdleTrustlist(uids);
+    ASSERT_TRUE(result == NetPolicyResultCode::ERR_NONE);
+
+    std::vector<uint32_t> current;
+    result = DelayedSingleton<NetPolicyClient>::GetInstance()->GetIdleTrustlist(current);
+    ASSERT_TRUE(result == NetPolicyResultCode::ERR_NONE);
+    std::vector<uint32_t> expect = {BATCH_POLICY_TEST_UID_FIRST, BATCH_POLICY_TEST_UID_SECOND};
+    ASSERT_TRUE(current == expect);
+
+    result = DelayedSingleton<NetPolicyClient>::GetInstance()->ReplaceIdleTrustlist(std::vector<uint32_t>());
+    ASSERT_TRUE(result == NetPolicyResultCode::ERR_NONE);
+    result = DelayedSingleton<NetPolicyClient>::GetInstance()->GetIdleTrustlist(current);
+    ASSERT_TRUE(result == NetPolicyResultCode::ERR_NONE);
+    ASSERT_TRUE(current.empty());
+}
 }
 }
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "net_uid_flat_set.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+using namespace testing::ext;
+namespace {
+constexpr uint32_t APP_UID_BASE = 20010000;
+constexpr uint32_t UID_COUNT = 3000;
+constexpr uint32_t REMOVE_STEP = 7;
+// Multiplier coprime with UID_COUNT so the insert order is a permutation
+constexpr uint32_t SHUFFLE_STEP = 1009;
+} // namespace
+
+class NetUidFlatSetTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+HWTEST_F(NetUidFlatSetTest, InsertEraseContains, TestSize.Level1)
+{
+    NetUidFlatSet uids;
+    EXPECT_TRUE(uids.Empty());
+    EXPECT_TRUE(uids.Insert(APP_UID_BASE + 1));
+    EXPECT_TRUE(uids.Insert(APP_UID_BASE));
+    EXPECT_FALSE(uids.Insert(APP_UID_BASE + 1));
+    EXPECT_EQ(uids.Size(), 2u);
+    EXPECT_TRUE(uids.Contains(APP_UID_BASE));
+    EXPECT_FALSE(uids.Contains(APP_UID_BASE + 2));
+
+    EXPECT_TRUE(uids.Erase(APP_UID_BASE));
+    EXPECT_FALSE(uids.Erase(APP_UID_BASE));
+    EXPECT_EQ(uids.Values(), std::vector<uint32_t>({APP_UID_BASE + 1}));
+
+    uids.Clear();
+    EXPECT_TRUE(uids.Empty());
+}
+
+HWTEST_F(NetUidFlatSetTest, AssignSortsAndDedups, TestSize.Level1)
+{
+    NetUidFlatSet uids;
+    EXPECT_TRUE(uids.Assign({APP_UID_BASE + 2, APP_UID_BASE, APP_UID_BASE + 2, APP_UID_BASE + 1}));
+    EXPECT_EQ(uids.Values(), std::vector<uint32_t>({APP_UID_BASE, APP_UID_BASE + 1, APP_UID_BASE + 2}));
+    EXPECT_FALSE(uids.Assign({APP_UID_BASE + 1, APP_UID_BASE, APP_UID_BASE + 2}));
+    EXPECT_TRUE(uids.Assign({}));
+    EXPECT_TRUE(uids.Empty());
+}
+
+HWTEST_F(NetUidFlatSetTest, MatchesReference, TestSize.Level1)
+{
+    NetUidFlatSet uids;
+    std::set<uint32_t> expect;
+    for (uint32_t i = 0; i < UID_COUNT; ++i) {
+        uint32_t uid = APP_UID_BASE + (i * SHUFFLE_STEP) % UID_COUNT;
+        EXPECT_TRUE(uids.Insert(uid));
+        expect.insert(uid);
+    }
+    for (uint32_t i = 0; i < UID_COUNT; i += REMOVE_STEP) {
+        EXPECT_TRUE(uids.Erase(APP_UID_BASE + i));
+        expect.erase(APP_UID_BASE + i);
+    }
+    ASSERT_EQ(uids.Size(), expect.size());
+    EXPECT_TRUE(std::equal(expect.begin(), expect.end(), uids.Values().begin()));
+    for (uint32_t i = 0; i < UID_COUNT; ++i) {
+        EXPECT_EQ(uids.Contains(APP_UID_BASE + i), expect.count(APP_UID_BASE + i) != 0);
+    }
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
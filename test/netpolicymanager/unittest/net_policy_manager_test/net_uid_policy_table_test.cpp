@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "net_uid_policy_table.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+using namespace testing::ext;
+namespace {
+constexpr uint32_t APP_UID_BASE = 20010000;
+constexpr uint32_t UID_COUNT = 5000;
+constexpr uint32_t REMOVE_STEP = 3;
+
+NetUidPolicy PolicyOf(uint32_t index)
+{
+    return (index % 2 == 0) ? NetUidPolicy::NET_POLICY_REJECT_ALL : NetUidPolicy::NET_POLICY_ALLOW_METERED;
+}
+
+std::vector<uint32_t> Sorted(std::vector<uint32_t> uids)
+{
+    std::sort(uids.begin(), uids.end());
+    return uids;
+}
+} // namespace
+
+class NetUidPolicyTableTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+HWTEST_F(NetUidPolicyTableTest, SetFindRemove, TestSize.Level1)
+{
+    NetUidPolicyTable table;
+    NetUidPolicy policy = NetUidPolicy::NET_POLICY_NONE;
+    EXPECT_FALSE(table.Find(APP_UID_BASE, policy));
+
+    table.Set(APP_UID_BASE, NetUidPolicy::NET_POLICY_REJECT_METERED);
+    ASSERT_TRUE(table.Find(APP_UID_BASE, policy));
+    EXPECT_EQ(policy, NetUidPolicy::NET_POLICY_REJECT_METERED);
+
+    table.Set(APP_UID_BASE, NetUidPolicy::NET_POLICY_ALLOW_ALL);
+    ASSERT_TRUE(table.Find(APP_UID_BASE, policy));
+    EXPECT_EQ(policy, NetUidPolicy::NET_POLICY_ALLOW_ALL);
+    EXPECT_EQ(table.Size(), 1u);
+
+    std::vector<uint32_t> uids;
+    table.GetUids(NetUidPolicy::NET_POLICY_REJECT_METERED, uids);
+    EXPECT_TRUE(uids.empty());
+
+    EXPECT_TRUE(table.Remove(APP_UID_BASE));
+    EXPECT_FALSE(table.Remove(APP_UID_BASE));
+    EXPECT_FALSE(table.Contains(APP_UID_BASE));
+    EXPECT_EQ(table.Size(), 0u);
+}
+
+HWTEST_F(NetUidPolicyTableTest, MatchesReferenceAfterGrowth, TestSize.Level1)
+{
+    NetUidPolicyTable table;
+    std::map<uint32_t, NetUidPolicy> expect;
+    for (uint32_t i = 0; i < UID_COUNT; ++i) {
+        table.Set(APP_UID_BASE + i, PolicyOf(i));
+        expect[APP_UID_BASE + i] = PolicyOf(i);
+    }
+    for (uint32_t i = 0; i < UID_COUNT; i += REMOVE_STEP) {
+        EXPECT_TRUE(table.Remove(APP_UID_BASE + i));
+        expect.erase(APP_UID_BASE + i);
+    }
+    // Reinserting over tombstones must not duplicate uids
+    for (uint32_t i = 0; i < UID_COUNT; i += REMOVE_STEP * REMOVE_STEP) {
+        table.Set(APP_UID_BASE + i, NetUidPolicy::NET_POLICY_TEMPORARY_ALLOW_METERED);
+        expect[APP_UID_BASE + i] = NetUidPolicy::NET_POLICY_TEMPORARY_ALLOW_METERED;
+    }
+    ASSERT_EQ(table.Size(), expect.size());
+
+    std::map<NetUidPolicy, std::vector<uint32_t>> byPolicy;
+    for (const auto &entry : expect) {
+        NetUidPolicy policy = NetUidPolicy::NET_POLICY_NONE;
+        ASSERT_TRUE(table.Find(entry.first, policy));
+        EXPECT_EQ(policy, entry.second);
+        byPolicy[entry.second].push_back(entry.first);
+    }
+    for (const auto &entry : byPolicy) {
+        std::vector<uint32_t> uids;
+        table.GetUids(entry.first, uids);
+        EXPECT_EQ(Sorted(uids), entry.second);
+    }
+
+    uint32_t visited = 0;
+    table.ForEach([&visited, &expect](uint32_t uid, NetUidPolicy policy) {
+        EXPECT_EQ(expect[uid], policy);
+        ++visited;
+    });
+    EXPECT_EQ(visited, expect.size());
+
+    table.Clear();
+    EXPECT_EQ(table.Size(), 0u);
+    EXPECT_FALSE(table.Contains(APP_UID_BASE + 1));
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "net_uid_verdict_table.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+using namespace testing::ext;
+namespace {
+constexpr uint32_t APP_UID_BASE = 20010000;
+constexpr uint32_t UID_COUNT = 2000;
+constexpr uint32_t READER_COUNT = 2;
+constexpr uint32_t RESET_ROUNDS = 20;
+const std::vector<NetUidPolicy> ALL_POLICIES = {
+    NetUidPolicy::NET_POLICY_NONE,
+    NetUidPolicy::NET_POLICY_ALLOW_METERED_BACKGROUND,
+    NetUidPolicy::NET_POLICY_TEMPORARY_ALLOW_METERED,
+    NetUidPolicy::NET_POLICY_REJECT_METERED_BACKGROUND,
+    NetUidPolicy::NET_POLICY_ALLOW_METERED,
+    NetUidPolicy::NET_POLICY_REJECT_METERED,
+    NetUidPolicy::NET_POLICY_ALLOW_ALL,
+    NetUidPolicy::NET_POLICY_REJECT_ALL,
+};
+
+bool Has(NetUidPolicy policy, NetUidPolicy flag)
+{
+    return (static_cast<uint32_t>(policy) & static_cast<uint32_t>(flag)) == static_cast<uint32_t>(flag);
+}
+
+// The chain IsUidNetAccess used to walk on every call
+bool ReferenceAccess(NetUidPolicy policy, bool metered, bool backgroundPolicy)
+{
+    if (Has(policy, NetUidPolicy::NET_POLICY_REJECT_ALL)) {
+        return false;
+    } else if (Has(policy, NetUidPolicy::NET_POLICY_ALLOW_ALL)) {
+        return true;
+    }
+    if (!metered) {
+        return true;
+    } else if (Has(policy, NetUidPolicy::NET_POLICY_REJECT_METERED)) {
+        return false;
+    } else if (Has(policy, NetUidPolicy::NET_POLICY_ALLOW_METERED) ||
+        Has(policy, NetUidPolicy::NET_POLICY_TEMPORARY_ALLOW_METERED)) {
+        return true;
+    }
+    if (Has(policy, NetUidPolicy::NET_POLICY_REJECT_METERED_BACKGROUND)) {
+        return false;
+    }
+    return backgroundPolicy || Has(policy, NetUidPolicy::NET_POLICY_ALLOW_METERED_BACKGROUND);
+}
+
+NetUidPolicy PolicyOf(uint32_t index)
+{
+    return ALL_POLICIES[index % ALL_POLICIES.size()];
+}
+} // namespace
+
+class NetUidVerdictTableTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+HWTEST_F(NetUidVerdictTableTest, ComputeVerdictMatchesPolicyChain, TestSize.Level1)
+{
+    for (bool backgroundPolicy : {true, false}) {
+        for (NetUidPolicy policy : ALL_POLICIES) {
+            uint8_t verdict = NetUidVerdictTable::ComputeVerdict(policy, backgroundPolicy);
+            EXPECT_EQ((verdict & VERDICT_METERED_ALLOWED) != 0, ReferenceAccess(policy, true, backgroundPolicy));
+            EXPECT_EQ((verdict & VERDICT_UNMETERED_ALLOWED) != 0, ReferenceAccess(policy, false, backgroundPolicy));
+            EXPECT_EQ((verdict & VERDICT_BACKGROUND_ALLOWED) != 0, ReferenceAccess(policy, true, backgroundPolicy));
+        }
+    }
+}
+
+HWTEST_F(NetUidVerdictTableTest, TracksPolicyAndBackgroundChanges, TestSize.Level1)
+{
+    NetUidVerdictTable table;
+    for (uint32_t i = 0; i < UID_COUNT; ++i) {
+        table.UpdateUid(APP_UID_BASE + i, PolicyOf(i));
+    }
+    for (bool backgroundPolicy : {false, true}) {
+        table.UpdateBackgroundPolicy(backgroundPolicy);
+        for (uint32_t i = 0; i < UID_COUNT; ++i) {
+            ASSERT_EQ(table.GetVerdict(APP_UID_BASE + i), NetUidVerdictTable::ComputeVerdict(PolicyOf(i),
+                backgroundPolicy));
+        }
+        EXPECT_EQ(table.GetVerdict(APP_UID_BASE + UID_COUNT),
+            NetUidVerdictTable::ComputeVerdict(NetUidPolicy::NET_POLICY_NONE, backgroundPolicy));
+    }
+
+    table.UpdateUid(APP_UID_BASE, NetUidPolicy::NET_POLICY_REJECT_ALL);
+    EXPECT_EQ(table.GetVerdict(APP_UID_BASE), 0);
+    table.UpdateUid(APP_UID_BASE, NetUidPolicy::NET_POLICY_NONE);
+    EXPECT_EQ(table.GetVerdict(APP_UID_BASE), NetUidVerdictTable::ComputeVerdict(NetUidPolicy::NET_POLICY_NONE, true));
+
+    table.Reset(false);
+    EXPECT_EQ(table.GetVerdict(APP_UID_BASE + ALL_POLICIES.size() - 1), VERDICT_UNMETERED_ALLOWED);
+}
+
+HWTEST_F(NetUidVerdictTableTest, ReadersSeeWholeVerdicts, TestSize.Level1)
+{
+    NetUidVerdictTable table;
+    const uint8_t rejected = NetUidVerdictTable::ComputeVerdict(NetUidPolicy::NET_POLICY_REJECT_ALL, true);
+    const uint8_t allowed = NetUidVerdictTable::ComputeVerdict(NetUidPolicy::NET_POLICY_ALLOW_ALL, true);
+    table.UpdateUid(APP_UID_BASE, NetUidPolicy::NET_POLICY_REJECT_ALL);
+
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> badReads(0);
+    std::vector<std::thread> readers;
+    for (uint32_t r = 0; r < READER_COUNT; ++r) {
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                uint8_t verdict = table.GetVerdict(APP_UID_BASE);
+                if (verdict != rejected && verdict != allowed) {
+                    badReads++;
+                }
+            }
+        });
+    }
+    // Growing the table while readers probe it must never lose the watched uid
+    for (uint32_t i = 1; i < UID_COUNT; ++i) {
+        table.UpdateUid(APP_UID_BASE + i, PolicyOf(i));
+        table.UpdateUid(APP_UID_BASE, (i % 2 == 0) ? NetUidPolicy::NET_POLICY_REJECT_ALL :
+            NetUidPolicy::NET_POLICY_ALLOW_ALL);
+    }
+    done = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(badReads.load(), 0u);
+}
+
+HWTEST_F(NetUidVerdictTableTest, ReadersSurviveReset, TestSize.Level1)
+{
+    NetUidVerdictTable table;
+    const uint8_t rejected = NetUidVerdictTable::ComputeVerdict(NetUidPolicy::NET_POLICY_REJECT_ALL, true);
+    const uint8_t byDefault = NetUidVerdictTable::ComputeVerdict(NetUidPolicy::NET_POLICY_NONE, true);
+
+    std::atomic<bool> done(false);
+    std::atomic<uint32_t> badReads(0);
+    std::vector<std::thread> readers;
+    for (uint32_t r = 0; r < READER_COUNT; ++r) {
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                uint8_t verdict = table.GetVerdict(APP_UID_BASE);
+                if (verdict != rejected && verdict != byDefault) {
+                    badReads++;
+                }
+            }
+        });
+    }
+    // Every reset and growth replaces the table under the readers, the replaced ones are freed as they go
+    for (uint32_t round = 0; round < RESET_ROUNDS; ++round) {
+        table.Reset(true);
+        for (uint32_t i = 0; i < UID_COUNT / RESET_ROUNDS; ++i) {
+            table.UpdateUid(APP_UID_BASE + i, (i == 0) ? NetUidPolicy::NET_POLICY_REJECT_ALL : PolicyOf(i));
+        }
+    }
+    done = true;
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(badReads.load(), 0u);
+    EXPECT_EQ(table.GetVerdict(APP_UID_BASE), rejected);
+}
+} // namespace NetManagerStandard
+} // namespace OHOS
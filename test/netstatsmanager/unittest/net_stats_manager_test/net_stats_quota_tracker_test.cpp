@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "net_stats_quota_tracker.h"
+
+namespace OHOS {
+namespace NetManagerStandard {
+using namespace testing::ext;
+namespace {
+const std::string TEST_IFACE = "rmnet0";
+const std::string TEST_IDENT = "quota_test";
+constexpr int64_t PERIOD_START = 1636598990;
+constexpr int64_t PERIOD_END = PERIOD_START + 86400;
+constexpr int64_t WARNING_BYTES = 1000;
+constexpr int64_t LIMIT_BYTES = 2000;
+
+NetStatsQuota MakeQuota(const std::string &ident)
+{
+    NetStatsQuota quota;
+    quota.ident = ident;
+    quota.iface = TEST_IFACE;
+    quota.periodStart = PERIOD_START;
+    quota.periodEnd = PERIOD_END;
+    quota.warningBytes = WARNING_BYTES;
+    quota.limitBytes = LIMIT_BYTES;
+    return quota;
+}
+} // namespace
+
+class NetStatsQuotaTrackerTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+HWTEST_F(NetStatsQuotaTrackerTest, ThresholdsFireOnce, TestSize.Level1)
+{
+    NetStatsQuotaTracker tracker;
+    tracker.SetQuota(MakeQuota(TEST_IDENT), 0, 0, 0, nullptr);
+
+    auto events = tracker.OnSample(TEST_IFACE, WARNING_BYTES / 2, WARNING_BYTES / 2, PERIOD_START + 1);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].type, NetStatsQuotaEventType::WARNING_REACHED);
+    EXPECT_TRUE(tracker.OnSample(TEST_IFACE, WARNING_BYTES, WARNING_BYTES / 2, PERIOD_START + 2).empty());
+
+    events = tracker.OnSample(TEST_IFACE, LIMIT_BYTES, 0, PERIOD_START + 3);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].type, NetStatsQuotaEventType::LIMIT_REACHED);
+    EXPECT_EQ(events[0].quota.ident, TEST_IDENT);
+    EXPECT_TRUE(tracker.OnSample(TEST_IFACE, LIMIT_BYTES, 0, PERIOD_START + 4).empty());
+
+    EXPECT_TRUE(tracker.OnSample("other0", LIMIT_BYTES, LIMIT_BYTES, PERIOD_START + 4).empty());
+}
+
+HWTEST_F(NetStatsQuotaTrackerTest, CounterResetAndBaseline, TestSize.Level1)
+{
+    NetStatsQuotaTracker tracker;
+    constexpr int64_t baseline = 500;
+    constexpr int64_t rawBytes = 100000;
+    tracker.SetQuota(MakeQuota(TEST_IDENT), baseline, rawBytes, rawBytes, nullptr);
+
+    int64_t usedBytes = 0;
+    EXPECT_TRUE(tracker.OnSample(TEST_IFACE, rawBytes + 100, rawBytes, PERIOD_START + 1).empty());
+    ASSERT_TRUE(tracker.GetUsedBytes(TEST_IDENT, usedBytes));
+    EXPECT_EQ(usedBytes, baseline + 100);
+
+    // Counters going backwards were reset, their value is new traffic
+    EXPECT_TRUE(tracker.OnSample(TEST_IFACE, 10, 20, PERIOD_START + 2).empty());
+    ASSERT_TRUE(tracker.GetUsedBytes(TEST_IDENT, usedBytes));
+    EXPECT_EQ(usedBytes, baseline + 130);
+
+    // A second quota armed between samples must not count the pending traffic twice
+    constexpr int64_t secondBaseline = 50;
+    tracker.SetQuota(MakeQuota("cellular_test"), secondBaseline, 40, 20, nullptr);
+    EXPECT_TRUE(tracker.OnSample(TEST_IFACE, 40, 20, PERIOD_START + 3).empty());
+    ASSERT_TRUE(tracker.GetUsedBytes("cellular_test", usedBytes));
+    EXPECT_EQ(usedBytes, secondBaseline);
+}
+
+HWTEST_F(NetStatsQuotaTrackerTest, PeriodEndDisarms, TestSize.Level1)
+{
+    NetStatsQuotaTracker tracker;
+    tracker.SetQuota(MakeQuota(TEST_IDENT), LIMIT_BYTES, 0, 0, nullptr);
+    EXPECT_TRUE(tracker.OnSample(TEST_IFACE, 1, 0, PERIOD_START + 1).empty());
+
+    auto events = tracker.OnSample(TEST_IFACE, 1, 0, PERIOD_END);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].type, NetStatsQuotaEventType::PERIOD_ENDED);
+    EXPECT_TRUE(tracker.GetIfaces().empty());
+
+    tracker.SetQuota(MakeQuota(TEST_IDENT), 0, 0, 0, nullptr);
+    EXPECT_TRUE(tracker.RemoveQuota(TEST_IDENT));
+    EXPECT_FALSE(tracker.RemoveQuota(TEST_IDENT));
+    EXPECT_TRUE(tracker.GetIfaces().empty());
+}
+} // namespace NetManagerStandard
+} // namespace OHOS